@@ -0,0 +1,377 @@
+/*******************************************************************************
+  ADC Stream Receiver Source File
+
+  File Name:
+    adc_rx.c
+
+  Summary:
+    Host side decoder for the framed binary stream of STREAM ON.
+
+  Description:
+    The parser works on a linear buffer: bytes are appended, complete
+    frames are consumed from the front and the rest is moved down. A byte
+    which does not start a good frame is skipped, after which the search
+    resumes at the next possible sync byte, so a corrupted frame costs at
+    most itself.
+
+    Unpacking puts every 3 byte sample into the top of a 32 bit lane with
+    one byte shuffle and sign extends it with an arithmetic shift by 8:
+    4 samples per SSSE3 step, 8 per AVX2 step. The kernel is picked at run
+    time, so one binary runs on any x86-64 and builds elsewhere with the
+    scalar code only.
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <string.h>
+#include "adc_rx.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define ADC_RX_X86                          1
+#endif
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+typedef void (*ADC_RX_UNPACK)(const uint8_t* in, int32_t* out, size_t count);
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data
+// *****************************************************************************
+// *****************************************************************************
+
+static ADC_RX_UNPACK rxUnpack;
+static const char* rxUnpackName;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+#if defined(ADC_RX_X86)
+
+__attribute__((target("ssse3")))
+static void lADC_RX_Unpack24Ssse3(const uint8_t* in, int32_t* out, size_t count)
+{
+    const __m128i shuffle = _mm_setr_epi8(-1, 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11);
+    __m128i v;
+    size_t i = 0;
+
+    /* A 16 byte load for 12 bytes of samples: stop before reading past in */
+    for (; ((3U * i) + 16U) <= (3U * count); i += 4U)
+    {
+        v = _mm_loadu_si128((const __m128i*) &in[3U * i]);
+        v = _mm_srai_epi32(_mm_shuffle_epi8(v, shuffle), 8);
+        _mm_storeu_si128((__m128i*) &out[i], v);
+    }
+
+    ADC_RX_Unpack24Ref(&in[3U * i], &out[i], count - i);
+}
+
+__attribute__((target("avx2")))
+static void lADC_RX_Unpack24Avx2(const uint8_t* in, int32_t* out, size_t count)
+{
+    const __m256i shuffle = _mm256_setr_epi8(-1, 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11,
+                                             -1, 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11);
+    __m256i v;
+    size_t i = 0;
+
+    /* vpshufb does not cross lanes: 12 sample bytes go into each 128 bit half */
+    for (; ((3U * i) + 28U) <= (3U * count); i += 8U)
+    {
+        v = _mm256_castsi128_si256(_mm_loadu_si128((const __m128i*) &in[3U * i]));
+        v = _mm256_inserti128_si256(v, _mm_loadu_si128((const __m128i*) &in[(3U * i) + 12U]), 1);
+        v = _mm256_srai_epi32(_mm256_shuffle_epi8(v, shuffle), 8);
+        _mm256_storeu_si256((__m256i*) &out[i], v);
+    }
+
+    ADC_RX_Unpack24Ref(&in[3U * i], &out[i], count - i);
+}
+
+#endif
+
+static void lADC_RX_UnpackSelect(void)
+{
+    rxUnpack = ADC_RX_Unpack24Ref;
+    rxUnpackName = "scalar";
+
+#if defined(ADC_RX_X86)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+    {
+        rxUnpack = lADC_RX_Unpack24Avx2;
+        rxUnpackName = "avx2";
+    }
+    else if (__builtin_cpu_supports("ssse3"))
+    {
+        rxUnpack = lADC_RX_Unpack24Ssse3;
+        rxUnpackName = "ssse3";
+    }
+#endif
+}
+
+static void lADC_RX_Deliver(ADC_RX* rx, const uint8_t* frame, uint32_t count)
+{
+    ADC_RX_FRAME info;
+    uint16_t gap;
+
+    info.sequence = (uint16_t) (frame[2] | (frame[3] << 8));
+    info.mask = (uint32_t) frame[4] | ((uint32_t) frame[5] << 8) | ((uint32_t) frame[6] << 16) |
+                ((uint32_t) frame[7] << 24);
+    info.count = count;
+    info.samples = rx->samples;
+
+    ADC_RX_Unpack24(&frame[ADC_STREAM_HEADER_SIZE], rx->samples, count);
+
+    /* 16 bit sequence: gaps of 65536 frames or more go unnoticed */
+    if (rx->synced)
+    {
+        gap = (uint16_t) (info.sequence - rx->expected);
+        if (gap != 0U)
+        {
+            rx->stats.gaps++;
+            rx->stats.lost += gap;
+        }
+    }
+    rx->synced = true;
+    rx->expected = (uint16_t) (info.sequence + 1U);
+
+    rx->stats.frames++;
+    rx->stats.samples += count;
+
+    if (rx->callback != NULL)
+    {
+        rx->callback(&info, rx->context);
+    }
+}
+
+/* Returns the number of bytes consumed from the front of the buffer */
+static size_t lADC_RX_Parse(ADC_RX* rx)
+{
+    const uint8_t* p;
+    const uint8_t* next;
+    size_t pos = 0;
+    size_t left;
+    size_t size;
+    uint32_t count;
+    uint16_t crc;
+
+    while ((left = rx->fill - pos) >= 2U)
+    {
+        p = &rx->buffer[pos];
+
+        if ((p[0] != ADC_STREAM_SYNC0) || (p[1] != ADC_STREAM_SYNC1))
+        {
+            next = memchr(&p[1], ADC_STREAM_SYNC0, left - 1U);
+            size = (next != NULL) ? (size_t) (next - p) : left;
+            rx->stats.skipped += size;
+            pos += size;
+            continue;
+        }
+
+        if (left < ADC_STREAM_HEADER_SIZE)
+        {
+            break;
+        }
+
+        count = (uint32_t) p[8] | ((uint32_t) p[9] << 8);
+        size = ADC_STREAM_HEADER_SIZE + (count * ADC_STREAM_SAMPLE_SIZE) + ADC_STREAM_CRC_SIZE;
+
+        if (count <= ADC_RX_FRAME_SAMPLES_MAX)
+        {
+            if (left < size)
+            {
+                break;
+            }
+
+            crc = ADC_RX_Crc16(ADC_STREAM_CRC_INIT, &p[2], size - 2U - ADC_STREAM_CRC_SIZE);
+            if ((p[size - 2U] == (uint8_t) crc) && (p[size - 1U] == (uint8_t) (crc >> 8)))
+            {
+                lADC_RX_Deliver(rx, p, count);
+                pos += size;
+                continue;
+            }
+
+            rx->stats.crcErrors++;
+        }
+
+        /* False sync or damaged frame: resume the hunt one byte further */
+        rx->stats.skipped++;
+        pos++;
+    }
+
+    /* A lone trailing byte which is not a sync byte cannot start a frame */
+    if (((rx->fill - pos) == 1U) && (rx->buffer[pos] != ADC_STREAM_SYNC0))
+    {
+        rx->stats.skipped++;
+        pos++;
+    }
+
+    return pos;
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+void ADC_RX_Initialize(ADC_RX* rx, ADC_RX_CALLBACK callback, void* context)
+{
+    memset(rx, 0, sizeof(*rx));
+    rx->callback = callback;
+    rx->context = context;
+
+    if (rxUnpack == NULL)
+    {
+        lADC_RX_UnpackSelect();
+    }
+}
+
+void ADC_RX_Feed(ADC_RX* rx, const uint8_t* data, size_t length)
+{
+    size_t chunk;
+    size_t used;
+
+    rx->stats.bytes += length;
+
+    while (length != 0U)
+    {
+        chunk = ADC_RX_BUFFER_SIZE - rx->fill;
+        if (chunk > length)
+        {
+            chunk = length;
+        }
+
+        memcpy(&rx->buffer[rx->fill], data, chunk);
+        rx->fill += chunk;
+        data += chunk;
+        length -= chunk;
+
+        used = lADC_RX_Parse(rx);
+        rx->fill -= used;
+        memmove(rx->buffer, &rx->buffer[used], rx->fill);
+    }
+}
+
+size_t ADC_RX_FrameBuild(uint8_t* frame, uint16_t sequence, uint32_t mask, const int32_t* samples, uint32_t count)
+{
+    uint8_t* p = &frame[ADC_STREAM_HEADER_SIZE];
+    size_t size;
+    uint16_t crc;
+    uint32_t i;
+
+    frame[0] = ADC_STREAM_SYNC0;
+    frame[1] = ADC_STREAM_SYNC1;
+    frame[2] = (uint8_t) sequence;
+    frame[3] = (uint8_t) (sequence >> 8);
+    frame[4] = (uint8_t) mask;
+    frame[5] = (uint8_t) (mask >> 8);
+    frame[6] = (uint8_t) (mask >> 16);
+    frame[7] = (uint8_t) (mask >> 24);
+    frame[8] = (uint8_t) count;
+    frame[9] = (uint8_t) (count >> 8);
+
+    for (i = 0; i < count; i++)
+    {
+        p[0] = (uint8_t) samples[i];
+        p[1] = (uint8_t) (samples[i] >> 8);
+        p[2] = (uint8_t) (samples[i] >> 16);
+        p += ADC_STREAM_SAMPLE_SIZE;
+    }
+
+    size = (size_t) (p - frame);
+    crc = ADC_RX_Crc16(ADC_STREAM_CRC_INIT, &frame[2], size - 2U);
+    p[0] = (uint8_t) crc;
+    p[1] = (uint8_t) (crc >> 8);
+
+    return size + ADC_STREAM_CRC_SIZE;
+}
+
+void ADC_RX_Unpack24(const uint8_t* in, int32_t* out, size_t count)
+{
+    if (rxUnpack == NULL)
+    {
+        lADC_RX_UnpackSelect();
+    }
+
+    rxUnpack(in, out, count);
+}
+
+void ADC_RX_Unpack24Ref(const uint8_t* in, int32_t* out, size_t count)
+{
+    size_t i;
+
+    for (i = 0; i < count; i++)
+    {
+        out[i] = (int32_t) ((uint32_t) in[0] << 8 | (uint32_t) in[1] << 16 | (uint32_t) in[2] << 24) >> 8;
+        in += 3;
+    }
+}
+
+const char* ADC_RX_Unpack24Kernel(void)
+{
+    if (rxUnpack == NULL)
+    {
+        lADC_RX_UnpackSelect();
+    }
+
+    return rxUnpackName;
+}
+
+bool ADC_RX_Unpack24KernelSet(const char* name)
+{
+    if (strcmp(name, "scalar") == 0)
+    {
+        rxUnpack = ADC_RX_Unpack24Ref;
+        rxUnpackName = "scalar";
+        return true;
+    }
+
+#if defined(ADC_RX_X86)
+    __builtin_cpu_init();
+    if ((strcmp(name, "avx2") == 0) && __builtin_cpu_supports("avx2"))
+    {
+        rxUnpack = lADC_RX_Unpack24Avx2;
+        rxUnpackName = "avx2";
+        return true;
+    }
+    if ((strcmp(name, "ssse3") == 0) && __builtin_cpu_supports("ssse3"))
+    {
+        rxUnpack = lADC_RX_Unpack24Ssse3;
+        rxUnpackName = "ssse3";
+        return true;
+    }
+#endif
+
+    return false;
+}
+
+uint16_t ADC_RX_Crc16(uint16_t crc, const uint8_t* data, size_t length)
+{
+    uint32_t x;
+
+    /* Same folding as the firmware's ADC_STREAM_Crc16 */
+    while (length-- != 0U)
+    {
+        x = ((uint32_t) crc >> 8) ^ *data++;
+        x ^= x >> 4;
+        crc = (uint16_t) ((crc << 8) ^ (x << 12) ^ (x << 5) ^ x);
+    }
+
+    return crc;
+}
+
+/*******************************************************************************
+ End of File
+ */
@@ -0,0 +1,152 @@
+/*******************************************************************************
+  ADC Stream Receiver Header File
+
+  File Name:
+    adc_rx.h
+
+  Summary:
+    Host side decoder for the framed binary stream of STREAM ON.
+
+  Description:
+    Bytes from the UART are fed in arbitrary pieces. The receiver hunts for
+    the sync word, checks length and CRC, unpacks the 24 bit samples and
+    hands each good frame to a callback. Anything else on the line (console
+    text, corrupted frames) is skipped and counted.
+
+    The frame layout is the one of src/adc_stream.h, which is included
+    here so both ends share the constants.
+*******************************************************************************/
+
+#ifndef _ADC_RX_H
+#define _ADC_RX_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "adc_stream.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Constants
+// *****************************************************************************
+// *****************************************************************************
+
+/* Longer frames are taken as a false sync */
+#define ADC_RX_FRAME_SAMPLES_MAX            ADC_STREAM_FRAME_SAMPLES
+#define ADC_RX_FRAME_SIZE_MAX               (ADC_STREAM_HEADER_SIZE + \
+                                             (ADC_RX_FRAME_SAMPLES_MAX * ADC_STREAM_SAMPLE_SIZE) + \
+                                             ADC_STREAM_CRC_SIZE)
+
+#define ADC_RX_BUFFER_SIZE                  4096U
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Type Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+typedef struct
+{
+    uint16_t sequence;
+    uint32_t mask;
+    uint32_t count;
+    const int32_t* samples;
+
+} ADC_RX_FRAME;
+
+typedef void (*ADC_RX_CALLBACK)(const ADC_RX_FRAME* frame, void* context);
+
+// *****************************************************************************
+/* Receiver counters
+
+  Remarks:
+    lost is the number of frames missing according to the sequence numbers,
+    which covers frames dropped by the firmware as well as frames lost or
+    corrupted on the line. skipped counts bytes outside good frames.
+*/
+
+typedef struct
+{
+    uint64_t bytes;
+    uint64_t frames;
+    uint64_t samples;
+    uint64_t skipped;
+    uint64_t crcErrors;
+    uint64_t gaps;
+    uint64_t lost;
+
+} ADC_RX_STATS;
+
+typedef struct
+{
+    ADC_RX_CALLBACK callback;
+    void* context;
+    uint8_t buffer[ADC_RX_BUFFER_SIZE];
+    size_t fill;
+    bool synced;
+    uint16_t expected;
+    int32_t samples[ADC_RX_FRAME_SAMPLES_MAX];
+    ADC_RX_STATS stats;
+
+} ADC_RX;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+void ADC_RX_Initialize ( ADC_RX* rx, ADC_RX_CALLBACK callback, void* context );
+
+/* Parses length bytes; frames are delivered from inside this call */
+void ADC_RX_Feed ( ADC_RX* rx, const uint8_t* data, size_t length );
+
+/*******************************************************************************
+  Function:
+    size_t ADC_RX_FrameBuild ( uint8_t* frame, uint16_t sequence, uint32_t mask,
+                               const int32_t* samples, uint32_t count )
+
+  Summary:
+    Encodes one frame the way the firmware does, returns its size.
+
+  Remarks:
+    count is at most ADC_RX_FRAME_SAMPLES_MAX, frame has room for
+    ADC_RX_FRAME_SIZE_MAX bytes. Used by the CLI's generator mode.
+*/
+
+size_t ADC_RX_FrameBuild ( uint8_t* frame, uint16_t sequence, uint32_t mask,
+                           const int32_t* samples, uint32_t count );
+
+/* Packed little endian signed 24 bit to int32, SIMD where the CPU has it */
+void ADC_RX_Unpack24 ( const uint8_t* in, int32_t* out, size_t count );
+
+void ADC_RX_Unpack24Ref ( const uint8_t* in, int32_t* out, size_t count );
+
+/* Name of the kernel ADC_RX_Unpack24 dispatches to: "avx2", "ssse3", "scalar" */
+const char* ADC_RX_Unpack24Kernel ( void );
+
+/* Makes ADC_RX_Unpack24 use the named kernel; false when the CPU or the
+   build lacks it. For the tests and benchmarks */
+bool ADC_RX_Unpack24KernelSet ( const char* name );
+
+uint16_t ADC_RX_Crc16 ( uint16_t crc, const uint8_t* data, size_t length );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _ADC_RX_H */
+
+/*******************************************************************************
+ End of File
+ */
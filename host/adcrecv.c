@@ -0,0 +1,490 @@
+/*******************************************************************************
+  ADC Stream Receiver Command Line Tool
+
+  File Name:
+    adcrecv.c
+
+  Summary:
+    Captures the STREAM ON output of the board from a tty or a file.
+
+  Description:
+    adcrecv [-b baud] [-o capture] [-t seconds] [-q] <tty|file|->
+      Decodes frames, optionally appends them to a memory mapped capture
+      file, and reports throughput, CRC errors and sequence gaps once per
+      second and at the end.
+
+    adcrecv -g [-b baud] [-n frames] [-r frames/s] [-d every] [-x] <tty|file|->
+      Generator: writes frames of a test signal the way the firmware does,
+      dropping every n-th frame (-d) and putting console text between
+      frames (-x) if asked. With a pty pair, e.g.
+
+        socat pty,raw,echo=0,link=/tmp/board pty,raw,echo=0,link=/tmp/host
+        adcrecv -g -r 2000 -d 100 -x /tmp/board &
+        adcrecv -o capture.bin /tmp/host
+
+      the receiver runs exactly as against the board.
+
+    Capture file: one record per frame, little endian,
+      uint16 sequence, uint16 count, uint32 mask, count x int32 samples.
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#define _DEFAULT_SOURCE
+
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <math.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+#include "adc_rx.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+#define ADCRECV_READ_SIZE                   65536U
+
+/* Capture file grows by at least this much per remap */
+#define ADCRECV_CAPTURE_GROW                (64UL << 20)
+
+#define ADCRECV_RECORD_HEADER_SIZE          8U
+
+#ifndef M_PI
+#define M_PI                                3.14159265358979323846
+#endif
+
+typedef struct
+{
+    int fd;
+    uint8_t* map;
+    size_t size;
+    size_t used;
+
+} ADCRECV_CAPTURE;
+
+typedef struct
+{
+    speed_t speed;
+    unsigned long baud;
+
+} ADCRECV_BAUD;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data
+// *****************************************************************************
+// *****************************************************************************
+
+static const ADCRECV_BAUD adcrecvBauds[] =
+{
+    {B115200, 115200UL}, {B230400, 230400UL}, {B460800, 460800UL}, {B921600, 921600UL},
+    {B1000000, 1000000UL}, {B1500000, 1500000UL}, {B2000000, 2000000UL}, {B3000000, 3000000UL},
+    {B4000000, 4000000UL},
+};
+
+static volatile sig_atomic_t adcrecvStop;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+static void lADCRECV_Signal(int signal)
+{
+    (void) signal;
+    adcrecvStop = 1;
+}
+
+static double lADCRECV_Now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (double) ts.tv_sec + ((double) ts.tv_nsec * 1e-9);
+}
+
+static int lADCRECV_Open(const char* path, int flags, unsigned long baud)
+{
+    struct termios tio;
+    size_t i;
+    int fd;
+
+    if (strcmp(path, "-") == 0)
+    {
+        return ((flags & O_ACCMODE) == O_RDONLY) ? STDIN_FILENO : STDOUT_FILENO;
+    }
+
+    fd = open(path, flags | O_NOCTTY, 0644);
+    if ((fd < 0) || !isatty(fd))
+    {
+        return fd;
+    }
+
+    /* A tty: raw 8N1 at the requested speed, reads return what is there */
+    if (tcgetattr(fd, &tio) == 0)
+    {
+        cfmakeraw(&tio);
+        tio.c_cc[VMIN] = 1;
+        tio.c_cc[VTIME] = 0;
+
+        for (i = 0; i < (sizeof(adcrecvBauds) / sizeof(adcrecvBauds[0])); i++)
+        {
+            if (adcrecvBauds[i].baud == baud)
+            {
+                cfsetispeed(&tio, adcrecvBauds[i].speed);
+                cfsetospeed(&tio, adcrecvBauds[i].speed);
+            }
+        }
+
+        (void) tcsetattr(fd, TCSANOW, &tio);
+    }
+
+    return fd;
+}
+
+static int lADCRECV_CaptureOpen(ADCRECV_CAPTURE* capture, const char* path)
+{
+    memset(capture, 0, sizeof(*capture));
+
+    capture->fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+
+    return (capture->fd < 0) ? -1 : 0;
+}
+
+static int lADCRECV_CaptureReserve(ADCRECV_CAPTURE* capture, size_t need)
+{
+    size_t size;
+
+    if ((capture->used + need) <= capture->size)
+    {
+        return 0;
+    }
+
+    size = capture->size + ((need > ADCRECV_CAPTURE_GROW) ? need : ADCRECV_CAPTURE_GROW);
+
+    if (capture->map != NULL)
+    {
+        (void) munmap(capture->map, capture->size);
+        capture->map = NULL;
+    }
+    if (ftruncate(capture->fd, (off_t) size) != 0)
+    {
+        return -1;
+    }
+
+    capture->map = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, capture->fd, 0);
+    if (capture->map == MAP_FAILED)
+    {
+        capture->map = NULL;
+        return -1;
+    }
+    capture->size = size;
+
+    return 0;
+}
+
+static void lADCRECV_CaptureClose(ADCRECV_CAPTURE* capture)
+{
+    if (capture->fd < 0)
+    {
+        return;
+    }
+
+    if (capture->map != NULL)
+    {
+        (void) munmap(capture->map, capture->size);
+    }
+
+    /* Drop the unused tail of the last growth step */
+    (void) ftruncate(capture->fd, (off_t) capture->used);
+    (void) close(capture->fd);
+    capture->fd = -1;
+}
+
+static void lADCRECV_Frame(const ADC_RX_FRAME* frame, void* context)
+{
+    ADCRECV_CAPTURE* capture = context;
+    uint8_t* p;
+
+    if ((capture == NULL) ||
+        (lADCRECV_CaptureReserve(capture, ADCRECV_RECORD_HEADER_SIZE + (frame->count * sizeof(int32_t))) != 0))
+    {
+        return;
+    }
+
+    p = &capture->map[capture->used];
+    p[0] = (uint8_t) frame->sequence;
+    p[1] = (uint8_t) (frame->sequence >> 8);
+    p[2] = (uint8_t) frame->count;
+    p[3] = (uint8_t) (frame->count >> 8);
+    p[4] = (uint8_t) frame->mask;
+    p[5] = (uint8_t) (frame->mask >> 8);
+    p[6] = (uint8_t) (frame->mask >> 16);
+    p[7] = (uint8_t) (frame->mask >> 24);
+
+    /* Host is little endian like the record format */
+    memcpy(&p[ADCRECV_RECORD_HEADER_SIZE], frame->samples, frame->count * sizeof(int32_t));
+    capture->used += ADCRECV_RECORD_HEADER_SIZE + (frame->count * sizeof(int32_t));
+}
+
+static void lADCRECV_Report(const ADC_RX_STATS* stats, const ADC_RX_STATS* last, double seconds)
+{
+    fprintf(stderr, "%8.3f MB/s %10.0f sps  frames %" PRIu64 "  samples %" PRIu64 "  lost %" PRIu64
+            " (%" PRIu64 " gaps)  crc %" PRIu64 "  skipped %" PRIu64 "\n",
+            (double) (stats->bytes - last->bytes) / seconds / 1e6,
+            (double) (stats->samples - last->samples) / seconds,
+            stats->frames, stats->samples, stats->lost, stats->gaps, stats->crcErrors, stats->skipped);
+}
+
+static int lADCRECV_Receive(const char* path, const char* capturePath, unsigned long baud, double limit, int quiet)
+{
+    static uint8_t data[ADCRECV_READ_SIZE];
+    static ADC_RX rx;
+    ADCRECV_CAPTURE capture;
+    ADC_RX_STATS last;
+    double start;
+    double mark;
+    double now;
+    ssize_t n;
+    int fd;
+
+    fd = lADCRECV_Open(path, O_RDONLY, baud);
+    if (fd < 0)
+    {
+        fprintf(stderr, "adcrecv: %s: %s\n", path, strerror(errno));
+        return 1;
+    }
+
+    capture.fd = -1;
+    if ((capturePath != NULL) && (lADCRECV_CaptureOpen(&capture, capturePath) != 0))
+    {
+        fprintf(stderr, "adcrecv: %s: %s\n", capturePath, strerror(errno));
+        return 1;
+    }
+
+    ADC_RX_Initialize(&rx, lADCRECV_Frame, (capturePath != NULL) ? &capture : NULL);
+    if (!quiet)
+    {
+        fprintf(stderr, "adcrecv: %s, unpack kernel %s\n", path, ADC_RX_Unpack24Kernel());
+    }
+
+    memset(&last, 0, sizeof(last));
+    start = lADCRECV_Now();
+    mark = start;
+
+    while (!adcrecvStop)
+    {
+        n = read(fd, data, sizeof(data));
+        if (n < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            /* EIO: the other side of a pty went away, same as end of file */
+            if (errno != EIO)
+            {
+                fprintf(stderr, "adcrecv: read: %s\n", strerror(errno));
+            }
+            break;
+        }
+        if (n == 0)
+        {
+            break;
+        }
+
+        ADC_RX_Feed(&rx, data, (size_t) n);
+
+        now = lADCRECV_Now();
+        if (!quiet && ((now - mark) >= 1.0))
+        {
+            lADCRECV_Report(&rx.stats, &last, now - mark);
+            last = rx.stats;
+            mark = now;
+        }
+        if ((limit > 0.0) && ((now - start) >= limit))
+        {
+            break;
+        }
+    }
+
+    now = lADCRECV_Now();
+    memset(&last, 0, sizeof(last));
+    fprintf(stderr, "total %.3f s: ", now - start);
+    lADCRECV_Report(&rx.stats, &last, (now > start) ? (now - start) : 1.0);
+
+    lADCRECV_CaptureClose(&capture);
+    if (fd != STDIN_FILENO)
+    {
+        (void) close(fd);
+    }
+
+    return 0;
+}
+
+static int lADCRECV_WriteAll(int fd, const uint8_t* data, size_t size)
+{
+    ssize_t n;
+
+    while (size != 0U)
+    {
+        n = write(fd, data, size);
+        if (n < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return -1;
+        }
+        data += n;
+        size -= (size_t) n;
+    }
+
+    return 0;
+}
+
+static int lADCRECV_Generate(const char* path, unsigned long baud, unsigned long frames, double rate,
+                             unsigned long dropEvery, int text)
+{
+    static const char line[] = "Setting the ADC in continuous mode...\r\n";
+    uint8_t frame[ADC_RX_FRAME_SIZE_MAX];
+    int32_t samples[ADC_RX_FRAME_SAMPLES_MAX];
+    struct timespec delay;
+    unsigned long i;
+    uint32_t k;
+    uint32_t t = 0;
+    size_t size;
+    int fd;
+
+    fd = lADCRECV_Open(path, O_WRONLY | O_CREAT | O_TRUNC, baud);
+    if (fd < 0)
+    {
+        fprintf(stderr, "adcrecv: %s: %s\n", path, strerror(errno));
+        return 1;
+    }
+
+    delay.tv_sec = 0;
+    delay.tv_nsec = (rate > 0.0) ? (long) (1e9 / rate) : 0L;
+
+    for (i = 0; (i < frames) && !adcrecvStop; i++)
+    {
+        /* Full scale sine over 1000 samples plus a small ramp */
+        for (k = 0; k < ADC_RX_FRAME_SAMPLES_MAX; k++, t++)
+        {
+            samples[k] = (int32_t) (8000000.0 * sin(2.0 * M_PI * (double) (t % 1000U) / 1000.0)) +
+                         (int32_t) (t % 256U);
+        }
+
+        if ((dropEvery != 0U) && ((i % dropEvery) == (dropEvery - 1U)))
+        {
+            continue;
+        }
+
+        size = ADC_RX_FrameBuild(frame, (uint16_t) i, ADC_STREAM_MASK_MUX, samples, ADC_RX_FRAME_SAMPLES_MAX);
+        if (((text != 0) && ((i % 16U) == 0U) && (lADCRECV_WriteAll(fd, (const uint8_t*) line, sizeof(line) - 1U) != 0)) ||
+            (lADCRECV_WriteAll(fd, frame, size) != 0))
+        {
+            fprintf(stderr, "adcrecv: write: %s\n", strerror(errno));
+            break;
+        }
+
+        if (delay.tv_nsec != 0L)
+        {
+            (void) nanosleep(&delay, NULL);
+        }
+    }
+
+    if (fd != STDOUT_FILENO)
+    {
+        (void) close(fd);
+    }
+
+    return 0;
+}
+
+static void lADCRECV_Usage(void)
+{
+    fprintf(stderr,
+            "usage: adcrecv [-b baud] [-o capture] [-t seconds] [-q] <tty|file|->\n"
+            "       adcrecv -g [-b baud] [-n frames] [-r frames/s] [-d every] [-x] <tty|file|->\n");
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Main Entry Point
+// *****************************************************************************
+// *****************************************************************************
+
+int main(int argc, char** argv)
+{
+    struct sigaction action;
+    const char* capturePath = NULL;
+    unsigned long baud = 115200UL;
+    unsigned long frames = 1000UL;
+    unsigned long dropEvery = 0UL;
+    double limit = 0.0;
+    double rate = 0.0;
+    int generate = 0;
+    int text = 0;
+    int quiet = 0;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "b:o:t:qgn:r:d:x")) != -1)
+    {
+        switch (opt)
+        {
+            case 'b': baud = strtoul(optarg, NULL, 0); break;
+            case 'o': capturePath = optarg; break;
+            case 't': limit = strtod(optarg, NULL); break;
+            case 'q': quiet = 1; break;
+            case 'g': generate = 1; break;
+            case 'n': frames = strtoul(optarg, NULL, 0); break;
+            case 'r': rate = strtod(optarg, NULL); break;
+            case 'd': dropEvery = strtoul(optarg, NULL, 0); break;
+            case 'x': text = 1; break;
+            default:
+                lADCRECV_Usage();
+                return 2;
+        }
+    }
+
+    if (optind != (argc - 1))
+    {
+        lADCRECV_Usage();
+        return 2;
+    }
+
+    /* No SA_RESTART: a blocked read has to return EINTR to see the stop */
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = lADCRECV_Signal;
+    (void) sigaction(SIGINT, &action, NULL);
+    (void) sigaction(SIGTERM, &action, NULL);
+
+    if (generate)
+    {
+        return lADCRECV_Generate(argv[optind], baud, frames, rate, dropEvery, text);
+    }
+
+    return lADCRECV_Receive(argv[optind], capturePath, baud, limit, quiet);
+}
+
+/*******************************************************************************
+ End of File
+ */
@@ -0,0 +1,339 @@
+/*******************************************************************************
+  Stream Receiver Test
+
+  File Name:
+    test_adc_rx.c
+
+  Summary:
+    The unpack kernels against the scalar one, and the parser's counters.
+
+  Description:
+    Every kernel this CPU has (avx2, ssse3, scalar) must unpack exactly
+    what ADC_RX_Unpack24Ref does, for every count from 0 to
+    TEST_RX_COUNT_MAX and every input alignment in a 32 byte line, and
+    write nothing past count. The parser is then fed, in pieces of random
+    size, a stream of frames with every fault the line can show: frames
+    missing, console text between frames, a flipped bit, a truncated
+    frame and a false sync. Every good frame must arrive with its samples
+    and the counters must add up to what was injected.
+
+    The benchmark reports ns per sample of each kernel on a full frame.
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <string.h>
+#include "adc_rx.h"
+#include "sim_test.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+#define TEST_RX_COUNT_MAX                   67U
+#define TEST_RX_ALIGNMENTS                  32U
+#define TEST_RX_GUARD                       8U
+#define TEST_RX_GUARD_VALUE                 0x5A5A5A5A
+
+#define TEST_RX_FRAMES                      400U
+#define TEST_RX_DROP_EVERY                  37U
+#define TEST_RX_TEXT_EVERY                  16U
+#define TEST_RX_CORRUPT                     101U
+#define TEST_RX_TRUNCATE                    202U
+#define TEST_RX_PIECE_MAX                   700U
+
+#define TEST_RX_BENCH_ROUNDS                200000U
+
+typedef struct
+{
+    uint32_t frames;
+    uint32_t wrong;
+    uint16_t last;
+
+} TEST_RX_SINK;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data
+// *****************************************************************************
+// *****************************************************************************
+
+static const char* const testRxKernels[] = { "avx2", "ssse3", "scalar" };
+
+static const char testRxText[] = "Setting the ADC in continuous mode...\r\n";
+
+static uint8_t testRxStream[TEST_RX_FRAMES * (ADC_RX_FRAME_SIZE_MAX + sizeof(testRxText))];
+static uint32_t testRxSeed = 0xCC9E2D51U;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+static uint32_t lTEST_RX_Random(void)
+{
+    testRxSeed ^= testRxSeed << 13;
+    testRxSeed ^= testRxSeed >> 17;
+    testRxSeed ^= testRxSeed << 5;
+
+    return testRxSeed;
+}
+
+/* Sample k of frame i, covering the whole 24 bit range */
+static int32_t lTEST_RX_Sample(uint32_t frame, uint32_t k)
+{
+    return (int32_t) (((frame * 2654435761U) ^ (k * 40503U)) << 8) >> 8;
+}
+
+static void lTEST_RX_Kernel(const char* name)
+{
+    uint8_t in[(TEST_RX_COUNT_MAX * ADC_STREAM_SAMPLE_SIZE) + TEST_RX_ALIGNMENTS];
+    int32_t out[TEST_RX_COUNT_MAX + TEST_RX_GUARD];
+    int32_t expected[TEST_RX_COUNT_MAX];
+    uint32_t mismatches = 0U;
+    uint32_t alignment;
+    uint32_t count;
+    uint32_t i;
+
+    if (!ADC_RX_Unpack24KernelSet(name))
+    {
+        SIM_TEST_Note("%s: not on this CPU, skipped", name);
+        return;
+    }
+    SIM_TEST_CHECK(strcmp(ADC_RX_Unpack24Kernel(), name) == 0);
+
+    for (alignment = 0U; alignment < TEST_RX_ALIGNMENTS; alignment++)
+    {
+        for (count = 0U; count <= TEST_RX_COUNT_MAX; count++)
+        {
+            for (i = 0U; i < sizeof(in); i++)
+            {
+                in[i] = (uint8_t) lTEST_RX_Random();
+            }
+            /* The ends of the range first */
+            if (count >= 2U)
+            {
+                memcpy(&in[alignment], (const uint8_t[]) { 0xFF, 0xFF, 0x7F, 0x00, 0x00, 0x80 }, 6U);
+            }
+            memset(out, 0x5A, sizeof(out));
+
+            ADC_RX_Unpack24(&in[alignment], out, count);
+            ADC_RX_Unpack24Ref(&in[alignment], expected, count);
+
+            if ((memcmp(out, expected, count * sizeof(int32_t)) != 0) || (out[count] != TEST_RX_GUARD_VALUE) ||
+                (out[count + TEST_RX_GUARD - 1U] != TEST_RX_GUARD_VALUE))
+            {
+                SIM_TEST_Note("%s: count %u alignment %u differs", name, count, alignment);
+                mismatches++;
+            }
+        }
+    }
+    SIM_TEST_CHECK(mismatches == 0U);
+
+    ADC_RX_Unpack24((const uint8_t[]) { 0xFF, 0xFF, 0x7F, 0x00, 0x00, 0x80 }, out, 2U);
+    SIM_TEST_CHECK((out[0] == 8388607) && (out[1] == -8388608));
+}
+
+static void lTEST_RX_Bench(void)
+{
+    static uint8_t in[ADC_RX_FRAME_SAMPLES_MAX * ADC_STREAM_SAMPLE_SIZE];
+    static int32_t out[ADC_RX_FRAME_SAMPLES_MAX];
+    double samples = (double) ADC_RX_FRAME_SAMPLES_MAX * TEST_RX_BENCH_ROUNDS;
+    uint64_t ns;
+    uint32_t round;
+    uint32_t k;
+
+    for (k = 0U; k < sizeof(in); k++)
+    {
+        in[k] = (uint8_t) lTEST_RX_Random();
+    }
+
+    for (k = 0U; k < (sizeof(testRxKernels) / sizeof(testRxKernels[0])); k++)
+    {
+        if (!ADC_RX_Unpack24KernelSet(testRxKernels[k]))
+        {
+            continue;
+        }
+
+        ns = SIM_TEST_HostNs();
+        for (round = 0U; round < TEST_RX_BENCH_ROUNDS; round++)
+        {
+            ADC_RX_Unpack24(in, out, ADC_RX_FRAME_SAMPLES_MAX);
+            __asm__ volatile ("" : : "r" (out) : "memory");
+        }
+        ns = SIM_TEST_HostNs() - ns;
+        SIM_TEST_Note("%-6s %.3f ns/sample", testRxKernels[k], (double) ns / samples);
+    }
+}
+
+static void lTEST_RX_Frame(const ADC_RX_FRAME* frame, void* context)
+{
+    TEST_RX_SINK* sink = context;
+    uint32_t k;
+
+    sink->frames++;
+    sink->last = frame->sequence;
+
+    if ((frame->mask != ADC_STREAM_MASK_MUX) || (frame->count != ADC_RX_FRAME_SAMPLES_MAX))
+    {
+        sink->wrong++;
+        return;
+    }
+    for (k = 0U; k < frame->count; k++)
+    {
+        if (frame->samples[k] != lTEST_RX_Sample(frame->sequence, k))
+        {
+            sink->wrong++;
+            return;
+        }
+    }
+}
+
+static void lTEST_RX_Parser(void)
+{
+    static ADC_RX rx;
+    int32_t samples[ADC_RX_FRAME_SAMPLES_MAX];
+    TEST_RX_SINK sink = { 0 };
+    uint32_t delivered = 0U;
+    uint32_t lost = 0U;
+    uint32_t gaps = 0U;
+    uint64_t skipped = 0U;
+    size_t size = 0U;
+    size_t frameSize;
+    size_t piece;
+    size_t pos;
+    uint32_t i;
+    uint32_t k;
+    bool missing = false;
+
+    /* Stray bytes before the first frame, one of them a false sync */
+    memcpy(testRxStream, (const uint8_t[]) { 0x00, ADC_STREAM_SYNC0, 0x13, 0x37 }, 4U);
+    size = 4U;
+    skipped += 4U;
+
+    for (i = 0U; i < TEST_RX_FRAMES; i++)
+    {
+        for (k = 0U; k < ADC_RX_FRAME_SAMPLES_MAX; k++)
+        {
+            samples[k] = lTEST_RX_Sample(i, k);
+        }
+
+        if ((i % TEST_RX_TEXT_EVERY) == 0U)
+        {
+            memcpy(&testRxStream[size], testRxText, sizeof(testRxText) - 1U);
+            size += sizeof(testRxText) - 1U;
+            skipped += sizeof(testRxText) - 1U;
+        }
+
+        if ((i % TEST_RX_DROP_EVERY) == (TEST_RX_DROP_EVERY - 1U))
+        {
+            missing = true;
+            lost++;
+            continue;
+        }
+
+        frameSize = ADC_RX_FrameBuild(&testRxStream[size], (uint16_t) i, ADC_STREAM_MASK_MUX, samples,
+                                      ADC_RX_FRAME_SAMPLES_MAX);
+
+        if (i == TEST_RX_CORRUPT)
+        {
+            /* One bit in the samples: the CRC fails, the whole frame is skipped */
+            testRxStream[size + ADC_STREAM_HEADER_SIZE + 10U] ^= 0x04U;
+            skipped += frameSize;
+            missing = true;
+            lost++;
+        }
+        else if (i == TEST_RX_TRUNCATE)
+        {
+            /* The end of the frame never came; the next frame starts early */
+            frameSize -= 50U;
+            skipped += frameSize;
+            missing = true;
+            lost++;
+        }
+        else
+        {
+            delivered++;
+            gaps += missing ? 1U : 0U;
+            missing = false;
+        }
+
+        size += frameSize;
+    }
+
+    ADC_RX_Initialize(&rx, lTEST_RX_Frame, &sink);
+    for (pos = 0U; pos < size; pos += piece)
+    {
+        piece = 1U + (lTEST_RX_Random() % TEST_RX_PIECE_MAX);
+        if (piece > (size - pos))
+        {
+            piece = size - pos;
+        }
+        ADC_RX_Feed(&rx, &testRxStream[pos], piece);
+    }
+
+    SIM_TEST_Note("parser: %llu frames, %llu lost in %llu gaps, %llu CRC errors, %llu bytes skipped",
+                  (unsigned long long) rx.stats.frames, (unsigned long long) rx.stats.lost,
+                  (unsigned long long) rx.stats.gaps, (unsigned long long) rx.stats.crcErrors,
+                  (unsigned long long) rx.stats.skipped);
+
+    SIM_TEST_CHECK(rx.stats.bytes == size);
+    SIM_TEST_CHECK(rx.stats.frames == delivered);
+    SIM_TEST_CHECK(sink.frames == delivered);
+    SIM_TEST_CHECK(sink.wrong == 0U);
+    SIM_TEST_CHECK(sink.last == (uint16_t) (TEST_RX_FRAMES - 1U));
+    SIM_TEST_CHECK(rx.stats.samples == ((uint64_t) delivered * ADC_RX_FRAME_SAMPLES_MAX));
+    SIM_TEST_CHECK(rx.stats.lost == lost);
+    SIM_TEST_CHECK(rx.stats.gaps == gaps);
+    SIM_TEST_CHECK(rx.stats.skipped == skipped);
+
+    /* The corrupted frame fails its CRC; the truncated one takes the next
+       frame's sync into its CRC span and fails too */
+    SIM_TEST_CHECK(rx.stats.crcErrors >= 2U);
+    SIM_TEST_CHECK(rx.fill == 0U);
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Main
+// *****************************************************************************
+// *****************************************************************************
+
+int main(void)
+{
+    uint32_t k;
+
+    SIM_TEST_Note("dispatch: %s", ADC_RX_Unpack24Kernel());
+    SIM_TEST_CHECK(!ADC_RX_Unpack24KernelSet("neon"));
+
+    for (k = 0U; k < (sizeof(testRxKernels) / sizeof(testRxKernels[0])); k++)
+    {
+        lTEST_RX_Kernel(testRxKernels[k]);
+    }
+
+    lTEST_RX_Bench();
+
+    /* The parser with each kernel */
+    SIM_TEST_CHECK(ADC_RX_Unpack24KernelSet("scalar"));
+    lTEST_RX_Parser();
+    for (k = 0U; k < 2U; k++)
+    {
+        if (ADC_RX_Unpack24KernelSet(testRxKernels[k]))
+        {
+            lTEST_RX_Parser();
+        }
+    }
+
+    return SIM_TEST_Finish();
+}
+
+/*******************************************************************************
+ End of File
+ */
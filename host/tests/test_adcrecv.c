@@ -0,0 +1,328 @@
+/*******************************************************************************
+  Receiver Loopback Test
+
+  File Name:
+    test_adcrecv.c
+
+  Summary:
+    adcrecv -g into a pseudo terminal, adcrecv on the other end.
+
+  Description:
+    The setup of the README without socat: the generator writes to the
+    master side of a pty (its stdout, path "-"), the receiver opens the
+    slave side by name and captures to a file, as it would a board's
+    /dev/ttyACM0. The generator drops every TEST_RECV_DROP_EVERY-th frame
+    (-d) and puts console text between frames (-x). The test checks the
+    receiver's total line (frames, lost, gaps, CRC errors, skipped bytes)
+    against what was injected, and the capture file record by record
+    against the generator's signal.
+
+    Run from host/ (make check); ADCRECV names another binary.
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#define _GNU_SOURCE
+
+#include <fcntl.h>
+#include <inttypes.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/wait.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+#include "adc_rx.h"
+#include "sim_test.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+#ifndef M_PI
+#define M_PI                                3.14159265358979323846
+#endif
+
+#define TEST_RECV_FRAMES                    1005UL
+#define TEST_RECV_DROP_EVERY                10UL
+#define TEST_RECV_TEXT_EVERY                16UL
+
+/* The generator's console line (-x) */
+#define TEST_RECV_TEXT_SIZE                 (sizeof("Setting the ADC in continuous mode...\r\n") - 1U)
+
+#define TEST_RECV_RECORD_HEADER_SIZE        8U
+
+typedef struct
+{
+    uint64_t frames;
+    uint64_t samples;
+    uint64_t lost;
+    uint64_t gaps;
+    uint64_t crc;
+    uint64_t skipped;
+
+} TEST_RECV_TOTAL;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+static pid_t lTEST_RECV_Spawn(char* const argv[], int in, int out, int err)
+{
+    pid_t pid = fork();
+
+    if (pid == 0)
+    {
+        if (in >= 0)
+        {
+            (void) dup2(in, STDIN_FILENO);
+        }
+        if (out >= 0)
+        {
+            (void) dup2(out, STDOUT_FILENO);
+        }
+        if (err >= 0)
+        {
+            (void) dup2(err, STDERR_FILENO);
+        }
+        execv(argv[0], argv);
+        _exit(127);
+    }
+
+    return pid;
+}
+
+static int lTEST_RECV_Wait(pid_t pid)
+{
+    int status = 0;
+
+    if ((pid < 0) || (waitpid(pid, &status, 0) != pid))
+    {
+        return -1;
+    }
+
+    return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+}
+
+static void lTEST_RECV_Drain(int slave)
+{
+    const struct timespec poll = { .tv_sec = 0, .tv_nsec = 10000000L };
+    uint32_t idle = 0U;
+    uint32_t tries;
+    int pending;
+
+    for (tries = 0U; (tries < 1000U) && (idle < 5U); tries++)
+    {
+        pending = 0;
+        (void) ioctl(slave, FIONREAD, &pending);
+        idle = (pending == 0) ? (idle + 1U) : 0U;
+        (void) nanosleep(&poll, NULL);
+    }
+}
+
+/* Last "total" line of the receiver's report */
+static bool lTEST_RECV_Total(FILE* report, TEST_RECV_TOTAL* total)
+{
+    char line[512];
+    const char* p;
+    bool found = false;
+
+    while (fgets(line, sizeof(line), report) != NULL)
+    {
+        p = strstr(line, "total ");
+        if ((p != NULL) &&
+            (sscanf(strstr(p, "frames"), "frames %" SCNu64 " samples %" SCNu64 " lost %" SCNu64 " (%" SCNu64
+                    " gaps) crc %" SCNu64 " skipped %" SCNu64, &total->frames, &total->samples, &total->lost,
+                    &total->gaps, &total->crc, &total->skipped) == 6))
+        {
+            found = true;
+        }
+    }
+
+    return found;
+}
+
+/* The records must be the frames the generator sent, in order */
+static void lTEST_RECV_Capture(const char* path, uint64_t frames)
+{
+    uint8_t header[TEST_RECV_RECORD_HEADER_SIZE];
+    int32_t samples[ADC_RX_FRAME_SAMPLES_MAX];
+    uint64_t records = 0U;
+    uint32_t wrong = 0U;
+    unsigned long i = 0UL;
+    uint32_t count;
+    uint32_t k;
+    uint32_t t;
+    FILE* file = fopen(path, "rb");
+
+    if (!SIM_TEST_CHECK(file != NULL))
+    {
+        return;
+    }
+
+    while (fread(header, sizeof(header), 1U, file) == 1U)
+    {
+        count = (uint32_t) header[2] | ((uint32_t) header[3] << 8);
+        if (!SIM_TEST_CHECK((count == ADC_RX_FRAME_SAMPLES_MAX) &&
+                            (fread(samples, sizeof(int32_t), count, file) == count)))
+        {
+            break;
+        }
+
+        /* The next frame not dropped by -d */
+        if ((i % TEST_RECV_DROP_EVERY) == (TEST_RECV_DROP_EVERY - 1UL))
+        {
+            i++;
+        }
+        if (((uint32_t) header[0] | ((uint32_t) header[1] << 8)) != (uint16_t) i)
+        {
+            wrong++;
+        }
+
+        /* lADCRECV_Generate's test signal */
+        for (k = 0U, t = (uint32_t) (i * ADC_RX_FRAME_SAMPLES_MAX); k < count; k++, t++)
+        {
+            if (samples[k] != ((int32_t) (8000000.0 * sin(2.0 * M_PI * (double) (t % 1000U) / 1000.0)) +
+                               (int32_t) (t % 256U)))
+            {
+                wrong++;
+                break;
+            }
+        }
+
+        records++;
+        i++;
+    }
+    (void) fclose(file);
+
+    SIM_TEST_Note("capture: %" PRIu64 " records, %u wrong", records, wrong);
+    SIM_TEST_CHECK(records == frames);
+    SIM_TEST_CHECK(wrong == 0U);
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Main
+// *****************************************************************************
+// *****************************************************************************
+
+int main(void)
+{
+    const char* adcrecv = (getenv("ADCRECV") != NULL) ? getenv("ADCRECV") : "./adcrecv";
+    char capture[] = "/tmp/test_adcrecv.XXXXXX";
+    char frames[16];
+    char drop[16];
+    char* generator[9];
+    char* receiver[8];
+    struct termios tio;
+    TEST_RECV_TOTAL total = { 0 };
+    uint64_t dropped = TEST_RECV_FRAMES / TEST_RECV_DROP_EVERY;
+    uint64_t sent = TEST_RECV_FRAMES - dropped;
+    uint64_t lines = 0U;
+    unsigned long i;
+    int report[2];
+    int master;
+    int slave;
+    int fd;
+    pid_t receiverPid;
+    pid_t generatorPid;
+    FILE* reportFile;
+
+    /* Frames the generator puts text in front of: not dropped, every 16th */
+    for (i = 0UL; i < TEST_RECV_FRAMES; i++)
+    {
+        if (((i % TEST_RECV_DROP_EVERY) != (TEST_RECV_DROP_EVERY - 1UL)) && ((i % TEST_RECV_TEXT_EVERY) == 0UL))
+        {
+            lines++;
+        }
+    }
+
+    master = posix_openpt(O_RDWR | O_NOCTTY);
+    /* Only the generator may hold the master (as its stdout, which dup2
+       leaves open across exec): the hangup comes when the test closes it */
+    if (!SIM_TEST_CHECK((master >= 0) && (fcntl(master, F_SETFD, FD_CLOEXEC) == 0) && (grantpt(master) == 0) &&
+                        (unlockpt(master) == 0)))
+    {
+        return SIM_TEST_Finish();
+    }
+
+    /* Raw before anything is written, and kept open so it stays raw
+       until the receiver has the slave open itself */
+    slave = open(ptsname(master), O_RDWR | O_NOCTTY | O_CLOEXEC);
+    SIM_TEST_CHECK((slave >= 0) && (tcgetattr(slave, &tio) == 0));
+    cfmakeraw(&tio);
+    SIM_TEST_CHECK(tcsetattr(slave, TCSANOW, &tio) == 0);
+
+    fd = mkstemp(capture);
+    SIM_TEST_CHECK(fd >= 0);
+    (void) close(fd);
+    SIM_TEST_CHECK(pipe2(report, O_CLOEXEC) == 0);
+
+    receiver[0] = (char*) adcrecv;
+    receiver[1] = "-q";
+    receiver[2] = "-o";
+    receiver[3] = capture;
+    receiver[4] = ptsname(master);
+    receiver[5] = NULL;
+    receiverPid = lTEST_RECV_Spawn(receiver, -1, -1, report[1]);
+    (void) close(report[1]);
+
+    (void) snprintf(frames, sizeof(frames), "%lu", TEST_RECV_FRAMES);
+    (void) snprintf(drop, sizeof(drop), "%lu", TEST_RECV_DROP_EVERY);
+    generator[0] = (char*) adcrecv;
+    generator[1] = "-g";
+    generator[2] = "-n";
+    generator[3] = frames;
+    generator[4] = "-d";
+    generator[5] = drop;
+    generator[6] = "-x";
+    generator[7] = "-";
+    generator[8] = NULL;
+    generatorPid = lTEST_RECV_Spawn(generator, -1, master, -1);
+
+    SIM_TEST_CHECK(lTEST_RECV_Wait(generatorPid) == 0);
+
+    /* A hangup discards unread input: let the receiver drain the slave
+       first, then hang up so its read returns EIO and it reports */
+    lTEST_RECV_Drain(slave);
+    (void) close(master);
+    (void) close(slave);
+
+    reportFile = fdopen(report[0], "r");
+    SIM_TEST_CHECK((reportFile != NULL) && lTEST_RECV_Total(reportFile, &total));
+    SIM_TEST_CHECK(lTEST_RECV_Wait(receiverPid) == 0);
+    if (reportFile != NULL)
+    {
+        (void) fclose(reportFile);
+    }
+
+    SIM_TEST_Note("receiver: %" PRIu64 " frames, %" PRIu64 " lost in %" PRIu64 " gaps, %" PRIu64
+                  " CRC errors, %" PRIu64 " bytes skipped", total.frames, total.lost, total.gaps, total.crc,
+                  total.skipped);
+    SIM_TEST_CHECK(total.frames == sent);
+    SIM_TEST_CHECK(total.samples == (sent * ADC_RX_FRAME_SAMPLES_MAX));
+    SIM_TEST_CHECK(total.lost == dropped);
+    SIM_TEST_CHECK(total.gaps == dropped);
+    SIM_TEST_CHECK(total.crc == 0U);
+    SIM_TEST_CHECK(total.skipped == (lines * TEST_RECV_TEXT_SIZE));
+
+    lTEST_RECV_Capture(capture, sent);
+    (void) unlink(capture);
+
+    return SIM_TEST_Finish();
+}
+
+/*******************************************************************************
+ End of File
+ */
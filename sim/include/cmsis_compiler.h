@@ -0,0 +1,67 @@
+/*******************************************************************************
+  Host CMSIS Compiler Header File
+
+  File Name:
+    cmsis_compiler.h
+
+  Summary:
+    Compiler abstraction of the CMSIS core headers for host GCC/Clang.
+
+  Description:
+    Stands in for CMSIS/Core/Include/cmsis_compiler.h when the firmware is
+    built for the host simulation (sim/Makefile puts sim/include ahead of
+    the device pack and leaves the CMSIS include directory out). Only the
+    attribute macros are provided; the intrinsics which need Cortex-M
+    instructions live in the host core_cm4.h.
+*******************************************************************************/
+
+#ifndef __CMSIS_COMPILER_H
+#define __CMSIS_COMPILER_H
+
+#include <stdint.h>
+
+#ifndef   __ASM
+  #define __ASM                                  __asm
+#endif
+#ifndef   __INLINE
+  #define __INLINE                               inline
+#endif
+#ifndef   __STATIC_INLINE
+  #define __STATIC_INLINE                        static inline
+#endif
+#ifndef   __STATIC_FORCEINLINE
+  #define __STATIC_FORCEINLINE                   __attribute__((always_inline)) static inline
+#endif
+#ifndef   __NO_RETURN
+  #define __NO_RETURN                            __attribute__((__noreturn__))
+#endif
+#ifndef   __USED
+  #define __USED                                 __attribute__((used))
+#endif
+#ifndef   __WEAK
+  #define __WEAK                                 __attribute__((weak))
+#endif
+#ifndef   __PACKED
+  #define __PACKED                               __attribute__((packed, aligned(1)))
+#endif
+#ifndef   __PACKED_STRUCT
+  #define __PACKED_STRUCT                        struct __attribute__((packed, aligned(1)))
+#endif
+#ifndef   __PACKED_UNION
+  #define __PACKED_UNION                         union __attribute__((packed, aligned(1)))
+#endif
+#ifndef   __ALIGNED
+  #define __ALIGNED(x)                           __attribute__((aligned(x)))
+#endif
+#ifndef   __RESTRICT
+  #define __RESTRICT                             __restrict
+#endif
+#ifndef   __COMPILER_BARRIER
+  #define __COMPILER_BARRIER()                   __ASM volatile("":::"memory")
+#endif
+
+#endif /* __CMSIS_COMPILER_H */
+
+/*******************************************************************************
+ End of File
+ */
@@ -0,0 +1,271 @@
+/*******************************************************************************
+  Host Cortex-M4 Core Header File
+
+  File Name:
+    core_cm4.h
+
+  Summary:
+    The part of CMSIS core_cm4.h the firmware uses, for the host simulation.
+
+  Description:
+    Included by the device header (same51j20a.h) in place of the CMSIS
+    original when sim/include comes first on the include path. Provides
+
+      - the NVIC functions and the PRIMASK intrinsics, backed by sim_cpu.c
+      - __WFI, which lets simulated time run to the next interrupt
+      - barriers and __NOP as compiler barriers
+      - SCB, DWT and CoreDebug as host variables with the CMSIS layout;
+        DWT->CYCCNT follows simulated time while CYCCNTENA is set
+
+    The system control space is not mapped, code which writes other core
+    registers does not build against this header, which is the intent.
+*******************************************************************************/
+
+#ifndef __CORE_CM4_H_GENERIC
+#define __CORE_CM4_H_GENERIC
+
+#include <stdint.h>
+#include "cmsis_compiler.h"
+#include "sim_cpu.h"
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+#define __CORTEX_M                (4U)
+
+#ifdef __cplusplus
+  #define   __I     volatile
+#else
+  #define   __I     volatile const
+#endif
+#define     __O     volatile
+#define     __IO    volatile
+
+#define     __IM     volatile const
+#define     __OM     volatile
+#define     __IOM    volatile
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Core Registers
+// *****************************************************************************
+// *****************************************************************************
+
+typedef struct
+{
+  __IM  uint32_t CPUID;
+  __IOM uint32_t ICSR;
+  __IOM uint32_t VTOR;
+  __IOM uint32_t AIRCR;
+  __IOM uint32_t SCR;
+  __IOM uint32_t CCR;
+  __IOM uint8_t  SHP[12U];
+  __IOM uint32_t SHCSR;
+  __IOM uint32_t CFSR;
+  __IOM uint32_t HFSR;
+  __IOM uint32_t DFSR;
+  __IOM uint32_t MMFAR;
+  __IOM uint32_t BFAR;
+  __IOM uint32_t AFSR;
+  __IM  uint32_t PFR[2U];
+  __IM  uint32_t DFR;
+  __IM  uint32_t ADR;
+  __IM  uint32_t MMFR[4U];
+  __IM  uint32_t ISAR[5U];
+        uint32_t RESERVED0[5U];
+  __IOM uint32_t CPACR;
+} SCB_Type;
+
+#define SCB_CCR_DIV_0_TRP_Pos               4U
+#define SCB_CCR_DIV_0_TRP_Msk              (1UL << SCB_CCR_DIV_0_TRP_Pos)
+#define SCB_SHCSR_USGFAULTENA_Pos          18U
+#define SCB_SHCSR_USGFAULTENA_Msk          (1UL << SCB_SHCSR_USGFAULTENA_Pos)
+#define SCB_SHCSR_BUSFAULTENA_Pos          17U
+#define SCB_SHCSR_BUSFAULTENA_Msk          (1UL << SCB_SHCSR_BUSFAULTENA_Pos)
+#define SCB_SHCSR_MEMFAULTENA_Pos          16U
+#define SCB_SHCSR_MEMFAULTENA_Msk          (1UL << SCB_SHCSR_MEMFAULTENA_Pos)
+#define SCB_SCR_SLEEPDEEP_Pos               2U
+#define SCB_SCR_SLEEPDEEP_Msk              (1UL << SCB_SCR_SLEEPDEEP_Pos)
+
+typedef struct
+{
+  __IOM uint32_t CTRL;
+  __IOM uint32_t CYCCNT;
+  __IOM uint32_t CPICNT;
+  __IOM uint32_t EXCCNT;
+  __IOM uint32_t SLEEPCNT;
+  __IOM uint32_t LSUCNT;
+  __IOM uint32_t FOLDCNT;
+  __IM  uint32_t PCSR;
+  __IOM uint32_t COMP0;
+  __IOM uint32_t MASK0;
+  __IOM uint32_t FUNCTION0;
+        uint32_t RESERVED0[1U];
+  __IOM uint32_t COMP1;
+  __IOM uint32_t MASK1;
+  __IOM uint32_t FUNCTION1;
+        uint32_t RESERVED1[1U];
+  __IOM uint32_t COMP2;
+  __IOM uint32_t MASK2;
+  __IOM uint32_t FUNCTION2;
+        uint32_t RESERVED2[1U];
+  __IOM uint32_t COMP3;
+  __IOM uint32_t MASK3;
+  __IOM uint32_t FUNCTION3;
+} DWT_Type;
+
+#define DWT_CTRL_CYCCNTENA_Pos              0U
+#define DWT_CTRL_CYCCNTENA_Msk             (0x1UL)
+
+typedef struct
+{
+  __IOM uint32_t DHCSR;
+  __OM  uint32_t DCRSR;
+  __IOM uint32_t DCRDR;
+  __IOM uint32_t DEMCR;
+} CoreDebug_Type;
+
+#define CoreDebug_DEMCR_TRCENA_Pos         24U
+#define CoreDebug_DEMCR_TRCENA_Msk         (1UL << CoreDebug_DEMCR_TRCENA_Pos)
+
+extern SCB_Type simScb;
+extern DWT_Type simDwt;
+extern CoreDebug_Type simCoreDebug;
+
+#define SCB                 (&simScb)
+#define DWT                 (&simDwt)
+#define CoreDebug           (&simCoreDebug)
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Intrinsics
+// *****************************************************************************
+// *****************************************************************************
+
+__STATIC_FORCEINLINE void __NOP(void)
+{
+  __COMPILER_BARRIER();
+}
+
+__STATIC_FORCEINLINE void __DMB(void)
+{
+  __atomic_signal_fence(__ATOMIC_SEQ_CST);
+}
+
+__STATIC_FORCEINLINE void __DSB(void)
+{
+  __atomic_signal_fence(__ATOMIC_SEQ_CST);
+}
+
+__STATIC_FORCEINLINE void __ISB(void)
+{
+  __atomic_signal_fence(__ATOMIC_SEQ_CST);
+}
+
+__STATIC_FORCEINLINE void __enable_irq(void)
+{
+  __COMPILER_BARRIER();
+  SIM_CPU_PrimaskSet(0U);
+}
+
+__STATIC_FORCEINLINE void __disable_irq(void)
+{
+  SIM_CPU_PrimaskSet(1U);
+  __COMPILER_BARRIER();
+}
+
+__STATIC_FORCEINLINE uint32_t __get_PRIMASK(void)
+{
+  return SIM_CPU_PrimaskGet();
+}
+
+__STATIC_FORCEINLINE void __set_PRIMASK(uint32_t priMask)
+{
+  __COMPILER_BARRIER();
+  SIM_CPU_PrimaskSet(priMask & 1U);
+  __COMPILER_BARRIER();
+}
+
+__STATIC_FORCEINLINE uint32_t __get_IPSR(void)
+{
+  return SIM_CPU_IpsrGet();
+}
+
+__STATIC_FORCEINLINE void __WFI(void)
+{
+  __COMPILER_BARRIER();
+  SIM_CPU_WaitForInterrupt();
+  __COMPILER_BARRIER();
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: NVIC Functions
+// *****************************************************************************
+// *****************************************************************************
+
+__STATIC_INLINE void NVIC_SetPriorityGrouping(uint32_t PriorityGroup)
+{
+  (void) PriorityGroup;
+}
+
+__STATIC_INLINE void NVIC_EnableIRQ(IRQn_Type IRQn)
+{
+  SIM_CPU_IrqEnable((int32_t) IRQn);
+}
+
+__STATIC_INLINE uint32_t NVIC_GetEnableIRQ(IRQn_Type IRQn)
+{
+  return SIM_CPU_IrqIsEnabled((int32_t) IRQn) ? 1U : 0U;
+}
+
+__STATIC_INLINE void NVIC_DisableIRQ(IRQn_Type IRQn)
+{
+  SIM_CPU_IrqDisable((int32_t) IRQn);
+}
+
+__STATIC_INLINE uint32_t NVIC_GetPendingIRQ(IRQn_Type IRQn)
+{
+  return SIM_CPU_IrqIsPending((int32_t) IRQn) ? 1U : 0U;
+}
+
+__STATIC_INLINE void NVIC_SetPendingIRQ(IRQn_Type IRQn)
+{
+  SIM_CPU_IrqPend((int32_t) IRQn);
+}
+
+__STATIC_INLINE void NVIC_ClearPendingIRQ(IRQn_Type IRQn)
+{
+  SIM_CPU_IrqUnpend((int32_t) IRQn);
+}
+
+__STATIC_INLINE uint32_t NVIC_GetActive(IRQn_Type IRQn)
+{
+  return SIM_CPU_IrqIsActive((int32_t) IRQn) ? 1U : 0U;
+}
+
+__STATIC_INLINE void NVIC_SetPriority(IRQn_Type IRQn, uint32_t priority)
+{
+  SIM_CPU_IrqPrioritySet((int32_t) IRQn, priority);
+}
+
+__STATIC_INLINE uint32_t NVIC_GetPriority(IRQn_Type IRQn)
+{
+  return SIM_CPU_IrqPriorityGet((int32_t) IRQn);
+}
+
+__NO_RETURN __STATIC_INLINE void NVIC_SystemReset(void)
+{
+  SIM_CPU_SystemReset();
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __CORE_CM4_H_GENERIC */
+
+/*******************************************************************************
+ End of File
+ */
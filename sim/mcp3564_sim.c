@@ -0,0 +1,885 @@
+/*******************************************************************************
+  MCP3564 Simulation Model Source File
+
+  File Name:
+    mcp3564_sim.c
+
+  Summary:
+    Register level model of the MCP3564 for host builds.
+
+  Description:
+    Register widths and access rights come from the firmware's descriptor
+    table (mcp3564_reg.c), so both sides agree on the register map. The
+    read CRC is computed bit by bit here rather than with the firmware's
+    table, so the model does not inherit a mistake in it.
+
+    Two events are used: conversion end and the end of the conversion
+    start pulse on IRQ. Register writes take effect at the next conversion
+    start, except ADC_MODE which starts or aborts a conversion at once.
+
+    Incremental reads and writes move from CRCCFG back to CONFIG0.
+    Incremental reads of ADCDATA stay on ADCDATA. With EN_CRCCOM the CRC
+    follows every register of a static read and every pass through the
+    register map of an incremental read.
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stddef.h>
+#include <string.h>
+#include "sim_core.h"
+#include "mcp3564_sim.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+/* Command byte */
+#define MCP3564_SIM_CMD_ADDRESS(c)          (((uint32_t) (c) >> 6) & 0x3U)
+#define MCP3564_SIM_CMD_REGISTER(c)         (((uint32_t) (c) >> 2) & 0xFU)
+#define MCP3564_SIM_CMD_TYPE(c)             ((uint32_t) (c) & 0x3U)
+#define MCP3564_SIM_CMD_TYPE_FAST           0x0U
+
+/* Fast command codes, bits 5:2 */
+#define MCP3564_SIM_FAST_CONVERT            0xAU
+#define MCP3564_SIM_FAST_STANDBY            0xBU
+#define MCP3564_SIM_FAST_SHUTDOWN           0xCU
+#define MCP3564_SIM_FAST_FULL_SHUTDOWN      0xDU
+#define MCP3564_SIM_FAST_RESET              0xEU
+
+/* CONFIG0 */
+#define MCP3564_SIM_CLK_SEL(r)              (((r) >> 4) & 0x3U)
+#define MCP3564_SIM_ADC_MODE_Msk            0x03U
+#define MCP3564_SIM_ADC_MODE_SHUTDOWN       0x00U
+#define MCP3564_SIM_ADC_MODE_STANDBY        0x02U
+#define MCP3564_SIM_ADC_MODE_CONVERSION     0x03U
+
+/* CONFIG1 */
+#define MCP3564_SIM_PRE(r)                  (1UL << (((r) >> 6) & 0x3U))
+#define MCP3564_SIM_OSR(r)                  (((r) >> 2) & 0xFU)
+
+/* CONFIG2 */
+#define MCP3564_SIM_GAIN(r)                 (((r) >> 3) & 0x7U)
+
+/* CONFIG3 */
+#define MCP3564_SIM_CONV_MODE(r)            (((r) >> 6) & 0x3U)
+#define MCP3564_SIM_CONV_MODE_ONESHOT_STBY  0x2U
+#define MCP3564_SIM_CONV_MODE_CONTINUOUS    0x3U
+#define MCP3564_SIM_DATA_FORMAT(r)          (((r) >> 4) & 0x3U)
+#define MCP3564_SIM_CRC_FORMAT_32           0x08U
+#define MCP3564_SIM_EN_OFFCAL               0x02U
+#define MCP3564_SIM_EN_GAINCAL              0x01U
+
+/* IRQ: status flags 6:4 are kept apart from the writable bits 3:0 */
+#define MCP3564_SIM_IRQ_MDAT                0x08U
+#define MCP3564_SIM_IRQ_EN_FASTCMD          0x02U
+#define MCP3564_SIM_IRQ_EN_STP              0x01U
+
+/* SCAN */
+#define MCP3564_SIM_SCAN_DLY(r)             (((r) >> 21) & 0x7U)
+#define MCP3564_SIM_SCAN_CHANNELS(r)        ((r) & 0xFFFFUL)
+
+#define MCP3564_SIM_LOCK_KEY                0xA5U
+#define MCP3564_SIM_CRC_POLY                0x8005U
+
+/* Conversion start pulse on IRQ, in MCLK periods */
+#define MCP3564_SIM_STP_MCLK                16U
+
+#define MCP3564_SIM_CODE_MAX                ((1L << 23) - 1)
+#define MCP3564_SIM_CODE_MIN                (-(1L << 23))
+
+/* The 32 bit formats with SGN keep over-range results to 25 bits */
+#define MCP3564_SIM_CODE_SGN_MAX            ((1L << 24) - 1)
+#define MCP3564_SIM_CODE_SGN_MIN            (-(1L << 24))
+
+/* One register, or a CRC with CRC_FORMAT = 32 bit */
+#define MCP3564_SIM_SHIFT_SIZE              MCP3564_REG_SIZE_MAX
+
+typedef enum
+{
+    MCP3564_SIM_BUS_IDLE = 0,
+    MCP3564_SIM_BUS_COMMAND,
+    MCP3564_SIM_BUS_STATIC_READ,
+    MCP3564_SIM_BUS_INC_READ,
+    MCP3564_SIM_BUS_INC_WRITE,
+    MCP3564_SIM_BUS_DONE
+
+} MCP3564_SIM_BUS;
+
+typedef struct
+{
+    uint32_t regs[MCP3564_REG_COUNT];
+
+    /* IRQ status flags, 1 = nothing pending */
+    bool drStatus;
+    bool crccfgStatus;
+    bool porStatus;
+
+    /* Latched result of the last conversion */
+    int32_t data;
+    uint32_t dataChannel;
+
+    /* Conversion engine */
+    bool converting;
+    bool scanning;
+    uint32_t scanChannel;
+    uint32_t mclkHz;
+    SIM_EVENT convEvent;
+    SIM_EVENT stpEvent;
+    bool stpActive;
+
+    /* IRQ pin */
+    bool irqLevel;
+    MCP3564_SIM_IRQ_CALLBACK irqCallback;
+    uintptr_t irqContext;
+
+    /* Inputs */
+    int32_t inputs[MCP3564_SIM_INPUTS];
+    MCP3564_SIM_SOURCE source;
+    uintptr_t sourceContext;
+
+    /* Serial interface */
+    MCP3564_SIM_BUS bus;
+    uint32_t address;
+    uint8_t shift[MCP3564_SIM_SHIFT_SIZE];
+    uint32_t shiftSize;
+    uint32_t shiftPos;
+    bool shiftCrc;
+    uint16_t crc;
+
+    /* ADCDATA CRCs still to go out wrong, MCP3564_SIM_CrcCorrupt */
+    uint32_t crcCorrupt;
+
+    MCP3564_SIM_STATS stats;
+
+} MCP3564_SIM_OBJ;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data
+// *****************************************************************************
+// *****************************************************************************
+
+static MCP3564_SIM_OBJ simAdc;
+
+/* Power on values, indexed by address */
+static const uint32_t mcp3564SimDefaults[MCP3564_REG_COUNT] =
+{
+    0x000000U, 0xC0U, 0x0CU, 0x8BU, 0x00U, 0x03U, 0x01U, 0x000000U,
+    0x000000U, 0x000000U, 0x800000U, 0x900000U, 0x50U, MCP3564_SIM_LOCK_KEY, MCP3564_SIM_CHIP_ID, 0x0000U,
+};
+
+static const uint32_t mcp3564SimOsr[16] =
+{
+    32U, 64U, 128U, 256U, 512U, 1024U, 2048U, 4096U,
+    8192U, 16384U, 20480U, 24576U, 40960U, 49152U, 81920U, 98304U,
+};
+
+/* Gain x3, so the 1/3 setting stays an integer */
+static const uint32_t mcp3564SimGain3[8] = { 1U, 3U, 6U, 12U, 24U, 48U, 96U, 192U };
+
+/* SCAN.DLY in DMCLK periods */
+static const uint32_t mcp3564SimScanDelay[8] = { 0U, 8U, 16U, 32U, 64U, 128U, 256U, 512U };
+
+/* VIN+ / VIN- MUX codes of the SCAN channel IDs */
+static const uint8_t mcp3564SimScanMux[16] =
+{
+    0x08U, 0x18U, 0x28U, 0x38U, 0x48U, 0x58U, 0x68U, 0x78U,
+    0x01U, 0x23U, 0x45U, 0x67U, 0xDEU, 0x98U, 0xF8U, 0x88U,
+};
+
+/* Microvolts: 3.3 V on AVDD and REFIN+, internal VCM and a room temperature diode */
+static const int32_t mcp3564SimInputDefaults[MCP3564_SIM_INPUTS] =
+{
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 3300000, 0, 3300000, 0, 90000, 0, 1200000,
+};
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+static void lMCP3564_SIM_ConversionEnd(uintptr_t context);
+
+static uint16_t lMCP3564_SIM_Crc(uint16_t crc, uint8_t byte)
+{
+    uint32_t bit;
+
+    crc ^= (uint16_t) ((uint32_t) byte << 8);
+    for (bit = 0; bit < 8U; bit++)
+    {
+        crc = ((crc & 0x8000U) != 0U) ? (uint16_t) ((crc << 1) ^ MCP3564_SIM_CRC_POLY) : (uint16_t) (crc << 1);
+    }
+
+    return crc;
+}
+
+static uint8_t lMCP3564_SIM_Status(void)
+{
+    return (uint8_t) ((MCP3564_DEVICE_ADDRESS << 4) | ((uint32_t) (~MCP3564_DEVICE_ADDRESS & 0x1U) << 3) |
+                      ((simAdc.drStatus ? 1U : 0U) << 2) | ((simAdc.crccfgStatus ? 1U : 0U) << 1) |
+                      (simAdc.porStatus ? 1U : 0U));
+}
+
+static void lMCP3564_SIM_IrqUpdate(void)
+{
+    bool level = true;
+
+    if ((simAdc.regs[MCP3564_REG_IRQ] & MCP3564_SIM_IRQ_MDAT) == 0U)
+    {
+        level = simAdc.drStatus && !simAdc.stpActive;
+    }
+
+    if (level != simAdc.irqLevel)
+    {
+        simAdc.irqLevel = level;
+        if (simAdc.irqCallback != NULL)
+        {
+            simAdc.irqCallback(level, simAdc.irqContext);
+        }
+    }
+}
+
+static uint32_t lMCP3564_SIM_Mclk(void)
+{
+    /* CLK_SEL 1x: internal oscillator */
+    return ((MCP3564_SIM_CLK_SEL(simAdc.regs[MCP3564_REG_CONFIG0]) & 0x2U) != 0U) ? MCP3564_SIM_MCLK_HZ_INTERNAL
+                                                                                   : simAdc.mclkHz;
+}
+
+/* DMCLK = MCLK / PRE / 4 */
+static uint64_t lMCP3564_SIM_Dmclk(uint32_t periods)
+{
+    uint64_t mclk = (uint64_t) periods * 4U * MCP3564_SIM_PRE(simAdc.regs[MCP3564_REG_CONFIG1]);
+
+    return SIM_PERIODS_NS(mclk, lMCP3564_SIM_Mclk());
+}
+
+static int32_t lMCP3564_SIM_Input(uint32_t input)
+{
+    if (simAdc.source != NULL)
+    {
+        return simAdc.source(input, SIM_Now(), simAdc.sourceContext);
+    }
+
+    return simAdc.inputs[input];
+}
+
+static int32_t lMCP3564_SIM_Convert(uint32_t mux)
+{
+    int64_t diff = (int64_t) lMCP3564_SIM_Input(mux >> 4) - lMCP3564_SIM_Input(mux & 0xFU);
+    int64_t vref = (int64_t) lMCP3564_SIM_Input(MCP3564_SIM_INPUT_REFINP) - lMCP3564_SIM_Input(MCP3564_SIM_INPUT_REFINM);
+    uint32_t config3 = simAdc.regs[MCP3564_REG_CONFIG3];
+    bool sgn = (MCP3564_SIM_DATA_FORMAT(config3) >= 2U);
+    int64_t code;
+
+    if (vref <= 0)
+    {
+        vref = 1;
+    }
+
+    code = (diff * mcp3564SimGain3[MCP3564_SIM_GAIN(simAdc.regs[MCP3564_REG_CONFIG2])] * (1LL << 23)) / (3 * vref);
+
+    if ((config3 & MCP3564_SIM_EN_OFFCAL) != 0U)
+    {
+        /* 24 bit two's complement */
+        code += (int32_t) (simAdc.regs[MCP3564_REG_OFFSETCAL] << 8) >> 8;
+    }
+    if ((config3 & MCP3564_SIM_EN_GAINCAL) != 0U)
+    {
+        code = (code * (int64_t) simAdc.regs[MCP3564_REG_GAINCAL]) / (1LL << 23);
+    }
+
+    if (code > (sgn ? MCP3564_SIM_CODE_SGN_MAX : MCP3564_SIM_CODE_MAX))
+    {
+        code = sgn ? MCP3564_SIM_CODE_SGN_MAX : MCP3564_SIM_CODE_MAX;
+    }
+    else if (code < (sgn ? MCP3564_SIM_CODE_SGN_MIN : MCP3564_SIM_CODE_MIN))
+    {
+        code = sgn ? MCP3564_SIM_CODE_SGN_MIN : MCP3564_SIM_CODE_MIN;
+    }
+
+    return (int32_t) code;
+}
+
+static uint32_t lMCP3564_SIM_ScanNext(uint32_t from)
+{
+    uint32_t channels = MCP3564_SIM_SCAN_CHANNELS(simAdc.regs[MCP3564_REG_SCAN]);
+
+    while ((from < 16U) && ((channels & (1UL << from)) == 0U))
+    {
+        from++;
+    }
+
+    return from;
+}
+
+static void lMCP3564_SIM_Schedule(uint64_t delay)
+{
+    uint64_t conversion = lMCP3564_SIM_Dmclk(mcp3564SimOsr[MCP3564_SIM_OSR(simAdc.regs[MCP3564_REG_CONFIG1])]);
+
+    SIM_EventSchedule(&simAdc.convEvent, SIM_Now() + delay + conversion, lMCP3564_SIM_ConversionEnd, 0U);
+}
+
+static void lMCP3564_SIM_StpEnd(uintptr_t context)
+{
+    simAdc.stpActive = false;
+    lMCP3564_SIM_IrqUpdate();
+}
+
+static void lMCP3564_SIM_Start(void)
+{
+    simAdc.converting = true;
+    simAdc.scanning = (MCP3564_SIM_SCAN_CHANNELS(simAdc.regs[MCP3564_REG_SCAN]) != 0U);
+    simAdc.scanChannel = lMCP3564_SIM_ScanNext(0U);
+
+    lMCP3564_SIM_Schedule(simAdc.scanning ? lMCP3564_SIM_Dmclk(mcp3564SimScanDelay[MCP3564_SIM_SCAN_DLY(simAdc.regs[MCP3564_REG_SCAN])]) : 0U);
+
+    if ((simAdc.regs[MCP3564_REG_IRQ] & MCP3564_SIM_IRQ_EN_STP) != 0U)
+    {
+        simAdc.stpActive = true;
+        lMCP3564_SIM_IrqUpdate();
+        SIM_EventSchedule(&simAdc.stpEvent, SIM_Now() + SIM_PERIODS_NS(MCP3564_SIM_STP_MCLK, lMCP3564_SIM_Mclk()),
+                          lMCP3564_SIM_StpEnd, 0U);
+    }
+}
+
+static void lMCP3564_SIM_Abort(void)
+{
+    simAdc.converting = false;
+    SIM_EventCancel(&simAdc.convEvent);
+}
+
+static void lMCP3564_SIM_ModeSet(uint32_t mode)
+{
+    uint32_t config0 = simAdc.regs[MCP3564_REG_CONFIG0];
+
+    simAdc.regs[MCP3564_REG_CONFIG0] = (config0 & ~MCP3564_SIM_ADC_MODE_Msk) | mode;
+
+    if (mode == MCP3564_SIM_ADC_MODE_CONVERSION)
+    {
+        /* Also a restart when already converting */
+        lMCP3564_SIM_Start();
+    }
+    else
+    {
+        lMCP3564_SIM_Abort();
+    }
+}
+
+static void lMCP3564_SIM_ConversionEnd(uintptr_t context)
+{
+    uint32_t config3 = simAdc.regs[MCP3564_REG_CONFIG3];
+    uint32_t scan = simAdc.regs[MCP3564_REG_SCAN];
+    uint32_t next;
+
+    simAdc.stats.conversions++;
+    if (simAdc.scanning)
+    {
+        simAdc.data = lMCP3564_SIM_Convert(mcp3564SimScanMux[simAdc.scanChannel]);
+        simAdc.dataChannel = simAdc.scanChannel;
+    }
+    else
+    {
+        simAdc.data = lMCP3564_SIM_Convert(simAdc.regs[MCP3564_REG_MUX]);
+        simAdc.dataChannel = 0U;
+    }
+
+    /* Unread data: IRQ goes high for a moment before the new falling edge */
+    if (!simAdc.drStatus)
+    {
+        simAdc.stats.unread++;
+        simAdc.drStatus = true;
+        lMCP3564_SIM_IrqUpdate();
+    }
+    simAdc.drStatus = false;
+    lMCP3564_SIM_IrqUpdate();
+
+    if (simAdc.scanning)
+    {
+        next = lMCP3564_SIM_ScanNext(simAdc.scanChannel + 1U);
+        if (next < 16U)
+        {
+            simAdc.scanChannel = next;
+            lMCP3564_SIM_Schedule(lMCP3564_SIM_Dmclk(mcp3564SimScanDelay[MCP3564_SIM_SCAN_DLY(scan)]));
+            return;
+        }
+
+        /* End of a scan cycle */
+        simAdc.scanChannel = lMCP3564_SIM_ScanNext(0U);
+        if (MCP3564_SIM_CONV_MODE(config3) == MCP3564_SIM_CONV_MODE_CONTINUOUS)
+        {
+            lMCP3564_SIM_Schedule(lMCP3564_SIM_Dmclk(simAdc.regs[MCP3564_REG_TIMER] +
+                                                     mcp3564SimScanDelay[MCP3564_SIM_SCAN_DLY(scan)]));
+            return;
+        }
+    }
+    else if (MCP3564_SIM_CONV_MODE(config3) == MCP3564_SIM_CONV_MODE_CONTINUOUS)
+    {
+        lMCP3564_SIM_Schedule(0U);
+        return;
+    }
+
+    /* One-shot done */
+    simAdc.converting = false;
+    simAdc.regs[MCP3564_REG_CONFIG0] &= ~MCP3564_SIM_ADC_MODE_Msk;
+    if (MCP3564_SIM_CONV_MODE(config3) == MCP3564_SIM_CONV_MODE_ONESHOT_STBY)
+    {
+        simAdc.regs[MCP3564_REG_CONFIG0] |= MCP3564_SIM_ADC_MODE_STANDBY;
+    }
+}
+
+static uint32_t lMCP3564_SIM_Size(uint32_t address)
+{
+    if ((address == MCP3564_REG_ADCDATA) && (MCP3564_SIM_DATA_FORMAT(simAdc.regs[MCP3564_REG_CONFIG3]) != 0U))
+    {
+        return 4U;
+    }
+
+    return MCP3564_REG_Get(address)->size;
+}
+
+static uint32_t lMCP3564_SIM_DataWord(void)
+{
+    uint32_t code = (uint32_t) simAdc.data;
+
+    switch (MCP3564_SIM_DATA_FORMAT(simAdc.regs[MCP3564_REG_CONFIG3]))
+    {
+        case 0U:
+            return code & 0xFFFFFFU;
+
+        case 1U:
+            return code << 8;
+
+        case 2U:
+            return code;
+
+        default:
+            return (simAdc.dataChannel << 28) | (code & 0x0FFFFFFFU);
+    }
+}
+
+static uint32_t lMCP3564_SIM_ReadValue(uint32_t address)
+{
+    switch (address)
+    {
+        case MCP3564_REG_ADCDATA:
+            return lMCP3564_SIM_DataWord();
+
+        case MCP3564_REG_IRQ:
+            return ((simAdc.drStatus ? 1UL : 0UL) << 6) | ((simAdc.crccfgStatus ? 1UL : 0UL) << 5) |
+                   ((simAdc.porStatus ? 1UL : 0UL) << 4) | (simAdc.regs[MCP3564_REG_IRQ] & MCP3564_IRQ_WRITE_MASK);
+
+        default:
+            return simAdc.regs[address];
+    }
+}
+
+/* Loads the next register of a read into the shift buffer */
+static void lMCP3564_SIM_ReadLoad(void)
+{
+    uint32_t size = lMCP3564_SIM_Size(simAdc.address);
+    uint32_t value = lMCP3564_SIM_ReadValue(simAdc.address);
+    uint32_t i;
+
+    if (simAdc.address == MCP3564_REG_ADCDATA)
+    {
+        simAdc.stats.dataReads++;
+        simAdc.drStatus = true;
+        lMCP3564_SIM_IrqUpdate();
+    }
+
+    for (i = 0; i < size; i++)
+    {
+        simAdc.shift[i] = (uint8_t) (value >> (8U * (size - 1U - i)));
+    }
+    simAdc.shiftSize = size;
+    simAdc.shiftPos = 0U;
+    simAdc.shiftCrc = false;
+}
+
+static uint32_t lMCP3564_SIM_NextAddress(uint32_t address)
+{
+    return (address == MCP3564_REG_CRCCFG) ? MCP3564_REG_CONFIG0 : address + 1U;
+}
+
+static void lMCP3564_SIM_ReadNext(void)
+{
+    if ((simAdc.bus == MCP3564_SIM_BUS_INC_READ) && (simAdc.address != MCP3564_REG_ADCDATA))
+    {
+        simAdc.address = lMCP3564_SIM_NextAddress(simAdc.address);
+    }
+
+    lMCP3564_SIM_ReadLoad();
+}
+
+/* Appends the CRC of everything clocked out since the last one */
+static void lMCP3564_SIM_CrcLoad(void)
+{
+    if ((simAdc.address == MCP3564_REG_ADCDATA) && (simAdc.crcCorrupt != 0U))
+    {
+        simAdc.crc ^= 0x0001U;
+        simAdc.crcCorrupt--;
+    }
+
+    simAdc.shift[0] = (uint8_t) (simAdc.crc >> 8);
+    simAdc.shift[1] = (uint8_t) simAdc.crc;
+    simAdc.shift[2] = 0U;
+    simAdc.shift[3] = 0U;
+    simAdc.shiftSize = ((simAdc.regs[MCP3564_REG_CONFIG3] & MCP3564_SIM_CRC_FORMAT_32) != 0U) ? 4U : 2U;
+    simAdc.shiftPos = 0U;
+    simAdc.shiftCrc = true;
+    simAdc.crc = MCP3564_CRC_SEED;
+}
+
+static void lMCP3564_SIM_ConfigCrc(void)
+{
+    uint16_t crc = MCP3564_CRC_SEED;
+    uint32_t address;
+    uint32_t size;
+    uint32_t i;
+
+    for (address = MCP3564_REG_CONFIG0; address < MCP3564_REG_LOCK; address++)
+    {
+        size = MCP3564_REG_Get(address)->size;
+        for (i = size; i-- != 0U;)
+        {
+            crc = lMCP3564_SIM_Crc(crc, (uint8_t) (simAdc.regs[address] >> (8U * i)));
+        }
+    }
+
+    simAdc.regs[MCP3564_REG_CRCCFG] = crc;
+}
+
+static void lMCP3564_SIM_Reset(void)
+{
+    memcpy(simAdc.regs, mcp3564SimDefaults, sizeof(simAdc.regs));
+    simAdc.drStatus = true;
+    simAdc.crccfgStatus = true;
+    simAdc.porStatus = true;
+    simAdc.data = 0;
+    simAdc.dataChannel = 0U;
+    simAdc.stpActive = false;
+    SIM_EventCancel(&simAdc.stpEvent);
+    lMCP3564_SIM_Abort();
+    lMCP3564_SIM_IrqUpdate();
+}
+
+static void lMCP3564_SIM_Write(uint32_t address, uint32_t value)
+{
+    uint32_t old = simAdc.regs[address];
+
+    if ((MCP3564_REG_Get(address)->access & MCP3564_ACCESS_W) == 0U)
+    {
+        return;
+    }
+
+    if ((address != MCP3564_REG_LOCK) && (simAdc.regs[MCP3564_REG_LOCK] != MCP3564_SIM_LOCK_KEY))
+    {
+        simAdc.stats.lockedWrites++;
+        return;
+    }
+
+    simAdc.stats.writes++;
+
+    switch (address)
+    {
+        case MCP3564_REG_CONFIG0:
+            simAdc.regs[address] = value & ~MCP3564_SIM_ADC_MODE_Msk;
+            if ((value & MCP3564_SIM_ADC_MODE_Msk) == MCP3564_SIM_ADC_MODE_CONVERSION)
+            {
+                lMCP3564_SIM_ModeSet(MCP3564_SIM_ADC_MODE_CONVERSION);
+            }
+            else if (((value ^ old) & MCP3564_SIM_ADC_MODE_Msk) != 0U)
+            {
+                lMCP3564_SIM_ModeSet(value & MCP3564_SIM_ADC_MODE_Msk);
+            }
+            else
+            {
+                simAdc.regs[address] = value;
+            }
+            break;
+
+        case MCP3564_REG_IRQ:
+            simAdc.regs[address] = value & MCP3564_IRQ_WRITE_MASK;
+            lMCP3564_SIM_IrqUpdate();
+            break;
+
+        case MCP3564_REG_LOCK:
+            simAdc.regs[address] = value;
+            if (value != MCP3564_SIM_LOCK_KEY)
+            {
+                lMCP3564_SIM_ConfigCrc();
+            }
+            break;
+
+        default:
+            simAdc.regs[address] = value;
+            break;
+    }
+}
+
+static void lMCP3564_SIM_FastCommand(uint32_t code)
+{
+    if ((simAdc.regs[MCP3564_REG_IRQ] & MCP3564_SIM_IRQ_EN_FASTCMD) == 0U)
+    {
+        return;
+    }
+
+    simAdc.stats.fastCommands++;
+
+    switch (code)
+    {
+        case MCP3564_SIM_FAST_CONVERT:
+            lMCP3564_SIM_ModeSet(MCP3564_SIM_ADC_MODE_CONVERSION);
+            break;
+
+        case MCP3564_SIM_FAST_STANDBY:
+            lMCP3564_SIM_ModeSet(MCP3564_SIM_ADC_MODE_STANDBY);
+            break;
+
+        case MCP3564_SIM_FAST_SHUTDOWN:
+            lMCP3564_SIM_ModeSet(MCP3564_SIM_ADC_MODE_SHUTDOWN);
+            break;
+
+        case MCP3564_SIM_FAST_FULL_SHUTDOWN:
+            lMCP3564_SIM_Abort();
+            simAdc.regs[MCP3564_REG_CONFIG0] = 0U;
+            break;
+
+        case MCP3564_SIM_FAST_RESET:
+            lMCP3564_SIM_Reset();
+            break;
+
+        default:
+            break;
+    }
+}
+
+static uint8_t lMCP3564_SIM_Command(uint8_t cmd)
+{
+    uint8_t status = lMCP3564_SIM_Status();
+
+    if (MCP3564_SIM_CMD_ADDRESS(cmd) != MCP3564_DEVICE_ADDRESS)
+    {
+        /* Not us: SDO stays high impedance until the next select */
+        simAdc.stats.ignored++;
+        simAdc.bus = MCP3564_SIM_BUS_DONE;
+        return 0xFFU;
+    }
+
+    simAdc.stats.commands++;
+    simAdc.address = MCP3564_SIM_CMD_REGISTER(cmd);
+    simAdc.crc = lMCP3564_SIM_Crc(MCP3564_CRC_SEED, status);
+
+    switch (MCP3564_SIM_CMD_TYPE(cmd))
+    {
+        case MCP3564_SIM_CMD_TYPE_FAST:
+            simAdc.bus = MCP3564_SIM_BUS_DONE;
+            lMCP3564_SIM_FastCommand(simAdc.address);
+            break;
+
+        case MCP3564_CMD_TYPE_STATIC_READ:
+            simAdc.bus = MCP3564_SIM_BUS_STATIC_READ;
+            lMCP3564_SIM_ReadLoad();
+            break;
+
+        case MCP3564_CMD_TYPE_INC_READ:
+            simAdc.bus = MCP3564_SIM_BUS_INC_READ;
+            lMCP3564_SIM_ReadLoad();
+            break;
+
+        default:
+            simAdc.bus = MCP3564_SIM_BUS_INC_WRITE;
+            simAdc.shiftSize = lMCP3564_SIM_Size(simAdc.address);
+            simAdc.shiftPos = 0U;
+            break;
+    }
+
+    return status;
+}
+
+static uint8_t lMCP3564_SIM_ReadByte(void)
+{
+    uint8_t miso = simAdc.shift[simAdc.shiftPos++];
+    bool crcPoint;
+
+    if (simAdc.shiftCrc)
+    {
+        if (simAdc.shiftPos == simAdc.shiftSize)
+        {
+            simAdc.shiftCrc = false;
+            lMCP3564_SIM_ReadNext();
+        }
+        return miso;
+    }
+
+    simAdc.crc = lMCP3564_SIM_Crc(simAdc.crc, miso);
+    if (simAdc.shiftPos < simAdc.shiftSize)
+    {
+        return miso;
+    }
+
+    crcPoint = (simAdc.bus == MCP3564_SIM_BUS_STATIC_READ) || (simAdc.address == MCP3564_REG_ADCDATA) ||
+               (simAdc.address == MCP3564_REG_CRCCFG);
+
+    if (crcPoint && ((simAdc.regs[MCP3564_REG_CONFIG3] & MCP3564_CONFIG3_EN_CRCCOM) != 0U))
+    {
+        lMCP3564_SIM_CrcLoad();
+    }
+    else
+    {
+        lMCP3564_SIM_ReadNext();
+    }
+
+    return miso;
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+void MCP3564_SIM_Initialize(void)
+{
+    SIM_EventCancel(&simAdc.convEvent);
+    SIM_EventCancel(&simAdc.stpEvent);
+    memset(&simAdc, 0, sizeof(simAdc));
+
+    memcpy(simAdc.inputs, mcp3564SimInputDefaults, sizeof(simAdc.inputs));
+    simAdc.mclkHz = MCP3564_SIM_MCLK_HZ_DEFAULT;
+    simAdc.irqLevel = true;
+    simAdc.bus = MCP3564_SIM_BUS_IDLE;
+
+    lMCP3564_SIM_Reset();
+}
+
+void MCP3564_SIM_MclkSet(uint32_t frequencyHz)
+{
+    /* Takes effect from the next conversion */
+    simAdc.mclkHz = (frequencyHz != 0U) ? frequencyHz : 1U;
+}
+
+void MCP3564_SIM_InputSet(uint32_t input, int32_t microvolts)
+{
+    if (input < MCP3564_SIM_INPUTS)
+    {
+        simAdc.inputs[input] = microvolts;
+    }
+}
+
+void MCP3564_SIM_SourceSet(MCP3564_SIM_SOURCE source, uintptr_t context)
+{
+    simAdc.source = source;
+    simAdc.sourceContext = context;
+}
+
+void MCP3564_SIM_IrqCallbackRegister(MCP3564_SIM_IRQ_CALLBACK callback, uintptr_t context)
+{
+    simAdc.irqCallback = callback;
+    simAdc.irqContext = context;
+}
+
+bool MCP3564_SIM_IrqGet(void)
+{
+    return simAdc.irqLevel;
+}
+
+void MCP3564_SIM_Select(bool selected)
+{
+    simAdc.shiftCrc = false;
+    simAdc.bus = selected ? MCP3564_SIM_BUS_COMMAND : MCP3564_SIM_BUS_IDLE;
+}
+
+uint8_t MCP3564_SIM_Exchange(uint8_t mosi)
+{
+    uint32_t value;
+    uint32_t i;
+    uint8_t miso = 0xFFU;
+
+    switch (simAdc.bus)
+    {
+        case MCP3564_SIM_BUS_COMMAND:
+            miso = lMCP3564_SIM_Command(mosi);
+            break;
+
+        case MCP3564_SIM_BUS_STATIC_READ:
+        case MCP3564_SIM_BUS_INC_READ:
+            miso = lMCP3564_SIM_ReadByte();
+            break;
+
+        case MCP3564_SIM_BUS_INC_WRITE:
+            miso = 0x00U;
+            simAdc.shift[simAdc.shiftPos++] = mosi;
+            if (simAdc.shiftPos == simAdc.shiftSize)
+            {
+                value = 0U;
+                for (i = 0; i < simAdc.shiftSize; i++)
+                {
+                    value = (value << 8) | simAdc.shift[i];
+                }
+                lMCP3564_SIM_Write(simAdc.address, value);
+
+                simAdc.address = lMCP3564_SIM_NextAddress(simAdc.address);
+                simAdc.shiftSize = lMCP3564_SIM_Size(simAdc.address);
+                simAdc.shiftPos = 0U;
+            }
+            break;
+
+        case MCP3564_SIM_BUS_IDLE:
+            simAdc.stats.ignored++;
+            break;
+
+        default:
+            break;
+    }
+
+    return miso;
+}
+
+uint32_t MCP3564_SIM_RegisterGet(uint32_t address)
+{
+    if (address >= MCP3564_REG_COUNT)
+    {
+        return 0U;
+    }
+
+    return lMCP3564_SIM_ReadValue(address);
+}
+
+void MCP3564_SIM_RegisterSet(uint32_t address, uint32_t value)
+{
+    uint32_t size;
+
+    if ((address >= MCP3564_REG_COUNT) || (address == MCP3564_REG_ADCDATA) ||
+        (address == MCP3564_REG_CONFIG0) || (address == MCP3564_REG_IRQ))
+    {
+        return;
+    }
+
+    size = lMCP3564_SIM_Size(address);
+    simAdc.regs[address] = (size < 4U) ? (value & ((1UL << (8U * size)) - 1UL)) : value;
+}
+
+void MCP3564_SIM_CrcCorrupt(uint32_t count)
+{
+    simAdc.crcCorrupt = count;
+}
+
+void MCP3564_SIM_StatsGet(MCP3564_SIM_STATS* stats)
+{
+    *stats = simAdc.stats;
+}
+
+/*******************************************************************************
+ End of File
+ */
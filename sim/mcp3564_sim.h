@@ -0,0 +1,186 @@
+/*******************************************************************************
+  MCP3564 Simulation Model Header File
+
+  File Name:
+    mcp3564_sim.h
+
+  Summary:
+    Register level model of the MCP3564 for host builds.
+
+  Description:
+    The model sits behind a byte exchange interface, the same way the chip
+    sits behind SCLK/SDI/SDO: MCP3564_SIM_Select follows the chip select
+    line and MCP3564_SIM_Exchange clocks one byte in each direction. On top
+    of that it implements
+
+      - the command byte: device address, register address, command type
+      - fast commands (conversion start, standby, shutdown, full shutdown,
+        full reset) gated by IRQ.EN_FASTCMD
+      - static and incremental reads and incremental writes, the LOCK
+        register and the CRC-16 on reads selected by CONFIG3.EN_CRCCOM
+      - the four ADCDATA formats of CONFIG3.DATA_FORMAT, with the channel
+        ID of the 32 bit + CH_ID format; the 24 bit formats clamp an
+        over-range result to 24 bits, the SGN formats to 25
+      - one-shot and continuous conversions in MUX and SCAN mode, with the
+        SCAN.DLY delay and the TIMER interval between scan cycles
+      - the IRQ pin: low while unread data is pending, cleared by the start
+        of an ADCDATA read, a short high pulse when a conversion overwrites
+        unread data, and the conversion start pulse of IRQ.EN_STP
+
+    Conversion timing runs on the simulation clock (sim_core.h). One
+    conversion takes 4 * PRE * OSR MCLK periods; the longer settling of the
+    first conversion after a start is not modelled. Inputs are voltages per
+    MUX input code, either set directly or supplied by a source callback
+    evaluated at the end of each conversion.
+*******************************************************************************/
+
+#ifndef _MCP3564_SIM_H
+#define _MCP3564_SIM_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "mcp3564_reg.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Constants
+// *****************************************************************************
+// *****************************************************************************
+
+/* GCLK5 default: DFLL48M / 8 on PA11 */
+#define MCP3564_SIM_MCLK_HZ_DEFAULT         6000000U
+
+/* CONFIG0.CLK_SEL = internal oscillator, nominal frequency */
+#define MCP3564_SIM_MCLK_HZ_INTERNAL        3300000U
+
+/* RESERVED2 of the MCP3564 */
+#define MCP3564_SIM_CHIP_ID                 0x000FU
+
+/* MUX input codes, also the index of MCP3564_SIM_InputSet */
+#define MCP3564_SIM_INPUT_CH(n)             (n)
+#define MCP3564_SIM_INPUT_AGND              0x8U
+#define MCP3564_SIM_INPUT_AVDD              0x9U
+#define MCP3564_SIM_INPUT_REFINP            0xBU
+#define MCP3564_SIM_INPUT_REFINM            0xCU
+#define MCP3564_SIM_INPUT_TEMPP             0xDU
+#define MCP3564_SIM_INPUT_TEMPM             0xEU
+#define MCP3564_SIM_INPUT_VCM               0xFU
+#define MCP3564_SIM_INPUTS                  16U
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Type Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+/* Voltage of a MUX input in microvolts at time (simulation ns) */
+typedef int32_t (*MCP3564_SIM_SOURCE)(uint32_t input, uint64_t time, uintptr_t context);
+
+/* Called on every change of the IRQ pin, level true = high */
+typedef void (*MCP3564_SIM_IRQ_CALLBACK)(bool level, uintptr_t context);
+
+// *****************************************************************************
+/* Model counters
+
+  Remarks:
+    unread counts conversions which replaced data that was never read,
+    the model's view of an overrun. ignored counts command bytes with a
+    foreign device address and bytes clocked while not selected.
+*/
+
+typedef struct
+{
+    uint32_t conversions;
+    uint32_t unread;
+    uint32_t dataReads;
+    uint32_t commands;
+    uint32_t fastCommands;
+    uint32_t writes;
+    uint32_t lockedWrites;
+    uint32_t ignored;
+
+} MCP3564_SIM_STATS;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+/*******************************************************************************
+  Function:
+    void MCP3564_SIM_Initialize ( void )
+
+  Summary:
+    Power on reset: register defaults, inputs, MCLK and counters.
+
+  Remarks:
+    Call after SIM_Initialize, the model keeps an event on its queue while
+    converting. The IRQ callback and the source survive a full reset fast
+    command but not this call.
+*/
+
+void MCP3564_SIM_Initialize ( void );
+
+/* Frequency on the MCLK pin, used while CONFIG0.CLK_SEL selects it */
+void MCP3564_SIM_MclkSet ( uint32_t frequencyHz );
+
+void MCP3564_SIM_InputSet ( uint32_t input, int32_t microvolts );
+
+/* A NULL source goes back to the voltages of MCP3564_SIM_InputSet */
+void MCP3564_SIM_SourceSet ( MCP3564_SIM_SOURCE source, uintptr_t context );
+
+void MCP3564_SIM_IrqCallbackRegister ( MCP3564_SIM_IRQ_CALLBACK callback, uintptr_t context );
+
+bool MCP3564_SIM_IrqGet ( void );
+
+/*******************************************************************************
+  Function:
+    void MCP3564_SIM_Select ( bool selected )
+
+  Summary:
+    Follows the chip select line, selected = CS low.
+
+  Description:
+    Selecting starts a new command, deselecting ends it. A register write
+    which is not complete when the chip is deselected is discarded.
+*/
+
+void MCP3564_SIM_Select ( bool selected );
+
+/* One SPI byte: mosi is shifted in, the return value was on SDO */
+uint8_t MCP3564_SIM_Exchange ( uint8_t mosi );
+
+/* Register value as the device holds it, without any bus side effect */
+uint32_t MCP3564_SIM_RegisterGet ( uint32_t address );
+
+/* Register changed behind the bus, as by a disturbance: no write is counted
+   and the model picks the value up where it next reads the register. Not
+   for ADCDATA, CONFIG0 and IRQ, whose writes have side effects. */
+void MCP3564_SIM_RegisterSet ( uint32_t address, uint32_t value );
+
+/* The next count CRCs appended to an ADCDATA read go out with their last
+   bit inverted, as a bit error on SDO would. 0 cancels the ones left. */
+void MCP3564_SIM_CrcCorrupt ( uint32_t count );
+
+void MCP3564_SIM_StatsGet ( MCP3564_SIM_STATS* stats );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _MCP3564_SIM_H */
+
+/*******************************************************************************
+ End of File
+ */
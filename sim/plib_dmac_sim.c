@@ -0,0 +1,557 @@
+/*******************************************************************************
+  DMAC Simulation Source File
+
+  File Name:
+    plib_dmac_sim.c
+
+  Summary:
+    Host replacement of plib_dmac.c for the firmware image.
+
+  Description:
+    Implements plib_dmac.h for the channels DRV_SPI and the firmware use.
+    Channel setup (CHCTRLA) is written to the register block as by
+    plib_dmac.c, the trigger source is taken from there when a transfer
+    starts, so firmware which reconfigures a channel is followed:
+
+      - SERCOM1 TX (TRIGSRC 7): every beat goes through
+        SERCOM1_SPI_SIM_DataExchange at once, the character received is
+        stored by the SERCOM1 RX channel (TRIGSRC 6) while it has beats
+        left. Transfer complete of either channel comes after the time
+        its last character takes at the SCK frequency, for TX one
+        character less (the last beat only has to reach DATA).
+      - SERCOM5 TX (TRIGSRC 15), the console of plib_sercom5_usart.c:
+        one beat per character time through SERCOM5_USART_SIM_DataTransmit,
+        the first at once (DATA is empty). Transfer complete comes with the
+        last beat, which only has to reach DATA.
+      - Software trigger (TRIGSRC 0): copied and complete at once.
+
+    Linked descriptor lists (DMAC_ChannelLinkedListTransfer) run one burst
+    of one beat per trigger, as the event mode acquisition sets them up:
+
+      - event trigger (CHEVCTRL EVIE, EVACT TRIG, DMAC_SIM_EventTrigger):
+        a beat into SERCOM1 DATA is exchanged with the MCP3564 at once,
+        LSB first, and its character reaches the SERCOM1 RX channel after
+        the time it takes at the SCK frequency
+      - SERCOM1 RX: the beat is stored, and with CHEVCTRL EVOE and
+        EVOSEL BURST generates the channel's event (SIM_SOC_EventGenerate)
+
+    At the end of a block BLOCKACT INT completes it (the channel callback)
+    and the channel goes on with DESCADDR, a ring when the list loops.
+    Descriptor addresses are 32 bit, so the image is linked below 4 GB
+    (-no-pie). Other triggers and the CRC engine are not modelled; the
+    transfer functions refuse them (return false).
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <string.h>
+#include "peripheral/dmac/plib_dmac.h"
+#include "interrupts.h"
+#include "sim_core.h"
+#include "sim_cpu.h"
+#include "sim_soc.h"
+#include "plib_sim.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+#define DMAC_CHANNELS_NUMBER                (3U)
+
+#define DMAC_SIM_TRIGSRC_SW                 0U
+#define DMAC_SIM_TRIGSRC_SERCOM1_RX         6U
+#define DMAC_SIM_TRIGSRC_SERCOM1_TX         7U
+#define DMAC_SIM_TRIGSRC_SERCOM5_TX         15U
+
+typedef struct
+{
+    DMAC_CHANNEL_CALLBACK callback;
+    uintptr_t context;
+    bool isBusy;
+    uint16_t btctrl;
+    DMAC_TRANSFER_EVENT status;
+    uint8_t* src;
+    uint8_t* dst;
+    uint16_t beats;
+    uint16_t beatsDone;
+    SIM_EVENT doneEvent;
+
+    /* Linked list: the descriptor running, and the next beat to come */
+    bool linked;
+    dmac_descriptor_registers_t desc;
+    uint8_t rxData[4];
+    SIM_EVENT beatEvent;
+
+} DMAC_SIM_CH_OBJ;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data
+// *****************************************************************************
+// *****************************************************************************
+
+static DMAC_SIM_CH_OBJ dmacSimChannel[DMAC_CHANNELS_NUMBER];
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+static uint32_t lDMAC_SIM_TriggerGet(DMAC_CHANNEL channel)
+{
+    return (DMAC_REGS->CHANNEL[channel].DMAC_CHCTRLA & DMAC_CHCTRLA_TRIGSRC_Msk) >> DMAC_CHCTRLA_TRIGSRC_Pos;
+}
+
+static size_t lDMAC_SIM_BeatSize(const DMAC_SIM_CH_OBJ* ch)
+{
+    return (size_t) 1U << ((ch->btctrl & DMAC_BTCTRL_BEATSIZE_Msk) >> DMAC_BTCTRL_BEATSIZE_Pos);
+}
+
+static void lDMAC_SIM_Done(uintptr_t context)
+{
+    DMAC_CHANNEL channel = (DMAC_CHANNEL) context;
+
+    dmacSimChannel[channel].status = DMAC_TRANSFER_EVENT_COMPLETE;
+    SIM_CPU_IrqPend((int32_t) DMAC_0_IRQn + (int32_t) channel);
+}
+
+static DMAC_CHANNEL lDMAC_SIM_ChannelFind(uint32_t trigger)
+{
+    DMAC_CHANNEL channel;
+
+    for (channel = 0U; channel < DMAC_CHANNELS_NUMBER; channel++)
+    {
+        if ((lDMAC_SIM_TriggerGet(channel) == trigger) && dmacSimChannel[channel].isBusy &&
+            (dmacSimChannel[channel].beatsDone < dmacSimChannel[channel].beats))
+        {
+            return channel;
+        }
+    }
+
+    return DMAC_CHANNELS_NUMBER;
+}
+
+/* One beat of a channel, src or dst NULL for the peripheral side */
+static void lDMAC_SIM_Beat(DMAC_SIM_CH_OBJ* ch, const uint8_t* in, uint8_t* out)
+{
+    size_t size = lDMAC_SIM_BeatSize(ch);
+    size_t offset = (size_t) ch->beatsDone * size;
+
+    if (in == NULL)
+    {
+        in = ch->src + (((ch->btctrl & DMAC_BTCTRL_SRCINC_Msk) != 0U) ? offset : 0U);
+    }
+    if (out == NULL)
+    {
+        out = ch->dst + (((ch->btctrl & DMAC_BTCTRL_DSTINC_Msk) != 0U) ? offset : 0U);
+    }
+
+    (void) memmove(out, in, size);
+    ch->beatsDone++;
+}
+
+static void lDMAC_SIM_SpiTransmit(DMAC_CHANNEL channel)
+{
+    DMAC_SIM_CH_OBJ* tx = &dmacSimChannel[channel];
+    DMAC_SIM_CH_OBJ* rx;
+    DMAC_CHANNEL rxChannel;
+    uint8_t beat[4];
+    uint8_t data[4] = { 0U, 0U, 0U, 0U };
+    uint16_t i;
+
+    for (i = 0U; i < tx->beats; i++)
+    {
+        lDMAC_SIM_Beat(tx, NULL, beat);
+        data[0] = SERCOM1_SPI_SIM_DataExchange(beat[0]);
+
+        rxChannel = lDMAC_SIM_ChannelFind(DMAC_SIM_TRIGSRC_SERCOM1_RX);
+        if (rxChannel < DMAC_CHANNELS_NUMBER)
+        {
+            rx = &dmacSimChannel[rxChannel];
+            lDMAC_SIM_Beat(rx, data, NULL);
+
+            if (rx->beatsDone == rx->beats)
+            {
+                SIM_EventSchedule(&rx->doneEvent, SIM_Now() + SERCOM1_SPI_SIM_TransferTime((size_t) i + 1U),
+                                  lDMAC_SIM_Done, (uintptr_t) rxChannel);
+            }
+        }
+    }
+
+    /* The last beat goes to DATA while the character before it is shifted
+       out, so the TX channel completes ahead of the RX channel */
+    SIM_EventSchedule(&tx->doneEvent, SIM_Now() + SERCOM1_SPI_SIM_TransferTime((size_t) tx->beats - 1U),
+                      lDMAC_SIM_Done, (uintptr_t) channel);
+}
+
+/* SERCOM5 TX: one beat per data register empty */
+static void lDMAC_SIM_UartTransmit(uintptr_t context)
+{
+    DMAC_CHANNEL channel = (DMAC_CHANNEL) context;
+    DMAC_SIM_CH_OBJ* ch = &dmacSimChannel[channel];
+    uint8_t beat[4];
+
+    if (!ch->isBusy || (ch->beatsDone >= ch->beats))
+    {
+        return;
+    }
+
+    lDMAC_SIM_Beat(ch, NULL, beat);
+    SERCOM5_USART_SIM_DataTransmit(beat[0]);
+
+    if (ch->beatsDone < ch->beats)
+    {
+        SIM_EventSchedule(&ch->beatEvent, SIM_Now() + SERCOM5_USART_SIM_TransferTime(1U), lDMAC_SIM_UartTransmit,
+                          context);
+    }
+    else
+    {
+        lDMAC_SIM_Done(context);
+    }
+}
+
+/* Loads a descriptor; the addresses of an incrementing side are its end */
+static void lDMAC_SIM_DescriptorLoad(DMAC_SIM_CH_OBJ* ch, const dmac_descriptor_registers_t* desc)
+{
+    size_t size;
+
+    ch->desc = *desc;
+    ch->btctrl = desc->DMAC_BTCTRL;
+    ch->beats = desc->DMAC_BTCNT;
+    ch->beatsDone = 0U;
+
+    size = (size_t) ch->beats * lDMAC_SIM_BeatSize(ch);
+    ch->src = (uint8_t*) (uintptr_t) desc->DMAC_SRCADDR;
+    ch->dst = (uint8_t*) (uintptr_t) desc->DMAC_DSTADDR;
+    if ((ch->btctrl & DMAC_BTCTRL_SRCINC_Msk) != 0U)
+    {
+        ch->src -= size;
+    }
+    if ((ch->btctrl & DMAC_BTCTRL_DSTINC_Msk) != 0U)
+    {
+        ch->dst -= size;
+    }
+}
+
+/* A linked list beat done: block end, its interrupt and the next descriptor */
+static void lDMAC_SIM_LinkedBeatDone(DMAC_CHANNEL channel)
+{
+    DMAC_SIM_CH_OBJ* ch = &dmacSimChannel[channel];
+    uint32_t evosel = (ch->btctrl & DMAC_BTCTRL_EVOSEL_Msk) >> DMAC_BTCTRL_EVOSEL_Pos;
+    bool eventOut = (DMAC_REGS->CHANNEL[channel].DMAC_CHEVCTRL & DMAC_CHEVCTRL_EVOE_Msk) != 0U;
+
+    if (eventOut && (evosel == DMAC_BTCTRL_EVOSEL_BURST_Val))
+    {
+        SIM_SOC_EventGenerate(EVENT_ID_GEN_DMAC_CH_0 + (uint32_t) channel);
+    }
+
+    if (ch->beatsDone < ch->beats)
+    {
+        return;
+    }
+
+    if (eventOut && (evosel == DMAC_BTCTRL_EVOSEL_BLOCK_Val))
+    {
+        SIM_SOC_EventGenerate(EVENT_ID_GEN_DMAC_CH_0 + (uint32_t) channel);
+    }
+
+    if ((((ch->btctrl & DMAC_BTCTRL_BLOCKACT_Msk) >> DMAC_BTCTRL_BLOCKACT_Pos) & DMAC_BTCTRL_BLOCKACT_INT_Val) != 0U)
+    {
+        ch->status = DMAC_TRANSFER_EVENT_COMPLETE;
+        SIM_CPU_IrqPend((int32_t) DMAC_0_IRQn + (int32_t) channel);
+    }
+
+    if (ch->desc.DMAC_DESCADDR != 0U)
+    {
+        lDMAC_SIM_DescriptorLoad(ch, (const dmac_descriptor_registers_t*) (uintptr_t) ch->desc.DMAC_DESCADDR);
+    }
+    else
+    {
+        ch->linked = false;
+        DMAC_REGS->CHANNEL[channel].DMAC_CHCTRLA &= ~DMAC_CHCTRLA_ENABLE_Msk;
+    }
+}
+
+/* SERCOM1 RX of a linked list: the character of the last event beat */
+static void lDMAC_SIM_LinkedReceive(uintptr_t context)
+{
+    DMAC_CHANNEL channel = (DMAC_CHANNEL) context;
+    DMAC_SIM_CH_OBJ* ch = &dmacSimChannel[channel];
+
+    if (!ch->linked || (ch->beatsDone >= ch->beats))
+    {
+        return;
+    }
+
+    lDMAC_SIM_Beat(ch, ch->rxData, NULL);
+    lDMAC_SIM_LinkedBeatDone(channel);
+}
+
+/* Event trigger of a linked list: one beat from memory to SERCOM1 DATA */
+static void lDMAC_SIM_LinkedTransmit(uintptr_t context)
+{
+    DMAC_CHANNEL channel = (DMAC_CHANNEL) context;
+    DMAC_SIM_CH_OBJ* tx = &dmacSimChannel[channel];
+    DMAC_SIM_CH_OBJ* rx;
+    DMAC_CHANNEL rxChannel;
+    uint8_t beat[4];
+    uint8_t data[4];
+    size_t size = lDMAC_SIM_BeatSize(tx);
+    size_t i;
+
+    if (!tx->linked || (tx->beatsDone >= tx->beats) ||
+        (tx->desc.DMAC_DSTADDR != (uint32_t) (uintptr_t) &SERCOM1_REGS->SPIM.SERCOM_DATA))
+    {
+        return;
+    }
+
+    lDMAC_SIM_Beat(tx, NULL, beat);
+    for (i = 0U; i < size; i++)
+    {
+        data[i] = SERCOM1_SPI_SIM_DataExchange(beat[i]);
+    }
+
+    for (rxChannel = 0U; rxChannel < DMAC_CHANNELS_NUMBER; rxChannel++)
+    {
+        rx = &dmacSimChannel[rxChannel];
+        if (rx->linked && (lDMAC_SIM_TriggerGet(rxChannel) == DMAC_SIM_TRIGSRC_SERCOM1_RX))
+        {
+            (void) memcpy(rx->rxData, data, size);
+            SIM_EventSchedule(&rx->beatEvent, SIM_Now() + SERCOM1_SPI_SIM_TransferTime(size),
+                              lDMAC_SIM_LinkedReceive, (uintptr_t) rxChannel);
+            break;
+        }
+    }
+
+    lDMAC_SIM_LinkedBeatDone(channel);
+}
+
+static void lDMAC_SIM_InterruptHandler(DMAC_CHANNEL channel)
+{
+    DMAC_SIM_CH_OBJ* ch = &dmacSimChannel[channel];
+    DMAC_TRANSFER_EVENT event;
+
+    SIM_CPU_Enter();
+    event = ch->status;
+    ch->status = DMAC_TRANSFER_EVENT_NONE;
+
+    /* A linked list ring keeps running */
+    ch->isBusy = ch->linked;
+    SIM_CPU_Leave();
+
+    if ((event != DMAC_TRANSFER_EVENT_NONE) && (ch->callback != NULL))
+    {
+        ch->callback(event, ch->context);
+    }
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+void DMAC_Initialize(void)
+{
+    DMAC_CHANNEL channel;
+
+    for (channel = 0U; channel < DMAC_CHANNELS_NUMBER; channel++)
+    {
+        SIM_EventCancel(&dmacSimChannel[channel].doneEvent);
+        SIM_EventCancel(&dmacSimChannel[channel].beatEvent);
+        dmacSimChannel[channel].linked = false;
+        dmacSimChannel[channel].callback = NULL;
+        dmacSimChannel[channel].context = 0U;
+        dmacSimChannel[channel].isBusy = false;
+        dmacSimChannel[channel].status = DMAC_TRANSFER_EVENT_NONE;
+        dmacSimChannel[channel].beats = 0U;
+        dmacSimChannel[channel].beatsDone = 0U;
+    }
+
+    /* Channel setup of plib_dmac.c */
+    DMAC_REGS->CHANNEL[0].DMAC_CHCTRLA = DMAC_CHCTRLA_TRIGACT(2U) | DMAC_CHCTRLA_TRIGSRC(7U);
+    dmacSimChannel[0].btctrl = DMAC_BTCTRL_BLOCKACT_INT | DMAC_BTCTRL_BEATSIZE_BYTE | DMAC_BTCTRL_VALID_Msk | DMAC_BTCTRL_SRCINC_Msk;
+
+    DMAC_REGS->CHANNEL[1].DMAC_CHCTRLA = DMAC_CHCTRLA_TRIGACT(2U) | DMAC_CHCTRLA_TRIGSRC(6U);
+    dmacSimChannel[1].btctrl = DMAC_BTCTRL_BLOCKACT_INT | DMAC_BTCTRL_BEATSIZE_BYTE | DMAC_BTCTRL_VALID_Msk | DMAC_BTCTRL_DSTINC_Msk;
+
+    DMAC_REGS->CHANNEL[2].DMAC_CHCTRLA = DMAC_CHCTRLA_TRIGACT(2U) | DMAC_CHCTRLA_TRIGSRC(15U);
+    dmacSimChannel[2].btctrl = DMAC_BTCTRL_BLOCKACT_INT | DMAC_BTCTRL_BEATSIZE_BYTE | DMAC_BTCTRL_VALID_Msk | DMAC_BTCTRL_SRCINC_Msk;
+
+    DMAC_REGS->DMAC_CTRL = DMAC_CTRL_DMAENABLE_Msk | DMAC_CTRL_LVLEN0_Msk | DMAC_CTRL_LVLEN1_Msk | DMAC_CTRL_LVLEN2_Msk | DMAC_CTRL_LVLEN3_Msk;
+}
+
+bool DMAC_ChannelTransfer(DMAC_CHANNEL channel, const void *srcAddr, const void *destAddr, size_t blockSize)
+{
+    DMAC_SIM_CH_OBJ* ch = &dmacSimChannel[channel];
+    uint32_t trigger = lDMAC_SIM_TriggerGet(channel);
+    bool returnStatus = false;
+
+    SIM_CPU_Enter();
+
+    if ((!ch->isBusy || (ch->status != DMAC_TRANSFER_EVENT_NONE)) &&
+        ((trigger == DMAC_SIM_TRIGSRC_SW) || (trigger == DMAC_SIM_TRIGSRC_SERCOM1_RX) ||
+         (trigger == DMAC_SIM_TRIGSRC_SERCOM1_TX) || (trigger == DMAC_SIM_TRIGSRC_SERCOM5_TX)))
+    {
+        ch->status = DMAC_TRANSFER_EVENT_NONE;
+        ch->isBusy = true;
+        ch->src = (uint8_t*) srcAddr;
+        ch->dst = (uint8_t*) destAddr;
+        ch->beats = (uint16_t) (blockSize / lDMAC_SIM_BeatSize(ch));
+        ch->beatsDone = 0U;
+
+        if (trigger == DMAC_SIM_TRIGSRC_SERCOM1_TX)
+        {
+            lDMAC_SIM_SpiTransmit(channel);
+        }
+        else if (trigger == DMAC_SIM_TRIGSRC_SERCOM5_TX)
+        {
+            SIM_EventSchedule(&ch->beatEvent, SIM_Now(), lDMAC_SIM_UartTransmit, (uintptr_t) channel);
+        }
+        else if (trigger == DMAC_SIM_TRIGSRC_SW)
+        {
+            while (ch->beatsDone < ch->beats)
+            {
+                lDMAC_SIM_Beat(ch, NULL, NULL);
+            }
+            SIM_EventSchedule(&ch->doneEvent, SIM_Now(), lDMAC_SIM_Done, (uintptr_t) channel);
+        }
+        else
+        {
+            /* SERCOM1 RX: filled by the TX channel */
+        }
+
+        returnStatus = true;
+    }
+
+    SIM_CPU_Leave();
+
+    return returnStatus;
+}
+
+bool DMAC_ChannelLinkedListTransfer(DMAC_CHANNEL channel, dmac_descriptor_registers_t* channelDesc)
+{
+    DMAC_SIM_CH_OBJ* ch = &dmacSimChannel[channel];
+    uint32_t trigger = lDMAC_SIM_TriggerGet(channel);
+    bool eventTrigger = ((DMAC_REGS->CHANNEL[channel].DMAC_CHEVCTRL & DMAC_CHEVCTRL_EVIE_Msk) != 0U) &&
+                        ((DMAC_REGS->CHANNEL[channel].DMAC_CHEVCTRL & DMAC_CHEVCTRL_EVACT_Msk) == DMAC_CHEVCTRL_EVACT_TRIG);
+    bool returnStatus = false;
+
+    SIM_CPU_Enter();
+
+    /* Only the event mode acquisition uses them: event triggered TX, RX */
+    if ((!ch->isBusy || (ch->status != DMAC_TRANSFER_EVENT_NONE)) &&
+        (((trigger == DMAC_SIM_TRIGSRC_SW) && eventTrigger) || (trigger == DMAC_SIM_TRIGSRC_SERCOM1_RX)))
+    {
+        ch->status = DMAC_TRANSFER_EVENT_NONE;
+        ch->isBusy = true;
+        ch->linked = true;
+        lDMAC_SIM_DescriptorLoad(ch, channelDesc);
+        DMAC_REGS->CHANNEL[channel].DMAC_CHCTRLA |= DMAC_CHCTRLA_ENABLE_Msk;
+
+        returnStatus = true;
+    }
+
+    SIM_CPU_Leave();
+
+    return returnStatus;
+}
+
+bool DMAC_ChannelIsBusy(DMAC_CHANNEL channel)
+{
+    if (dmacSimChannel[channel].isBusy && (dmacSimChannel[channel].status == DMAC_TRANSFER_EVENT_NONE))
+    {
+        SIM_CPU_Poll();
+    }
+
+    return dmacSimChannel[channel].isBusy && (dmacSimChannel[channel].status == DMAC_TRANSFER_EVENT_NONE);
+}
+
+DMAC_TRANSFER_EVENT DMAC_ChannelTransferStatusGet(DMAC_CHANNEL channel)
+{
+    return dmacSimChannel[channel].status;
+}
+
+void DMAC_ChannelDisable(DMAC_CHANNEL channel)
+{
+    SIM_CPU_Enter();
+
+    SIM_EventCancel(&dmacSimChannel[channel].doneEvent);
+    SIM_EventCancel(&dmacSimChannel[channel].beatEvent);
+    SIM_CPU_IrqUnpend((int32_t) DMAC_0_IRQn + (int32_t) channel);
+    dmacSimChannel[channel].isBusy = false;
+    dmacSimChannel[channel].linked = false;
+    DMAC_REGS->CHANNEL[channel].DMAC_CHCTRLA &= ~DMAC_CHCTRLA_ENABLE_Msk;
+
+    SIM_CPU_Leave();
+}
+
+void DMAC_SIM_EventTrigger(uint32_t channel)
+{
+    DMAC_SIM_CH_OBJ* ch;
+    uint32_t chevctrl;
+
+    if (channel >= DMAC_CHANNELS_NUMBER)
+    {
+        return;
+    }
+
+    ch = &dmacSimChannel[channel];
+    chevctrl = DMAC_REGS->CHANNEL[channel].DMAC_CHEVCTRL;
+
+    /* A burst, one beat, after the event; no transfer running, no burst */
+    if (((chevctrl & DMAC_CHEVCTRL_EVIE_Msk) != 0U) && ((chevctrl & DMAC_CHEVCTRL_EVACT_Msk) == DMAC_CHEVCTRL_EVACT_TRIG) &&
+        ch->linked)
+    {
+        SIM_EventSchedule(&ch->beatEvent, SIM_Now(), lDMAC_SIM_LinkedTransmit, (uintptr_t) channel);
+    }
+}
+
+uint16_t DMAC_ChannelGetTransferredCount(DMAC_CHANNEL channel)
+{
+    return dmacSimChannel[channel].beatsDone;
+}
+
+void DMAC_ChannelCallbackRegister(DMAC_CHANNEL channel, const DMAC_CHANNEL_CALLBACK callback, const uintptr_t context)
+{
+    dmacSimChannel[channel].callback = callback;
+    dmacSimChannel[channel].context = context;
+}
+
+DMAC_CHANNEL_CONFIG DMAC_ChannelSettingsGet(DMAC_CHANNEL channel)
+{
+    return dmacSimChannel[channel].btctrl;
+}
+
+bool DMAC_ChannelSettingsSet(DMAC_CHANNEL channel, DMAC_CHANNEL_CONFIG setting)
+{
+    dmacSimChannel[channel].btctrl = (uint16_t) setting;
+
+    return true;
+}
+
+void DMAC_0_InterruptHandler(void)
+{
+    lDMAC_SIM_InterruptHandler(DMAC_CHANNEL_0);
+}
+
+void DMAC_1_InterruptHandler(void)
+{
+    lDMAC_SIM_InterruptHandler(DMAC_CHANNEL_1);
+}
+
+void DMAC_2_InterruptHandler(void)
+{
+    lDMAC_SIM_InterruptHandler(DMAC_CHANNEL_2);
+}
+
+/*******************************************************************************
+ End of File
+ */
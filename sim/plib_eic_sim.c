@@ -0,0 +1,187 @@
+/*******************************************************************************
+  EIC Simulation Source File
+
+  File Name:
+    plib_eic_sim.c
+
+  Summary:
+    Host replacement of plib_eic.c.
+
+  Description:
+    Implements plib_eic.h with the configuration of plib_eic.c: EXTINT 14
+    (MCP3564 IRQ) senses falling edges, drives its interrupt and its event
+    output. Inputs come from EIC_SIM_PinSet; interrupt flags live here, a
+    write of EIC_REGS->EIC_INTFLAG by the firmware reaches them through the
+    register fold of sim_soc.c (EIC_SIM_FlagClear).
+
+    Edge senses only, the filter and debouncer are not modelled.
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include "peripheral/eic/plib_eic.h"
+#include "interrupts.h"
+#include "sim_cpu.h"
+#include "plib_sim.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+typedef struct
+{
+    EIC_CALLBACK_OBJ callbacks[EXTINT_COUNT];
+    uint8_t sense[EXTINT_COUNT];
+    bool level[EXTINT_COUNT];
+    uint32_t intenMask;
+    uint32_t evctrlMask;
+    uint32_t flags;
+
+} EIC_SIM_OBJ;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data
+// *****************************************************************************
+// *****************************************************************************
+
+volatile static EIC_SIM_OBJ eicSim;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+static void lEIC_SIM_Pend(uint32_t pin)
+{
+    if (((eicSim.flags & eicSim.intenMask) & (1UL << pin)) != 0U)
+    {
+        SIM_CPU_IrqPend((int32_t) EIC_EXTINT_0_IRQn + (int32_t) pin);
+    }
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+void EIC_Initialize(void)
+{
+    uint32_t pin;
+
+    for (pin = 0U; pin < EXTINT_COUNT; pin++)
+    {
+        eicSim.callbacks[pin].eicPinNo = EIC_PIN_MAX;
+        eicSim.callbacks[pin].callback = NULL;
+        eicSim.callbacks[pin].context = 0U;
+        eicSim.sense[pin] = EIC_CONFIG_SENSE0_NONE_Val;
+        eicSim.level[pin] = true;
+    }
+
+    eicSim.sense[EIC_PIN_14] = EIC_CONFIG_SENSE0_FALL_Val;
+    eicSim.callbacks[EIC_PIN_14].eicPinNo = EIC_PIN_14;
+
+    eicSim.evctrlMask = 0x4000U;
+    eicSim.intenMask = 0x4000U;
+    eicSim.flags = 0U;
+}
+
+void EIC_InterruptEnable(EIC_PIN pin)
+{
+    SIM_CPU_Enter();
+
+    eicSim.intenMask |= (1UL << (uint32_t) pin);
+    lEIC_SIM_Pend(pin);
+
+    SIM_CPU_Leave();
+}
+
+void EIC_InterruptDisable(EIC_PIN pin)
+{
+    SIM_CPU_Enter();
+
+    eicSim.intenMask &= ~(1UL << (uint32_t) pin);
+
+    SIM_CPU_Leave();
+}
+
+void EIC_CallbackRegister(EIC_PIN pin, EIC_CALLBACK callback, uintptr_t context)
+{
+    if (eicSim.callbacks[pin].eicPinNo == pin)
+    {
+        eicSim.callbacks[pin].callback = callback;
+
+        eicSim.callbacks[pin].context  = context;
+    }
+}
+
+void EIC_EXTINT_14_InterruptHandler(void)
+{
+    SIM_CPU_Enter();
+    eicSim.flags &= ~(1UL << 14U);
+    SIM_CPU_Leave();
+
+    if ((eicSim.callbacks[14].callback != NULL))
+    {
+        uintptr_t context = eicSim.callbacks[14].context;
+        eicSim.callbacks[14].callback(context);
+    }
+}
+
+bool EIC_SIM_PinSet(uint32_t pin, bool level)
+{
+    bool edge;
+
+    if (pin >= EXTINT_COUNT)
+    {
+        return false;
+    }
+
+    switch (eicSim.sense[pin])
+    {
+        case EIC_CONFIG_SENSE0_RISE_Val:
+            edge = level && !eicSim.level[pin];
+            break;
+
+        case EIC_CONFIG_SENSE0_FALL_Val:
+            edge = !level && eicSim.level[pin];
+            break;
+
+        case EIC_CONFIG_SENSE0_BOTH_Val:
+            edge = level != eicSim.level[pin];
+            break;
+
+        default:
+            edge = false;
+            break;
+    }
+
+    eicSim.level[pin] = level;
+
+    if (!edge)
+    {
+        return false;
+    }
+
+    eicSim.flags |= (1UL << pin);
+    lEIC_SIM_Pend(pin);
+
+    return (eicSim.evctrlMask & (1UL << pin)) != 0U;
+}
+
+void EIC_SIM_FlagClear(uint32_t mask)
+{
+    eicSim.flags &= ~mask;
+}
+
+/*******************************************************************************
+ End of File
+ */
@@ -0,0 +1,278 @@
+/*******************************************************************************
+  RTC Simulation Source File
+
+  File Name:
+    plib_rtc_timer_sim.c
+
+  Summary:
+    Host replacement of plib_rtc_timer.c.
+
+  Description:
+    Implements the 32-bit counter of plib_rtc.h in the configuration of
+    plib_rtc_timer.c: 32768 Hz, COMP0 0x1F with clear on match, CMP0
+    interrupt enabled, so SYS_TIME gets its 1024 Hz tick.
+
+    The count is derived from the simulated time, only the compare match
+    is an event, so an idle RTC costs nothing between matches. COMP1,
+    periodic intervals, tamper and timestamp are not modelled.
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include "peripheral/rtc/plib_rtc.h"
+#include "interrupts.h"
+#include "sim_core.h"
+#include "sim_cpu.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+typedef struct
+{
+    RTC_OBJECT rtc;
+    bool running;
+    bool matchClear;
+    uint64_t startTime;
+    uint64_t clearTick;
+    uint32_t clearCount;
+    uint32_t compare[2];
+    uint32_t intenMask;
+    uint32_t flags;
+    uint32_t backup[8];
+    SIM_EVENT matchEvent;
+
+} RTC_SIM_OBJ;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data
+// *****************************************************************************
+// *****************************************************************************
+
+static RTC_SIM_OBJ rtcSim;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+/* Counter clocks since the start at the current time */
+static uint64_t lRTC_SIM_TicksGet(void)
+{
+    return ((SIM_Now() - rtcSim.startTime) * RTC_COUNTER_CLOCK_FREQUENCY) / SIM_NS_PER_S;
+}
+
+static uint32_t lRTC_SIM_CountGet(void)
+{
+    if (!rtcSim.running)
+    {
+        return rtcSim.clearCount;
+    }
+
+    return rtcSim.clearCount + (uint32_t) (lRTC_SIM_TicksGet() - rtcSim.clearTick);
+}
+
+static void lRTC_SIM_Match(uintptr_t context);
+
+/* Schedules the tick at which the count equals COMP0 */
+static void lRTC_SIM_MatchSchedule(void)
+{
+    uint64_t tick;
+
+    SIM_EventCancel(&rtcSim.matchEvent);
+
+    if (!rtcSim.running || (rtcSim.compare[0] < rtcSim.clearCount))
+    {
+        /* Stopped, or only after the count wraps: never in practice */
+        return;
+    }
+
+    tick = rtcSim.clearTick + (uint64_t) (rtcSim.compare[0] - rtcSim.clearCount);
+
+    SIM_EventSchedule(&rtcSim.matchEvent, rtcSim.startTime + SIM_PERIODS_NS(tick, RTC_COUNTER_CLOCK_FREQUENCY),
+                      lRTC_SIM_Match, 0U);
+}
+
+static void lRTC_SIM_Match(uintptr_t context)
+{
+    uint64_t tick = rtcSim.clearTick + (uint64_t) (rtcSim.compare[0] - rtcSim.clearCount);
+
+    rtcSim.flags |= RTC_TIMER32_INT_MASK_CMP0;
+    if ((rtcSim.intenMask & RTC_TIMER32_INT_MASK_CMP0) != 0U)
+    {
+        SIM_CPU_IrqPend((int32_t) RTC_IRQn);
+    }
+
+    if (rtcSim.matchClear)
+    {
+        /* The count is 0 one clock after the match */
+        rtcSim.clearTick = tick + 1U;
+        rtcSim.clearCount = 0U;
+        lRTC_SIM_MatchSchedule();
+    }
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+void RTC_Initialize(void)
+{
+    SIM_EventCancel(&rtcSim.matchEvent);
+
+    rtcSim.running = false;
+    rtcSim.matchClear = true;
+    rtcSim.startTime = 0U;
+    rtcSim.clearTick = 0U;
+    rtcSim.clearCount = 0U;
+    rtcSim.compare[0] = 0x1fU;
+    rtcSim.compare[1] = 0x0U;
+    rtcSim.intenMask = 0x100U;
+    rtcSim.flags = 0U;
+}
+
+void RTC_Timer32CountSyncEnable(void)
+{
+    /* The count is always read in sync */
+}
+
+void RTC_Timer32CountSyncDisable(void)
+{
+}
+
+void RTC_Timer32Start(void)
+{
+    SIM_CPU_Enter();
+
+    if (!rtcSim.running)
+    {
+        rtcSim.running = true;
+        rtcSim.startTime = SIM_Now();
+        rtcSim.clearTick = 0U;
+        lRTC_SIM_MatchSchedule();
+    }
+
+    SIM_CPU_Leave();
+}
+
+void RTC_Timer32Stop(void)
+{
+    SIM_CPU_Enter();
+
+    rtcSim.clearCount = lRTC_SIM_CountGet();
+    rtcSim.running = false;
+    lRTC_SIM_MatchSchedule();
+
+    SIM_CPU_Leave();
+}
+
+void RTC_Timer32CounterSet(uint32_t count)
+{
+    SIM_CPU_Enter();
+
+    rtcSim.clearTick = rtcSim.running ? lRTC_SIM_TicksGet() : 0U;
+    rtcSim.clearCount = count;
+    lRTC_SIM_MatchSchedule();
+
+    SIM_CPU_Leave();
+}
+
+void RTC_Timer32Compare0Set(uint32_t compareValue)
+{
+    SIM_CPU_Enter();
+
+    /* Rebase on the current count, the schedule counts from there */
+    rtcSim.clearCount = lRTC_SIM_CountGet();
+    rtcSim.clearTick = rtcSim.running ? lRTC_SIM_TicksGet() : 0U;
+    rtcSim.compare[0] = compareValue;
+    lRTC_SIM_MatchSchedule();
+
+    SIM_CPU_Leave();
+}
+
+void RTC_Timer32Compare1Set(uint32_t compareValue)
+{
+    rtcSim.compare[1] = compareValue;
+}
+
+uint32_t RTC_Timer32CounterGet(void)
+{
+    uint32_t count;
+
+    SIM_CPU_Enter();
+    count = lRTC_SIM_CountGet();
+    SIM_CPU_Leave();
+
+    return count;
+}
+
+uint32_t RTC_Timer32PeriodGet(void)
+{
+    return (RTC_MODE0_COUNT_COUNT_Msk);
+}
+
+uint32_t RTC_Timer32FrequencyGet(void)
+{
+    return RTC_COUNTER_CLOCK_FREQUENCY;
+}
+
+void RTC_Timer32InterruptEnable(RTC_TIMER32_INT_MASK interruptMask)
+{
+    SIM_CPU_Enter();
+
+    rtcSim.intenMask |= (uint32_t) interruptMask;
+    if ((rtcSim.flags & rtcSim.intenMask) != 0U)
+    {
+        SIM_CPU_IrqPend((int32_t) RTC_IRQn);
+    }
+
+    SIM_CPU_Leave();
+}
+
+void RTC_Timer32InterruptDisable(RTC_TIMER32_INT_MASK interruptMask)
+{
+    rtcSim.intenMask &= ~(uint32_t) interruptMask;
+}
+
+void RTC_BackupRegisterSet(BACKUP_REGISTER reg, uint32_t value)
+{
+    rtcSim.backup[reg] = value;
+}
+
+uint32_t RTC_BackupRegisterGet(BACKUP_REGISTER reg)
+{
+    return rtcSim.backup[reg];
+}
+
+void RTC_Timer32CallbackRegister(RTC_TIMER32_CALLBACK callback, uintptr_t context)
+{
+    rtcSim.rtc.timer32BitCallback = callback;
+    rtcSim.rtc.context = context;
+}
+
+void RTC_InterruptHandler(void)
+{
+    SIM_CPU_Enter();
+    rtcSim.rtc.timer32intCause = (RTC_TIMER32_INT_MASK) rtcSim.flags;
+    rtcSim.flags = 0U;
+    SIM_CPU_Leave();
+
+    if (rtcSim.rtc.timer32BitCallback != NULL)
+    {
+        rtcSim.rtc.timer32BitCallback(rtcSim.rtc.timer32intCause, rtcSim.rtc.context);
+    }
+}
+
+/*******************************************************************************
+ End of File
+ */
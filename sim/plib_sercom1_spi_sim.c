@@ -0,0 +1,250 @@
+/*******************************************************************************
+  SERCOM1 SPI Simulation Source File
+
+  File Name:
+    plib_sercom1_spi_sim.c
+
+  Summary:
+    Host replacement of plib_sercom1_spi_master.c wired to the MCP3564 model.
+
+  Description:
+    Implements the interface of plib_sercom1_spi_master.h, so application
+    code and DRV_SPI link against it unchanged. The bytes of a transfer are
+    exchanged with the model when the transfer is accepted; busy stays set
+    for the time the transfer takes at the configured SCK frequency, then
+    the transmit complete interrupt (SERCOM1_1) is pended and
+    SERCOM1_SPI_InterruptHandler completes the transfer and calls the
+    callback, as on the target.
+
+    Chip select is not part of this PLIB (it is a port pin), whoever drives
+    the SPI_CS pin calls MCP3564_SIM_Select; in the firmware image that is
+    the port fold of sim_soc.c.
+
+    DMA transfers go through the DATA register, the simulated DMAC moves
+    them with SERCOM1_SPI_SIM_DataExchange (plib_sim.h).
+
+    Polling IsBusy or IsTransmitterBusy while a transfer is in flight steps
+    the simulation, so the usual while (SERCOM1_SPI_IsBusy()) loop ends
+    when the transfer does.
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include "peripheral/sercom/spi_master/plib_sercom1_spi_master.h"
+#include "interrupts.h"
+#include "sim_core.h"
+#include "sim_cpu.h"
+#include "plib_sim.h"
+#include "mcp3564_sim.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+/* Same GCLK as the target: GCLK1 60 MHz, BAUD 29 for 1 MHz */
+#define SERCOM1_Frequency                   (60000000UL)
+#define SERCOM1_SPIM_BAUD_VALUE             (29UL)
+
+#define SERCOM1_SPI_SIM_DUMMY               0xFFU
+
+typedef struct
+{
+    SPI_OBJECT spi;
+    uint32_t sckHz;
+    SIM_EVENT doneEvent;
+
+} SERCOM1_SPI_SIM_OBJ;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data
+// *****************************************************************************
+// *****************************************************************************
+
+static SERCOM1_SPI_SIM_OBJ sercom1SpiSim;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+static void lSERCOM1_SPI_SIM_Done(uintptr_t context)
+{
+    SIM_CPU_IrqPend((int32_t) SERCOM1_1_IRQn);
+}
+
+static bool lSERCOM1_SPI_SIM_Busy(void)
+{
+    if (sercom1SpiSim.spi.transferIsBusy)
+    {
+        SIM_CPU_Poll();
+    }
+
+    return sercom1SpiSim.spi.transferIsBusy;
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+void SERCOM1_SPI_Initialize(void)
+{
+    SIM_EventCancel(&sercom1SpiSim.doneEvent);
+
+    sercom1SpiSim.spi.callback = NULL;
+    sercom1SpiSim.spi.transferIsBusy = false;
+    sercom1SpiSim.spi.txSize = 0U;
+    sercom1SpiSim.spi.rxSize = 0U;
+    sercom1SpiSim.sckHz = SERCOM1_Frequency / (2U * (SERCOM1_SPIM_BAUD_VALUE + 1U));
+}
+
+bool SERCOM1_SPI_TransferSetup(SPI_TRANSFER_SETUP* setup, uint32_t spiSourceClock)
+{
+    uint32_t baudValue;
+
+    if (spiSourceClock == 0U)
+    {
+        spiSourceClock = SERCOM1_Frequency;
+    }
+
+    /* 9 bit characters are not modelled */
+    if ((setup == NULL) || (setup->clockFrequency == 0U) || (setup->clockFrequency > (spiSourceClock / 2U)) ||
+        (setup->dataBits != SPI_DATA_BITS_8))
+    {
+        return false;
+    }
+
+    baudValue = (spiSourceClock / (2U * setup->clockFrequency));
+    if (baudValue != 0U)
+    {
+        baudValue--;
+    }
+    if (baudValue > 255U)
+    {
+        return false;
+    }
+
+    sercom1SpiSim.sckHz = spiSourceClock / (2U * (baudValue + 1U));
+
+    return true;
+}
+
+void SERCOM1_SPI_CallbackRegister(SERCOM_SPI_CALLBACK callBack, uintptr_t context)
+{
+    sercom1SpiSim.spi.callback = callBack;
+    sercom1SpiSim.spi.context = context;
+}
+
+bool SERCOM1_SPI_IsBusy(void)
+{
+    return lSERCOM1_SPI_SIM_Busy();
+}
+
+bool SERCOM1_SPI_IsTransmitterBusy(void)
+{
+    return lSERCOM1_SPI_SIM_Busy();
+}
+
+bool SERCOM1_SPI_WriteRead(void* pTransmitData, size_t txSize, void* pReceiveData, size_t rxSize)
+{
+    const uint8_t* tx = pTransmitData;
+    uint8_t* rx = pReceiveData;
+    size_t size;
+    size_t i;
+    uint8_t miso;
+
+    if (sercom1SpiSim.spi.transferIsBusy)
+    {
+        return false;
+    }
+
+    SIM_CPU_Enter();
+
+    if (tx == NULL)
+    {
+        txSize = 0U;
+    }
+    if (rx == NULL)
+    {
+        rxSize = 0U;
+    }
+    if ((txSize == 0U) && (rxSize == 0U))
+    {
+        SIM_CPU_Leave();
+        return false;
+    }
+
+    size = (txSize > rxSize) ? txSize : rxSize;
+
+    for (i = 0; i < size; i++)
+    {
+        miso = MCP3564_SIM_Exchange((i < txSize) ? tx[i] : SERCOM1_SPI_SIM_DUMMY);
+        if (i < rxSize)
+        {
+            rx[i] = miso;
+        }
+    }
+
+    sercom1SpiSim.spi.txBuffer = pTransmitData;
+    sercom1SpiSim.spi.rxBuffer = pReceiveData;
+    sercom1SpiSim.spi.txSize = txSize;
+    sercom1SpiSim.spi.rxSize = rxSize;
+    sercom1SpiSim.spi.txCount = txSize;
+    sercom1SpiSim.spi.rxCount = rxSize;
+    sercom1SpiSim.spi.transferIsBusy = true;
+
+    SIM_EventSchedule(&sercom1SpiSim.doneEvent, SIM_Now() + SERCOM1_SPI_SIM_TransferTime(size),
+                      lSERCOM1_SPI_SIM_Done, 0U);
+
+    SIM_CPU_Leave();
+
+    return true;
+}
+
+bool SERCOM1_SPI_Write(void* pTransmitData, size_t txSize)
+{
+    return SERCOM1_SPI_WriteRead(pTransmitData, txSize, NULL, 0U);
+}
+
+bool SERCOM1_SPI_Read(void* pReceiveData, size_t rxSize)
+{
+    return SERCOM1_SPI_WriteRead(NULL, 0U, pReceiveData, rxSize);
+}
+
+void SERCOM1_SPI_InterruptHandler(void)
+{
+    if (!sercom1SpiSim.spi.transferIsBusy)
+    {
+        return;
+    }
+
+    sercom1SpiSim.spi.transferIsBusy = false;
+
+    if (sercom1SpiSim.spi.callback != NULL)
+    {
+        sercom1SpiSim.spi.callback(sercom1SpiSim.spi.context);
+    }
+}
+
+uint8_t SERCOM1_SPI_SIM_DataExchange(uint8_t data)
+{
+    return MCP3564_SIM_Exchange(data);
+}
+
+uint64_t SERCOM1_SPI_SIM_TransferTime(size_t size)
+{
+    return SIM_PERIODS_NS(8U * size, sercom1SpiSim.sckHz);
+}
+
+/*******************************************************************************
+ End of File
+ */
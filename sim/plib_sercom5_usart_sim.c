@@ -0,0 +1,617 @@
+/*******************************************************************************
+  SERCOM5 USART Simulation Source File
+
+  File Name:
+    plib_sercom5_usart_sim.c
+
+  Summary:
+    Host replacement of plib_sercom5_usart.c, the console UART.
+
+  Description:
+    Implements the ring buffer interface of plib_sercom5_usart.h with the
+    buffer sizes, notifications and callbacks of plib_sercom5_usart.c, for
+    8 bit characters. The line is connected to host file descriptors
+    (SERCOM5_USART_SIM_Attach):
+
+      - TX sends contiguous segments of the write ring, as the DMAC does
+        on the target. A segment reaches txFd and leaves the ring when the
+        time its characters take at the baud rate has passed.
+      - RX takes one character per character time from rxFd and pushes it
+        from the interrupt handler. A character waits while the previous
+        one was not taken, so a slow firmware never overruns here. rxFd is
+        polled without blocking, every millisecond of simulated time while
+        nothing arrives.
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <errno.h>
+#include <poll.h>
+#include <unistd.h>
+#include "peripheral/sercom/usart/plib_sercom5_usart.h"
+#include "interrupts.h"
+#include "sim_core.h"
+#include "sim_cpu.h"
+#include "plib_sim.h"
+#include "sys_trace_hook.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+#define SERCOM5_USART_READ_BUFFER_SIZE      1024U
+#define SERCOM5_USART_WRITE_BUFFER_SIZE     1024U
+
+#define SERCOM5_USART_SIM_BAUD              115200U
+
+/* Start, 8 data and stop bit */
+#define SERCOM5_USART_SIM_CHAR_BITS         10U
+
+/* Largest TX segment, bounds the time a write waits for the line */
+#define SERCOM5_USART_SIM_SEGMENT_MAX       64U
+
+#define SERCOM5_USART_SIM_RX_POLL_NS        1000000U
+
+#define SERCOM5_USART_SIM_RX_HOST_SIZE      256U
+
+typedef struct
+{
+    int rxFd;
+    int txFd;
+    uint32_t baud;
+
+    uint32_t txSize;
+    bool txDone;
+    SIM_EVENT txEvent;
+
+    uint8_t rxHost[SERCOM5_USART_SIM_RX_HOST_SIZE];
+    size_t rxHostCount;
+    size_t rxHostIndex;
+    bool rxEof;
+    uint8_t rxData;
+    bool rxReady;
+    SIM_EVENT rxEvent;
+
+} SERCOM5_USART_SIM_OBJ;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data
+// *****************************************************************************
+// *****************************************************************************
+
+volatile static SERCOM_USART_RING_BUFFER_OBJECT sercom5USARTObj;
+
+volatile static uint8_t SERCOM5_USART_ReadBuffer[SERCOM5_USART_READ_BUFFER_SIZE];
+volatile static uint8_t SERCOM5_USART_WriteBuffer[SERCOM5_USART_WRITE_BUFFER_SIZE];
+
+static SERCOM5_USART_SIM_OBJ sercom5UsartSim = { .rxFd = -1, .txFd = -1 };
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+static uint64_t lSERCOM5_USART_SIM_CharTime(size_t count)
+{
+    return SIM_PERIODS_NS(SERCOM5_USART_SIM_CHAR_BITS * count, sercom5UsartSim.baud);
+}
+
+static void lSERCOM5_USART_SIM_HostWrite(const volatile uint8_t* data, size_t size)
+{
+    ssize_t n;
+
+    if (sercom5UsartSim.txFd < 0)
+    {
+        return;
+    }
+
+    while (size > 0U)
+    {
+        n = write(sercom5UsartSim.txFd, (const void*) data, size);
+        if (n < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            /* Nobody listens any more, the line drops the characters */
+            sercom5UsartSim.txFd = -1;
+            return;
+        }
+        data += n;
+        size -= (size_t) n;
+    }
+}
+
+static void lSERCOM5_USART_SIM_TxDone(uintptr_t context)
+{
+    sercom5UsartSim.txDone = true;
+    SIM_CPU_IrqPend((int32_t) SERCOM5_1_IRQn);
+}
+
+static void lSERCOM5_USART_SIM_TxStart(void)
+{
+    uint32_t wrInIndex = sercom5USARTObj.wrInIndex;
+    uint32_t wrOutIndex = sercom5USARTObj.wrOutIndex;
+    uint32_t size;
+
+    if ((sercom5UsartSim.txSize != 0U) || (wrInIndex == wrOutIndex))
+    {
+        return;
+    }
+
+    size = (wrInIndex > wrOutIndex) ? (wrInIndex - wrOutIndex) : (sercom5USARTObj.wrBufferSize - wrOutIndex);
+    if (size > SERCOM5_USART_SIM_SEGMENT_MAX)
+    {
+        size = SERCOM5_USART_SIM_SEGMENT_MAX;
+    }
+
+    sercom5UsartSim.txSize = size;
+    SIM_EventSchedule(&sercom5UsartSim.txEvent, SIM_Now() + lSERCOM5_USART_SIM_CharTime(size),
+                      lSERCOM5_USART_SIM_TxDone, 0U);
+}
+
+static void lSERCOM5_USART_SIM_Receive(uintptr_t context)
+{
+    struct pollfd pfd;
+    ssize_t n;
+
+    if (sercom5UsartSim.rxReady)
+    {
+        /* Previous character not taken yet */
+        SIM_EventSchedule(&sercom5UsartSim.rxEvent, SIM_Now() + lSERCOM5_USART_SIM_CharTime(1U),
+                          lSERCOM5_USART_SIM_Receive, 0U);
+        return;
+    }
+
+    if ((sercom5UsartSim.rxHostIndex == sercom5UsartSim.rxHostCount) && !sercom5UsartSim.rxEof)
+    {
+        sercom5UsartSim.rxHostIndex = 0U;
+        sercom5UsartSim.rxHostCount = 0U;
+
+        pfd.fd = sercom5UsartSim.rxFd;
+        pfd.events = POLLIN;
+        if (poll(&pfd, 1, 0) > 0)
+        {
+            n = read(sercom5UsartSim.rxFd, sercom5UsartSim.rxHost, sizeof(sercom5UsartSim.rxHost));
+            if (n > 0)
+            {
+                sercom5UsartSim.rxHostCount = (size_t) n;
+            }
+            else if ((n == 0) || ((errno != EINTR) && (errno != EAGAIN)))
+            {
+                sercom5UsartSim.rxEof = true;
+            }
+            else
+            {
+                /* Try again at the next poll */
+            }
+        }
+    }
+
+    if (sercom5UsartSim.rxHostIndex < sercom5UsartSim.rxHostCount)
+    {
+        sercom5UsartSim.rxData = sercom5UsartSim.rxHost[sercom5UsartSim.rxHostIndex];
+        sercom5UsartSim.rxHostIndex++;
+        sercom5UsartSim.rxReady = true;
+        SIM_CPU_IrqPend((int32_t) SERCOM5_2_IRQn);
+
+        SIM_EventSchedule(&sercom5UsartSim.rxEvent, SIM_Now() + lSERCOM5_USART_SIM_CharTime(1U),
+                          lSERCOM5_USART_SIM_Receive, 0U);
+    }
+    else if (!sercom5UsartSim.rxEof)
+    {
+        SIM_EventSchedule(&sercom5UsartSim.rxEvent, SIM_Now() + SERCOM5_USART_SIM_RX_POLL_NS,
+                          lSERCOM5_USART_SIM_Receive, 0U);
+    }
+    else
+    {
+        /* End of input, the line stays idle */
+    }
+}
+
+static bool lSERCOM5_USART_SIM_RxPushByte(uint8_t rdByte)
+{
+    uint32_t tempInIndex;
+
+    tempInIndex = sercom5USARTObj.rdInIndex + 1U;
+
+    if (tempInIndex >= sercom5USARTObj.rdBufferSize)
+    {
+        tempInIndex = 0U;
+    }
+
+    if (tempInIndex == sercom5USARTObj.rdOutIndex)
+    {
+        if (sercom5USARTObj.rdCallback != NULL)
+        {
+            sercom5USARTObj.rdCallback(SERCOM_USART_EVENT_READ_BUFFER_FULL, sercom5USARTObj.rdContext);
+
+            tempInIndex = sercom5USARTObj.rdInIndex + 1U;
+
+            if (tempInIndex >= sercom5USARTObj.rdBufferSize)
+            {
+                tempInIndex = 0U;
+            }
+        }
+    }
+
+    if (tempInIndex == sercom5USARTObj.rdOutIndex)
+    {
+        /* Queue is full. Data will be lost. */
+        return false;
+    }
+
+    SERCOM5_USART_ReadBuffer[sercom5USARTObj.rdInIndex] = rdByte;
+    sercom5USARTObj.rdInIndex = tempInIndex;
+
+    return true;
+}
+
+static void lSERCOM5_USART_SIM_ReadNotificationSend(void)
+{
+    size_t nUnreadBytesAvailable;
+
+    if ((sercom5USARTObj.isRdNotificationEnabled == true) && (sercom5USARTObj.rdCallback != NULL))
+    {
+        nUnreadBytesAvailable = SERCOM5_USART_ReadCountGet();
+
+        if (((sercom5USARTObj.isRdNotifyPersistently == true) && (nUnreadBytesAvailable >= sercom5USARTObj.rdThreshold)) ||
+            (nUnreadBytesAvailable == sercom5USARTObj.rdThreshold))
+        {
+            sercom5USARTObj.rdCallback(SERCOM_USART_EVENT_READ_THRESHOLD_REACHED, sercom5USARTObj.rdContext);
+        }
+    }
+}
+
+static void lSERCOM5_USART_SIM_WriteNotificationSend(void)
+{
+    size_t nFreeWrBufferCount;
+
+    if ((sercom5USARTObj.isWrNotificationEnabled == true) && (sercom5USARTObj.wrCallback != NULL))
+    {
+        nFreeWrBufferCount = SERCOM5_USART_WriteFreeBufferCountGet();
+
+        if (((sercom5USARTObj.isWrNotifyPersistently == true) && (nFreeWrBufferCount >= sercom5USARTObj.wrThreshold)) ||
+            (nFreeWrBufferCount == sercom5USARTObj.wrThreshold))
+        {
+            sercom5USARTObj.wrCallback(SERCOM_USART_EVENT_WRITE_THRESHOLD_REACHED, sercom5USARTObj.wrContext);
+        }
+    }
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+void SERCOM5_USART_Initialize(void)
+{
+    SIM_EventCancel(&sercom5UsartSim.txEvent);
+
+    sercom5USARTObj.rdCallback = NULL;
+    sercom5USARTObj.rdInIndex = 0U;
+    sercom5USARTObj.rdOutIndex = 0U;
+    sercom5USARTObj.isRdNotificationEnabled = false;
+    sercom5USARTObj.isRdNotifyPersistently = false;
+    sercom5USARTObj.rdThreshold = 0U;
+    sercom5USARTObj.errorStatus = USART_ERROR_NONE;
+    sercom5USARTObj.wrCallback = NULL;
+    sercom5USARTObj.wrInIndex = 0U;
+    sercom5USARTObj.wrOutIndex = 0U;
+    sercom5USARTObj.isWrNotificationEnabled = false;
+    sercom5USARTObj.isWrNotifyPersistently = false;
+    sercom5USARTObj.wrThreshold = 0U;
+    sercom5USARTObj.rdBufferSize = SERCOM5_USART_READ_BUFFER_SIZE;
+    sercom5USARTObj.wrBufferSize = SERCOM5_USART_WRITE_BUFFER_SIZE;
+
+    sercom5UsartSim.baud = SERCOM5_USART_SIM_BAUD;
+    sercom5UsartSim.txSize = 0U;
+    sercom5UsartSim.txDone = false;
+    sercom5UsartSim.rxReady = false;
+
+    if (sercom5UsartSim.rxFd >= 0)
+    {
+        SIM_EventSchedule(&sercom5UsartSim.rxEvent, SIM_Now(), lSERCOM5_USART_SIM_Receive, 0U);
+    }
+}
+
+uint32_t SERCOM5_USART_FrequencyGet(void)
+{
+    return 60000000UL;
+}
+
+bool SERCOM5_USART_SerialSetup(USART_SERIAL_SETUP * serialSetup, uint32_t clkFrequency)
+{
+    /* Parity and stop bits only change the character time a little */
+    if ((serialSetup == NULL) || (serialSetup->baudRate == 0U) || (serialSetup->dataWidth != USART_DATA_8_BIT))
+    {
+        return false;
+    }
+
+    sercom5UsartSim.baud = serialSetup->baudRate;
+
+    return true;
+}
+
+void SERCOM5_USART_Enable(void)
+{
+}
+
+void SERCOM5_USART_Disable(void)
+{
+}
+
+USART_ERROR SERCOM5_USART_ErrorGet(void)
+{
+    USART_ERROR errorStatus = sercom5USARTObj.errorStatus;
+
+    sercom5USARTObj.errorStatus = USART_ERROR_NONE;
+
+    return errorStatus;
+}
+
+size_t SERCOM5_USART_Read(uint8_t* pRdBuffer, const size_t size)
+{
+    size_t nBytesRead = 0U;
+    uint32_t rdOutIndex = sercom5USARTObj.rdOutIndex;
+    uint32_t rdInIndex = sercom5USARTObj.rdInIndex;
+
+    while ((nBytesRead < size) && (rdOutIndex != rdInIndex))
+    {
+        pRdBuffer[nBytesRead] = SERCOM5_USART_ReadBuffer[rdOutIndex];
+        nBytesRead++;
+        rdOutIndex++;
+
+        if (rdOutIndex >= sercom5USARTObj.rdBufferSize)
+        {
+            rdOutIndex = 0U;
+        }
+    }
+
+    sercom5USARTObj.rdOutIndex = rdOutIndex;
+
+    return nBytesRead;
+}
+
+size_t SERCOM5_USART_ReadCountGet(void)
+{
+    uint32_t rdOutIndex = sercom5USARTObj.rdOutIndex;
+    uint32_t rdInIndex = sercom5USARTObj.rdInIndex;
+
+    if (rdInIndex >= rdOutIndex)
+    {
+        return rdInIndex - rdOutIndex;
+    }
+
+    return (sercom5USARTObj.rdBufferSize - rdOutIndex) + rdInIndex;
+}
+
+size_t SERCOM5_USART_ReadFreeBufferCountGet(void)
+{
+    return (sercom5USARTObj.rdBufferSize - 1U) - SERCOM5_USART_ReadCountGet();
+}
+
+size_t SERCOM5_USART_ReadBufferSizeGet(void)
+{
+    return (sercom5USARTObj.rdBufferSize - 1U);
+}
+
+bool SERCOM5_USART_ReadNotificationEnable(bool isEnabled, bool isPersistent)
+{
+    bool previousStatus = sercom5USARTObj.isRdNotificationEnabled;
+
+    sercom5USARTObj.isRdNotificationEnabled = isEnabled;
+    sercom5USARTObj.isRdNotifyPersistently = isPersistent;
+
+    return previousStatus;
+}
+
+void SERCOM5_USART_ReadThresholdSet(uint32_t nBytesThreshold)
+{
+    if (nBytesThreshold > 0U)
+    {
+        sercom5USARTObj.rdThreshold = nBytesThreshold;
+    }
+}
+
+void SERCOM5_USART_ReadCallbackRegister(SERCOM_USART_RING_BUFFER_CALLBACK callback, uintptr_t context)
+{
+    sercom5USARTObj.rdCallback = callback;
+    sercom5USARTObj.rdContext = context;
+}
+
+bool SERCOM5_USART_TransmitComplete(void)
+{
+    return (sercom5UsartSim.txSize == 0U) && (SERCOM5_USART_WriteCountGet() == 0U);
+}
+
+size_t SERCOM5_USART_Write(uint8_t* pWrBuffer, const size_t size)
+{
+    size_t nBytesWritten = 0U;
+    uint32_t tempInIndex;
+
+    while (nBytesWritten < size)
+    {
+        tempInIndex = sercom5USARTObj.wrInIndex + 1U;
+
+        if (tempInIndex >= sercom5USARTObj.wrBufferSize)
+        {
+            tempInIndex = 0U;
+        }
+        if (tempInIndex == sercom5USARTObj.wrOutIndex)
+        {
+            /* Queue is full, exit the loop */
+            break;
+        }
+
+        SERCOM5_USART_WriteBuffer[sercom5USARTObj.wrInIndex] = pWrBuffer[nBytesWritten];
+        sercom5USARTObj.wrInIndex = tempInIndex;
+        nBytesWritten++;
+    }
+
+    SIM_CPU_Enter();
+    lSERCOM5_USART_SIM_TxStart();
+    SIM_CPU_Leave();
+
+    return nBytesWritten;
+}
+
+size_t SERCOM5_USART_WriteCountGet(void)
+{
+    uint32_t wrInIndex = sercom5USARTObj.wrInIndex;
+    uint32_t wrOutIndex = sercom5USARTObj.wrOutIndex;
+
+    if (wrInIndex >= wrOutIndex)
+    {
+        return wrInIndex - wrOutIndex;
+    }
+
+    return (sercom5USARTObj.wrBufferSize - wrOutIndex) + wrInIndex;
+}
+
+size_t SERCOM5_USART_WriteFreeBufferCountGet(void)
+{
+    return (sercom5USARTObj.wrBufferSize - 1U) - SERCOM5_USART_WriteCountGet();
+}
+
+size_t SERCOM5_USART_WriteBufferSizeGet(void)
+{
+    return (sercom5USARTObj.wrBufferSize - 1U);
+}
+
+bool SERCOM5_USART_WriteNotificationEnable(bool isEnabled, bool isPersistent)
+{
+    bool previousStatus = sercom5USARTObj.isWrNotificationEnabled;
+
+    sercom5USARTObj.isWrNotificationEnabled = isEnabled;
+    sercom5USARTObj.isWrNotifyPersistently = isPersistent;
+
+    return previousStatus;
+}
+
+void SERCOM5_USART_WriteThresholdSet(uint32_t nBytesThreshold)
+{
+    if (nBytesThreshold > 0U)
+    {
+        sercom5USARTObj.wrThreshold = nBytesThreshold;
+    }
+}
+
+void SERCOM5_USART_WriteCallbackRegister(SERCOM_USART_RING_BUFFER_CALLBACK callback, uintptr_t context)
+{
+    sercom5USARTObj.wrCallback = callback;
+    sercom5USARTObj.wrContext = context;
+}
+
+void SERCOM5_USART_InterruptHandler(void)
+{
+    uint32_t wrOutIndex;
+    bool txDone;
+    bool rxReady;
+    uint8_t rxData;
+
+    SIM_CPU_Enter();
+    txDone = sercom5UsartSim.txDone;
+    rxReady = sercom5UsartSim.rxReady;
+    rxData = sercom5UsartSim.rxData;
+    sercom5UsartSim.txDone = false;
+    sercom5UsartSim.rxReady = false;
+    SIM_CPU_Leave();
+
+    if (txDone)
+    {
+        lSERCOM5_USART_SIM_HostWrite(&SERCOM5_USART_WriteBuffer[sercom5USARTObj.wrOutIndex], sercom5UsartSim.txSize);
+
+        wrOutIndex = sercom5USARTObj.wrOutIndex + sercom5UsartSim.txSize;
+        if (wrOutIndex >= sercom5USARTObj.wrBufferSize)
+        {
+            wrOutIndex = 0U;
+        }
+        sercom5USARTObj.wrOutIndex = wrOutIndex;
+        sercom5UsartSim.txSize = 0U;
+
+        if (wrOutIndex == sercom5USARTObj.wrInIndex)
+        {
+            SYS_TRACE_HOOK(UART_DRAINED, 0U);
+        }
+
+        lSERCOM5_USART_SIM_WriteNotificationSend();
+
+        SIM_CPU_Enter();
+        lSERCOM5_USART_SIM_TxStart();
+        SIM_CPU_Leave();
+    }
+
+    if (rxReady && lSERCOM5_USART_SIM_RxPushByte(rxData))
+    {
+        lSERCOM5_USART_SIM_ReadNotificationSend();
+    }
+}
+
+void SERCOM5_USART_SIM_Attach(int rxFd, int txFd)
+{
+    sercom5UsartSim.rxFd = rxFd;
+    sercom5UsartSim.txFd = txFd;
+    sercom5UsartSim.rxEof = (rxFd < 0);
+    sercom5UsartSim.rxHostIndex = 0U;
+    sercom5UsartSim.rxHostCount = 0U;
+
+    /* Before SERCOM5_USART_Initialize it schedules the first poll itself */
+    if (rxFd >= 0)
+    {
+        SIM_EventSchedule(&sercom5UsartSim.rxEvent, SIM_Now(), lSERCOM5_USART_SIM_Receive, 0U);
+    }
+    else
+    {
+        SIM_EventCancel(&sercom5UsartSim.rxEvent);
+    }
+}
+
+bool SERCOM5_USART_SIM_RxEnded(void)
+{
+    return sercom5UsartSim.rxEof && (sercom5UsartSim.rxHostIndex == sercom5UsartSim.rxHostCount) &&
+           !sercom5UsartSim.rxReady;
+}
+
+void SERCOM5_USART_SIM_Flush(void)
+{
+    uint32_t wrInIndex = sercom5USARTObj.wrInIndex;
+    uint32_t wrOutIndex = sercom5USARTObj.wrOutIndex;
+
+    SIM_EventCancel(&sercom5UsartSim.txEvent);
+
+    if (wrOutIndex > wrInIndex)
+    {
+        lSERCOM5_USART_SIM_HostWrite(&SERCOM5_USART_WriteBuffer[wrOutIndex], sercom5USARTObj.wrBufferSize - wrOutIndex);
+        wrOutIndex = 0U;
+    }
+    lSERCOM5_USART_SIM_HostWrite(&SERCOM5_USART_WriteBuffer[wrOutIndex], wrInIndex - wrOutIndex);
+
+    sercom5USARTObj.wrOutIndex = wrInIndex;
+    sercom5UsartSim.txSize = 0U;
+    sercom5UsartSim.txDone = false;
+}
+
+void SERCOM5_USART_SIM_DataTransmit(uint8_t data)
+{
+    lSERCOM5_USART_SIM_HostWrite(&data, 1U);
+}
+
+uint64_t SERCOM5_USART_SIM_TransferTime(size_t size)
+{
+    return lSERCOM5_USART_SIM_CharTime(size);
+}
+
+/*******************************************************************************
+ End of File
+ */
@@ -0,0 +1,132 @@
+/*******************************************************************************
+  Simulated PLIB Extensions Header File
+
+  File Name:
+    plib_sim.h
+
+  Summary:
+    Simulation side functions of the simulated PLIBs.
+
+  Description:
+    The simulated PLIBs implement the Harmony PLIB headers unchanged. The
+    functions here are what the other models and the host use to connect
+    to them: the wires between peripherals (DMAC to SERCOM1 DATA, the
+    MCP3564 IRQ pin to EXTINT 14, EVSYS to the DMAC) and the host side of
+    the console UART.
+*******************************************************************************/
+
+#ifndef _PLIB_SIM_H
+#define _PLIB_SIM_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: SERCOM1 SPI
+// *****************************************************************************
+// *****************************************************************************
+
+/* One character through the DATA register, as a DMAC beat moves it */
+uint8_t SERCOM1_SPI_SIM_DataExchange ( uint8_t data );
+
+/* Time size characters take at the current SCK frequency */
+uint64_t SERCOM1_SPI_SIM_TransferTime ( size_t size );
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: EIC
+// *****************************************************************************
+// *****************************************************************************
+
+/*******************************************************************************
+  Function:
+    bool EIC_SIM_PinSet ( uint32_t pin, bool level )
+
+  Summary:
+    Drives an EXTINT input.
+
+  Description:
+    Detects the edge or level of the pin's CONFIG sense, sets its flag and
+    pends the EXTINT interrupt when it is enabled. Returns true when the
+    pin produced an event, which EVSYS routes to its users (the TC0 stamp).
+*/
+
+bool EIC_SIM_PinSet ( uint32_t pin, bool level );
+
+/* Write-one-to-clear of INTFLAG, folded from the register block */
+void EIC_SIM_FlagClear ( uint32_t mask );
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: DMAC
+// *****************************************************************************
+// *****************************************************************************
+
+/*******************************************************************************
+  Function:
+    void DMAC_SIM_EventTrigger ( uint32_t channel )
+
+  Summary:
+    Event input of a DMAC channel, from EVSYS (sim_soc.c).
+
+  Description:
+    With CHEVCTRL EVIE and EVACT TRIG set and a linked descriptor list
+    running, starts one beat of the channel; otherwise ignored.
+*/
+
+void DMAC_SIM_EventTrigger ( uint32_t channel );
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: SERCOM5 USART
+// *****************************************************************************
+// *****************************************************************************
+
+/*******************************************************************************
+  Function:
+    void SERCOM5_USART_SIM_Attach ( int rxFd, int txFd )
+
+  Summary:
+    Connects RX and TX of the console UART to host file descriptors.
+
+  Description:
+    Characters are taken from rxFd and written to txFd at the baud rate of
+    SERCOM5. rxFd is polled without blocking, -1 leaves RX idle. It can be
+    called again at any time to switch to other descriptors.
+*/
+
+void SERCOM5_USART_SIM_Attach ( int rxFd, int txFd );
+
+/* rxFd reached end of file and every character of it was received */
+bool SERCOM5_USART_SIM_RxEnded ( void );
+
+/* Writes what is still in the TX ring buffer to txFd at once */
+void SERCOM5_USART_SIM_Flush ( void );
+
+/* One character a DMAC beat moved into DATA, onto the line (txFd) */
+void SERCOM5_USART_SIM_DataTransmit ( uint8_t data );
+
+/* Time size characters take on the line */
+uint64_t SERCOM5_USART_SIM_TransferTime ( size_t size );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _PLIB_SIM_H */
+
+/*******************************************************************************
+ End of File
+ */
@@ -0,0 +1,138 @@
+/*******************************************************************************
+  Simulation Core Source File
+
+  File Name:
+    sim_core.c
+
+  Summary:
+    Virtual time base and event queue of the host simulation.
+
+  Description:
+    The queue is a singly linked list sorted by time, equal times in
+    scheduling order. A handful of events is pending at any time (one per
+    model), so the linear insert is cheaper than anything cleverer.
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stddef.h>
+#include "sim_core.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data
+// *****************************************************************************
+// *****************************************************************************
+
+static uint64_t simNow;
+static SIM_EVENT* simQueue;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+void SIM_Initialize(void)
+{
+    while (simQueue != NULL)
+    {
+        SIM_EventCancel(simQueue);
+    }
+
+    simNow = 0U;
+}
+
+uint64_t SIM_Now(void)
+{
+    return simNow;
+}
+
+void SIM_EventSchedule(SIM_EVENT* event, uint64_t time, SIM_EVENT_HANDLER handler, uintptr_t context)
+{
+    SIM_EVENT** link = &simQueue;
+
+    SIM_EventCancel(event);
+
+    /* Nothing runs in the past */
+    event->time = (time < simNow) ? simNow : time;
+    event->handler = handler;
+    event->context = context;
+
+    while ((*link != NULL) && ((*link)->time <= event->time))
+    {
+        link = &(*link)->next;
+    }
+
+    event->next = *link;
+    *link = event;
+    event->queued = true;
+}
+
+void SIM_EventCancel(SIM_EVENT* event)
+{
+    SIM_EVENT** link = &simQueue;
+
+    if (!event->queued)
+    {
+        return;
+    }
+
+    while (*link != event)
+    {
+        link = &(*link)->next;
+    }
+
+    *link = event->next;
+    event->next = NULL;
+    event->queued = false;
+}
+
+bool SIM_Step(void)
+{
+    SIM_EVENT* event = simQueue;
+
+    if (event == NULL)
+    {
+        return false;
+    }
+
+    simQueue = event->next;
+    event->next = NULL;
+    event->queued = false;
+
+    simNow = event->time;
+    event->handler(event->context);
+
+    return true;
+}
+
+bool SIM_StepUntil(uint64_t time)
+{
+    if ((simQueue == NULL) || (simQueue->time > time))
+    {
+        return false;
+    }
+
+    return SIM_Step();
+}
+
+void SIM_RunUntil(uint64_t time)
+{
+    while (SIM_StepUntil(time))
+    {
+    }
+
+    if (time > simNow)
+    {
+        simNow = time;
+    }
+}
+
+/*******************************************************************************
+ End of File
+ */
@@ -0,0 +1,117 @@
+/*******************************************************************************
+  Simulation Core Header File
+
+  File Name:
+    sim_core.h
+
+  Summary:
+    Virtual time base and event queue of the host simulation.
+
+  Description:
+    Time is a 64 bit nanosecond count which only moves when an event is
+    run. Models schedule events (a conversion ending, an SPI transfer
+    completing) at absolute times; the queue runs them in time order, and
+    in scheduling order for equal times, so a run is fully deterministic.
+
+    Code which polls a peripheral (while (SERCOM1_SPI_IsBusy())) calls
+    SIM_Step from the polled function, which lets time pass exactly as far
+    as the next thing that can change the answer.
+*******************************************************************************/
+
+#ifndef _SIM_CORE_H
+#define _SIM_CORE_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Constants
+// *****************************************************************************
+// *****************************************************************************
+
+#define SIM_NS_PER_S                        1000000000ULL
+
+/* Duration of count periods of a frequencyHz clock, rounded up */
+#define SIM_PERIODS_NS(count, frequencyHz)  ((((uint64_t) (count) * SIM_NS_PER_S) + (frequencyHz) - 1U) / (frequencyHz))
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Type Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+typedef void (*SIM_EVENT_HANDLER)(uintptr_t context);
+
+// *****************************************************************************
+/* Scheduled event
+
+  Remarks:
+    Owned by the model which schedules it, usually a static member of the
+    model object. Scheduling an event which is already queued moves it.
+*/
+
+typedef struct SIM_EVENT
+{
+    uint64_t time;
+    SIM_EVENT_HANDLER handler;
+    uintptr_t context;
+    bool queued;
+    struct SIM_EVENT* next;
+
+} SIM_EVENT;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+/* Empties the queue and sets the time back to 0 */
+void SIM_Initialize ( void );
+
+uint64_t SIM_Now ( void );
+
+void SIM_EventSchedule ( SIM_EVENT* event, uint64_t time, SIM_EVENT_HANDLER handler, uintptr_t context );
+
+void SIM_EventCancel ( SIM_EVENT* event );
+
+/*******************************************************************************
+  Function:
+    bool SIM_Step ( void )
+
+  Summary:
+    Advances the time to the earliest queued event and runs it.
+
+  Remarks:
+    Returns false, without moving the time, when nothing is queued. The
+    handler may schedule further events, including at the current time.
+*/
+
+bool SIM_Step ( void );
+
+/* As SIM_Step, but false when the earliest event is later than time */
+bool SIM_StepUntil ( uint64_t time );
+
+/* Runs every event up to time, then leaves the time at time */
+void SIM_RunUntil ( uint64_t time );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _SIM_CORE_H */
+
+/*******************************************************************************
+ End of File
+ */
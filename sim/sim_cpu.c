@@ -0,0 +1,460 @@
+/*******************************************************************************
+  Simulated Processor Core Source File
+
+  File Name:
+    sim_cpu.c
+
+  Summary:
+    NVIC, PRIMASK, WFI and the cycle counter of the host simulation.
+
+  Description:
+    The vector table holds the handlers interrupts.c installs for this
+    configuration. They are weak references, a handler which is not linked
+    in (the model library on its own has no RTC) leaves its vector empty.
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "device.h"
+#include "interrupts.h"
+#include "sim_core.h"
+#include "sim_cpu.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+/* Below every handler priority */
+#define SIM_CPU_THREAD_PRIORITY             0x100U
+
+#define SIM_CPU_NO_IRQ                      (-1)
+
+/* Exception number of peripheral interrupt 0 */
+#define SIM_CPU_IRQ_EXCEPTION_BASE          16U
+
+typedef void (*SIM_CPU_HANDLER)(void);
+
+typedef struct
+{
+    uint8_t enabled[SIM_CPU_IRQS];
+    uint8_t pending[SIM_CPU_IRQS];
+    uint8_t active[SIM_CPU_IRQS];
+    uint8_t priority[SIM_CPU_IRQS];
+    uint32_t pendingCount;
+
+    uint32_t primask;
+    uint32_t executionPriority;
+    uint32_t ipsr;
+
+    /* SIM_CPU_Enter nesting */
+    uint32_t depth;
+
+    uint32_t progress;
+    uint32_t interrupts;
+
+    SIM_CPU_SYNC sync[SIM_CPU_SYNC_MAX];
+    uint32_t syncCount;
+
+    /* Simulated time DWT->CYCCNT was last brought up to */
+    uint64_t cycleTime;
+
+} SIM_CPU_OBJ;
+
+#pragma weak RTC_InterruptHandler
+#pragma weak EIC_EXTINT_14_InterruptHandler
+#pragma weak DMAC_0_InterruptHandler
+#pragma weak DMAC_1_InterruptHandler
+#pragma weak DMAC_2_InterruptHandler
+#pragma weak SERCOM1_SPI_InterruptHandler
+#pragma weak SERCOM5_USART_InterruptHandler
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data
+// *****************************************************************************
+// *****************************************************************************
+
+SCB_Type simScb;
+DWT_Type simDwt;
+CoreDebug_Type simCoreDebug;
+
+volatile static SIM_CPU_OBJ simCpu;
+
+static const SIM_CPU_HANDLER simCpuVectors[SIM_CPU_IRQS] =
+{
+    [RTC_IRQn]              = RTC_InterruptHandler,
+    [EIC_EXTINT_14_IRQn]    = EIC_EXTINT_14_InterruptHandler,
+    [DMAC_0_IRQn]           = DMAC_0_InterruptHandler,
+    [DMAC_1_IRQn]           = DMAC_1_InterruptHandler,
+    [DMAC_2_IRQn]           = DMAC_2_InterruptHandler,
+    [SERCOM1_0_IRQn]        = SERCOM1_SPI_InterruptHandler,
+    [SERCOM1_1_IRQn]        = SERCOM1_SPI_InterruptHandler,
+    [SERCOM1_2_IRQn]        = SERCOM1_SPI_InterruptHandler,
+    [SERCOM1_OTHER_IRQn]    = SERCOM1_SPI_InterruptHandler,
+    [SERCOM5_0_IRQn]        = SERCOM5_USART_InterruptHandler,
+    [SERCOM5_1_IRQn]        = SERCOM5_USART_InterruptHandler,
+    [SERCOM5_2_IRQn]        = SERCOM5_USART_InterruptHandler,
+    [SERCOM5_OTHER_IRQn]    = SERCOM5_USART_InterruptHandler,
+};
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+static inline bool lSIM_CPU_IrqValid(int32_t irq)
+{
+    return (irq >= 0) && ((uint32_t) irq < SIM_CPU_IRQS);
+}
+
+/* Highest priority source which would preempt the running code, PRIMASK aside */
+static int32_t lSIM_CPU_Next(void)
+{
+    int32_t best = SIM_CPU_NO_IRQ;
+    uint32_t bestPriority = simCpu.executionPriority;
+    uint32_t irq;
+
+    if (simCpu.pendingCount == 0U)
+    {
+        return SIM_CPU_NO_IRQ;
+    }
+
+    for (irq = 0U; irq < SIM_CPU_IRQS; irq++)
+    {
+        if ((simCpu.pending[irq] != 0U) && (simCpu.enabled[irq] != 0U) && (simCpu.priority[irq] < bestPriority))
+        {
+            best = (int32_t) irq;
+            bestPriority = simCpu.priority[irq];
+        }
+    }
+
+    return best;
+}
+
+static void lSIM_CPU_Sync(void)
+{
+    uint32_t i;
+
+    for (i = 0U; i < simCpu.syncCount; i++)
+    {
+        simCpu.sync[i]();
+    }
+
+    SIM_CPU_CycleCountUpdate();
+}
+
+/*******************************************************************************
+  Takes pending interrupts until none can preempt the running code. The
+  selection runs entered so that a stall poll (sim_host.c) arriving in the
+  middle cannot take the same source twice.
+*/
+
+static void lSIM_CPU_Dispatch(void)
+{
+    int32_t irq;
+    uint32_t savedPriority;
+    uint32_t savedIpsr;
+
+    while (true)
+    {
+        simCpu.depth++;
+
+        irq = (simCpu.primask == 0U) ? lSIM_CPU_Next() : SIM_CPU_NO_IRQ;
+        if (irq == SIM_CPU_NO_IRQ)
+        {
+            simCpu.depth--;
+            break;
+        }
+
+        simCpu.pending[irq] = 0U;
+        simCpu.pendingCount--;
+        simCpu.active[irq] = 1U;
+        savedPriority = simCpu.executionPriority;
+        savedIpsr = simCpu.ipsr;
+        simCpu.executionPriority = simCpu.priority[irq];
+        simCpu.ipsr = (uint32_t) irq + SIM_CPU_IRQ_EXCEPTION_BASE;
+        simCpu.interrupts++;
+
+        simCpu.depth--;
+
+        if (simCpuVectors[irq] != NULL)
+        {
+            simCpuVectors[irq]();
+        }
+
+        simCpu.depth++;
+        simCpu.active[irq] = 0U;
+        simCpu.executionPriority = savedPriority;
+        simCpu.ipsr = savedIpsr;
+        simCpu.depth--;
+    }
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+void SIM_CPU_Initialize(void)
+{
+    uint32_t irq;
+
+    for (irq = 0U; irq < SIM_CPU_IRQS; irq++)
+    {
+        simCpu.enabled[irq] = 0U;
+        simCpu.pending[irq] = 0U;
+        simCpu.active[irq] = 0U;
+        simCpu.priority[irq] = 0U;
+    }
+
+    simCpu.pendingCount = 0U;
+    simCpu.primask = 0U;
+    simCpu.executionPriority = SIM_CPU_THREAD_PRIORITY;
+    simCpu.ipsr = 0U;
+    simCpu.depth = 0U;
+    simCpu.progress = 0U;
+    simCpu.interrupts = 0U;
+    simCpu.syncCount = 0U;
+    simCpu.cycleTime = SIM_Now();
+}
+
+void SIM_CPU_SyncRegister(SIM_CPU_SYNC sync)
+{
+    if (simCpu.syncCount < SIM_CPU_SYNC_MAX)
+    {
+        simCpu.sync[simCpu.syncCount] = sync;
+        simCpu.syncCount++;
+    }
+}
+
+void SIM_CPU_Enter(void)
+{
+    simCpu.depth++;
+
+    if (simCpu.depth == 1U)
+    {
+        lSIM_CPU_Sync();
+    }
+}
+
+void SIM_CPU_Leave(void)
+{
+    if (simCpu.depth == 1U)
+    {
+        lSIM_CPU_Sync();
+    }
+
+    simCpu.depth--;
+
+    if (simCpu.depth == 0U)
+    {
+        lSIM_CPU_Dispatch();
+    }
+}
+
+bool SIM_CPU_IsEntered(void)
+{
+    return simCpu.depth != 0U;
+}
+
+void SIM_CPU_Poll(void)
+{
+    SIM_CPU_Enter();
+
+    if (SIM_Step())
+    {
+        simCpu.progress++;
+    }
+
+    SIM_CPU_Leave();
+}
+
+void SIM_CPU_Run(uint64_t duration)
+{
+    uint64_t end = SIM_Now() + duration;
+    bool stepped;
+
+    /* One event per entry: its interrupts are taken at the time it ran */
+    do
+    {
+        SIM_CPU_Enter();
+
+        stepped = SIM_StepUntil(end);
+        if (!stepped)
+        {
+            SIM_RunUntil(end);
+        }
+        simCpu.progress++;
+
+        SIM_CPU_Leave();
+    } while (stepped);
+}
+
+uint32_t SIM_CPU_ProgressGet(void)
+{
+    return simCpu.progress;
+}
+
+uint32_t SIM_CPU_InterruptCountGet(void)
+{
+    return simCpu.interrupts;
+}
+
+void SIM_CPU_IrqEnable(int32_t irq)
+{
+    if (!lSIM_CPU_IrqValid(irq))
+    {
+        return;
+    }
+
+    simCpu.enabled[irq] = 1U;
+
+    if ((simCpu.depth == 0U) && (simCpu.pending[irq] != 0U))
+    {
+        lSIM_CPU_Dispatch();
+    }
+}
+
+void SIM_CPU_IrqDisable(int32_t irq)
+{
+    if (lSIM_CPU_IrqValid(irq))
+    {
+        simCpu.enabled[irq] = 0U;
+    }
+}
+
+bool SIM_CPU_IrqIsEnabled(int32_t irq)
+{
+    return lSIM_CPU_IrqValid(irq) && (simCpu.enabled[irq] != 0U);
+}
+
+void SIM_CPU_IrqPend(int32_t irq)
+{
+    if (!lSIM_CPU_IrqValid(irq))
+    {
+        return;
+    }
+
+    simCpu.depth++;
+    if (simCpu.pending[irq] == 0U)
+    {
+        simCpu.pending[irq] = 1U;
+        simCpu.pendingCount++;
+    }
+    simCpu.depth--;
+
+    if (simCpu.depth == 0U)
+    {
+        lSIM_CPU_Dispatch();
+    }
+}
+
+void SIM_CPU_IrqUnpend(int32_t irq)
+{
+    if (!lSIM_CPU_IrqValid(irq))
+    {
+        return;
+    }
+
+    simCpu.depth++;
+    if (simCpu.pending[irq] != 0U)
+    {
+        simCpu.pending[irq] = 0U;
+        simCpu.pendingCount--;
+    }
+    simCpu.depth--;
+}
+
+bool SIM_CPU_IrqIsPending(int32_t irq)
+{
+    return lSIM_CPU_IrqValid(irq) && (simCpu.pending[irq] != 0U);
+}
+
+bool SIM_CPU_IrqIsActive(int32_t irq)
+{
+    return lSIM_CPU_IrqValid(irq) && (simCpu.active[irq] != 0U);
+}
+
+void SIM_CPU_IrqPrioritySet(int32_t irq, uint32_t priority)
+{
+    if (lSIM_CPU_IrqValid(irq))
+    {
+        simCpu.priority[irq] = (uint8_t) (priority & ((1UL << SIM_CPU_PRIO_BITS) - 1U));
+    }
+}
+
+uint32_t SIM_CPU_IrqPriorityGet(int32_t irq)
+{
+    return lSIM_CPU_IrqValid(irq) ? simCpu.priority[irq] : 0U;
+}
+
+void SIM_CPU_PrimaskSet(uint32_t primask)
+{
+    simCpu.primask = primask;
+
+    if ((primask == 0U) && (simCpu.depth == 0U) && (simCpu.pendingCount != 0U))
+    {
+        lSIM_CPU_Dispatch();
+    }
+}
+
+uint32_t SIM_CPU_PrimaskGet(void)
+{
+    return simCpu.primask;
+}
+
+uint32_t SIM_CPU_IpsrGet(void)
+{
+    return simCpu.ipsr;
+}
+
+void SIM_CPU_WaitForInterrupt(void)
+{
+    SIM_CPU_Enter();
+
+    /* PRIMASK does not keep the core asleep, it only keeps it from taking the interrupt */
+    while (lSIM_CPU_Next() == SIM_CPU_NO_IRQ)
+    {
+        if (!SIM_Step())
+        {
+            break;
+        }
+        simCpu.progress++;
+    }
+
+    SIM_CPU_Leave();
+}
+
+void SIM_CPU_SystemReset(void)
+{
+    (void) fflush(stdout);
+    (void) fprintf(stderr, "sim: NVIC_SystemReset at %llu ns\n", (unsigned long long) SIM_Now());
+    exit(EXIT_SUCCESS);
+}
+
+void SIM_CPU_CycleCountUpdate(void)
+{
+    uint64_t now = SIM_Now();
+
+    if ((simDwt.CTRL & DWT_CTRL_CYCCNTENA_Msk) != 0U)
+    {
+        simDwt.CYCCNT += (uint32_t) (((now * (SIM_CPU_CLOCK_HZ / 1000000U)) / 1000U) -
+                                     ((simCpu.cycleTime * (SIM_CPU_CLOCK_HZ / 1000000U)) / 1000U));
+    }
+
+    simCpu.cycleTime = now;
+}
+
+/*******************************************************************************
+ End of File
+ */
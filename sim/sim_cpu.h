@@ -0,0 +1,182 @@
+/*******************************************************************************
+  Simulated Processor Core Header File
+
+  File Name:
+    sim_cpu.h
+
+  Summary:
+    NVIC, PRIMASK, WFI and the cycle counter of the host simulation.
+
+  Description:
+    The firmware runs on one host thread. Interrupts are taken at defined
+    points instead of between any two instructions:
+
+      - when the simulation leaves a peripheral model (SIM_CPU_Leave),
+        which every simulated PLIB function and the main loop tick do
+      - when __enable_irq clears PRIMASK or NVIC_EnableIRQ enables a
+        pending source, as on the target
+      - in __WFI, which lets time run to the next interrupt
+      - from SIM_CPU_WaitForInterrupt, when the host notices the firmware
+        spinning on a flag without reaching any of the above (sim_host.c)
+
+    Between those points firmware code runs without interruption, so a run
+    is repeatable: the same input gives the same interrupt order at the same
+    simulated times. Priorities are honoured, a pending source only
+    preempts a handler of lower priority (higher number).
+
+    SIM_CPU_Enter/SIM_CPU_Leave bracket every access to simulation state.
+    They nest; the outermost pair runs the registered sync functions, which
+    fold firmware register writes into the models (port pins, write-one-to-
+    clear flags), so models see register writes in program order relative
+    to PLIB calls.
+
+    The host core_cm4.h maps the CMSIS NVIC and PRIMASK functions to the
+    functions below.
+*******************************************************************************/
+
+#ifndef _SIM_CPU_H
+#define _SIM_CPU_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Constants
+// *****************************************************************************
+// *****************************************************************************
+
+/* GCLK0 on the target, clocks the core and DWT->CYCCNT */
+#define SIM_CPU_CLOCK_HZ                    120000000U
+
+/* Peripheral interrupts of the SAM E51 */
+#define SIM_CPU_IRQS                        136U
+
+/* __NVIC_PRIO_BITS of the SAM E51 */
+#define SIM_CPU_PRIO_BITS                   3U
+
+#define SIM_CPU_SYNC_MAX                    4U
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Type Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+typedef void (*SIM_CPU_SYNC)(void);
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+/* Disables and clears every source, PRIMASK clear, thread mode */
+void SIM_CPU_Initialize ( void );
+
+/*******************************************************************************
+  Function:
+    void SIM_CPU_SyncRegister ( SIM_CPU_SYNC sync )
+
+  Summary:
+    Adds a function run on the outermost SIM_CPU_Enter and SIM_CPU_Leave.
+
+  Remarks:
+    Up to SIM_CPU_SYNC_MAX functions, run in registration order with the
+    simulation entered.
+*/
+
+void SIM_CPU_SyncRegister ( SIM_CPU_SYNC sync );
+
+void SIM_CPU_Enter ( void );
+
+/* Takes pending interrupts when leaving the outermost level */
+void SIM_CPU_Leave ( void );
+
+bool SIM_CPU_IsEntered ( void );
+
+/*******************************************************************************
+  Function:
+    void SIM_CPU_Poll ( void )
+
+  Summary:
+    Runs the next simulation event, for polled functions of a busy model.
+
+  Description:
+    A status function polled in a loop (while (SERCOM1_SPI_IsBusy())) calls
+    this when its answer can only change with time, the loop then ends at
+    the simulated time the peripheral would have finished.
+*/
+
+void SIM_CPU_Poll ( void );
+
+/* Lets time run for duration ns, the cost of one pass of the main loop */
+void SIM_CPU_Run ( uint64_t duration );
+
+/* Incremented whenever simulated time moved on behalf of the firmware */
+uint32_t SIM_CPU_ProgressGet ( void );
+
+/* Handlers run, for the curious */
+uint32_t SIM_CPU_InterruptCountGet ( void );
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: CMSIS Back End
+// *****************************************************************************
+// *****************************************************************************
+
+void SIM_CPU_IrqEnable ( int32_t irq );
+void SIM_CPU_IrqDisable ( int32_t irq );
+bool SIM_CPU_IrqIsEnabled ( int32_t irq );
+void SIM_CPU_IrqPend ( int32_t irq );
+void SIM_CPU_IrqUnpend ( int32_t irq );
+bool SIM_CPU_IrqIsPending ( int32_t irq );
+bool SIM_CPU_IrqIsActive ( int32_t irq );
+void SIM_CPU_IrqPrioritySet ( int32_t irq, uint32_t priority );
+uint32_t SIM_CPU_IrqPriorityGet ( int32_t irq );
+
+void SIM_CPU_PrimaskSet ( uint32_t primask );
+uint32_t SIM_CPU_PrimaskGet ( void );
+
+/* Exception number of the running handler, 0 in thread mode */
+uint32_t SIM_CPU_IpsrGet ( void );
+
+/*******************************************************************************
+  Function:
+    void SIM_CPU_WaitForInterrupt ( void )
+
+  Summary:
+    __WFI: lets time run until an enabled interrupt is pending.
+
+  Remarks:
+    Returns with the interrupt taken unless PRIMASK is set, as the core
+    does. Returns at once when nothing is scheduled which could wake it.
+*/
+
+void SIM_CPU_WaitForInterrupt ( void );
+
+/* NVIC_SystemReset: the simulation ends, exit status 0 */
+void SIM_CPU_SystemReset ( void ) __attribute__((noreturn));
+
+/* Cycle count DWT->CYCCNT would show at the current simulated time */
+void SIM_CPU_CycleCountUpdate ( void );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _SIM_CPU_H */
+
+/*******************************************************************************
+ End of File
+ */
@@ -0,0 +1,284 @@
+/*******************************************************************************
+  Simulation Host Source File
+
+  File Name:
+    sim_host.c
+
+  Summary:
+    Runs the firmware image as a Linux process.
+
+  Description:
+    Sets up the simulation before main() (a constructor, so main.c and
+    SYS_Initialize stay untouched) and hooks SYS_Tasks, which the image is
+    linked to wrap (-Wl,--wrap=SYS_Tasks):
+
+      - every pass of the main loop lets SIM_LOOP_NS ns of simulated time
+        pass before the real SYS_Tasks runs
+      - the console UART is stdin/stdout, raw when stdin is a terminal, or
+        with SIM_CONSOLE=pty a new pseudo terminal whose name is printed
+        on stderr (connect a terminal program or adcrecv to it)
+      - at the end of piped input the firmware keeps running until the
+        application has no ADC command running or queued (APP_IsBusy),
+        then SIM_LINGER_MS ms of simulated time more, and the process
+        exits; a command still busy, or one that has not returned to the
+        main loop, after 60 s of simulated time ends it as well
+
+    A real time timer notices firmware spinning on a flag without calling
+    into the simulation (no time passes, no progress for 100 us of host
+    time) and treats the loop as a WFI: time runs to the next interrupt,
+    which is what such a loop waits for.
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#define _GNU_SOURCE
+
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <termios.h>
+#include <unistd.h>
+#include "sim_core.h"
+#include "sim_cpu.h"
+#include "sim_soc.h"
+#include "plib_sim.h"
+#include "mcp3564_sim.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+#define SIM_HOST_LOOP_NS_DEFAULT            2000U
+#define SIM_HOST_LINGER_MS_DEFAULT          100U
+
+/* Host time without progress before the stall poll steps the simulation */
+#define SIM_HOST_STALL_US                   100
+
+/* After the end of input, simulated time busy in one command which ends the run */
+#define SIM_HOST_HUNG_NS                    (60ULL * SIM_NS_PER_S)
+
+typedef struct
+{
+    uint64_t loopNs;
+    uint64_t lingerNs;
+    uint64_t endTime;
+    uint64_t loopTime;
+    uint64_t busyTime;
+    bool ending;
+    bool busy;
+    bool termiosSaved;
+    struct termios termios;
+    int ptySlaveFd;
+    uint32_t stallProgress;
+
+} SIM_HOST_OBJ;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data
+// *****************************************************************************
+// *****************************************************************************
+
+static SIM_HOST_OBJ simHost = { .ptySlaveFd = -1 };
+
+void __real_SYS_Tasks(void);
+bool APP_IsBusy(void);
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+static uint64_t lSIM_HOST_EnvGet(const char* name, uint64_t defaultValue)
+{
+    const char* value = getenv(name);
+    char* end;
+    unsigned long long n;
+
+    if ((value == NULL) || (*value == '\0'))
+    {
+        return defaultValue;
+    }
+
+    n = strtoull(value, &end, 0);
+
+    return (*end == '\0') ? (uint64_t) n : defaultValue;
+}
+
+static void lSIM_HOST_TermiosRestore(void)
+{
+    if (simHost.termiosSaved)
+    {
+        (void) tcsetattr(STDIN_FILENO, TCSANOW, &simHost.termios);
+    }
+}
+
+static void lSIM_HOST_Exit(void)
+{
+    (void) signal(SIGALRM, SIG_IGN);
+    SERCOM5_USART_SIM_Flush();
+    exit(EXIT_SUCCESS);
+}
+
+static void lSIM_HOST_EndCheck(void)
+{
+    uint64_t now = SIM_Now();
+    bool busy = APP_IsBusy();
+
+    /* The linger, or the hung limit, counts from the later of the end of
+     * input and the last change between busy and idle */
+    if (busy != simHost.busy)
+    {
+        simHost.busy = busy;
+        simHost.busyTime = now;
+    }
+    if (!simHost.ending && SERCOM5_USART_SIM_RxEnded())
+    {
+        simHost.ending = true;
+        simHost.endTime = now;
+    }
+    if (!simHost.ending)
+    {
+        return;
+    }
+
+    if ((now - ((simHost.busyTime > simHost.endTime) ? simHost.busyTime : simHost.endTime)) >=
+        (busy ? SIM_HOST_HUNG_NS : simHost.lingerNs))
+    {
+        lSIM_HOST_Exit();
+    }
+}
+
+static void lSIM_HOST_Stall(int signal)
+{
+    int savedErrno = errno;
+    uint32_t progress = SIM_CPU_ProgressGet();
+
+    /* A handler which takes long on the host is not waiting: WFI there
+       would find nothing able to preempt it and never return */
+    if ((progress == simHost.stallProgress) && !SIM_CPU_IsEntered() && (SIM_CPU_IpsrGet() == 0U))
+    {
+        SIM_CPU_WaitForInterrupt();
+
+        /* A command which never returns to the main loop */
+        if (simHost.ending && ((SIM_Now() - simHost.loopTime) >= SIM_HOST_HUNG_NS))
+        {
+            lSIM_HOST_Exit();
+        }
+    }
+    simHost.stallProgress = SIM_CPU_ProgressGet();
+
+    errno = savedErrno;
+}
+
+static int lSIM_HOST_PtyOpen(void)
+{
+    struct termios tio;
+    int master;
+
+    master = posix_openpt(O_RDWR | O_NOCTTY);
+    if ((master < 0) || (grantpt(master) != 0) || (unlockpt(master) != 0))
+    {
+        perror("sim: pty");
+        exit(EXIT_FAILURE);
+    }
+
+    /* Held open, so the master does not see a hangup between clients */
+    simHost.ptySlaveFd = open(ptsname(master), O_RDWR | O_NOCTTY);
+    if ((simHost.ptySlaveFd >= 0) && (tcgetattr(simHost.ptySlaveFd, &tio) == 0))
+    {
+        cfmakeraw(&tio);
+        (void) tcsetattr(simHost.ptySlaveFd, TCSANOW, &tio);
+    }
+
+    fprintf(stderr, "sim: console on %s\n", ptsname(master));
+
+    return master;
+}
+
+static void lSIM_HOST_ConsoleOpen(void)
+{
+    const char* console = getenv("SIM_CONSOLE");
+    struct termios raw;
+    int fd;
+
+    if ((console != NULL) && (strcmp(console, "pty") == 0))
+    {
+        fd = lSIM_HOST_PtyOpen();
+        SERCOM5_USART_SIM_Attach(fd, fd);
+        return;
+    }
+
+    if (isatty(STDIN_FILENO) && (tcgetattr(STDIN_FILENO, &simHost.termios) == 0))
+    {
+        /* The firmware console echoes and edits the line itself */
+        simHost.termiosSaved = true;
+        (void) atexit(lSIM_HOST_TermiosRestore);
+
+        raw = simHost.termios;
+        raw.c_lflag &= ~(tcflag_t) (ICANON | ECHO);
+        raw.c_iflag &= ~(tcflag_t) (ICRNL | IXON);
+        raw.c_cc[VMIN] = 1;
+        raw.c_cc[VTIME] = 0;
+        (void) tcsetattr(STDIN_FILENO, TCSANOW, &raw);
+    }
+
+    SERCOM5_USART_SIM_Attach(STDIN_FILENO, STDOUT_FILENO);
+}
+
+__attribute__((constructor)) static void lSIM_HOST_Initialize(void)
+{
+    struct sigaction action;
+    struct itimerval timer;
+
+    simHost.loopNs = lSIM_HOST_EnvGet("SIM_LOOP_NS", SIM_HOST_LOOP_NS_DEFAULT);
+    simHost.lingerNs = lSIM_HOST_EnvGet("SIM_LINGER_MS", SIM_HOST_LINGER_MS_DEFAULT) * 1000000U;
+
+    SIM_Initialize();
+    SIM_CPU_Initialize();
+    MCP3564_SIM_Initialize();
+    SIM_SOC_Initialize();
+
+    lSIM_HOST_ConsoleOpen();
+
+    (void) memset(&action, 0, sizeof(action));
+    action.sa_handler = lSIM_HOST_Stall;
+    action.sa_flags = SA_RESTART;
+    (void) sigemptyset(&action.sa_mask);
+    (void) sigaction(SIGALRM, &action, NULL);
+
+    timer.it_interval.tv_sec = 0;
+    timer.it_interval.tv_usec = SIM_HOST_STALL_US;
+    timer.it_value = timer.it_interval;
+    (void) setitimer(ITIMER_REAL, &timer, NULL);
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+void __wrap_SYS_Tasks(void)
+{
+    SIM_CPU_Run(simHost.loopNs);
+    simHost.loopTime = SIM_Now();
+    lSIM_HOST_EndCheck();
+
+    __real_SYS_Tasks();
+}
+
+/*******************************************************************************
+ End of File
+ */
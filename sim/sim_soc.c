@@ -0,0 +1,332 @@
+/*******************************************************************************
+  Simulated SoC Source File
+
+  File Name:
+    sim_soc.c
+
+  Summary:
+    Register blocks and board wiring of the firmware image simulation.
+
+  Description:
+    See sim_soc.h. Register writes only reach the models at the next fold,
+    which is early enough: a model can only act on them when simulation
+    code runs, and every entry to it folds first.
+
+    A pin set and cleared between two folds (a pulse) is seen as both
+    edges, starting from its previous level.
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include "device.h"
+#include "sim_core.h"
+#include "sim_cpu.h"
+#include "sim_soc.h"
+#include "plib_sim.h"
+#include "mcp3564_sim.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+/* HPB0 to HPB3 */
+#define SIM_SOC_PERIPH_BASE                 0x40000000UL
+#define SIM_SOC_PERIPH_SIZE                 0x04000000UL
+
+#define SIM_SOC_PORT_GROUPS                 2U
+
+/* Sources of GCLK generator 5, the MCLK of the MCP3564 */
+#define SIM_SOC_DFLL_HZ                     48000000U
+#define SIM_SOC_DPLL0_HZ                    120000000U
+
+/* GCLK1, the clock of TC0 */
+#define SIM_SOC_TC0_HZ                      60000000U
+
+#define SIM_SOC_CS_GROUP                    1U
+#define SIM_SOC_CS_PIN                      5U
+#define SIM_SOC_IRQ_EXTINT                  14U
+
+#define SIM_SOC_EVSYS_CHANNELS              32U
+
+typedef struct
+{
+    uint32_t out[SIM_SOC_PORT_GROUPS];
+    uint32_t gclk5;
+    bool tc0Enabled;
+
+} SIM_SOC_OBJ;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data
+// *****************************************************************************
+// *****************************************************************************
+
+static SIM_SOC_OBJ simSoc;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+static uint32_t lSIM_SOC_Take(volatile uint32_t* reg)
+{
+    return __atomic_exchange_n(reg, 0U, __ATOMIC_SEQ_CST);
+}
+
+/* Registers read-only for the firmware are written by the hardware */
+static void lSIM_SOC_Set(const volatile uint32_t* reg, uint32_t value)
+{
+    *(volatile uint32_t*) reg = value;
+}
+
+static void lSIM_SOC_PinChanged(uint32_t group, uint32_t pin, bool level)
+{
+    if ((group == SIM_SOC_CS_GROUP) && (pin == SIM_SOC_CS_PIN))
+    {
+        /* Active low */
+        MCP3564_SIM_Select(!level);
+    }
+}
+
+static void lSIM_SOC_PortFold(uint32_t group)
+{
+    port_group_registers_t* port = &PORT_REGS->GROUP[group];
+    uint32_t set = lSIM_SOC_Take(&port->PORT_OUTSET);
+    uint32_t clr = lSIM_SOC_Take(&port->PORT_OUTCLR);
+    uint32_t tgl = lSIM_SOC_Take(&port->PORT_OUTTGL);
+    uint32_t dirSet = lSIM_SOC_Take(&port->PORT_DIRSET);
+    uint32_t dirClr = lSIM_SOC_Take(&port->PORT_DIRCLR);
+    uint32_t old = simSoc.out[group];
+    uint32_t out;
+    uint32_t pulse;
+    uint32_t changed;
+    uint32_t pin;
+
+    /* PORT_OUT holds direct writes (PORT_GroupWrite) on top of old */
+    pulse = set & clr;
+    out = ((port->PORT_OUT | (set & ~pulse)) & ~(clr & ~pulse)) ^ tgl;
+    changed = (old ^ out) | pulse;
+
+    for (pin = 0U; changed != 0U; pin++, changed >>= 1U)
+    {
+        if ((changed & 1U) == 0U)
+        {
+            continue;
+        }
+        if ((pulse & (1UL << pin)) != 0U)
+        {
+            lSIM_SOC_PinChanged(group, pin, (old & (1UL << pin)) == 0U);
+        }
+        lSIM_SOC_PinChanged(group, pin, (out & (1UL << pin)) != 0U);
+    }
+
+    simSoc.out[group] = out;
+    port->PORT_OUT = out;
+    lSIM_SOC_Set(&port->PORT_IN, (port->PORT_IN & ~port->PORT_DIR) | (out & port->PORT_DIR));
+    port->PORT_DIR = (port->PORT_DIR | dirSet) & ~dirClr;
+}
+
+static void lSIM_SOC_Sync(void)
+{
+    uint32_t group;
+    uint32_t flags;
+    uint32_t div;
+    uint32_t genctrl;
+    bool enabled;
+
+    for (group = 0U; group < SIM_SOC_PORT_GROUPS; group++)
+    {
+        lSIM_SOC_PortFold(group);
+    }
+
+    flags = __atomic_exchange_n(&EIC_REGS->EIC_INTFLAG, 0U, __ATOMIC_SEQ_CST);
+    if (flags != 0U)
+    {
+        EIC_SIM_FlagClear(flags);
+    }
+
+    genctrl = GCLK_REGS->GCLK_GENCTRL[5] & (GCLK_GENCTRL_DIV_Msk | GCLK_GENCTRL_SRC_Msk | GCLK_GENCTRL_GENEN_Msk);
+    if ((genctrl != simSoc.gclk5) && ((genctrl & GCLK_GENCTRL_GENEN_Msk) != 0U))
+    {
+        simSoc.gclk5 = genctrl;
+        div = (genctrl & GCLK_GENCTRL_DIV_Msk) >> GCLK_GENCTRL_DIV_Pos;
+        MCP3564_SIM_MclkSet((((genctrl & GCLK_GENCTRL_SRC_Msk) == GCLK_GENCTRL_SRC_DPLL0) ? SIM_SOC_DPLL0_HZ : SIM_SOC_DFLL_HZ) /
+                            ((div == 0U) ? 1U : div));
+    }
+
+    /* Flags written before the enable (a clear) are not pending captures */
+    enabled = (TC0_REGS->COUNT32.TC_CTRLA & TC_CTRLA_ENABLE_Msk) != 0U;
+    if (enabled && !simSoc.tc0Enabled)
+    {
+        TC0_REGS->COUNT32.TC_INTFLAG = 0U;
+    }
+    simSoc.tc0Enabled = enabled;
+
+    if ((TC0_REGS->COUNT32.TC_CTRLBSET & TC_CTRLBSET_CMD_Msk) == TC_CTRLBSET_CMD_READSYNC)
+    {
+        TC0_REGS->COUNT32.TC_COUNT = (uint32_t) ((SIM_Now() * SIM_SOC_TC0_HZ) / SIM_NS_PER_S);
+        TC0_REGS->COUNT32.TC_CTRLBSET &= (uint8_t) ~TC_CTRLBSET_CMD_Msk;
+    }
+}
+
+/* PORT event input: the action each group has for it on its pin */
+static void lSIM_SOC_PortEvent(uint32_t input)
+{
+    port_group_registers_t* port;
+    uint32_t group;
+    uint32_t evctrl;
+    uint32_t pin;
+
+    for (group = 0U; group < SIM_SOC_PORT_GROUPS; group++)
+    {
+        port = &PORT_REGS->GROUP[group];
+        evctrl = (port->PORT_EVCTRL >> (8U * input)) & 0xFFU;
+        if ((evctrl & PORT_EVCTRL_PORTEI0_Msk) == 0U)
+        {
+            continue;
+        }
+
+        pin = 1UL << ((evctrl & PORT_EVCTRL_PID0_Msk) >> PORT_EVCTRL_PID0_Pos);
+        switch ((evctrl & PORT_EVCTRL_EVACT0_Msk) >> PORT_EVCTRL_EVACT0_Pos)
+        {
+            case PORT_EVCTRL_EVACT0_SET_Val:
+                port->PORT_OUTSET |= pin;
+                break;
+
+            case PORT_EVCTRL_EVACT0_CLR_Val:
+                port->PORT_OUTCLR |= pin;
+                break;
+
+            case PORT_EVCTRL_EVACT0_TGL_Val:
+                port->PORT_OUTTGL |= pin;
+                break;
+
+            default:
+                /* OUT follows the event level, which a pulse does not have */
+                break;
+        }
+
+        lSIM_SOC_PortFold(group);
+    }
+}
+
+/* TC0 time stamp capture */
+static void lSIM_SOC_Tc0Capture(void)
+{
+    uint8_t flags;
+
+    if (!simSoc.tc0Enabled || ((TC0_REGS->COUNT32.TC_EVCTRL & TC_EVCTRL_TCEI_Msk) == 0U))
+    {
+        return;
+    }
+
+    /* MC0 still set: the previous capture was not read, overflow */
+    flags = TC0_REGS->COUNT32.TC_INTFLAG;
+    TC0_REGS->COUNT32.TC_CC[0] = (uint32_t) ((SIM_Now() * SIM_SOC_TC0_HZ) / SIM_NS_PER_S);
+    TC0_REGS->COUNT32.TC_INTFLAG = ((flags & TC_INTFLAG_MC0_Msk) != 0U) ?
+                                   (uint8_t) (TC_INTFLAG_MC0_Msk | TC_INTFLAG_ERR_Msk) : TC_INTFLAG_MC0_Msk;
+}
+
+/* The users of one EVSYS channel, as EVSYS_USER routes them */
+static void lSIM_SOC_EventDeliver(uint32_t channel)
+{
+    static const uint8_t users[] =
+    {
+        EVENT_ID_USER_PORT_EV_0, EVENT_ID_USER_PORT_EV_1, EVENT_ID_USER_PORT_EV_2, EVENT_ID_USER_PORT_EV_3,
+        EVENT_ID_USER_DMAC_CH_0, EVENT_ID_USER_DMAC_CH_1, EVENT_ID_USER_DMAC_CH_2, EVENT_ID_USER_TC0_EVU
+    };
+    uint32_t user;
+    uint32_t i;
+
+    for (i = 0U; i < sizeof(users); i++)
+    {
+        user = users[i];
+        if ((EVSYS_REGS->EVSYS_USER[user] & EVSYS_USER_CHANNEL_Msk) != (channel + 1U))
+        {
+            continue;
+        }
+
+        if (user <= EVENT_ID_USER_PORT_EV_3)
+        {
+            lSIM_SOC_PortEvent(user - EVENT_ID_USER_PORT_EV_0);
+        }
+        else if (user <= EVENT_ID_USER_DMAC_CH_2)
+        {
+            DMAC_SIM_EventTrigger(user - EVENT_ID_USER_DMAC_CH_0);
+        }
+        else
+        {
+            lSIM_SOC_Tc0Capture();
+        }
+    }
+}
+
+/* MCP3564 IRQ pin: EXTINT 14 */
+static void lSIM_SOC_AdcIrq(bool level, uintptr_t context)
+{
+    if (EIC_SIM_PinSet(SIM_SOC_IRQ_EXTINT, level))
+    {
+        SIM_SOC_EventGenerate(EVENT_ID_GEN_EIC_EXTINT_14);
+    }
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+void SIM_SOC_Initialize(void)
+{
+    void* base;
+
+    base = mmap((void*) SIM_SOC_PERIPH_BASE, SIM_SOC_PERIPH_SIZE, PROT_READ | PROT_WRITE,
+                MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE | MAP_NORESERVE, -1, 0);
+    if (base != (void*) SIM_SOC_PERIPH_BASE)
+    {
+        fprintf(stderr, "sim: cannot map the peripheral space at 0x%08lx\n", SIM_SOC_PERIPH_BASE);
+        exit(EXIT_FAILURE);
+    }
+
+    /* Status plib_clock.c waits for: the DPLL locks, the main clock is ready */
+    lSIM_SOC_Set(&OSCCTRL_REGS->DPLL[0].OSCCTRL_DPLLSTATUS, OSCCTRL_DPLLSTATUS_LOCK_Msk | OSCCTRL_DPLLSTATUS_CLKRDY_Msk);
+    MCLK_REGS->MCLK_INTFLAG = MCLK_INTFLAG_CKRDY_Msk;
+
+    /* Pull-ups: SPI_CS idles high */
+    PORT_REGS->GROUP[SIM_SOC_CS_GROUP].PORT_OUT = 1UL << SIM_SOC_CS_PIN;
+    simSoc.out[SIM_SOC_CS_GROUP] = 1UL << SIM_SOC_CS_PIN;
+
+    simSoc.gclk5 = 0U;
+    simSoc.tc0Enabled = false;
+
+    MCP3564_SIM_IrqCallbackRegister(lSIM_SOC_AdcIrq, 0U);
+    SIM_CPU_SyncRegister(lSIM_SOC_Sync);
+}
+
+void SIM_SOC_EventGenerate(uint32_t generator)
+{
+    uint32_t channel;
+
+    for (channel = 0U; channel < SIM_SOC_EVSYS_CHANNELS; channel++)
+    {
+        if (((EVSYS_REGS->CHANNEL[channel].EVSYS_CHANNEL & EVSYS_CHANNEL_EVGEN_Msk) >> EVSYS_CHANNEL_EVGEN_Pos) == generator)
+        {
+            lSIM_SOC_EventDeliver(channel);
+        }
+    }
+}
+
+/*******************************************************************************
+ End of File
+ */
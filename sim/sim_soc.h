@@ -0,0 +1,82 @@
+/*******************************************************************************
+  Simulated SoC Header File
+
+  File Name:
+    sim_soc.h
+
+  Summary:
+    Register blocks and board wiring of the firmware image simulation.
+
+  Description:
+    The real clock, port, EVSYS, NVMCTRL and CMCC PLIBs run unchanged
+    against host memory mapped at the peripheral addresses of the SAM E51.
+    Registers firmware writes directly and the models must see are folded
+    into them on every outermost SIM_CPU_Enter/SIM_CPU_Leave:
+
+      - PORT OUTSET/OUTCLR/OUTTGL into OUT and IN; SPI_CS (PB05) selects
+        the MCP3564 model
+      - EIC INTFLAG, write one to clear, into the simulated EIC
+      - GCLK generator 5 DIV, the MCP3564 MCLK, into the model
+      - TC0 COUNT read synchronisation
+
+    The MCP3564 IRQ pin drives EXTINT 14. Its event, and the beat event of
+    the DMAC channels, is routed by the EVSYS channel and user registers
+    the firmware wrote, to:
+
+      - the PORT event inputs: SET, CLR or TGL of the pin in PORT EVCTRL
+        (SPI_CS in the event mode acquisition)
+      - the DMAC channel event inputs (DMAC_SIM_EventTrigger)
+      - the TC0 time stamp capture into CC0, when TC0 is enabled for it
+*******************************************************************************/
+
+#ifndef _SIM_SOC_H
+#define _SIM_SOC_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************
+  Function:
+    void SIM_SOC_Initialize ( void )
+
+  Summary:
+    Maps the peripheral address space and connects the models.
+
+  Remarks:
+    Call once after SIM_CPU_Initialize and before the firmware touches a
+    register. Exits the process when the address range cannot be mapped.
+*/
+
+void SIM_SOC_Initialize ( void );
+
+/*******************************************************************************
+  Function:
+    void SIM_SOC_EventGenerate ( uint32_t generator )
+
+  Summary:
+    Delivers an event of generator (EVENT_ID_GEN_*) to the users of every
+    EVSYS channel it is routed to.
+
+  Remarks:
+    Delivery is immediate, the resynchronization delay of a few GCLK
+    cycles is not modelled.
+*/
+
+void SIM_SOC_EventGenerate ( uint32_t generator );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _SIM_SOC_H */
+
+/*******************************************************************************
+ End of File
+ */
@@ -0,0 +1,100 @@
+/*******************************************************************************
+  Simulation Test Source File
+
+  File Name:
+    sim_test.c
+
+  Summary:
+    Checks and result reporting of the host tests (make check).
+
+  Description:
+    See sim_test.h. The test name is the program name.
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#define _GNU_SOURCE
+
+#include <errno.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+#include "sim_test.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data
+// *****************************************************************************
+// *****************************************************************************
+
+static uint32_t simTestChecks;
+static uint32_t simTestFailures;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+bool SIM_TEST_Check(bool ok, const char* file, int line, const char* text)
+{
+    simTestChecks++;
+
+    if (!ok)
+    {
+        simTestFailures++;
+        fprintf(stderr, "%s:%d: check failed: %s\n", file, line, text);
+    }
+
+    return ok;
+}
+
+void SIM_TEST_Note(const char* format, ...)
+{
+    va_list args;
+
+    printf("%s: ", program_invocation_short_name);
+    va_start(args, format);
+    vprintf(format, args);
+    va_end(args);
+    printf("\n");
+    fflush(stdout);
+}
+
+uint64_t SIM_TEST_HostNs(void)
+{
+    struct timespec now;
+
+    (void) clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return ((uint64_t) now.tv_sec * 1000000000ULL) + (uint64_t) now.tv_nsec;
+}
+
+uint64_t SIM_TEST_HostCycles(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return SIM_TEST_HostNs();
+#endif
+}
+
+int SIM_TEST_Finish(void)
+{
+    printf("%s: %s, %u checks, %u failed\n", program_invocation_short_name,
+           (simTestFailures == 0U) ? "PASS" : "FAIL", simTestChecks, simTestFailures);
+
+    return (simTestFailures == 0U) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/*******************************************************************************
+ End of File
+ */
@@ -0,0 +1,84 @@
+/*******************************************************************************
+  Simulation Test Header File
+
+  File Name:
+    sim_test.h
+
+  Summary:
+    Checks and result reporting of the host tests (make check).
+
+  Description:
+    Every test is a program of its own which exits with status 0 when all
+    its checks held. A failed check prints its file, line and expression
+    and the test goes on, so one run shows every failure:
+
+        SIM_TEST_CHECK(stats.overruns == 0U);
+        ...
+        return SIM_TEST_Finish();
+
+    SIM_TEST_Note prints measurements (throughput, cycles per sample)
+    which the test reports but does not judge.
+*******************************************************************************/
+
+#ifndef _SIM_TEST_H
+#define _SIM_TEST_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Constants
+// *****************************************************************************
+// *****************************************************************************
+
+#define SIM_TEST_CHECK(cond)                SIM_TEST_Check((cond), __FILE__, __LINE__, #cond)
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+/* Counts the check, prints it when it failed; returns ok */
+bool SIM_TEST_Check ( bool ok, const char* file, int line, const char* text );
+
+/* A line of test output, prefixed with the test name */
+void SIM_TEST_Note ( const char* format, ... ) __attribute__((format(printf, 1, 2)));
+
+/* Host monotonic time in ns, for the benchmarks */
+uint64_t SIM_TEST_HostNs ( void );
+
+/* Host cycle counter (x86 time stamp counter), for the benchmarks; ns
+   where there is none */
+uint64_t SIM_TEST_HostCycles ( void );
+
+/*******************************************************************************
+  Function:
+    int SIM_TEST_Finish ( void )
+
+  Summary:
+    Prints the result line and returns the exit status of the test.
+*/
+
+int SIM_TEST_Finish ( void );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _SIM_TEST_H */
+
+/*******************************************************************************
+ End of File
+ */
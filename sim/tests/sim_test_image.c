@@ -0,0 +1,183 @@
+/*******************************************************************************
+  Simulation Test Image Source File
+
+  File Name:
+    sim_test_image.c
+
+  Summary:
+    Runs the firmware image inside a host test.
+
+  Description:
+    See sim_test_image.h. The stall poll of sim_host.c is repeated here: a
+    firmware loop spinning on a flag without calling into the simulation
+    is treated as a WFI after 100 us of host time without progress.
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <unistd.h>
+#include "definitions.h"
+#include "app.h"
+#include "sim_core.h"
+#include "sim_cpu.h"
+#include "sim_soc.h"
+#include "plib_sim.h"
+#include "mcp3564_sim.h"
+#include "sim_test_image.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+#define SIM_TEST_IMAGE_STALL_US             100
+
+/* Idle time after a command, for its last console output */
+#define SIM_TEST_IMAGE_SETTLE_NS            10000000ULL
+
+typedef struct
+{
+    int txFd;
+    uint32_t stallProgress;
+
+} SIM_TEST_IMAGE_OBJ;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data
+// *****************************************************************************
+// *****************************************************************************
+
+static SIM_TEST_IMAGE_OBJ simTestImage = { .txFd = -1 };
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+static void lSIM_TEST_IMAGE_Stall(int signal)
+{
+    int savedErrno = errno;
+    uint32_t progress = SIM_CPU_ProgressGet();
+
+    /* A handler which takes long on the host is not waiting: WFI there
+       would find nothing able to preempt it and never return */
+    if ((progress == simTestImage.stallProgress) && !SIM_CPU_IsEntered() && (SIM_CPU_IpsrGet() == 0U))
+    {
+        SIM_CPU_WaitForInterrupt();
+    }
+    simTestImage.stallProgress = SIM_CPU_ProgressGet();
+
+    errno = savedErrno;
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+void SIM_TEST_ImageInitialize(void)
+{
+    struct sigaction action;
+    struct itimerval timer;
+
+    SIM_Initialize();
+    SIM_CPU_Initialize();
+    MCP3564_SIM_Initialize();
+    SIM_SOC_Initialize();
+
+    simTestImage.txFd = (getenv("SIM_TEST_VERBOSE") != NULL) ? STDOUT_FILENO : open("/dev/null", O_WRONLY);
+    SERCOM5_USART_SIM_Attach(-1, simTestImage.txFd);
+
+    (void) memset(&action, 0, sizeof(action));
+    action.sa_handler = lSIM_TEST_IMAGE_Stall;
+    action.sa_flags = SA_RESTART;
+    (void) sigemptyset(&action.sa_mask);
+    (void) sigaction(SIGALRM, &action, NULL);
+
+    timer.it_interval.tv_sec = 0;
+    timer.it_interval.tv_usec = SIM_TEST_IMAGE_STALL_US;
+    timer.it_value = timer.it_interval;
+    (void) setitimer(ITIMER_REAL, &timer, NULL);
+
+    SYS_Initialize(NULL);
+}
+
+void SIM_TEST_ImageRun(uint64_t duration)
+{
+    uint64_t end = SIM_Now() + duration;
+
+    while (SIM_Now() < end)
+    {
+        SIM_CPU_Run(SIM_TEST_IMAGE_LOOP_NS);
+        SYS_Tasks();
+    }
+}
+
+bool SIM_TEST_ImageCommand(const char* line)
+{
+    uint64_t idleTime = 0U;
+    uint64_t start;
+    int fds[2];
+    bool idle = false;
+
+    if (pipe(fds) != 0)
+    {
+        perror("sim_test: pipe");
+        exit(EXIT_FAILURE);
+    }
+
+    /* The whole line is in the pipe before the UART sees end of file */
+    (void) write(fds[1], line, strlen(line));
+    (void) write(fds[1], "\r", 1U);
+    (void) close(fds[1]);
+    SERCOM5_USART_SIM_Attach(fds[0], simTestImage.txFd);
+
+    start = SIM_Now();
+    while ((SIM_Now() - start) < SIM_TEST_IMAGE_HUNG_NS)
+    {
+        SIM_TEST_ImageRun(SIM_TEST_IMAGE_LOOP_NS);
+
+        if (!SERCOM5_USART_SIM_RxEnded() || APP_IsBusy())
+        {
+            idle = false;
+        }
+        else if (!idle)
+        {
+            idle = true;
+            idleTime = SIM_Now();
+        }
+        else if ((SIM_Now() - idleTime) >= SIM_TEST_IMAGE_SETTLE_NS)
+        {
+            break;
+        }
+        else
+        {
+            /* Settling */
+        }
+    }
+
+    SERCOM5_USART_SIM_Attach(-1, simTestImage.txFd);
+    (void) close(fds[0]);
+    SERCOM5_USART_SIM_Flush();
+
+    return idle;
+}
+
+/*******************************************************************************
+ End of File
+ */
@@ -0,0 +1,90 @@
+/*******************************************************************************
+  Simulation Test Image Header File
+
+  File Name:
+    sim_test_image.h
+
+  Summary:
+    Runs the firmware image inside a host test.
+
+  Description:
+    The tests which need the whole image link it without main.c and
+    sim_host.c and drive it from here: the simulation and SYS_Initialize
+    come up once, then each console command is fed through the simulated
+    UART and the main loop runs until the application is idle again.
+
+        SIM_TEST_ImageInitialize();
+        SIM_TEST_CHECK(SIM_TEST_ImageCommand("CONTINUOUS 8"));
+        ADC_ACQ_StatsGet(&stats);
+
+    The results are read from the module interfaces (ADC_ACQ_StatsGet,
+    ADC_SCAN_StatsGet, ...) rather than from the console text. The console
+    output is discarded, or printed with SIM_TEST_VERBOSE set.
+*******************************************************************************/
+
+#ifndef _SIM_TEST_IMAGE_H
+#define _SIM_TEST_IMAGE_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Constants
+// *****************************************************************************
+// *****************************************************************************
+
+/* Simulated time one pass of the main loop takes, as SIM_LOOP_NS */
+#define SIM_TEST_IMAGE_LOOP_NS              2000U
+
+/* Simulated time a command may stay busy before it counts as hung */
+#define SIM_TEST_IMAGE_HUNG_NS              (60ULL * 1000000000ULL)
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+/* Simulation, MCP3564 model and SYS_Initialize */
+void SIM_TEST_ImageInitialize ( void );
+
+/* Runs the main loop for duration ns of simulated time */
+void SIM_TEST_ImageRun ( uint64_t duration );
+
+/*******************************************************************************
+  Function:
+    bool SIM_TEST_ImageCommand ( const char* line )
+
+  Summary:
+    Types line and a carriage return on the console and waits for the
+    command to finish.
+
+  Description:
+    Returns once every character was received, the application has no
+    ADC command running or queued (APP_IsBusy) and 10 ms more of simulated
+    time have passed. Returns false when the command is still busy after
+    SIM_TEST_IMAGE_HUNG_NS.
+*/
+
+bool SIM_TEST_ImageCommand ( const char* line );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _SIM_TEST_IMAGE_H */
+
+/*******************************************************************************
+ End of File
+ */
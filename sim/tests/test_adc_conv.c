@@ -0,0 +1,266 @@
+/*******************************************************************************
+  Fixed-Point Conversion Test
+
+  File Name:
+    test_adc_conv.c
+
+  Summary:
+    ADC_CONV against an exact reference, and its cost next to the float
+    conversion it replaced.
+
+  Description:
+    (code - offset) * scale stays below 2^53 for every scale checked here,
+    so a double holds the product and its quotient by 2^24 exactly, and
+    floor(x + 0.5) is the round half up the module promises. The checks:
+
+      - every 24 bit code at the default scale, a stride through the codes
+        at the PGA gains and at a calibrated scale with an offset, and the
+        25 bit over-range codes, must match the reference exactly
+      - ADC_CONV_Block gives the same as ADC_CONV_ToMicrovolts sample by
+        sample, channel IDs past the table use the MUX entry
+      - ADC_CONV_Format prints what printf prints for the value in volts,
+        and cuts it to the buffer like snprintf
+
+    The benchmark converts the same block with ADC_CONV_Block and with the
+    float expression of the original firmware ((float) code * Vref / 2^23)
+    and reports host cycles and ns per sample, and the worst error of the
+    float path in uV. The host vectorizes both loops, so the numbers
+    compare the two on this machine only; on the Cortex-M4F the float path
+    is a VCVT, VMUL and VDIV per sample, VDIV alone taking 14 cycles.
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include "adc_conv.h"
+#include "sim_test.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+#define TEST_CONV_CODE_MIN                  (-(1L << 23))
+#define TEST_CONV_CODE_MAX                  ((1L << 23) - 1)
+
+/* Prime stride: hits codes of every residue near both ends */
+#define TEST_CONV_STRIDE                    97
+
+#define TEST_CONV_BENCH_BLOCK               4096U
+#define TEST_CONV_BENCH_ROUNDS              2000U
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data
+// *****************************************************************************
+// *****************************************************************************
+
+static int32_t testConvCodes[TEST_CONV_BENCH_BLOCK];
+static int32_t testConvUv[TEST_CONV_BENCH_BLOCK];
+static float testConvVolts[TEST_CONV_BENCH_BLOCK];
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+static int32_t lTEST_CONV_Reference(const ADC_CONV_CAL* cal, int32_t code)
+{
+    double x = ((double) code - (double) cal->offset) * (double) cal->scale / (double) (1UL << ADC_CONV_SCALE_SHIFT);
+
+    return (int32_t) floor(x + 0.5);
+}
+
+/* Converts codes lo..hi in steps of stride on MUX, counts mismatches */
+static uint32_t lTEST_CONV_Sweep(const ADC_CONV_CAL* cal, int32_t lo, int32_t hi, int32_t stride)
+{
+    uint32_t mismatches = 0U;
+    int32_t code;
+
+    (void) ADC_CONV_CalSet(ADC_CONV_CHANNEL_MUX, cal);
+
+    for (code = lo; code <= hi; code += stride)
+    {
+        if (ADC_CONV_ToMicrovolts(ADC_CONV_CHANNEL_MUX, code) != lTEST_CONV_Reference(cal, code))
+        {
+            if (mismatches == 0U)
+            {
+                SIM_TEST_Note("scale %d offset %d code %d: %d uV, expected %d", cal->scale, cal->offset, code,
+                              ADC_CONV_ToMicrovolts(ADC_CONV_CHANNEL_MUX, code), lTEST_CONV_Reference(cal, code));
+            }
+            mismatches++;
+        }
+        if (code > (hi - stride))
+        {
+            break;
+        }
+    }
+
+    return mismatches;
+}
+
+static void lTEST_CONV_Format(int32_t uv)
+{
+    char text[ADC_CONV_TEXT_SIZE];
+    char expected[32];
+    size_t length;
+    size_t size;
+
+    (void) snprintf(expected, sizeof(expected), "%.6f", (double) uv / 1e6);
+
+    length = ADC_CONV_Format(uv, text, sizeof(text));
+    if (!SIM_TEST_CHECK((strcmp(text, expected) == 0) && (length == strlen(expected))))
+    {
+        SIM_TEST_Note("%d uV: \"%s\", expected \"%s\"", uv, text, expected);
+    }
+
+    /* Too small a buffer keeps the leading characters, like snprintf */
+    for (size = 1U; size < strlen(expected); size += 3U)
+    {
+        length = ADC_CONV_Format(uv, text, size);
+        SIM_TEST_CHECK((length == (size - 1U)) && (strncmp(text, expected, length) == 0) && (text[length] == '\0'));
+    }
+}
+
+/* The conversion of the original firmware, kept out of line like the
+   module's so neither is folded into the benchmark loop */
+static void __attribute__((noinline)) lTEST_CONV_Float(const int32_t* codes, float* volts, uint32_t count)
+{
+    const float refVoltage = (float) ADC_CONV_VREF_UV / 1e6f;
+    uint32_t i;
+
+    for (i = 0; i < count; i++)
+    {
+        volts[i] = (float) codes[i] * refVoltage / 8388608U;
+    }
+}
+
+static void lTEST_CONV_Bench(void)
+{
+    const ADC_CONV_CAL cal = { .scale = ADC_CONV_SCALE_DEFAULT, .offset = 0 };
+    uint64_t samples = (uint64_t) TEST_CONV_BENCH_BLOCK * TEST_CONV_BENCH_ROUNDS;
+    uint64_t cycles;
+    uint64_t ns;
+    double floatError = 0.0;
+    double error;
+    uint32_t seed = 0x2545F491U;
+    uint32_t round;
+    uint32_t i;
+
+    for (i = 0; i < TEST_CONV_BENCH_BLOCK; i++)
+    {
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        testConvCodes[i] = (int32_t) (seed << 8) >> 8;
+    }
+    (void) ADC_CONV_CalSet(0U, &cal);
+
+    ns = SIM_TEST_HostNs();
+    cycles = SIM_TEST_HostCycles();
+    for (round = 0; round < TEST_CONV_BENCH_ROUNDS; round++)
+    {
+        ADC_CONV_Block(0U, testConvCodes, testConvUv, TEST_CONV_BENCH_BLOCK);
+    }
+    cycles = SIM_TEST_HostCycles() - cycles;
+    ns = SIM_TEST_HostNs() - ns;
+    SIM_TEST_Note("fixed: %.2f cycles/sample, %.2f ns/sample", (double) cycles / (double) samples,
+                  (double) ns / (double) samples);
+
+    ns = SIM_TEST_HostNs();
+    cycles = SIM_TEST_HostCycles();
+    for (round = 0; round < TEST_CONV_BENCH_ROUNDS; round++)
+    {
+        lTEST_CONV_Float(testConvCodes, testConvVolts, TEST_CONV_BENCH_BLOCK);
+    }
+    cycles = SIM_TEST_HostCycles() - cycles;
+    ns = SIM_TEST_HostNs() - ns;
+    SIM_TEST_Note("float: %.2f cycles/sample, %.2f ns/sample", (double) cycles / (double) samples,
+                  (double) ns / (double) samples);
+
+    for (i = 0; i < TEST_CONV_BENCH_BLOCK; i++)
+    {
+        error = fabs(((double) testConvVolts[i] * 1e6) - ((double) testConvCodes[i] * cal.scale / (1UL << ADC_CONV_SCALE_SHIFT)));
+        if (error > floatError)
+        {
+            floatError = error;
+        }
+        SIM_TEST_CHECK(testConvUv[i] == lTEST_CONV_Reference(&cal, testConvCodes[i]));
+    }
+    SIM_TEST_Note("float: worst error %.3f uV, fixed: rounded to the uV, at most 0.5 uV", floatError);
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Main
+// *****************************************************************************
+// *****************************************************************************
+
+int main(void)
+{
+    static const int32_t gains[] = { 3, 1, 2, 4, 8, 16, 32, 64 };
+    static const int32_t formats[] = { 0, 1, -1, 999999, -999999, 1000000, -1000000, 123, -123,
+                                       3300000, -3300000, INT32_MAX, INT32_MIN };
+    ADC_CONV_CAL cal;
+    int32_t codes[5] = { TEST_CONV_CODE_MIN, -1, 0, 1, TEST_CONV_CODE_MAX };
+    int32_t uv[5];
+    uint32_t i;
+
+    ADC_CONV_Initialize();
+
+    /* Every code at the default scale */
+    cal = (ADC_CONV_CAL) { .scale = ADC_CONV_SCALE_DEFAULT, .offset = 0 };
+    SIM_TEST_CHECK(lTEST_CONV_Sweep(&cal, TEST_CONV_CODE_MIN, TEST_CONV_CODE_MAX, 1) == 0U);
+
+    /* PGA gains (the first entry stands for 1/3) */
+    for (i = 0; i < (sizeof(gains) / sizeof(gains[0])); i++)
+    {
+        cal.scale = (i == 0U) ? (3 * ADC_CONV_SCALE_DEFAULT) : ADC_CONV_SCALE(ADC_CONV_VREF_UV, gains[i]);
+        cal.offset = 0;
+        SIM_TEST_CHECK(lTEST_CONV_Sweep(&cal, TEST_CONV_CODE_MIN, TEST_CONV_CODE_MAX, TEST_CONV_STRIDE) == 0U);
+    }
+
+    /* Calibrated, with an offset, over the 25 bit codes of DATA_FORMAT 11 */
+    cal = (ADC_CONV_CAL) { .scale = ADC_CONV_SCALE_DEFAULT + 1234, .offset = -4321 };
+    SIM_TEST_CHECK(lTEST_CONV_Sweep(&cal, 2 * TEST_CONV_CODE_MIN, 2 * TEST_CONV_CODE_MAX + 1, TEST_CONV_STRIDE) == 0U);
+    SIM_TEST_CHECK(lTEST_CONV_Sweep(&cal, 2 * TEST_CONV_CODE_MIN, 2 * TEST_CONV_CODE_MIN + 1000, 1) == 0U);
+    SIM_TEST_CHECK(lTEST_CONV_Sweep(&cal, 2 * TEST_CONV_CODE_MAX - 999, 2 * TEST_CONV_CODE_MAX + 1, 1) == 0U);
+
+    /* Block and single conversions agree, out of range IDs use MUX */
+    (void) ADC_CONV_CalSet(3U, &cal);
+    ADC_CONV_Block(3U, codes, uv, 5U);
+    for (i = 0; i < 5U; i++)
+    {
+        SIM_TEST_CHECK(uv[i] == ADC_CONV_ToMicrovolts(3U, codes[i]));
+        SIM_TEST_CHECK(uv[i] == lTEST_CONV_Reference(&cal, codes[i]));
+    }
+    SIM_TEST_CHECK(ADC_CONV_ToMicrovolts(ADC_CONV_CHANNELS + 5U, 1000) == ADC_CONV_ToMicrovolts(ADC_CONV_CHANNEL_MUX, 1000));
+    SIM_TEST_CHECK(!ADC_CONV_CalSet(ADC_CONV_CHANNELS, &cal));
+    SIM_TEST_CHECK(!ADC_CONV_CalGet(0U, NULL));
+
+    for (i = 0; i < (sizeof(formats) / sizeof(formats[0])); i++)
+    {
+        lTEST_CONV_Format(formats[i]);
+    }
+    for (i = 0; i < 100000U; i++)
+    {
+        lTEST_CONV_Format((int32_t) (i * 40503U) - 2000000);
+    }
+    SIM_TEST_CHECK(ADC_CONV_Format(1, NULL, 0U) == 0U);
+
+    lTEST_CONV_Bench();
+
+    return SIM_TEST_Finish();
+}
+
+/*******************************************************************************
+ End of File
+ */
@@ -0,0 +1,236 @@
+/*******************************************************************************
+  ADC Data CRC Test
+
+  File Name:
+    test_adc_crc.c
+
+  Summary:
+    CRC checking of the ADCDATA reads on the simulated image.
+
+  Description:
+    With CRC ON the MCP3564 model appends CRC-16 to every ADCDATA read and
+    lADC_ACQ_StagePack checks it with MCP3564_REG_Crc16. Covered:
+      - the mcp3564Crc16 table against the bit by bit polynomial, and the
+        CRC-16/UMTS check value
+      - CONTINUOUS, 6 byte reads (STATUS, 24 bit data, CRC): no errors
+        when nothing is wrong, exactly one per read the model corrupts
+      - SCAN, 7 byte reads (STATUS, CH_ID/SGN + 24 bit data, CRC): the
+        same, and the channels still read their inputs, so the CRC bytes
+        did not leak into the samples
+      - CRC OFF again: nothing is counted even though the model would
+        have corrupted a CRC
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdlib.h>
+#include "definitions.h"
+#include "adc_acq.h"
+#include "adc_scan.h"
+#include "mcp3564_reg.h"
+#include "mcp3564_sim.h"
+#include "sim_core.h"
+#include "sim_test.h"
+#include "sim_test_image.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+#define TEST_CRC_POLY                       0x8005U
+#define TEST_CRC_CORRUPT                    5U
+
+#define TEST_CRC_SCAN_MASK                  0xFFU
+#define TEST_CRC_SCAN_CHANNELS              8U
+#define TEST_CRC_RUN_NS                     30000000U
+
+/* CHn gets (n + 1) * 100 mV */
+#define TEST_CRC_STEP_UV                    100000
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data
+// *****************************************************************************
+// *****************************************************************************
+
+static uint32_t testCrcSeed = 0x9E3779B9U;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+static uint32_t lTEST_CRC_Random(void)
+{
+    testCrcSeed ^= testCrcSeed << 13;
+    testCrcSeed ^= testCrcSeed >> 17;
+    testCrcSeed ^= testCrcSeed << 5;
+
+    return testCrcSeed;
+}
+
+static uint16_t lTEST_CRC_Bitwise(const uint8_t* data, uint32_t size)
+{
+    uint16_t crc = MCP3564_CRC_SEED;
+    uint32_t bit;
+
+    while (size-- != 0U)
+    {
+        crc ^= (uint16_t) ((uint32_t) *data++ << 8);
+        for (bit = 0U; bit < 8U; bit++)
+        {
+            crc = ((crc & 0x8000U) != 0U) ? (uint16_t) ((crc << 1) ^ TEST_CRC_POLY) : (uint16_t) (crc << 1);
+        }
+    }
+
+    return crc;
+}
+
+static void lTEST_CRC_Table(void)
+{
+    uint8_t data[64];
+    uint32_t wrong = 0U;
+    uint32_t size;
+    uint32_t i;
+    uint32_t j;
+
+    /* Every table entry is hit by the single bytes */
+    for (i = 0U; i < 256U; i++)
+    {
+        data[0] = (uint8_t) i;
+        wrong += (MCP3564_REG_Crc16(data, 1U) != lTEST_CRC_Bitwise(data, 1U)) ? 1U : 0U;
+    }
+
+    for (i = 0U; i < 1000U; i++)
+    {
+        size = lTEST_CRC_Random() % sizeof(data);
+        for (j = 0U; j < size; j++)
+        {
+            data[j] = (uint8_t) lTEST_CRC_Random();
+        }
+        wrong += (MCP3564_REG_Crc16(data, size) != lTEST_CRC_Bitwise(data, size)) ? 1U : 0U;
+    }
+    SIM_TEST_CHECK(wrong == 0U);
+
+    SIM_TEST_CHECK(MCP3564_REG_Crc16((const uint8_t*) "123456789", 9U) == 0xFEE8U);
+}
+
+static void lTEST_CRC_Continuous(uint32_t corrupt, uint32_t expected)
+{
+    ADC_ACQ_STATS stats;
+
+    MCP3564_SIM_CrcCorrupt(corrupt);
+    SIM_TEST_CHECK(SIM_TEST_ImageCommand("CONTINUOUS 16"));
+    MCP3564_SIM_CrcCorrupt(0U);
+    ADC_ACQ_StatsGet(&stats);
+
+    SIM_TEST_Note("CONTINUOUS, CRC %s, %u corrupted: %u samples, %u CRC errors",
+                  ADC_ACQ_CrcIsEnabled() ? "ON" : "OFF", corrupt, stats.samples, stats.crcErrors);
+    SIM_TEST_CHECK(stats.blocks == 16U);
+    SIM_TEST_CHECK(stats.overruns == 0U);
+    SIM_TEST_CHECK(stats.crcErrors == expected);
+}
+
+static void lTEST_CRC_ScanRun(void)
+{
+    uint64_t end = SIM_Now() + TEST_CRC_RUN_NS;
+
+    while (SIM_Now() < end)
+    {
+        SIM_TEST_ImageRun(100000U);
+        (void) ADC_SCAN_Process();
+    }
+}
+
+static void lTEST_CRC_Scan(uint32_t corrupt)
+{
+    ADC_ACQ_STATS stats;
+    const int32_t* data;
+    int64_t first;
+    uint32_t wrong = 0U;
+    uint32_t count;
+    uint32_t channel;
+    uint32_t i;
+
+    SIM_TEST_CHECK(ADC_SCAN_Start(TEST_CRC_SCAN_MASK, 0U, 0U));
+    lTEST_CRC_ScanRun();
+    MCP3564_SIM_CrcCorrupt(corrupt);
+    lTEST_CRC_ScanRun();
+    MCP3564_SIM_CrcCorrupt(0U);
+
+    ADC_ACQ_StatsGet(&stats);
+    SIM_TEST_Note("SCAN, %u corrupted: %u samples, %u CRC errors", corrupt, stats.samples, stats.crcErrors);
+    SIM_TEST_CHECK(stats.samples != 0U);
+    SIM_TEST_CHECK(stats.crcErrors == corrupt);
+
+    /* Every sample of CHn is (n + 1) times the first one of CH0 */
+    data = ADC_SCAN_ChannelGet(0U, &count);
+    SIM_TEST_CHECK(count != 0U);
+    first = (count != 0U) ? data[0] : 0;
+    SIM_TEST_CHECK(first > 0);
+
+    for (channel = 0U; channel < TEST_CRC_SCAN_CHANNELS; channel++)
+    {
+        data = ADC_SCAN_ChannelGet(channel, &count);
+        SIM_TEST_CHECK(count != 0U);
+        for (i = 0U; i < count; i++)
+        {
+            if (llabs((int64_t) data[i] - (first * (int64_t) (channel + 1U))) > (first / 100))
+            {
+                wrong++;
+            }
+        }
+    }
+    SIM_TEST_CHECK(wrong == 0U);
+
+    ADC_SCAN_Stop();
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Main
+// *****************************************************************************
+// *****************************************************************************
+
+int main(void)
+{
+    uint32_t channel;
+
+    lTEST_CRC_Table();
+
+    SIM_TEST_ImageInitialize();
+
+    SIM_TEST_CHECK(SIM_TEST_ImageCommand("CRC ON"));
+    SIM_TEST_CHECK(ADC_ACQ_CrcIsEnabled());
+
+    /* FORMAT_24: STATUS + 3 data bytes + 2 CRC bytes */
+    lTEST_CRC_Continuous(0U, 0U);
+    SIM_TEST_CHECK((MCP3564_SIM_RegisterGet(MCP3564_REG_CONFIG3) & MCP3564_CONFIG3_EN_CRCCOM) != 0U);
+    lTEST_CRC_Continuous(TEST_CRC_CORRUPT, TEST_CRC_CORRUPT);
+
+    /* FORMAT_32_CHID: STATUS + CH_ID/SGN + 3 data bytes + 2 CRC bytes */
+    for (channel = 0U; channel < TEST_CRC_SCAN_CHANNELS; channel++)
+    {
+        MCP3564_SIM_InputSet(channel, ((int32_t) channel + 1) * TEST_CRC_STEP_UV);
+    }
+    lTEST_CRC_Scan(0U);
+    lTEST_CRC_Scan(TEST_CRC_CORRUPT);
+
+    /* Off: the model leaves the CRC out, nothing is checked */
+    SIM_TEST_CHECK(SIM_TEST_ImageCommand("CRC OFF"));
+    lTEST_CRC_Continuous(TEST_CRC_CORRUPT, 0U);
+    SIM_TEST_CHECK((MCP3564_SIM_RegisterGet(MCP3564_REG_CONFIG3) & MCP3564_CONFIG3_EN_CRCCOM) == 0U);
+
+    return SIM_TEST_Finish();
+}
+
+/*******************************************************************************
+ End of File
+ */
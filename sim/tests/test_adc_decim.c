@@ -0,0 +1,335 @@
+/*******************************************************************************
+  Decimation Filter Test
+
+  File Name:
+    test_adc_decim.c
+
+  Summary:
+    ADC_DECIM against a direct-form reference and its frequency response.
+
+  Description:
+    A CIC of order N, ratio R and differential delay 1 is the FIR whose
+    taps are N boxcars of length R convolved, with the output taken at
+    every Rth input; the boxcar is the N = 1 case. The test checks that
+
+      - random 25 bit input, fed in chunks of random size with a second
+        channel interleaved, gives exactly the output of that FIR followed
+        by the module's rounding (half away from zero), for both types and
+        ratios of 2, 3, 16, 64, 1000 and 1024; ratio 1 passes samples
+        through
+      - full-scale input at ratio 1024 through the CIC comes out unchanged,
+        so the 64 bit integrators have the headroom the header promises
+      - sines of amplitude 2^22 come out with the amplitude
+        |sin(pi f R) / (R sin(pi f))|^N predicts, in the passband and
+        aliased from above the output Nyquist frequency, and a sine at the
+        output rate is nulled
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include "adc_decim.h"
+#include "sim_test.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+#ifndef M_PI
+#define M_PI                                3.14159265358979323846
+#endif
+
+#define TEST_DECIM_INPUT                    (1U << 16)
+#define TEST_DECIM_CHUNK_MAX                300U
+#define TEST_DECIM_TAPS_MAX                 ((ADC_DECIM_CIC_ORDER * (ADC_DECIM_RATIO_MAX - 1U)) + 1U)
+
+/* Frequency response: ratio, outputs per DFT, outputs let settle first */
+#define TEST_DECIM_RESPONSE_RATIO           16U
+#define TEST_DECIM_RESPONSE_OUTPUTS         512U
+#define TEST_DECIM_RESPONSE_SETTLE          ADC_DECIM_CIC_ORDER
+#define TEST_DECIM_RESPONSE_AMPLITUDE       4194304.0
+
+/* Rounding noise in the DFT is a few hundredths of a code */
+#define TEST_DECIM_RESPONSE_TOLERANCE       0.5
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data
+// *****************************************************************************
+// *****************************************************************************
+
+static int32_t testDecimIn[TEST_DECIM_INPUT];
+static int32_t testDecimOut[TEST_DECIM_INPUT];
+static int32_t testDecimOther[TEST_DECIM_INPUT];
+static int64_t testDecimTaps[TEST_DECIM_TAPS_MAX];
+static uint32_t testDecimSeed = 0x1B873593U;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+static uint32_t lTEST_DECIM_Random(void)
+{
+    testDecimSeed ^= testDecimSeed << 13;
+    testDecimSeed ^= testDecimSeed >> 17;
+    testDecimSeed ^= testDecimSeed << 5;
+
+    return testDecimSeed;
+}
+
+/* Taps of order boxcars of length ratio convolved, returns the count */
+static uint32_t lTEST_DECIM_Taps(uint32_t order, uint32_t ratio)
+{
+    static int64_t next[TEST_DECIM_TAPS_MAX];
+    uint32_t count = 1U;
+    uint32_t stage;
+    uint32_t i;
+    uint32_t j;
+
+    testDecimTaps[0] = 1;
+    for (stage = 0; stage < order; stage++)
+    {
+        for (i = 0; i < (count + ratio - 1U); i++)
+        {
+            next[i] = 0;
+            for (j = 0; (j < ratio) && (j <= i); j++)
+            {
+                next[i] += ((i - j) < count) ? testDecimTaps[i - j] : 0;
+            }
+        }
+        count += ratio - 1U;
+        memcpy(testDecimTaps, next, count * sizeof(int64_t));
+    }
+
+    return count;
+}
+
+static int32_t lTEST_DECIM_Round(int64_t sum, int64_t gain)
+{
+    int64_t half = gain / 2;
+
+    return (int32_t) ((sum < 0) ? -((-sum + half) / gain) : ((sum + half) / gain));
+}
+
+/* Output m of the FIR, from zero history */
+static int32_t lTEST_DECIM_Reference(const int32_t* in, uint32_t taps, uint32_t ratio, int64_t gain, uint32_t m)
+{
+    int64_t sum = 0;
+    int64_t n = ((int64_t) (m + 1U) * ratio) - 1;
+    uint32_t k;
+
+    for (k = 0; (k < taps) && ((n - (int64_t) k) >= 0); k++)
+    {
+        sum += testDecimTaps[k] * in[n - (int64_t) k];
+    }
+
+    return lTEST_DECIM_Round(sum, gain);
+}
+
+/* Feeds count inputs in random chunks, the other channel in between */
+static uint32_t lTEST_DECIM_Feed(const int32_t* in, int32_t* out, uint32_t count)
+{
+    uint32_t produced = 0U;
+    uint32_t chunk;
+
+    while (count != 0U)
+    {
+        chunk = 1U + (lTEST_DECIM_Random() % TEST_DECIM_CHUNK_MAX);
+        if (chunk > count)
+        {
+            chunk = count;
+        }
+
+        produced += ADC_DECIM_Process(0U, in, &out[produced], chunk);
+        (void) ADC_DECIM_Process(ADC_DECIM_CHANNEL_MUX, testDecimOther, testDecimOther, chunk);
+
+        in += chunk;
+        count -= chunk;
+    }
+
+    return produced;
+}
+
+static void lTEST_DECIM_Exact(ADC_DECIM_TYPE type, uint32_t ratio)
+{
+    uint32_t order = (type == ADC_DECIM_TYPE_CIC) ? ADC_DECIM_CIC_ORDER : 1U;
+    uint32_t taps = lTEST_DECIM_Taps(order, ratio);
+    uint32_t outputs = TEST_DECIM_INPUT / ratio;
+    uint32_t mismatches = 0U;
+    int64_t gain = 1;
+    uint32_t i;
+
+    for (i = 0; i < order; i++)
+    {
+        gain *= ratio;
+    }
+
+    for (i = 0; i < TEST_DECIM_INPUT; i++)
+    {
+        /* 25 bit two's complement, as ADC_DECODE_Block32Sgn hands out */
+        testDecimIn[i] = (int32_t) (lTEST_DECIM_Random() << 7) >> 7;
+        testDecimOther[i] = (int32_t) lTEST_DECIM_Random() >> 7;
+    }
+
+    SIM_TEST_CHECK(ADC_DECIM_Configure(type, ratio));
+    SIM_TEST_CHECK(lTEST_DECIM_Feed(testDecimIn, testDecimOut, TEST_DECIM_INPUT) == outputs);
+
+    for (i = 0; i < outputs; i++)
+    {
+        if (testDecimOut[i] != lTEST_DECIM_Reference(testDecimIn, taps, ratio, gain, i))
+        {
+            if (mismatches == 0U)
+            {
+                SIM_TEST_Note("%s ratio %u: output %u is %d, expected %d", (order == 1U) ? "boxcar" : "CIC", ratio, i,
+                              testDecimOut[i], lTEST_DECIM_Reference(testDecimIn, taps, ratio, gain, i));
+            }
+            mismatches++;
+        }
+    }
+    SIM_TEST_CHECK(mismatches == 0U);
+}
+
+static void lTEST_DECIM_FullScale(void)
+{
+    static const int32_t ends[] = { (1L << 24) - 1, -(1L << 24) };
+    uint32_t outputs;
+    uint32_t e;
+    uint32_t i;
+
+    for (e = 0; e < 2U; e++)
+    {
+        for (i = 0; i < TEST_DECIM_INPUT; i++)
+        {
+            testDecimIn[i] = ends[e];
+        }
+
+        SIM_TEST_CHECK(ADC_DECIM_Configure(ADC_DECIM_TYPE_CIC, ADC_DECIM_RATIO_MAX));
+        outputs = ADC_DECIM_Process(0U, testDecimIn, testDecimOut, TEST_DECIM_INPUT);
+        SIM_TEST_CHECK(outputs == (TEST_DECIM_INPUT / ADC_DECIM_RATIO_MAX));
+
+        /* Past the settling outputs */
+        for (i = ADC_DECIM_CIC_ORDER - 1U; i < outputs; i++)
+        {
+            SIM_TEST_CHECK(testDecimOut[i] == ends[e]);
+        }
+    }
+}
+
+/* Amplitude out of a sine at (k + alias * M) / (M * R) of the input rate */
+static void lTEST_DECIM_Response(ADC_DECIM_TYPE type, uint32_t k, uint32_t alias)
+{
+    const uint32_t ratio = TEST_DECIM_RESPONSE_RATIO;
+    const uint32_t outputs = TEST_DECIM_RESPONSE_OUTPUTS;
+    uint32_t order = (type == ADC_DECIM_TYPE_CIC) ? ADC_DECIM_CIC_ORDER : 1U;
+    uint32_t inputs = (outputs + TEST_DECIM_RESPONSE_SETTLE) * ratio;
+    double f = (double) (k + (alias * outputs)) / (double) (outputs * ratio);
+    double expected = TEST_DECIM_RESPONSE_AMPLITUDE * pow(fabs(sin(M_PI * f * ratio) / (ratio * sin(M_PI * f))), order);
+    double re = 0.0;
+    double im = 0.0;
+    double amplitude;
+    const int32_t* y;
+    uint32_t m;
+    uint32_t i;
+
+    for (i = 0; i < inputs; i++)
+    {
+        testDecimIn[i] = (int32_t) lround(TEST_DECIM_RESPONSE_AMPLITUDE * sin(2.0 * M_PI * f * i));
+    }
+
+    SIM_TEST_CHECK(ADC_DECIM_Configure(type, ratio));
+    SIM_TEST_CHECK(ADC_DECIM_Process(0U, testDecimIn, testDecimOut, inputs) == (inputs / ratio));
+
+    y = &testDecimOut[TEST_DECIM_RESPONSE_SETTLE];
+    for (m = 0; m < outputs; m++)
+    {
+        re += y[m] * cos(2.0 * M_PI * k * m / outputs);
+        im -= y[m] * sin(2.0 * M_PI * k * m / outputs);
+    }
+    amplitude = 2.0 * sqrt((re * re) + (im * im)) / outputs;
+
+    SIM_TEST_Note("%-6s f = %.5f fs: %12.2f, expected %12.2f (%7.2f dB)", (order == 1U) ? "boxcar" : "CIC", f,
+                  amplitude, expected, 20.0 * log10(expected / TEST_DECIM_RESPONSE_AMPLITUDE));
+    SIM_TEST_CHECK(fabs(amplitude - expected) <= TEST_DECIM_RESPONSE_TOLERANCE);
+}
+
+/* A sine at the output rate sums to zero over every output */
+static void lTEST_DECIM_Null(ADC_DECIM_TYPE type)
+{
+    const uint32_t ratio = TEST_DECIM_RESPONSE_RATIO;
+    uint32_t inputs = (TEST_DECIM_RESPONSE_OUTPUTS + TEST_DECIM_RESPONSE_SETTLE) * ratio;
+    int32_t peak = 0;
+    uint32_t i;
+
+    for (i = 0; i < inputs; i++)
+    {
+        testDecimIn[i] = (int32_t) lround(TEST_DECIM_RESPONSE_AMPLITUDE * sin(2.0 * M_PI * i / ratio));
+    }
+
+    SIM_TEST_CHECK(ADC_DECIM_Configure(type, ratio));
+    (void) ADC_DECIM_Process(0U, testDecimIn, testDecimOut, inputs);
+
+    for (i = TEST_DECIM_RESPONSE_SETTLE; i < (inputs / ratio); i++)
+    {
+        if (abs(testDecimOut[i]) > peak)
+        {
+            peak = abs(testDecimOut[i]);
+        }
+    }
+    SIM_TEST_CHECK(peak <= 1);
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Main
+// *****************************************************************************
+// *****************************************************************************
+
+int main(void)
+{
+    static const uint32_t ratios[] = { 2U, 3U, 16U, 64U, 1000U, ADC_DECIM_RATIO_MAX };
+    /* k, alias: passband, near the output Nyquist, aliased from 1, 2 and 5 output rates */
+    static const uint32_t tones[][2] = { { 8U, 0U }, { 64U, 0U }, { 200U, 0U }, { 8U, 1U }, { 40U, 2U }, { 100U, 5U } };
+    ADC_DECIM_TYPE type;
+    uint32_t i;
+
+    SIM_TEST_CHECK(!ADC_DECIM_Configure(ADC_DECIM_TYPE_CIC, 0U));
+    SIM_TEST_CHECK(!ADC_DECIM_Configure(ADC_DECIM_TYPE_CIC, ADC_DECIM_RATIO_MAX + 1U));
+
+    /* Ratio 1 passes through */
+    testDecimIn[0] = -5;
+    testDecimIn[1] = 7;
+    SIM_TEST_CHECK(ADC_DECIM_Configure(ADC_DECIM_TYPE_CIC, 1U));
+    SIM_TEST_CHECK(ADC_DECIM_Process(0U, testDecimIn, testDecimOut, 2U) == 2U);
+    SIM_TEST_CHECK((testDecimOut[0] == -5) && (testDecimOut[1] == 7));
+
+    for (type = ADC_DECIM_TYPE_BOXCAR; type <= ADC_DECIM_TYPE_CIC; type++)
+    {
+        for (i = 0; i < (sizeof(ratios) / sizeof(ratios[0])); i++)
+        {
+            lTEST_DECIM_Exact(type, ratios[i]);
+        }
+        for (i = 0; i < (sizeof(tones) / sizeof(tones[0])); i++)
+        {
+            lTEST_DECIM_Response(type, tones[i][0], tones[i][1]);
+        }
+        lTEST_DECIM_Null(type);
+    }
+
+    lTEST_DECIM_FullScale();
+
+    return SIM_TEST_Finish();
+}
+
+/*******************************************************************************
+ End of File
+ */
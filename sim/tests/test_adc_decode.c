@@ -0,0 +1,265 @@
+/*******************************************************************************
+  Block Decode Test
+
+  File Name:
+    test_adc_decode.c
+
+  Summary:
+    ADC_DECODE kernels against their one-byte-at-a-time references.
+
+  Description:
+    Random raw data, plus the codes at the ends of the range, is decoded by
+    each kernel and by its reference, and the results must match exactly:
+
+      - ADC_DECODE_Block24 for every count from 0 to TEST_DECODE_COUNT_MAX
+        and every byte alignment of the input, with guard words after the
+        output which must stay untouched
+      - ADC_DECODE_Block32 and ADC_DECODE_Block32Sgn for every count, into
+        a separate buffer and in place
+      - ADC_DECODE_Block32Sgn on CH_ID/SGN words from -2^24 to 2^24 - 1,
+        which Block32 would wrap at bit 23
+
+    The benchmark reports host cycles and ns per sample of each kernel and
+    its reference on a CONTINUOUS sized block.
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <string.h>
+#include "adc_decode.h"
+#include "sim_test.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+#define TEST_DECODE_COUNT_MAX               67U
+#define TEST_DECODE_ALIGNMENTS              4U
+#define TEST_DECODE_GUARD                   4U
+#define TEST_DECODE_GUARD_VALUE             0x5A5A5A5A
+
+#define TEST_DECODE_BENCH_BLOCK             128U
+#define TEST_DECODE_BENCH_ROUNDS            50000U
+
+typedef void (*TEST_DECODE_BLOCK32)(const uint32_t* raw, int32_t* samples, uint32_t count);
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data
+// *****************************************************************************
+// *****************************************************************************
+
+static uint32_t testDecodeSeed = 0x6C078965U;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+static uint32_t lTEST_DECODE_Random(void)
+{
+    testDecodeSeed ^= testDecodeSeed << 13;
+    testDecodeSeed ^= testDecodeSeed >> 17;
+    testDecodeSeed ^= testDecodeSeed << 5;
+
+    return testDecodeSeed;
+}
+
+/* Random bytes, the first samples set to the ends of the range */
+static void lTEST_DECODE_Fill(uint8_t* data, uint32_t size)
+{
+    static const uint8_t ends[] = { 0x7F, 0xFF, 0xFF, 0x80, 0x00, 0x00, 0xFF, 0xFF, 0xFF,
+                                    0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x80, 0x00, 0x01 };
+    uint32_t i;
+
+    for (i = 0; i < size; i++)
+    {
+        data[i] = (uint8_t) lTEST_DECODE_Random();
+    }
+    memcpy(data, ends, (size < sizeof(ends)) ? size : sizeof(ends));
+}
+
+static bool lTEST_DECODE_Guarded(const int32_t* samples)
+{
+    uint32_t i;
+
+    for (i = 0; i < TEST_DECODE_GUARD; i++)
+    {
+        if (samples[i] != TEST_DECODE_GUARD_VALUE)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static void lTEST_DECODE_Block24(void)
+{
+    uint8_t data[(TEST_DECODE_COUNT_MAX * ADC_DECODE_SAMPLE_SIZE_24) + TEST_DECODE_ALIGNMENTS];
+    int32_t samples[TEST_DECODE_COUNT_MAX + TEST_DECODE_GUARD];
+    int32_t expected[TEST_DECODE_COUNT_MAX + TEST_DECODE_GUARD];
+    uint32_t mismatches = 0U;
+    uint32_t alignment;
+    uint32_t count;
+
+    for (alignment = 0U; alignment < TEST_DECODE_ALIGNMENTS; alignment++)
+    {
+        for (count = 0U; count <= TEST_DECODE_COUNT_MAX; count++)
+        {
+            lTEST_DECODE_Fill(&data[alignment], count * ADC_DECODE_SAMPLE_SIZE_24);
+            memset(samples, 0x5A, sizeof(samples));
+            memset(expected, 0x5A, sizeof(expected));
+
+            ADC_DECODE_Block24(&data[alignment], samples, count);
+            ADC_DECODE_Block24Ref(&data[alignment], expected, count);
+
+            if ((memcmp(samples, expected, count * sizeof(int32_t)) != 0) || !lTEST_DECODE_Guarded(&samples[count]))
+            {
+                SIM_TEST_Note("Block24: count %u alignment %u differs", count, alignment);
+                mismatches++;
+            }
+        }
+    }
+    SIM_TEST_CHECK(mismatches == 0U);
+
+    /* Known values */
+    ADC_DECODE_Block24((const uint8_t[]) { 0x7F, 0xFF, 0xFF, 0x80, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x01 },
+                       samples, 4U);
+    SIM_TEST_CHECK((samples[0] == 8388607) && (samples[1] == -8388608) && (samples[2] == -1) && (samples[3] == 1));
+}
+
+static void lTEST_DECODE_Block32(const char* name, TEST_DECODE_BLOCK32 kernel, TEST_DECODE_BLOCK32 reference)
+{
+    uint32_t raw[TEST_DECODE_COUNT_MAX];
+    uint32_t inPlace[TEST_DECODE_COUNT_MAX];
+    int32_t samples[TEST_DECODE_COUNT_MAX + TEST_DECODE_GUARD];
+    int32_t expected[TEST_DECODE_COUNT_MAX];
+    uint32_t mismatches = 0U;
+    uint32_t count;
+
+    for (count = 0U; count <= TEST_DECODE_COUNT_MAX; count++)
+    {
+        lTEST_DECODE_Fill((uint8_t*) raw, count * sizeof(uint32_t));
+        memcpy(inPlace, raw, sizeof(raw));
+        memset(samples, 0x5A, sizeof(samples));
+
+        kernel(raw, samples, count);
+        reference(raw, expected, count);
+        kernel(inPlace, (int32_t*) inPlace, count);
+
+        if ((memcmp(samples, expected, count * sizeof(int32_t)) != 0) || !lTEST_DECODE_Guarded(&samples[count]) ||
+            (memcmp(inPlace, expected, count * sizeof(int32_t)) != 0))
+        {
+            SIM_TEST_Note("%s: count %u differs", name, count);
+            mismatches++;
+        }
+    }
+    SIM_TEST_CHECK(mismatches == 0U);
+}
+
+/* FIFO word of a CH_ID/SGN read: bytes as received, header first */
+static uint32_t lTEST_DECODE_SgnWord(uint32_t channel, int32_t value)
+{
+    uint8_t bytes[4];
+    uint32_t word;
+
+    bytes[0] = (uint8_t) ((channel << 4) | ((value < 0) ? 0x0FU : 0x00U));
+    bytes[1] = (uint8_t) ((uint32_t) value >> 16);
+    bytes[2] = (uint8_t) ((uint32_t) value >> 8);
+    bytes[3] = (uint8_t) value;
+    memcpy(&word, bytes, sizeof(word));
+
+    return word;
+}
+
+static void lTEST_DECODE_Sgn(void)
+{
+    static const int32_t values[] = { 0, 1, -1, 8388607, -8388608, 8388608, -8388609,
+                                      12582912, -12582912, 16777215, -16777216 };
+    uint32_t raw;
+    int32_t sample;
+    uint32_t i;
+
+    for (i = 0; i < (sizeof(values) / sizeof(values[0])); i++)
+    {
+        raw = lTEST_DECODE_SgnWord(i & 0xFU, values[i]);
+
+        ADC_DECODE_Block32Sgn(&raw, &sample, 1U);
+        if (!SIM_TEST_CHECK(sample == values[i]))
+        {
+            SIM_TEST_Note("Block32Sgn: %d decodes to %d", values[i], sample);
+        }
+        ADC_DECODE_Block32SgnRef(&raw, &sample, 1U);
+        SIM_TEST_CHECK(sample == values[i]);
+    }
+}
+
+static void lTEST_DECODE_Report(const char* name, uint64_t cycles, uint64_t ns)
+{
+    double samples = (double) TEST_DECODE_BENCH_BLOCK * TEST_DECODE_BENCH_ROUNDS;
+
+    SIM_TEST_Note("%-14s %6.2f cycles/sample, %6.2f ns/sample", name, (double) cycles / samples, (double) ns / samples);
+}
+
+#define TEST_DECODE_BENCH(name, call)                                           \
+    do                                                                          \
+    {                                                                           \
+        uint64_t ns = SIM_TEST_HostNs();                                        \
+        uint64_t cycles = SIM_TEST_HostCycles();                                \
+        uint32_t round;                                                         \
+                                                                                \
+        for (round = 0; round < TEST_DECODE_BENCH_ROUNDS; round++)              \
+        {                                                                       \
+            call;                                                               \
+            __asm__ volatile ("" : : "r" (samples) : "memory");                 \
+        }                                                                       \
+        cycles = SIM_TEST_HostCycles() - cycles;                                \
+        lTEST_DECODE_Report((name), cycles, SIM_TEST_HostNs() - ns);            \
+    } while (0)
+
+static void lTEST_DECODE_Bench(void)
+{
+    static uint32_t raw[TEST_DECODE_BENCH_BLOCK];
+    static uint8_t data[TEST_DECODE_BENCH_BLOCK * ADC_DECODE_SAMPLE_SIZE_24];
+    static int32_t samples[TEST_DECODE_BENCH_BLOCK];
+
+    lTEST_DECODE_Fill((uint8_t*) raw, sizeof(raw));
+    lTEST_DECODE_Fill(data, sizeof(data));
+
+    TEST_DECODE_BENCH("Block24", ADC_DECODE_Block24(data, samples, TEST_DECODE_BENCH_BLOCK));
+    TEST_DECODE_BENCH("Block24Ref", ADC_DECODE_Block24Ref(data, samples, TEST_DECODE_BENCH_BLOCK));
+    TEST_DECODE_BENCH("Block32", ADC_DECODE_Block32(raw, samples, TEST_DECODE_BENCH_BLOCK));
+    TEST_DECODE_BENCH("Block32Ref", ADC_DECODE_Block32Ref(raw, samples, TEST_DECODE_BENCH_BLOCK));
+    TEST_DECODE_BENCH("Block32Sgn", ADC_DECODE_Block32Sgn(raw, samples, TEST_DECODE_BENCH_BLOCK));
+    TEST_DECODE_BENCH("Block32SgnRef", ADC_DECODE_Block32SgnRef(raw, samples, TEST_DECODE_BENCH_BLOCK));
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Main
+// *****************************************************************************
+// *****************************************************************************
+
+int main(void)
+{
+    lTEST_DECODE_Block24();
+    lTEST_DECODE_Block32("Block32", ADC_DECODE_Block32, ADC_DECODE_Block32Ref);
+    lTEST_DECODE_Block32("Block32Sgn", ADC_DECODE_Block32Sgn, ADC_DECODE_Block32SgnRef);
+    lTEST_DECODE_Sgn();
+
+    lTEST_DECODE_Bench();
+
+    return SIM_TEST_Finish();
+}
+
+/*******************************************************************************
+ End of File
+ */
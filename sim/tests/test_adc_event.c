@@ -0,0 +1,175 @@
+/*******************************************************************************
+  ADC Event Mode Test
+
+  File Name:
+    test_adc_event.c
+
+  Summary:
+    CONTINUOUS ... EVENT on the simulated image.
+
+  Description:
+    The event mode chain runs without a CPU interrupt per sample: EXTINT14
+    through EVSYS drives CS low and triggers the TX DMAC beat, the RX beat
+    lands in the linked descriptor ring and its event drives CS high. The
+    test checks
+
+      - a console run: every block arrives, one EIC and one DMAC interrupt
+        per block, every block start stamped, a latency for every block
+        but the first which stays below one sample period
+      - a driver mode run after it, so the stop restored SERCOM1 and the
+        DMAC channels for DRV_SPI
+      - the samples of a run started through ADC_ACQ_Start while the input
+        ramps: each one is a new conversion in order, none lost or read
+        twice
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdlib.h>
+#include "adc_acq.h"
+#include "adc_decode.h"
+#include "mcp3564_sim.h"
+#include "sim_core.h"
+#include "sim_test.h"
+#include "sim_test_image.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+#define TEST_EVENT_BLOCKS                   8U
+#define TEST_EVENT_RAMP_BLOCKS              16U
+#define TEST_EVENT_RAMP_SAMPLES             (TEST_EVENT_RAMP_BLOCKS * ADC_ACQ_BLOCK_SAMPLES)
+
+/* CPU clock of the image, for the latency bound */
+#define TEST_EVENT_CPU_HZ                   120000000U
+
+/* Input ramp: 1 uV per us from the start of the run, 3.3 V reference */
+#define TEST_EVENT_REF_UV                   3300000
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data
+// *****************************************************************************
+// *****************************************************************************
+
+static uint64_t testEventRampStart;
+static uint32_t testEventRaw[TEST_EVENT_RAMP_SAMPLES];
+static int32_t testEventCodes[TEST_EVENT_RAMP_SAMPLES];
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+static int32_t lTEST_EVENT_Source(uint32_t input, uint64_t time, uintptr_t context)
+{
+    if (input == MCP3564_SIM_INPUT_REFINP)
+    {
+        return TEST_EVENT_REF_UV;
+    }
+    if (input == MCP3564_SIM_INPUT_CH(0))
+    {
+        return (int32_t) ((time - testEventRampStart) / 1000U);
+    }
+
+    return 0;
+}
+
+static void lTEST_EVENT_Console(void)
+{
+    ADC_ACQ_STATS stats;
+    uint32_t period;
+
+    SIM_TEST_CHECK(SIM_TEST_ImageCommand("CONTINUOUS 8 EVENT"));
+    ADC_ACQ_StatsGet(&stats);
+
+    SIM_TEST_Note("EVENT: %u samples, %u interrupts, latency %u..%u cycles (%u), %u stamps, %u missed",
+                  stats.samples, stats.interrupts, stats.latencyMin, stats.latencyMax, stats.latencyCount,
+                  stats.stamps, stats.stampMisses);
+    SIM_TEST_CHECK(stats.mode == ADC_ACQ_MODE_EVENT);
+    SIM_TEST_CHECK(stats.blocks == TEST_EVENT_BLOCKS);
+    SIM_TEST_CHECK(stats.samples == (TEST_EVENT_BLOCKS * ADC_ACQ_BLOCK_SAMPLES));
+    SIM_TEST_CHECK(stats.errors == 0U);
+    SIM_TEST_CHECK(stats.interrupts <= (2U * TEST_EVENT_BLOCKS) + 1U);
+    SIM_TEST_CHECK(stats.stamps == TEST_EVENT_BLOCKS);
+    SIM_TEST_CHECK(stats.stampMisses == 0U);
+    SIM_TEST_CHECK(stats.latencyCount == (TEST_EVENT_BLOCKS - 1U));
+
+    /* The default 6 MHz MCLK converts at 5859 sps */
+    period = TEST_EVENT_CPU_HZ / 5859U;
+    SIM_TEST_CHECK((stats.latencyMin != 0U) && (stats.latencyMax < period));
+
+    SIM_TEST_CHECK(SIM_TEST_ImageCommand("CONTINUOUS 2"));
+    ADC_ACQ_StatsGet(&stats);
+    SIM_TEST_CHECK(stats.mode == ADC_ACQ_MODE_DRIVER);
+    SIM_TEST_CHECK(stats.blocks == 2U);
+    SIM_TEST_CHECK(stats.errors == 0U);
+    SIM_TEST_CHECK(stats.overruns == 0U);
+}
+
+static void lTEST_EVENT_Ramp(void)
+{
+    uint32_t count = 0U;
+    uint32_t misordered = 0U;
+    int32_t step;
+    int32_t delta;
+    uint32_t i;
+
+    testEventRampStart = SIM_Now();
+    MCP3564_SIM_SourceSet(lTEST_EVENT_Source, 0U);
+
+    SIM_TEST_CHECK(ADC_ACQ_Start(ADC_ACQ_MODE_EVENT, ADC_ACQ_FORMAT_24));
+    for (i = 0U; (i < 1000U) && (count < TEST_EVENT_RAMP_SAMPLES); i++)
+    {
+        SIM_TEST_ImageRun(1000000U);
+        count += ADC_ACQ_Read(&testEventRaw[count], TEST_EVENT_RAMP_SAMPLES - count);
+    }
+    ADC_ACQ_Stop();
+    MCP3564_SIM_SourceSet(NULL, 0U);
+
+    SIM_TEST_CHECK(count == TEST_EVENT_RAMP_SAMPLES);
+    ADC_DECODE_Block32(testEventRaw, testEventCodes, count);
+
+    /* Each conversion is one sample period of ramp above the one before */
+    step = testEventCodes[2] - testEventCodes[1];
+    for (i = 2U; i < count; i++)
+    {
+        delta = testEventCodes[i] - testEventCodes[i - 1U];
+        if (abs(delta - step) > (step / 10))
+        {
+            misordered++;
+        }
+    }
+
+    SIM_TEST_Note("ramp: %u samples, %d codes per sample, %u out of step", count, step, misordered);
+    SIM_TEST_CHECK(step > 0);
+    SIM_TEST_CHECK(misordered == 0U);
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Main
+// *****************************************************************************
+// *****************************************************************************
+
+int main(void)
+{
+    SIM_TEST_ImageInitialize();
+
+    lTEST_EVENT_Console();
+    lTEST_EVENT_Ramp();
+
+    return SIM_TEST_Finish();
+}
+
+/*******************************************************************************
+ End of File
+ */
@@ -0,0 +1,365 @@
+/*******************************************************************************
+  Filter Pipeline Test
+
+  File Name:
+    test_adc_filter.c
+
+  Summary:
+    ADC_FILTER against a per-sample reference, a recorded output and the
+    responses its stages are designed for.
+
+  Description:
+    The header promises bit-identical output for the same coefficients and
+    samples, wherever it runs. The test checks that
+
+      - a FIR, notch and DC blocker chain with fixed coefficients, fed in
+        chunks of random size, gives exactly the output of a plain
+        per-sample implementation of the same arithmetic (Q2.30, round
+        half up on the FIR, error feedback on the recursive stages)
+      - that output still hashes to TEST_FILTER_GOLDEN; a change of the
+        arithmetic has to come with a new value
+      - the notch of ADC_FILTER_NotchDesign takes a 50 Hz tone down by at
+        least 60 dB and passes one at 7 Hz with the gain of its quantized
+        coefficients
+      - the DC blocker settles on 0, not on a truncation bias, and outputs
+        saturate to the int32 range
+      - the per stage sample counter adds up the samples processed
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <complex.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include "adc_filter.h"
+#include "sim_test.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+#ifndef M_PI
+#define M_PI                                3.14159265358979323846
+#endif
+
+#define TEST_FILTER_RATE_HZ                 1000U
+#define TEST_FILTER_NOTCH_HZ                50U
+#define TEST_FILTER_PASS_HZ                 7U
+#define TEST_FILTER_SAMPLES                 20000U
+#define TEST_FILTER_FIR_TAPS                9U
+#define TEST_FILTER_CHUNK_MAX               100U
+
+/* Outputs the tone measurements skip: the notch poles settle in ~1/(pi * 4 Hz) */
+#define TEST_FILTER_SETTLE                  10000U
+
+/* FNV-1a of the chain output on lTEST_FILTER_ChainInput */
+#define TEST_FILTER_GOLDEN                  0xA3E03DF0U
+
+#define TEST_FILTER_ROUND                   (1LL << (ADC_FILTER_SHIFT - 1U))
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data
+// *****************************************************************************
+// *****************************************************************************
+
+static int32_t testFilterIn[TEST_FILTER_SAMPLES];
+static int32_t testFilterOut[TEST_FILTER_SAMPLES];
+static int32_t testFilterRef[TEST_FILTER_SAMPLES];
+
+/* Hann windowed sinc, low pass at 100 Hz */
+static const int32_t testFilterFir[TEST_FILTER_FIR_TAPS] =
+{
+    4795936, 37434535, 106375500, 181711048, 214748365, 181711048, 106375500, 37434535, 4795936
+};
+
+/* ADC_FILTER_NotchDesign(50, 1000) */
+static const int32_t testFilterNotch[ADC_FILTER_BIQUAD_COEFS] =
+{
+    1061980973, -2020007849, 1061980973, -2016713034, 1046925307
+};
+
+static uint32_t testFilterSeed = 0x85EBCA6BU;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+static uint32_t lTEST_FILTER_Random(void)
+{
+    testFilterSeed ^= testFilterSeed << 13;
+    testFilterSeed ^= testFilterSeed >> 17;
+    testFilterSeed ^= testFilterSeed << 5;
+
+    return testFilterSeed;
+}
+
+static int32_t lTEST_FILTER_Saturate(int64_t value)
+{
+    return (value > INT32_MAX) ? INT32_MAX : ((value < INT32_MIN) ? INT32_MIN : (int32_t) value);
+}
+
+/* The stages one sample at a time, from zero state */
+static void lTEST_FILTER_RefFir(const int32_t* coef, uint32_t taps, int32_t* samples, uint32_t count)
+{
+    static int32_t x[TEST_FILTER_SAMPLES];
+    int64_t acc;
+    uint32_t i;
+    uint32_t k;
+
+    memcpy(x, samples, count * sizeof(int32_t));
+    for (i = 0; i < count; i++)
+    {
+        acc = TEST_FILTER_ROUND;
+        for (k = 0; (k < taps) && (k <= i); k++)
+        {
+            acc += (int64_t) coef[k] * x[i - k];
+        }
+        samples[i] = lTEST_FILTER_Saturate(acc >> ADC_FILTER_SHIFT);
+    }
+}
+
+static void lTEST_FILTER_RefBiquad(const int32_t* c, int32_t* samples, uint32_t count)
+{
+    int32_t x1 = 0, x2 = 0, y1 = 0, y2 = 0;
+    int64_t error = 0;
+    int64_t acc;
+    uint32_t i;
+
+    for (i = 0; i < count; i++)
+    {
+        acc = error + (int64_t) c[0] * samples[i] + (int64_t) c[1] * x1 + (int64_t) c[2] * x2 -
+              (int64_t) c[3] * y1 - (int64_t) c[4] * y2;
+        x2 = x1;
+        x1 = samples[i];
+        y2 = y1;
+        y1 = lTEST_FILTER_Saturate(acc >> ADC_FILTER_SHIFT);
+        error = acc - ((int64_t) y1 << ADC_FILTER_SHIFT);
+        samples[i] = y1;
+    }
+}
+
+static void lTEST_FILTER_RefDcBlock(int32_t pole, int32_t* samples, uint32_t count)
+{
+    int32_t x1 = 0, y1 = 0;
+    int64_t error = 0;
+    int64_t acc;
+    uint32_t i;
+
+    for (i = 0; i < count; i++)
+    {
+        acc = error + ((int64_t) samples[i] - x1) * ADC_FILTER_ONE + (int64_t) pole * y1;
+        x1 = samples[i];
+        y1 = lTEST_FILTER_Saturate(acc >> ADC_FILTER_SHIFT);
+        error = acc - ((int64_t) y1 << ADC_FILTER_SHIFT);
+        samples[i] = y1;
+    }
+}
+
+/* Runs count samples through the module in random chunks */
+static void lTEST_FILTER_Feed(int32_t* samples, uint32_t count)
+{
+    uint32_t chunk;
+
+    while (count != 0U)
+    {
+        chunk = 1U + (lTEST_FILTER_Random() % TEST_FILTER_CHUNK_MAX);
+        if (chunk > count)
+        {
+            chunk = count;
+        }
+
+        ADC_FILTER_Process(samples, chunk);
+        samples += chunk;
+        count -= chunk;
+    }
+}
+
+/* Amplitude of the tone at hz in samples[from..count-1], by correlation */
+static double lTEST_FILTER_Tone(const int32_t* samples, uint32_t from, uint32_t count, uint32_t hz)
+{
+    double complex sum = 0.0;
+    uint32_t i;
+
+    for (i = from; i < count; i++)
+    {
+        sum += samples[i] * cexp(-2.0 * I * M_PI * hz * i / TEST_FILTER_RATE_HZ);
+    }
+
+    return 2.0 * cabs(sum) / (count - from);
+}
+
+/* |H| of the quantized biquad at hz */
+static double lTEST_FILTER_BiquadGain(const int32_t* c, uint32_t hz)
+{
+    double complex z1 = cexp(-2.0 * I * M_PI * hz / TEST_FILTER_RATE_HZ);
+    double complex z2 = z1 * z1;
+
+    return cabs((c[0] + c[1] * z1 + c[2] * z2) / (ADC_FILTER_ONE + c[3] * z1 + c[4] * z2));
+}
+
+/* Integers only, so the golden hash does not depend on the host libm:
+   an offset, a 50 Hz triangle, a step and noise, within 25 bits */
+static void lTEST_FILTER_ChainInput(void)
+{
+    const int32_t period = TEST_FILTER_RATE_HZ / TEST_FILTER_NOTCH_HZ;
+    int32_t phase;
+    uint32_t i;
+
+    for (i = 0; i < TEST_FILTER_SAMPLES; i++)
+    {
+        phase = (int32_t) (i % (uint32_t) period);
+        testFilterIn[i] = 1000000 + (400000 * ((phase < (period / 2)) ? phase : (period - phase))) - 2000000 +
+                          ((i >= (TEST_FILTER_SAMPLES / 2U)) ? 3000000 : 0) +
+                          (int32_t) (lTEST_FILTER_Random() % 2001U) - 1000;
+    }
+}
+
+/* Mains hum and a slow signal, for the notch */
+static void lTEST_FILTER_ToneInput(void)
+{
+    uint32_t i;
+
+    for (i = 0; i < TEST_FILTER_SAMPLES; i++)
+    {
+        testFilterIn[i] = (int32_t) lround(2000000.0 * sin(2.0 * M_PI * TEST_FILTER_NOTCH_HZ * i / TEST_FILTER_RATE_HZ)) +
+                          (int32_t) lround(1000000.0 * sin(2.0 * M_PI * TEST_FILTER_PASS_HZ * i / TEST_FILTER_RATE_HZ));
+    }
+}
+
+static void lTEST_FILTER_Chain(void)
+{
+    ADC_FILTER_STAGE_INFO info;
+    uint32_t hash = 0x811C9DC5U;
+    uint32_t mismatches = 0U;
+    uint32_t i;
+
+    ADC_FILTER_Clear();
+    SIM_TEST_CHECK(ADC_FILTER_StageAdd(ADC_FILTER_TYPE_FIR, testFilterFir, TEST_FILTER_FIR_TAPS));
+    SIM_TEST_CHECK(ADC_FILTER_StageAdd(ADC_FILTER_TYPE_BIQUAD, testFilterNotch, ADC_FILTER_BIQUAD_COEFS));
+    SIM_TEST_CHECK(ADC_FILTER_StageAdd(ADC_FILTER_TYPE_DCBLOCK, NULL, ADC_FILTER_DCBLOCK_COEFS));
+
+    memcpy(testFilterOut, testFilterIn, sizeof(testFilterOut));
+    lTEST_FILTER_Feed(testFilterOut, TEST_FILTER_SAMPLES);
+
+    memcpy(testFilterRef, testFilterIn, sizeof(testFilterRef));
+    lTEST_FILTER_RefFir(testFilterFir, TEST_FILTER_FIR_TAPS, testFilterRef, TEST_FILTER_SAMPLES);
+    lTEST_FILTER_RefBiquad(testFilterNotch, testFilterRef, TEST_FILTER_SAMPLES);
+    lTEST_FILTER_RefDcBlock(ADC_FILTER_DCBLOCK_POLE_DEFAULT, testFilterRef, TEST_FILTER_SAMPLES);
+
+    for (i = 0; i < TEST_FILTER_SAMPLES; i++)
+    {
+        if (testFilterOut[i] != testFilterRef[i])
+        {
+            if (mismatches == 0U)
+            {
+                SIM_TEST_Note("chain: sample %u is %d, expected %d", i, testFilterOut[i], testFilterRef[i]);
+            }
+            mismatches++;
+        }
+
+        hash = (hash ^ (uint32_t) testFilterOut[i]) * 0x01000193U;
+    }
+    SIM_TEST_CHECK(mismatches == 0U);
+
+    SIM_TEST_Note("chain: output hash 0x%08X", hash);
+    SIM_TEST_CHECK(hash == TEST_FILTER_GOLDEN);
+
+    for (i = 0; ADC_FILTER_StageGet(i, &info); i++)
+    {
+        SIM_TEST_CHECK((info.samples == TEST_FILTER_SAMPLES) && (info.cycles == 0U));
+    }
+    SIM_TEST_CHECK(i == 3U);
+
+    ADC_FILTER_Reset();
+    SIM_TEST_CHECK(ADC_FILTER_StageGet(0U, &info) && (info.samples == 0U));
+}
+
+static void lTEST_FILTER_Notch(void)
+{
+    double notchIn = lTEST_FILTER_Tone(testFilterIn, TEST_FILTER_SETTLE, TEST_FILTER_SAMPLES, TEST_FILTER_NOTCH_HZ);
+    double passIn = lTEST_FILTER_Tone(testFilterIn, TEST_FILTER_SETTLE, TEST_FILTER_SAMPLES, TEST_FILTER_PASS_HZ);
+    double notchOut;
+    double passOut;
+    double passGain = lTEST_FILTER_BiquadGain(testFilterNotch, TEST_FILTER_PASS_HZ);
+
+    ADC_FILTER_Clear();
+    SIM_TEST_CHECK(ADC_FILTER_StageAdd(ADC_FILTER_TYPE_BIQUAD, testFilterNotch, ADC_FILTER_BIQUAD_COEFS));
+
+    memcpy(testFilterOut, testFilterIn, sizeof(testFilterOut));
+    lTEST_FILTER_Feed(testFilterOut, TEST_FILTER_SAMPLES);
+
+    notchOut = lTEST_FILTER_Tone(testFilterOut, TEST_FILTER_SETTLE, TEST_FILTER_SAMPLES, TEST_FILTER_NOTCH_HZ);
+    passOut = lTEST_FILTER_Tone(testFilterOut, TEST_FILTER_SETTLE, TEST_FILTER_SAMPLES, TEST_FILTER_PASS_HZ);
+
+    SIM_TEST_Note("notch: %u Hz %.1f dB, %u Hz %.4f dB (quantized design %.4f dB)", TEST_FILTER_NOTCH_HZ,
+                  20.0 * log10(notchOut / notchIn), TEST_FILTER_PASS_HZ, 20.0 * log10(passOut / passIn),
+                  20.0 * log10(passGain));
+    SIM_TEST_CHECK((notchOut / notchIn) < 1e-3);
+    SIM_TEST_CHECK(fabs((passOut / passIn) - passGain) < 1e-4);
+}
+
+static void lTEST_FILTER_DcBlock(void)
+{
+    static const int32_t scale[1] = { INT32_MAX };
+    int32_t big[2] = { INT32_MAX / 2 + 1000, INT32_MIN / 2 - 1000 };
+    uint32_t i;
+
+    ADC_FILTER_Clear();
+    SIM_TEST_CHECK(ADC_FILTER_StageAdd(ADC_FILTER_TYPE_DCBLOCK, NULL, ADC_FILTER_DCBLOCK_COEFS));
+
+    for (i = 0; i < TEST_FILTER_SAMPLES; i++)
+    {
+        testFilterOut[i] = 4000000;
+    }
+    lTEST_FILTER_Feed(testFilterOut, TEST_FILTER_SAMPLES);
+    SIM_TEST_Note("DC blocker: 4000000 settles on %d", testFilterOut[TEST_FILTER_SAMPLES - 1U]);
+    SIM_TEST_CHECK(testFilterOut[TEST_FILTER_SAMPLES - 1U] == 0);
+
+    /* A gain of almost 2 saturates both ends */
+    ADC_FILTER_Clear();
+    SIM_TEST_CHECK(ADC_FILTER_StageAdd(ADC_FILTER_TYPE_FIR, scale, 1U));
+    ADC_FILTER_Process(big, 2U);
+    SIM_TEST_CHECK((big[0] == INT32_MAX) && (big[1] == INT32_MIN));
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Main
+// *****************************************************************************
+// *****************************************************************************
+
+int main(void)
+{
+    int32_t notch[ADC_FILTER_BIQUAD_COEFS];
+    uint32_t i;
+
+    /* The design may differ in the last bit with another libm */
+    SIM_TEST_CHECK(ADC_FILTER_NotchDesign(TEST_FILTER_NOTCH_HZ, TEST_FILTER_RATE_HZ, notch));
+    for (i = 0; i < ADC_FILTER_BIQUAD_COEFS; i++)
+    {
+        SIM_TEST_CHECK(abs(notch[i] - testFilterNotch[i]) <= 1);
+    }
+    SIM_TEST_CHECK(!ADC_FILTER_NotchDesign(TEST_FILTER_RATE_HZ / 2U, TEST_FILTER_RATE_HZ, notch));
+
+    lTEST_FILTER_ChainInput();
+    lTEST_FILTER_Chain();
+    lTEST_FILTER_ToneInput();
+    lTEST_FILTER_Notch();
+    lTEST_FILTER_DcBlock();
+
+    return SIM_TEST_Finish();
+}
+
+/*******************************************************************************
+ End of File
+ */
@@ -0,0 +1,92 @@
+/*******************************************************************************
+  ADC Top Rate Test
+
+  File Name:
+    test_adc_rate.c
+
+  Summary:
+    CONTINUOUS sustained at the fastest data rates on the simulated image.
+
+  Description:
+    At 125 ksps (MCLK 48 MHz / 3, the fastest DFLL rate) and 156.25 ksps
+    (MCLK 120 MHz / 6 from DPLL0) a run of 64 blocks, in driver and in
+    event mode, must deliver every conversion: no overrun on the SPI queue,
+    no sample dropped from the FIFO, no transfer error.
+
+    ADC_ACQ_Start must also refuse the driver mode once the EIC interrupt
+    could preempt the DRV_SPI DMAC interrupts.
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include "definitions.h"
+#include "adc_acq.h"
+#include "sim_test.h"
+#include "sim_test_image.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+#define TEST_RATE_BLOCKS                    64U
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+static void lTEST_RATE_Run(const char* rate, const char* command)
+{
+    ADC_ACQ_STATS stats;
+
+    SIM_TEST_CHECK(SIM_TEST_ImageCommand(rate));
+    SIM_TEST_CHECK(SIM_TEST_ImageCommand(command));
+    ADC_ACQ_StatsGet(&stats);
+
+    SIM_TEST_Note("%s, %s: %u samples, %u overruns, %u dropped, FIFO high-water %u", rate, command,
+                  stats.samples, stats.overruns, stats.dropped, stats.highWater);
+    SIM_TEST_CHECK(stats.blocks == TEST_RATE_BLOCKS);
+    SIM_TEST_CHECK(stats.samples == (TEST_RATE_BLOCKS * ADC_ACQ_BLOCK_SAMPLES));
+    SIM_TEST_CHECK(stats.overruns == 0U);
+    SIM_TEST_CHECK(stats.dropped == 0U);
+    SIM_TEST_CHECK(stats.errors == 0U);
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Main
+// *****************************************************************************
+// *****************************************************************************
+
+int main(void)
+{
+    uint32_t priority;
+
+    SIM_TEST_ImageInitialize();
+
+    lTEST_RATE_Run("RATE 125000", "CONTINUOUS 64");
+    lTEST_RATE_Run("RATE 156250", "CONTINUOUS 64");
+    lTEST_RATE_Run("RATE 125000", "CONTINUOUS 64 EVENT");
+    lTEST_RATE_Run("RATE 156250", "CONTINUOUS 64 EVENT");
+
+    /* The data-ready interrupt above the DMAC ones could break into DRV_SPI */
+    priority = NVIC_GetPriority(EIC_EXTINT_14_IRQn);
+    NVIC_SetPriority(EIC_EXTINT_14_IRQn, priority - 1U);
+    SIM_TEST_CHECK(!ADC_ACQ_Start(ADC_ACQ_MODE_DRIVER, ADC_ACQ_FORMAT_24));
+    NVIC_SetPriority(EIC_EXTINT_14_IRQn, priority);
+    SIM_TEST_CHECK(ADC_ACQ_Start(ADC_ACQ_MODE_DRIVER, ADC_ACQ_FORMAT_24));
+    ADC_ACQ_Stop();
+
+    return SIM_TEST_Finish();
+}
+
+/*******************************************************************************
+ End of File
+ */
@@ -0,0 +1,235 @@
+/*******************************************************************************
+  ADC Scan Test
+
+  File Name:
+    test_adc_scan.c
+
+  Summary:
+    SCAN 0xFF on the simulated image: channel sorting and the error counters.
+
+  Description:
+    CH0..CH7 get distinct voltages. The test checks that
+
+      - SCAN 0xFF 32 collects at least 32 samples on each of the eight
+        single ended channels and none elsewhere, each with the voltage of
+        its own input, and counts no sequence error, unexpected ID or
+        overflow
+      - conversions lost while the data-ready interrupt is held off show
+        up as sequence errors, at most one per window
+      - channel IDs outside the mask, here DIFF_A slipped into the SCAN
+        register of the model behind the firmware, are counted as
+        unexpected and kept out of the channel buffers
+      - inputs of 1.5 Vref either way read as the 25 bit codes of
+        DATA_FORMAT 11, decoded with their SGN bit rather than wrapped
+        into the other sign at bit 23
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include "definitions.h"
+#include "adc_scan.h"
+#include "mcp3564_reg.h"
+#include "mcp3564_sim.h"
+#include "sim_core.h"
+#include "sim_test.h"
+#include "sim_test_image.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+#define TEST_SCAN_MASK                      0xFFU
+#define TEST_SCAN_SINGLE_ENDED              8U
+#define TEST_SCAN_SAMPLES                   32U
+
+/* CHn gets (n + 1) * 100 mV */
+#define TEST_SCAN_STEP_UV                   100000
+
+/* Masked windows, not multiples of a scan cycle (8 conversions) */
+#define TEST_SCAN_WINDOWS                   3U
+
+/* Over-range input: 1.5 * 3.3 V reads 1.5 * 2^23 */
+#define TEST_SCAN_OVER_UV                   4950000
+#define TEST_SCAN_OVER_CODE                 12582912
+
+/* Long enough for a few 128 sample blocks, which is what ADC_ACQ_Read hands out */
+#define TEST_SCAN_RUN_NS                    30000000U
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+static void lTEST_SCAN_Run(uint64_t duration)
+{
+    uint64_t end = SIM_Now() + duration;
+
+    while (SIM_Now() < end)
+    {
+        SIM_TEST_ImageRun(100000U);
+        (void) ADC_SCAN_Process();
+    }
+}
+
+static int64_t lTEST_SCAN_Mean(uint32_t channel, uint32_t* count)
+{
+    const int32_t* data = ADC_SCAN_ChannelGet(channel, count);
+    int64_t sum = 0;
+    uint32_t i;
+
+    for (i = 0U; i < *count; i++)
+    {
+        sum += data[i];
+    }
+
+    return (*count != 0U) ? (sum / (int64_t) *count) : 0;
+}
+
+static void lTEST_SCAN_Console(void)
+{
+    ADC_SCAN_STATS stats;
+    uint32_t total = 0U;
+    uint32_t count;
+    int64_t first = 0;
+    int64_t mean;
+    uint32_t channel;
+
+    SIM_TEST_CHECK(SIM_TEST_ImageCommand("SCAN 0xFF 32"));
+    ADC_SCAN_StatsGet(&stats);
+
+    for (channel = 0U; channel < ADC_SCAN_CHANNELS; channel++)
+    {
+        mean = lTEST_SCAN_Mean(channel, &count);
+        total += count;
+
+        if (channel >= TEST_SCAN_SINGLE_ENDED)
+        {
+            SIM_TEST_CHECK(count == 0U);
+            continue;
+        }
+
+        SIM_TEST_Note("%-6s n: %u  mean: %lld", ADC_SCAN_ChannelName(channel), count, (long long) mean);
+        SIM_TEST_CHECK((count >= TEST_SCAN_SAMPLES) && (count <= (TEST_SCAN_SAMPLES + 1U)));
+
+        /* Every channel reads its own input: CHn is (n + 1) times CH0 */
+        if (channel == 0U)
+        {
+            first = mean;
+            SIM_TEST_CHECK(first > 0);
+        }
+        else
+        {
+            SIM_TEST_CHECK(llabs(mean - (first * (int64_t) (channel + 1U))) <= (first / 100));
+        }
+    }
+
+    SIM_TEST_Note("SCAN 0xFF 32: %u samples, %u cycles, %u sequence, %u unexpected, %u overflow",
+                  stats.samples, stats.cycles, stats.sequence, stats.unexpected, stats.overflow);
+    SIM_TEST_CHECK(stats.mask == TEST_SCAN_MASK);
+    SIM_TEST_CHECK(stats.samples == total);
+    SIM_TEST_CHECK(stats.cycles >= TEST_SCAN_SAMPLES);
+    SIM_TEST_CHECK(stats.sequence == 0U);
+    SIM_TEST_CHECK(stats.unexpected == 0U);
+    SIM_TEST_CHECK(stats.overflow == 0U);
+}
+
+static void lTEST_SCAN_Errors(void)
+{
+    static const uint64_t windows[TEST_SCAN_WINDOWS] = { 900000U, 1900000U, 2300000U };
+    ADC_SCAN_STATS stats;
+    uint32_t count;
+    uint32_t scan;
+    uint32_t i;
+
+    SIM_TEST_CHECK(ADC_SCAN_Start(TEST_SCAN_MASK, 0U, 0U));
+    lTEST_SCAN_Run(TEST_SCAN_RUN_NS);
+
+    /* Conversions lost while the data-ready interrupt is held off */
+    for (i = 0U; i < TEST_SCAN_WINDOWS; i++)
+    {
+        NVIC_DisableIRQ(EIC_EXTINT_14_IRQn);
+        SIM_TEST_ImageRun(windows[i]);
+        NVIC_EnableIRQ(EIC_EXTINT_14_IRQn);
+        lTEST_SCAN_Run(TEST_SCAN_RUN_NS);
+    }
+
+    ADC_SCAN_StatsGet(&stats);
+    SIM_TEST_Note("held off %u times: %u sequence errors", TEST_SCAN_WINDOWS, stats.sequence);
+    SIM_TEST_CHECK((stats.sequence >= 1U) && (stats.sequence <= TEST_SCAN_WINDOWS));
+    SIM_TEST_CHECK(stats.unexpected == 0U);
+
+    /* DIFF_A joins the scan behind the firmware */
+    scan = MCP3564_SIM_RegisterGet(MCP3564_REG_SCAN);
+    MCP3564_SIM_RegisterSet(MCP3564_REG_SCAN, scan | ADC_SCAN_DIFF_A);
+    lTEST_SCAN_Run(TEST_SCAN_RUN_NS);
+    MCP3564_SIM_RegisterSet(MCP3564_REG_SCAN, scan);
+    lTEST_SCAN_Run(TEST_SCAN_RUN_NS);
+
+    ADC_SCAN_Stop();
+    (void) ADC_SCAN_Process();
+
+    count = stats.sequence;
+    ADC_SCAN_StatsGet(&stats);
+    SIM_TEST_Note("DIFF_A for 30 ms: %u unexpected, %u cycles", stats.unexpected, stats.cycles);
+    SIM_TEST_CHECK(stats.unexpected != 0U);
+    SIM_TEST_CHECK(stats.sequence == count);
+    SIM_TEST_CHECK(ADC_SCAN_ChannelGet(8U, &count) != NULL);
+    SIM_TEST_CHECK(count == 0U);
+}
+
+static void lTEST_SCAN_OverRange(void)
+{
+    uint32_t count;
+    int64_t mean;
+
+    MCP3564_SIM_InputSet(MCP3564_SIM_INPUT_CH(0U), TEST_SCAN_OVER_UV);
+    MCP3564_SIM_InputSet(MCP3564_SIM_INPUT_CH(1U), -TEST_SCAN_OVER_UV);
+
+    SIM_TEST_CHECK(ADC_SCAN_Start(0x03U, 0U, 0U));
+    lTEST_SCAN_Run(TEST_SCAN_RUN_NS);
+    ADC_SCAN_Stop();
+    (void) ADC_SCAN_Process();
+
+    mean = lTEST_SCAN_Mean(0U, &count);
+    SIM_TEST_Note("+1.5 Vref: n: %u  mean: %lld", count, (long long) mean);
+    SIM_TEST_CHECK((count != 0U) && (llabs(mean - TEST_SCAN_OVER_CODE) <= 1));
+
+    mean = lTEST_SCAN_Mean(1U, &count);
+    SIM_TEST_Note("-1.5 Vref: n: %u  mean: %lld", count, (long long) mean);
+    SIM_TEST_CHECK((count != 0U) && (llabs(mean + TEST_SCAN_OVER_CODE) <= 1));
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Main
+// *****************************************************************************
+// *****************************************************************************
+
+int main(void)
+{
+    uint32_t channel;
+
+    SIM_TEST_ImageInitialize();
+
+    for (channel = 0U; channel < TEST_SCAN_SINGLE_ENDED; channel++)
+    {
+        MCP3564_SIM_InputSet(MCP3564_SIM_INPUT_CH(channel), (int32_t) (channel + 1U) * TEST_SCAN_STEP_UV);
+    }
+
+    lTEST_SCAN_Console();
+    lTEST_SCAN_Errors();
+    lTEST_SCAN_OverRange();
+
+    return SIM_TEST_Finish();
+}
+
+/*******************************************************************************
+ End of File
+ */
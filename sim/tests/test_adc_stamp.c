@@ -0,0 +1,61 @@
+/*******************************************************************************
+  ADC Time Stamp Test
+
+  File Name:
+    test_adc_stamp.c
+
+  Summary:
+    Block time stamps of CONTINUOUS on the simulated image.
+
+  Description:
+    The conversions the MCP3564 makes between the CONVERSION command and the
+    data-ready handler taking over leave a capture in TC0. ADC_ACQ_Start has
+    to drop it, else the first block finds the capture overflowed and its
+    stamp is missed. Every block of a run must be stamped, in a first run
+    and in the ones after it.
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include "adc_acq.h"
+#include "sim_test.h"
+#include "sim_test_image.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Main
+// *****************************************************************************
+// *****************************************************************************
+
+int main(void)
+{
+    static const char* const commands[] = { "CONTINUOUS 2", "CONTINUOUS 16", "CONTINUOUS 1" };
+    static const uint32_t blocks[] = { 2U, 16U, 1U };
+    ADC_ACQ_STATS stats;
+    uint32_t i;
+
+    SIM_TEST_ImageInitialize();
+
+    for (i = 0U; i < (sizeof(blocks) / sizeof(blocks[0])); i++)
+    {
+        SIM_TEST_CHECK(SIM_TEST_ImageCommand(commands[i]));
+        ADC_ACQ_StatsGet(&stats);
+
+        SIM_TEST_Note("%s: %u blocks, %u stamps, %u missed", commands[i],
+                      stats.blocks, stats.stamps, stats.stampMisses);
+        SIM_TEST_CHECK(stats.blocks == blocks[i]);
+        SIM_TEST_CHECK(stats.overruns == 0U);
+        SIM_TEST_CHECK(stats.stamps == blocks[i]);
+        SIM_TEST_CHECK(stats.stampMisses == 0U);
+    }
+
+    return SIM_TEST_Finish();
+}
+
+/*******************************************************************************
+ End of File
+ */
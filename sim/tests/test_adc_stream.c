@@ -0,0 +1,346 @@
+/*******************************************************************************
+  Binary Stream Test
+
+  File Name:
+    test_adc_stream.c
+
+  Summary:
+    The firmware's frame encoder against the host receiver's parser.
+
+  Description:
+    src/adc_stream.c is linked with the console UART replaced by a capture
+    buffer and host/adc_rx.c parses what it wrote, so a framing, packing or
+    CRC difference between the two sides fails here instead of on the
+    line. The stream carries samples in chunks of random size, MUX and
+    SCAN masks which change mid-frame, values beyond the 24 bit range, a
+    partial frame at a flush, frames dropped on a full UART ring, and
+    console text between frames. Every frame must arrive with its
+    sequence number, mask and samples (clipped as the firmware clips
+    them), the CRC must never fail, and the receiver's counters must match
+    the firmware's.
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <string.h>
+#include "definitions.h"
+#include "adc_stream.h"
+#include "adc_rx.h"
+#include "sim_test.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+#define TEST_STREAM_SAMPLES                 20000U
+#define TEST_STREAM_CHUNK_MAX               150U
+#define TEST_STREAM_CAPTURE_SIZE            (512U * 1024U)
+
+/* Every n-th frame finds the UART ring full, every m-th chunk is followed by text */
+#define TEST_STREAM_FULL_EVERY              29U
+#define TEST_STREAM_TEXT_EVERY              13U
+
+/* One frame as the firmware meant it */
+typedef struct
+{
+    uint16_t sequence;
+    uint32_t mask;
+    uint32_t count;
+    int32_t samples[ADC_STREAM_FRAME_SAMPLES];
+
+} TEST_STREAM_FRAME;
+
+typedef struct
+{
+    uint32_t frames;
+    uint32_t wrong;
+
+} TEST_STREAM_SINK;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data
+// *****************************************************************************
+// *****************************************************************************
+
+static const char testStreamText[] = "Setting the ADC in continuous mode...\r\n";
+
+static uint8_t testStreamCapture[TEST_STREAM_CAPTURE_SIZE];
+static size_t testStreamSize;
+
+/* The frames the UART took, in order */
+static TEST_STREAM_FRAME testStreamFrames[(TEST_STREAM_SAMPLES / 16U) + 16U];
+static uint32_t testStreamSent;
+
+/* The frame the encoder is filling */
+static TEST_STREAM_FRAME testStreamPending;
+static uint16_t testStreamSequence;
+
+static uint32_t testStreamWrites;
+static uint32_t testStreamSeed = 0x2545F491U;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Console UART
+// *****************************************************************************
+// *****************************************************************************
+
+/* Every TEST_STREAM_FULL_EVERY-th frame finds no room */
+size_t SERCOM5_USART_WriteFreeBufferCountGet(void)
+{
+    return (((testStreamWrites++ + 1U) % TEST_STREAM_FULL_EVERY) == 0U) ? 0U : ADC_STREAM_FRAME_SIZE;
+}
+
+size_t SERCOM5_USART_Write(uint8_t* pWrBuffer, const size_t size)
+{
+    if ((testStreamSize + size) > sizeof(testStreamCapture))
+    {
+        return 0U;
+    }
+
+    memcpy(&testStreamCapture[testStreamSize], pWrBuffer, size);
+    testStreamSize += size;
+
+    return size;
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+static uint32_t lTEST_STREAM_Random(void)
+{
+    testStreamSeed ^= testStreamSeed << 13;
+    testStreamSeed ^= testStreamSeed >> 17;
+    testStreamSeed ^= testStreamSeed << 5;
+
+    return testStreamSeed;
+}
+
+/* The whole 24 bit range, every 10th sample doubled so it needs clipping */
+static int32_t lTEST_STREAM_Sample(uint32_t n)
+{
+    int32_t sample = (int32_t) ((n * 2654435761U) << 8) >> 8;
+
+    return ((n % 10U) == 0U) ? (sample * 2) : sample;
+}
+
+static int32_t lTEST_STREAM_Clip(int32_t sample)
+{
+    if (sample > ((1L << 23) - 1))
+    {
+        return (1L << 23) - 1;
+    }
+    if (sample < -(1L << 23))
+    {
+        return -(1L << 23);
+    }
+
+    return sample;
+}
+
+/* What the encoder does with a frame it closes: keep it if the UART took it */
+static void lTEST_STREAM_Close(uint32_t framesBefore)
+{
+    ADC_STREAM_STATS stats;
+
+    ADC_STREAM_StatsGet(&stats);
+    if (stats.frames != framesBefore)
+    {
+        testStreamFrames[testStreamSent++] = testStreamPending;
+    }
+    testStreamPending.count = 0U;
+    testStreamPending.sequence = ++testStreamSequence;
+}
+
+/* The samples go to the encoder one by one, to follow each frame it sends */
+static void lTEST_STREAM_Add(uint32_t mask, const int32_t* samples, uint32_t count)
+{
+    ADC_STREAM_STATS stats;
+    uint32_t i;
+
+    for (i = 0U; i < count; i++)
+    {
+        ADC_STREAM_StatsGet(&stats);
+        if ((testStreamPending.count != 0U) && (mask != testStreamPending.mask))
+        {
+            ADC_STREAM_Samples(mask, &samples[i], 1U);
+            lTEST_STREAM_Close(stats.frames);
+            ADC_STREAM_StatsGet(&stats);
+        }
+        else
+        {
+            ADC_STREAM_Samples(mask, &samples[i], 1U);
+        }
+
+        testStreamPending.mask = mask;
+        testStreamPending.samples[testStreamPending.count++] = lTEST_STREAM_Clip(samples[i]);
+        if (testStreamPending.count == ADC_STREAM_FRAME_SAMPLES)
+        {
+            lTEST_STREAM_Close(stats.frames);
+        }
+    }
+}
+
+static void lTEST_STREAM_Flush(void)
+{
+    ADC_STREAM_STATS stats;
+
+    ADC_STREAM_StatsGet(&stats);
+    ADC_STREAM_Flush();
+    if (testStreamPending.count != 0U)
+    {
+        lTEST_STREAM_Close(stats.frames);
+    }
+}
+
+static void lTEST_STREAM_Frame(const ADC_RX_FRAME* frame, void* context)
+{
+    TEST_STREAM_SINK* sink = context;
+    const TEST_STREAM_FRAME* expected;
+
+    if (sink->frames >= testStreamSent)
+    {
+        sink->wrong++;
+        return;
+    }
+
+    expected = &testStreamFrames[sink->frames++];
+    if ((frame->sequence != expected->sequence) || (frame->mask != expected->mask) ||
+        (frame->count != expected->count) ||
+        (memcmp(frame->samples, expected->samples, frame->count * sizeof(int32_t)) != 0))
+    {
+        if (sink->wrong++ < 5U)
+        {
+            SIM_TEST_Note("frame %u: sequence %u mask 0x%X count %u, expected %u 0x%X %u", sink->frames - 1U,
+                          frame->sequence, (unsigned) frame->mask, (unsigned) frame->count, expected->sequence,
+                          (unsigned) expected->mask, (unsigned) expected->count);
+        }
+    }
+}
+
+static void lTEST_STREAM_Crc(void)
+{
+    uint8_t data[256];
+    uint32_t length;
+    uint32_t wrong = 0U;
+
+    for (length = 0U; length <= sizeof(data); length++)
+    {
+        if (length != 0U)
+        {
+            data[length - 1U] = (uint8_t) lTEST_STREAM_Random();
+        }
+        if (ADC_STREAM_Crc16(ADC_STREAM_CRC_INIT, data, length) != ADC_RX_Crc16(ADC_STREAM_CRC_INIT, data, length))
+        {
+            wrong++;
+        }
+    }
+    SIM_TEST_CHECK(wrong == 0U);
+
+    /* CRC-16/CCITT-FALSE check value */
+    SIM_TEST_CHECK(ADC_STREAM_Crc16(ADC_STREAM_CRC_INIT, (const uint8_t*) "123456789", 9U) == 0x29B1U);
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Main
+// *****************************************************************************
+// *****************************************************************************
+
+int main(void)
+{
+    static const uint32_t masks[] = { ADC_STREAM_MASK_MUX, 0x00FFU, 0x0003U, 0x8001U };
+    static ADC_RX rx;
+    int32_t samples[TEST_STREAM_CHUNK_MAX];
+    TEST_STREAM_SINK sink = { 0 };
+    ADC_STREAM_STATS stats;
+    uint32_t mask = ADC_STREAM_MASK_MUX;
+    uint32_t chunks = 0U;
+    uint32_t clipped = 0U;
+    uint32_t total = 0U;
+    uint32_t count;
+    uint32_t i;
+    size_t piece;
+    size_t pos;
+
+    lTEST_STREAM_Crc();
+
+    /* Off: nothing is written */
+    ADC_STREAM_Enable(false);
+    ADC_STREAM_Samples(mask, samples, 0U);
+    SIM_TEST_CHECK(testStreamSize == 0U);
+
+    ADC_STREAM_Enable(true);
+    while (total < TEST_STREAM_SAMPLES)
+    {
+        count = 1U + (lTEST_STREAM_Random() % TEST_STREAM_CHUNK_MAX);
+        for (i = 0U; i < count; i++)
+        {
+            samples[i] = lTEST_STREAM_Sample(total + i);
+            clipped += (samples[i] != lTEST_STREAM_Clip(samples[i])) ? 1U : 0U;
+        }
+        lTEST_STREAM_Add(mask, samples, count);
+        total += count;
+        chunks++;
+
+        /* A SCAN with another mask, or the end of a CONTINUOUS */
+        if ((chunks % 7U) == 0U)
+        {
+            mask = masks[lTEST_STREAM_Random() % (sizeof(masks) / sizeof(masks[0]))];
+        }
+        if ((chunks % TEST_STREAM_TEXT_EVERY) == 0U)
+        {
+            lTEST_STREAM_Flush();
+            (void) SERCOM5_USART_Write((uint8_t*) testStreamText, sizeof(testStreamText) - 1U);
+        }
+    }
+    lTEST_STREAM_Flush();
+    ADC_STREAM_Enable(false);
+
+    ADC_STREAM_StatsGet(&stats);
+    SIM_TEST_Note("firmware: %u frames, %u samples, %u dropped, %u clipped, %u bytes", (unsigned) stats.frames,
+                  (unsigned) stats.samples, (unsigned) stats.dropped, (unsigned) stats.clipped, (unsigned) stats.bytes);
+    SIM_TEST_CHECK(stats.dropped != 0U);
+    SIM_TEST_CHECK(stats.clipped == clipped);
+    SIM_TEST_CHECK(stats.frames == testStreamSent);
+
+    /* The receiver, in pieces of random size */
+    ADC_RX_Initialize(&rx, lTEST_STREAM_Frame, &sink);
+    for (pos = 0U; pos < testStreamSize; pos += piece)
+    {
+        piece = 1U + (lTEST_STREAM_Random() % 500U);
+        if (piece > (testStreamSize - pos))
+        {
+            piece = testStreamSize - pos;
+        }
+        ADC_RX_Feed(&rx, &testStreamCapture[pos], piece);
+    }
+
+    SIM_TEST_Note("receiver: %llu frames, %llu lost in %llu gaps, %llu CRC errors, %llu bytes skipped",
+                  (unsigned long long) rx.stats.frames, (unsigned long long) rx.stats.lost,
+                  (unsigned long long) rx.stats.gaps, (unsigned long long) rx.stats.crcErrors,
+                  (unsigned long long) rx.stats.skipped);
+    SIM_TEST_CHECK(sink.wrong == 0U);
+    SIM_TEST_CHECK(sink.frames == stats.frames);
+    SIM_TEST_CHECK(rx.stats.frames == stats.frames);
+    SIM_TEST_CHECK(rx.stats.samples == stats.samples);
+    SIM_TEST_CHECK(rx.stats.crcErrors == 0U);
+    SIM_TEST_CHECK(rx.stats.lost == stats.dropped);
+    SIM_TEST_CHECK(rx.stats.bytes == testStreamSize);
+    SIM_TEST_CHECK(rx.stats.skipped == ((chunks / TEST_STREAM_TEXT_EVERY) * (sizeof(testStreamText) - 1U)));
+
+    return SIM_TEST_Finish();
+}
+
+/*******************************************************************************
+ End of File
+ */
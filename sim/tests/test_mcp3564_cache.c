@@ -0,0 +1,179 @@
+/*******************************************************************************
+  MCP3564 Register Cache Test
+
+  File Name:
+    test_mcp3564_cache.c
+
+  Summary:
+    The shadow register cache against the register file of the model.
+
+  Description:
+    On the simulated image the test checks that
+
+      - a read of a shadowed register is served without SPI traffic
+      - a write only marks the register dirty until the flush, which leaves
+        the device equal to the shadow; rewriting the same value and
+        writing a read-only register do nothing
+      - a register changed behind the cache is found by the verify,
+        flagged in mismatchMask and taken over into the shadow
+      - the background verify stays off the SPI while CONTINUOUS streams at
+        the top rate and runs as soon as the stream stops
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include "definitions.h"
+#include "adc_acq.h"
+#include "mcp3564_cache.h"
+#include "mcp3564_reg.h"
+#include "mcp3564_sim.h"
+#include "sim_test.h"
+#include "sim_test_image.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+#define TEST_CACHE_BIT(address)             ((uint16_t) (1U << (address)))
+
+/* CONFIG2.GAIN, bits 5:3 */
+#define TEST_CACHE_CONFIG2_GAIN_Msk         0x38U
+
+#define TEST_CACHE_TIMER                    0x123456U
+
+/* Streaming across more than two verify periods */
+#define TEST_CACHE_STREAM_NS                (2500ULL * 1000000ULL)
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+static void lTEST_CACHE_ReadWrite(void)
+{
+    MCP3564_CACHE_STATS before;
+    MCP3564_CACHE_STATS after;
+    MCP3564_SIM_STATS model;
+    uint32_t commands;
+    uint32_t config2;
+    uint32_t value;
+
+    SIM_TEST_CHECK(MCP3564_CACHE_Load());
+    MCP3564_CACHE_StatsGet(&before);
+    SIM_TEST_CHECK((before.valid & TEST_CACHE_BIT(MCP3564_REG_CONFIG2)) != 0U);
+    SIM_TEST_CHECK(before.dirty == 0U);
+
+    /* Hit: no command reaches the device */
+    MCP3564_SIM_StatsGet(&model);
+    commands = model.commands;
+    SIM_TEST_CHECK(MCP3564_CACHE_Read(MCP3564_REG_CONFIG2, &config2));
+    SIM_TEST_CHECK(config2 == MCP3564_SIM_RegisterGet(MCP3564_REG_CONFIG2));
+    MCP3564_SIM_StatsGet(&model);
+    MCP3564_CACHE_StatsGet(&after);
+    SIM_TEST_CHECK(model.commands == commands);
+    SIM_TEST_CHECK(after.hits == (before.hits + 1U));
+
+    /* Write back: dirty until the flush */
+    value = config2 ^ TEST_CACHE_CONFIG2_GAIN_Msk;
+    SIM_TEST_CHECK(MCP3564_CACHE_Write(MCP3564_REG_CONFIG2, value));
+    MCP3564_CACHE_StatsGet(&after);
+    SIM_TEST_CHECK(after.dirty == TEST_CACHE_BIT(MCP3564_REG_CONFIG2));
+    SIM_TEST_CHECK(MCP3564_SIM_RegisterGet(MCP3564_REG_CONFIG2) == config2);
+    SIM_TEST_CHECK(MCP3564_CACHE_Read(MCP3564_REG_CONFIG2, &config2) && (config2 == value));
+
+    SIM_TEST_CHECK(MCP3564_CACHE_Flush());
+    MCP3564_CACHE_StatsGet(&after);
+    SIM_TEST_CHECK(after.dirty == 0U);
+    SIM_TEST_CHECK(after.flushes == (before.flushes + 1U));
+    SIM_TEST_CHECK(after.bytesWritten == (before.bytesWritten + 1U));
+    SIM_TEST_CHECK(MCP3564_SIM_RegisterGet(MCP3564_REG_CONFIG2) == value);
+
+    /* Same value and read-only registers */
+    SIM_TEST_CHECK(MCP3564_CACHE_Write(MCP3564_REG_CONFIG2, value));
+    SIM_TEST_CHECK(!MCP3564_CACHE_Write(MCP3564_REG_ADCDATA, 0U));
+    SIM_TEST_CHECK(!MCP3564_CACHE_Write(MCP3564_REG_CONFIG2, 0x100U));
+    MCP3564_CACHE_StatsGet(&after);
+    SIM_TEST_CHECK(after.dirty == 0U);
+
+    SIM_TEST_CHECK(MCP3564_CACHE_Write(MCP3564_REG_CONFIG2, value ^ TEST_CACHE_CONFIG2_GAIN_Msk));
+    SIM_TEST_CHECK(MCP3564_CACHE_Flush());
+}
+
+static void lTEST_CACHE_Behind(void)
+{
+    MCP3564_CACHE_STATS before;
+    MCP3564_CACHE_STATS after;
+    uint32_t timer;
+    uint32_t value;
+
+    SIM_TEST_CHECK(MCP3564_CACHE_Verify());
+    SIM_TEST_CHECK(MCP3564_CACHE_Read(MCP3564_REG_TIMER, &timer));
+    MCP3564_CACHE_StatsGet(&before);
+
+    SIM_TEST_CHECK(ADC_ACQ_RegisterWrite(MCP3564_REG_TIMER, TEST_CACHE_TIMER));
+    SIM_TEST_CHECK(!MCP3564_CACHE_Verify());
+    MCP3564_CACHE_StatsGet(&after);
+    SIM_TEST_CHECK(after.verifies == (before.verifies + 1U));
+    SIM_TEST_CHECK(after.mismatches == (before.mismatches + 1U));
+    SIM_TEST_CHECK(after.mismatchMask == TEST_CACHE_BIT(MCP3564_REG_TIMER));
+    SIM_TEST_CHECK(MCP3564_CACHE_Read(MCP3564_REG_TIMER, &value) && (value == TEST_CACHE_TIMER));
+    SIM_TEST_CHECK(MCP3564_CACHE_Verify());
+
+    SIM_TEST_CHECK(MCP3564_CACHE_Write(MCP3564_REG_TIMER, timer));
+    SIM_TEST_CHECK(MCP3564_CACHE_Flush());
+    SIM_TEST_CHECK(MCP3564_SIM_RegisterGet(MCP3564_REG_TIMER) == timer);
+}
+
+static void lTEST_CACHE_Streaming(void)
+{
+    MCP3564_CACHE_STATS before;
+    MCP3564_CACHE_STATS after;
+    ADC_ACQ_STATS acq;
+
+    SIM_TEST_CHECK(SIM_TEST_ImageCommand("RATE 156250"));
+    MCP3564_CACHE_StatsGet(&before);
+
+    SIM_TEST_CHECK(ADC_ACQ_Start(ADC_ACQ_MODE_DRIVER, ADC_ACQ_FORMAT_24));
+    SIM_TEST_ImageRun(TEST_CACHE_STREAM_NS);
+    ADC_ACQ_StatsGet(&acq);
+    MCP3564_CACHE_StatsGet(&after);
+    ADC_ACQ_Stop();
+
+    SIM_TEST_Note("streaming 2.5 s: %u samples, %u overruns, %u verifies", acq.samples,
+                  acq.overruns, after.verifies - before.verifies);
+    SIM_TEST_CHECK(after.verifies == before.verifies);
+    SIM_TEST_CHECK(acq.overruns == 0U);
+
+    /* The overdue verify at the next poll */
+    SIM_TEST_ImageRun(MCP3564_CACHE_VERIFY_PERIOD_MS * 1000000ULL / 2U);
+    MCP3564_CACHE_StatsGet(&after);
+    SIM_TEST_CHECK(after.verifies == (before.verifies + 1U));
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Main
+// *****************************************************************************
+// *****************************************************************************
+
+int main(void)
+{
+    SIM_TEST_ImageInitialize();
+
+    lTEST_CACHE_ReadWrite();
+    lTEST_CACHE_Behind();
+    lTEST_CACHE_Streaming();
+
+    return SIM_TEST_Finish();
+}
+
+/*******************************************************************************
+ End of File
+ */
@@ -0,0 +1,260 @@
+/*******************************************************************************
+  MCP3564 Data Rate Test
+
+  File Name:
+    test_mcp3564_rate.c
+
+  Summary:
+    MCP3564_RATE_Find against a brute force search, RATE on the image.
+
+  Description:
+    For requested rates across the whole range the test searches every
+    source, DIV, PRE and OSR in 64 bit arithmetic and checks that
+    MCP3564_RATE_Find
+
+      - lands on the smallest rate error there is
+      - reports the rate its setting really gives, i.e. the compile time
+        table is right
+      - keeps MCLK within 1..20 MHz
+      - among the settings with that error picks the highest OSR
+
+    Then RATE on the simulated image must program GCLK5 and CONFIG1 so that
+    the model converts at the rate reported, including the DPLL0 top rate
+    of 156.25 ksps, and must leave both alone for arguments which are not
+    a rate: no digits, trailing characters, too many decimals, negative,
+    or too large for milli-sps in 32 bits.
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include "definitions.h"
+#include "adc_acq.h"
+#include "mcp3564_rate.h"
+#include "mcp3564_reg.h"
+#include "mcp3564_sim.h"
+#include "sim_test.h"
+#include "sim_test_image.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+/* Requested rates from 0.1 sps to 200 ksps, 1 % apart */
+#define TEST_RATE_FIRST                     100U
+#define TEST_RATE_LAST                      200000000U
+
+/* Simulated time the conversions are counted over */
+#define TEST_RATE_WINDOW_NS                 20000000U
+
+typedef struct
+{
+    uint32_t error;
+    uint32_t osr;
+
+} TEST_RATE_BEST;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data
+// *****************************************************************************
+// *****************************************************************************
+
+static const uint32_t testRateSourceHz[MCP3564_RATE_SOURCES] = { MCP3564_RATE_DFLL_HZ, MCP3564_RATE_DPLL_HZ };
+
+static const uint32_t testRateOsr[16] =
+{
+    32U, 64U, 128U, 256U, 512U, 1024U, 2048U, 4096U,
+    8192U, 16384U, 20480U, 24576U, 40960U, 49152U, 81920U, 98304U,
+};
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+static uint32_t lTEST_RATE_Rate(uint32_t sourceHz, uint32_t div, uint32_t pre, uint32_t osr)
+{
+    return (uint32_t) (((uint64_t) sourceHz * 1000U / 4U) / ((uint64_t) div * pre * osr));
+}
+
+static TEST_RATE_BEST lTEST_RATE_Search(uint32_t rate)
+{
+    TEST_RATE_BEST best = { .error = UINT32_MAX };
+    uint32_t source;
+    uint32_t div;
+    uint32_t pre;
+    uint32_t osr;
+    uint32_t actual;
+    uint32_t error;
+
+    for (source = 0U; source < MCP3564_RATE_SOURCES; source++)
+    {
+        for (div = 1U; (testRateSourceHz[source] / div) >= MCP3564_RATE_MCLK_MIN_HZ; div++)
+        {
+            if ((testRateSourceHz[source] / div) > MCP3564_RATE_MCLK_MAX_HZ)
+            {
+                continue;
+            }
+
+            for (pre = 0U; pre < 4U; pre++)
+            {
+                for (osr = 0U; osr < 16U; osr++)
+                {
+                    actual = lTEST_RATE_Rate(testRateSourceHz[source], div, 1U << pre, testRateOsr[osr]);
+                    error = (actual > rate) ? (actual - rate) : (rate - actual);
+                    if ((error < best.error) || ((error == best.error) && (testRateOsr[osr] > best.osr)))
+                    {
+                        best.error = error;
+                        best.osr = testRateOsr[osr];
+                    }
+                }
+            }
+        }
+    }
+
+    return best;
+}
+
+static void lTEST_RATE_Find(void)
+{
+    MCP3564_RATE setting;
+    TEST_RATE_BEST best;
+    uint32_t requests = 0U;
+    uint32_t wrong = 0U;
+    uint32_t error;
+    uint32_t rate;
+
+    SIM_TEST_CHECK(!MCP3564_RATE_Find(0U, &setting));
+
+    for (rate = TEST_RATE_FIRST; rate <= TEST_RATE_LAST; rate += (rate / 100U) + 1U)
+    {
+        requests++;
+        if (!MCP3564_RATE_Find(rate, &setting))
+        {
+            wrong++;
+            continue;
+        }
+
+        best = lTEST_RATE_Search(rate);
+        error = (setting.rate > rate) ? (setting.rate - rate) : (rate - setting.rate);
+
+        if ((error != best.error) || (setting.osr != best.osr) ||
+            (setting.rate != lTEST_RATE_Rate(setting.sourceHz, setting.mclkDiv, setting.pre, setting.osr)) ||
+            (setting.sourceHz != testRateSourceHz[setting.source]) ||
+            (setting.mclkHz < MCP3564_RATE_MCLK_MIN_HZ) || (setting.mclkHz > MCP3564_RATE_MCLK_MAX_HZ))
+        {
+            if (wrong++ < 5U)
+            {
+                SIM_TEST_Note("%u mSPS: found %u (error %u, OSR %u), best error %u OSR %u", rate,
+                              setting.rate, error, setting.osr, best.error, best.osr);
+            }
+        }
+    }
+
+    SIM_TEST_Note("Find: %u requested rates, %u off the brute force search", requests, wrong);
+    SIM_TEST_CHECK(wrong == 0U);
+
+    /* The ends of the range */
+    SIM_TEST_CHECK(MCP3564_RATE_Find(UINT32_MAX, &setting));
+    SIM_TEST_CHECK((setting.rate == 156250000U) && (setting.source == MCP3564_RATE_SOURCE_DPLL));
+    SIM_TEST_CHECK(MCP3564_RATE_Find(125000000U, &setting));
+    SIM_TEST_CHECK((setting.rate == 125000000U) && (setting.source == MCP3564_RATE_SOURCE_DFLL) &&
+                   (setting.mclkDiv == 3U));
+    SIM_TEST_CHECK(MCP3564_RATE_Find(1U, &setting));
+    SIM_TEST_CHECK((setting.mclkHz == MCP3564_RATE_MCLK_MIN_HZ) && (setting.pre == 8U) && (setting.osr == 98304U));
+
+    /* ENOB grows with OSR; PRE does not change it */
+    SIM_TEST_CHECK(MCP3564_RATE_Find(UINT32_MAX, &setting) && (setting.osr == 32U) && (setting.enob == 137U));
+    SIM_TEST_CHECK(MCP3564_RATE_Find(1U, &setting) && (setting.enob == 220U));
+}
+
+static void lTEST_RATE_Rejected(void)
+{
+    static const char* const commands[] =
+    {
+        "RATE x", "RATE 1000x", "RATE 1000.5x", "RATE 1000.1234", "RATE -1000", "RATE 4294968", "RATE 0",
+        "RATE .5",
+    };
+    uint32_t genctrl = GCLK_REGS->GCLK_GENCTRL[5];
+    uint32_t config1 = MCP3564_SIM_RegisterGet(MCP3564_REG_CONFIG1);
+    uint32_t i;
+
+    for (i = 0U; i < (sizeof(commands) / sizeof(commands[0])); i++)
+    {
+        SIM_TEST_CHECK(SIM_TEST_ImageCommand(commands[i]));
+        if (!SIM_TEST_CHECK((GCLK_REGS->GCLK_GENCTRL[5] == genctrl) &&
+                            (MCP3564_SIM_RegisterGet(MCP3564_REG_CONFIG1) == config1)))
+        {
+            SIM_TEST_Note("%s changed the rate", commands[i]);
+        }
+    }
+}
+
+static void lTEST_RATE_Apply(const char* command, MCP3564_RATE_SOURCE source)
+{
+    MCP3564_RATE setting;
+    MCP3564_SIM_STATS before;
+    MCP3564_SIM_STATS after;
+    uint32_t genctrl;
+    uint32_t config1;
+    uint32_t expected;
+    uint32_t converted;
+
+    SIM_TEST_CHECK(SIM_TEST_ImageCommand(command));
+    SIM_TEST_CHECK(MCP3564_RATE_Get(&setting));
+
+    genctrl = GCLK_REGS->GCLK_GENCTRL[5];
+    config1 = MCP3564_SIM_RegisterGet(MCP3564_REG_CONFIG1);
+    SIM_TEST_CHECK(setting.source == source);
+    SIM_TEST_CHECK(((genctrl & GCLK_GENCTRL_SRC_Msk) == GCLK_GENCTRL_SRC_DPLL0) == (source == MCP3564_RATE_SOURCE_DPLL));
+    SIM_TEST_CHECK(((genctrl & GCLK_GENCTRL_DIV_Msk) >> GCLK_GENCTRL_DIV_Pos) == setting.mclkDiv);
+    SIM_TEST_CHECK(((config1 >> MCP3564_CONFIG1_PRE_Pos) & 0x3U) == setting.preCode);
+    SIM_TEST_CHECK(((config1 & MCP3564_CONFIG1_OSR_Msk) >> MCP3564_CONFIG1_OSR_Pos) == setting.osrCode);
+
+    /* The model converts at what RATE reports */
+    SIM_TEST_CHECK(ADC_ACQ_Start(ADC_ACQ_MODE_DRIVER, ADC_ACQ_FORMAT_24));
+    SIM_TEST_ImageRun(1000000U);
+    MCP3564_SIM_StatsGet(&before);
+    SIM_TEST_ImageRun(TEST_RATE_WINDOW_NS);
+    MCP3564_SIM_StatsGet(&after);
+    ADC_ACQ_Stop();
+    SIM_TEST_ImageRun(10000000U);
+
+    expected = (uint32_t) (((uint64_t) setting.rate * TEST_RATE_WINDOW_NS) / 1000000000000ULL);
+    converted = after.conversions - before.conversions;
+    SIM_TEST_Note("%s: %u.%03u sps, MCLK %u Hz / %u, PRE %u, OSR %u: %u conversions in 20 ms, %u expected",
+                  command, setting.rate / 1000U, setting.rate % 1000U, setting.sourceHz, setting.mclkDiv,
+                  setting.pre, setting.osr, converted, expected);
+    SIM_TEST_CHECK((converted + 1U >= expected) && (converted <= expected + 1U));
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Main
+// *****************************************************************************
+// *****************************************************************************
+
+int main(void)
+{
+    lTEST_RATE_Find();
+
+    SIM_TEST_ImageInitialize();
+    lTEST_RATE_Apply("RATE 156250", MCP3564_RATE_SOURCE_DPLL);
+    lTEST_RATE_Apply("RATE 125000", MCP3564_RATE_SOURCE_DFLL);
+    lTEST_RATE_Apply("RATE 1000", MCP3564_RATE_SOURCE_DPLL);
+    lTEST_RATE_Apply("RATE 5859.375", MCP3564_RATE_SOURCE_DFLL);
+    lTEST_RATE_Rejected();
+
+    return SIM_TEST_Finish();
+}
+
+/*******************************************************************************
+ End of File
+ */
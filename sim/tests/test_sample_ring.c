@@ -0,0 +1,249 @@
+/*******************************************************************************
+  Sample Ring Stress Test
+
+  File Name:
+    test_sample_ring.c
+
+  Summary:
+    SAMPLE_RING with the producer and the consumer on two host threads.
+
+  Description:
+    The producer pushes a counting sequence in bulks of random length, the
+    consumer pops bulks of other random lengths and checks what it gets:
+
+      - lossless: the producer only pushes what fits, every value must
+        arrive in order and nothing may be counted as an overrun
+      - overrun: the producer pushes regardless of the space and the
+        consumer is slower; what arrives must still be in order, the values
+        missing must add up to the overrun counter, and the counter must
+        match what the producer saw refused
+
+    In both the high-watermark must cover the deepest fill the consumer
+    saw and never exceed the capacity. A small ring makes the index wrap
+    often, so bulks straddle the end of the storage all the time.
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h>
+#include "sample_ring.h"
+#include "sim_test.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+#define TEST_RING_SIZE                      1024U
+#define TEST_RING_SAMPLES                   (1U << 22)
+#define TEST_RING_PUSH_MAX                  200U
+#define TEST_RING_POP_MAX                   300U
+
+/* Overrun run: both yield after every bulk and the consumer pops a fifth
+   of what the producer pushes, so it falls behind but keeps up in part */
+#define TEST_RING_SLOW_POP_MAX              40U
+
+typedef struct
+{
+    SAMPLE_RING ring;
+    bool lossless;
+    volatile bool produced;
+
+    /* Producer side: samples the ring refused */
+    uint32_t refused;
+
+    /* Consumer side */
+    uint32_t received;
+    uint32_t missing;
+    uint32_t disorder;
+    uint32_t deepest;
+
+} TEST_RING;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data
+// *****************************************************************************
+// *****************************************************************************
+
+static uint32_t testRingBuffer[TEST_RING_SIZE];
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+static uint32_t lTEST_RING_Random(uint32_t* state)
+{
+    uint32_t x = *state;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+
+    return x;
+}
+
+static void* lTEST_RING_Producer(void* context)
+{
+    TEST_RING* test = context;
+    uint32_t bulk[TEST_RING_PUSH_MAX];
+    uint32_t seed = 0x12345678U;
+    uint32_t next = 0U;
+    uint32_t count;
+    uint32_t i;
+
+    while (next < TEST_RING_SAMPLES)
+    {
+        count = 1U + (lTEST_RING_Random(&seed) % TEST_RING_PUSH_MAX);
+        if (count > (TEST_RING_SAMPLES - next))
+        {
+            count = TEST_RING_SAMPLES - next;
+        }
+
+        while (test->lossless && (SAMPLE_RING_Space(&test->ring) < count))
+        {
+            (void) sched_yield();
+        }
+
+        for (i = 0U; i < count; i++)
+        {
+            bulk[i] = next + i;
+        }
+        test->refused += count - SAMPLE_RING_Push(&test->ring, bulk, count);
+        next += count;
+
+        if (!test->lossless)
+        {
+            /* Let the consumer in, else it only sees the end */
+            (void) sched_yield();
+        }
+    }
+
+    __atomic_store_n(&test->produced, true, __ATOMIC_RELEASE);
+
+    return NULL;
+}
+
+static void* lTEST_RING_Consumer(void* context)
+{
+    TEST_RING* test = context;
+    uint32_t bulk[TEST_RING_POP_MAX];
+    uint32_t seed = 0x9E3779B9U;
+    uint32_t popMax = test->lossless ? TEST_RING_POP_MAX : TEST_RING_SLOW_POP_MAX;
+    uint32_t expected = 0U;
+    uint32_t fill;
+    uint32_t count;
+    uint32_t i;
+    bool done;
+
+    do
+    {
+        done = __atomic_load_n(&test->produced, __ATOMIC_ACQUIRE);
+
+        fill = SAMPLE_RING_Count(&test->ring);
+        if (fill > test->deepest)
+        {
+            test->deepest = fill;
+        }
+
+        count = SAMPLE_RING_Pop(&test->ring, bulk, 1U + (lTEST_RING_Random(&seed) % popMax));
+        for (i = 0U; i < count; i++)
+        {
+            if (bulk[i] < expected)
+            {
+                test->disorder++;
+            }
+            else
+            {
+                test->missing += bulk[i] - expected;
+                expected = bulk[i] + 1U;
+            }
+        }
+        test->received += count;
+
+        if ((count == 0U) || !test->lossless)
+        {
+            (void) sched_yield();
+        }
+    } while (!done || (count != 0U));
+
+    /* Refused samples at the very end leave no gap behind them */
+    test->missing += TEST_RING_SAMPLES - expected;
+
+    return NULL;
+}
+
+static void lTEST_RING_Run(TEST_RING* test, bool lossless)
+{
+    pthread_t producer;
+    pthread_t consumer;
+
+    *test = (TEST_RING) { .lossless = lossless };
+    SIM_TEST_CHECK(SAMPLE_RING_Initialize(&test->ring, testRingBuffer, TEST_RING_SIZE));
+
+    SIM_TEST_CHECK(pthread_create(&consumer, NULL, lTEST_RING_Consumer, test) == 0);
+    SIM_TEST_CHECK(pthread_create(&producer, NULL, lTEST_RING_Producer, test) == 0);
+    (void) pthread_join(producer, NULL);
+    (void) pthread_join(consumer, NULL);
+
+    SIM_TEST_Note("%s: %u received, %u overruns, high-watermark %u of %u",
+                  lossless ? "lossless" : "overrun", test->received,
+                  SAMPLE_RING_OverrunsGet(&test->ring), SAMPLE_RING_HighWaterGet(&test->ring), TEST_RING_SIZE);
+
+    SIM_TEST_CHECK(test->disorder == 0U);
+    SIM_TEST_CHECK(test->received + test->missing == TEST_RING_SAMPLES);
+    SIM_TEST_CHECK(SAMPLE_RING_OverrunsGet(&test->ring) == test->missing);
+    SIM_TEST_CHECK(SAMPLE_RING_OverrunsGet(&test->ring) == test->refused);
+    SIM_TEST_CHECK(SAMPLE_RING_HighWaterGet(&test->ring) >= test->deepest);
+    SIM_TEST_CHECK(SAMPLE_RING_HighWaterGet(&test->ring) <= TEST_RING_SIZE);
+    SIM_TEST_CHECK(SAMPLE_RING_Count(&test->ring) == 0U);
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Main
+// *****************************************************************************
+// *****************************************************************************
+
+int main(void)
+{
+    static TEST_RING test;
+    uint32_t buffer[3];
+    uint32_t out[4];
+
+    /* Capacity must be a power of two */
+    SIM_TEST_CHECK(!SAMPLE_RING_Initialize(&test.ring, buffer, 3U));
+    SIM_TEST_CHECK(!SAMPLE_RING_Initialize(&test.ring, buffer, 0U));
+
+    /* Single thread: a bulk larger than the space is cut, the rest counted */
+    SIM_TEST_CHECK(SAMPLE_RING_Initialize(&test.ring, testRingBuffer, 4U));
+    SIM_TEST_CHECK(SAMPLE_RING_Push(&test.ring, (const uint32_t[]) { 1U, 2U, 3U, 4U, 5U, 6U }, 6U) == 4U);
+    SIM_TEST_CHECK(SAMPLE_RING_OverrunsGet(&test.ring) == 2U);
+    SIM_TEST_CHECK(SAMPLE_RING_HighWaterGet(&test.ring) == 4U);
+    SIM_TEST_CHECK(SAMPLE_RING_Pop(&test.ring, out, 4U) == 4U);
+    SIM_TEST_CHECK((out[0] == 1U) && (out[3] == 4U));
+    SIM_TEST_CHECK(SAMPLE_RING_Pop(&test.ring, out, 4U) == 0U);
+
+    lTEST_RING_Run(&test, true);
+    SIM_TEST_CHECK(SAMPLE_RING_OverrunsGet(&test.ring) == 0U);
+
+    lTEST_RING_Run(&test, false);
+    SIM_TEST_CHECK(SAMPLE_RING_OverrunsGet(&test.ring) != 0U);
+    SIM_TEST_CHECK(SAMPLE_RING_HighWaterGet(&test.ring) == TEST_RING_SIZE);
+
+    return SIM_TEST_Finish();
+}
+
+/*******************************************************************************
+ End of File
+ */
@@ -0,0 +1,253 @@
+/*******************************************************************************
+  Console UART DMA Test
+
+  File Name:
+    test_sercom5_usart.c
+
+  Summary:
+    The DMA transmit path of the real plib_sercom5_usart.c on the DMAC
+    model.
+
+  Description:
+    The image links plib_sercom5_usart_sim.c, so the write ring drained
+    by DMAC channel 2 (SERCOM5_USART_TxDmaStart, SERCOM5_USART_TxDmaCallback)
+    only runs on the target. Here the PLIB is linked as it is built there,
+    against plib_dmac_sim.c and the register blocks of sim_soc.c, and the
+    characters the DMAC moves into DATA are captured:
+
+      - a full ring which wraps drains in two segments, in order, and a
+        segment stays in the ring, not free, until its transfer completes
+      - writes of random size at random times, some finding the ring full,
+        come out in order with nothing lost or repeated
+      - the persistent WRITE_THRESHOLD notification fires once per
+        segment drained with the threshold free, not once per character
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <string.h>
+#include "definitions.h"
+#include "sim_core.h"
+#include "sim_cpu.h"
+#include "sim_soc.h"
+#include "plib_sim.h"
+#include "sim_test.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+#define TEST_USART_RING_SIZE                1023U
+
+/* 10 bits at 115200 baud */
+#define TEST_USART_CHAR_NS                  86806U
+
+#define TEST_USART_THRESHOLD                256U
+#define TEST_USART_STREAM_SIZE              (64U * 1024U)
+
+typedef struct
+{
+    uint32_t calls;
+    uint32_t belowThreshold;
+
+} TEST_USART_NOTIFY;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data
+// *****************************************************************************
+// *****************************************************************************
+
+static uint8_t testUsartSent[TEST_USART_STREAM_SIZE];
+static size_t testUsartSentSize;
+
+static uint8_t testUsartLine[TEST_USART_STREAM_SIZE];
+static size_t testUsartLineSize;
+
+static TEST_USART_NOTIFY testUsartNotify;
+
+static uint32_t testUsartSeed = 0x6C078965U;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Line
+// *****************************************************************************
+// *****************************************************************************
+
+void SERCOM5_USART_SIM_DataTransmit(uint8_t data)
+{
+    if (testUsartLineSize < sizeof(testUsartLine))
+    {
+        testUsartLine[testUsartLineSize++] = data;
+    }
+}
+
+uint64_t SERCOM5_USART_SIM_TransferTime(size_t size)
+{
+    return (uint64_t) size * TEST_USART_CHAR_NS;
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+static uint32_t lTEST_USART_Random(void)
+{
+    testUsartSeed ^= testUsartSeed << 13;
+    testUsartSeed ^= testUsartSeed >> 17;
+    testUsartSeed ^= testUsartSeed << 5;
+
+    return testUsartSeed;
+}
+
+static void lTEST_USART_Notify(SERCOM_USART_EVENT event, uintptr_t context)
+{
+    if (event != SERCOM_USART_EVENT_WRITE_THRESHOLD_REACHED)
+    {
+        return;
+    }
+
+    testUsartNotify.calls++;
+    if (SERCOM5_USART_WriteFreeBufferCountGet() < TEST_USART_THRESHOLD)
+    {
+        testUsartNotify.belowThreshold++;
+    }
+}
+
+/* Writes size bytes of the reference stream, returns how many the ring took */
+static size_t lTEST_USART_Write(size_t size)
+{
+    uint8_t data[TEST_USART_RING_SIZE + 64U];
+    size_t written;
+    size_t i;
+
+    for (i = 0U; i < size; i++)
+    {
+        data[i] = (uint8_t) lTEST_USART_Random();
+    }
+
+    written = SERCOM5_USART_Write(data, size);
+    memcpy(&testUsartSent[testUsartSentSize], data, written);
+    testUsartSentSize += written;
+
+    return written;
+}
+
+static void lTEST_USART_Drain(void)
+{
+    uint64_t end = SIM_Now() + ((uint64_t) (TEST_USART_RING_SIZE + 1U) * TEST_USART_CHAR_NS);
+
+    while ((SERCOM5_USART_WriteCountGet() != 0U) && (SIM_Now() < end))
+    {
+        SIM_CPU_Run(TEST_USART_CHAR_NS);
+    }
+}
+
+static bool lTEST_USART_LineMatches(void)
+{
+    return (testUsartLineSize == testUsartSentSize) && (memcmp(testUsartLine, testUsartSent, testUsartSentSize) == 0);
+}
+
+/* A full ring from write index first: two segments when it wraps */
+static void lTEST_USART_Wrap(size_t first)
+{
+    size_t move = ((TEST_USART_RING_SIZE + 1U) + first - (testUsartSentSize % (TEST_USART_RING_SIZE + 1U))) %
+                  (TEST_USART_RING_SIZE + 1U);
+    size_t tail = (TEST_USART_RING_SIZE + 1U) - first;
+    uint32_t calls;
+
+    /* Moves the indices to first */
+    SIM_TEST_CHECK(lTEST_USART_Write(move) == move);
+    lTEST_USART_Drain();
+    SIM_TEST_CHECK(SERCOM5_USART_WriteFreeBufferCountGet() == TEST_USART_RING_SIZE);
+
+    (void) SERCOM5_USART_WriteNotificationEnable(true, true);
+    calls = testUsartNotify.calls;
+
+    /* One byte more than fits */
+    SIM_TEST_CHECK(lTEST_USART_Write(TEST_USART_RING_SIZE + 1U) == TEST_USART_RING_SIZE);
+    SIM_TEST_CHECK(SERCOM5_USART_WriteFreeBufferCountGet() == 0U);
+    SIM_TEST_CHECK(SERCOM5_USART_WriteCountGet() == TEST_USART_RING_SIZE);
+
+    /* Half of the first segment is out, none of it is free yet */
+    SIM_CPU_Run((uint64_t) (tail / 2U) * TEST_USART_CHAR_NS);
+    SIM_TEST_CHECK(SERCOM5_USART_WriteFreeBufferCountGet() == 0U);
+    SIM_TEST_CHECK(testUsartNotify.calls == calls);
+
+    /* The first segment, to the end of the ring, is released as a whole */
+    SIM_CPU_Run((uint64_t) (tail - (tail / 2U)) * TEST_USART_CHAR_NS);
+    SIM_TEST_CHECK(SERCOM5_USART_WriteFreeBufferCountGet() == tail);
+    SIM_TEST_CHECK(testUsartNotify.calls == (calls + ((tail >= TEST_USART_THRESHOLD) ? 1U : 0U)));
+
+    lTEST_USART_Drain();
+    SIM_TEST_CHECK(SERCOM5_USART_WriteFreeBufferCountGet() == TEST_USART_RING_SIZE);
+    SIM_TEST_CHECK(testUsartNotify.calls == (calls + ((tail >= TEST_USART_THRESHOLD) ? 2U : 1U)));
+    SIM_TEST_CHECK(lTEST_USART_LineMatches());
+
+    (void) SERCOM5_USART_WriteNotificationEnable(false, false);
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Main
+// *****************************************************************************
+// *****************************************************************************
+
+int main(void)
+{
+    uint32_t full = 0U;
+    uint32_t calls;
+    size_t size;
+
+    SIM_Initialize();
+    SIM_CPU_Initialize();
+    SIM_SOC_Initialize();
+
+    DMAC_Initialize();
+    SERCOM5_USART_Initialize();
+    NVIC_EnableIRQ(DMAC_2_IRQn);
+
+    SERCOM5_USART_WriteCallbackRegister(lTEST_USART_Notify, 0U);
+    SERCOM5_USART_WriteThresholdSet(TEST_USART_THRESHOLD);
+    SIM_TEST_CHECK(SERCOM5_USART_WriteBufferSizeGet() == TEST_USART_RING_SIZE);
+
+    /* Wrapping with a long first segment, and with one below the threshold */
+    lTEST_USART_Wrap(300U);
+    lTEST_USART_Wrap(900U);
+    SIM_TEST_CHECK(testUsartNotify.belowThreshold == 0U);
+
+    /* Notification off: no callback however much drains */
+    calls = testUsartNotify.calls;
+    SIM_TEST_CHECK(lTEST_USART_Write(500U) == 500U);
+    lTEST_USART_Drain();
+    SIM_TEST_CHECK(testUsartNotify.calls == calls);
+
+    /* Writes while segments are in flight, the ring full now and then */
+    while (testUsartSentSize < (TEST_USART_STREAM_SIZE - TEST_USART_RING_SIZE))
+    {
+        size = 1U + (lTEST_USART_Random() % 200U);
+        full += (lTEST_USART_Write(size) < size) ? 1U : 0U;
+        SIM_CPU_Run((uint64_t) (lTEST_USART_Random() % 150U) * TEST_USART_CHAR_NS);
+    }
+    lTEST_USART_Drain();
+
+    SIM_TEST_Note("%u bytes in order, ring full %u times, %u threshold callbacks", (unsigned) testUsartLineSize,
+                  full, testUsartNotify.calls);
+    SIM_TEST_CHECK(full != 0U);
+    SIM_TEST_CHECK(SERCOM5_USART_WriteFreeBufferCountGet() == TEST_USART_RING_SIZE);
+    SIM_TEST_CHECK(lTEST_USART_LineMatches());
+
+    return SIM_TEST_Finish();
+}
+
+/*******************************************************************************
+ End of File
+ */
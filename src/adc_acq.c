@@ -0,0 +1,1102 @@
+/*******************************************************************************
+  MCP3564 Continuous Acquisition Source File
+
+  File Name:
+    adc_acq.c
+
+  Summary:
+    DMA driven continuous ADCDATA acquisition for the MCP3564.
+
+  Description:
+    The data-ready interrupt (EIC pin 14) only queues a 4 byte ADCDATA read on
+    the SPI driver; the DMAC moves the bytes and the driver end-of-transfer
+    event advances the ping-pong bookkeeping. With a queue depth of two the
+    next read can be queued while the previous one is still on the bus.
+    Every completed half is pushed into the sample FIFO (sample_ring.c) from
+    interrupt context, so the halves are never held by the application.
+    With DATA_FORMAT = 32 bit + CH_ID each read is 5 bytes, and CRCCOM adds
+    2 CRC bytes to either format; these reads land in a staging block which
+    is checked and packed to one word per sample before the push.
+
+    Event mode chain, no CPU involvement per sample:
+
+      EXTINT14 --EVSYS ch0--> PORT EV0: CLR PB05 (CS low)
+               --EVSYS ch1--> DMAC ch0: one 32 bit beat to SERCOM1 DATA
+      SERCOM1 RXC --> DMAC ch1: one 32 bit beat into the ring
+      DMAC ch1 beat --EVSYS ch2--> PORT EV1: SET PB05 (CS high)
+
+    SERCOM1 runs in 32 bit data mode (LENGTH = 4) so a whole STATUS + 24 bit
+    read is one DMA beat. DATA is shifted out LSB first, which keeps the
+    ring layout identical to the byte wise driver mode.
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <string.h>
+#include "definitions.h"
+#include "adc_acq.h"
+#include "sample_ring.h"
+#include "mcp3564_reg.h"
+#include "mcp3564_cache.h"
+#include "adc_decode.h"
+#include "adc_stamp.h"
+#include "app_perf.h"
+#include "app_trace.h"
+#include "app_wait.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+/* MCP3564 command bytes */
+#define ADC_ACQ_CMD_ADCDATA_READ            MCP3564_CMD(MCP3564_REG_ADCDATA, MCP3564_CMD_TYPE_STATIC_READ)
+#define ADC_ACQ_CMD_CONFIG3_WRITE           MCP3564_CMD(MCP3564_REG_CONFIG3, MCP3564_CMD_TYPE_INC_WRITE)
+#define ADC_ACQ_CMD_CONVERSION              0x68U
+#define ADC_ACQ_CMD_STANDBY                 0x6CU
+
+/* CONFIG3: CONV_MODE = continuous conversion, DATA_FORMAT in bits 5:4 */
+#define ADC_ACQ_CONFIG3_CONTINUOUS          0xC0U
+#define ADC_ACQ_CONFIG3_FORMAT(f)           ((uint8_t)(f) << 4)
+
+/* STATUS + CH_ID/SGN + 24 data bits */
+#define ADC_ACQ_SAMPLE_SIZE_CHID            5U
+
+/* Largest staged read: 32 bit + CH_ID with the CRC appended */
+#define ADC_ACQ_STAGE_SIZE                  8U
+
+#define ADC_ACQ_RING_SAMPLES                (2U * ADC_ACQ_BLOCK_SAMPLES)
+
+/* Event mode resources */
+#define ADC_ACQ_DMAC_TX                     ((DMAC_CHANNEL)DRV_SPI_XMIT_DMA_CH_IDX0)
+#define ADC_ACQ_DMAC_RX                     ((DMAC_CHANNEL)DRV_SPI_RCV_DMA_CH_IDX0)
+#define ADC_ACQ_DMAC_TRIGSRC_SERCOM1_RX     6U
+#define ADC_ACQ_SERCOM_BAUD                 1U      /* 60 MHz / (2 * (1 + 1)) */
+#define ADC_ACQ_CS_GROUP                    1U      /* PB05 */
+#define ADC_ACQ_CS_PIN                      5U
+
+/* CPU cycles per ADC_STAMP tick */
+#define ADC_ACQ_STAMP_CYCLES                (CPU_CLOCK_FREQUENCY / ADC_STAMP_FREQUENCY_HZ)
+
+/* No block start stamped yet */
+#define ADC_ACQ_EDGE_NONE                   0xFFFFFFFFU
+
+typedef struct
+{
+    DRV_HANDLE spiHandle;
+
+    /* Set while the data-ready interrupt is hooked */
+    volatile bool streaming;
+
+    /* Next ring slot to be queued (EIC) and next slot to complete (DMAC) */
+    volatile uint32_t queuePos;
+    volatile uint32_t donePos;
+
+    ADC_ACQ_MODE mode;
+    ADC_ACQ_FORMAT format;
+
+    /* CRCCOM requested for the next start; bytes per read before the CRC */
+    bool crc;
+    uint32_t readSize;
+    uint32_t dataSize;
+
+    /* Register snapshot queued between sample reads while streaming */
+    volatile DRV_SPI_TRANSFER_HANDLE snapHandle;
+
+    /* Command queued by ADC_ACQ_CommandStart, bytes read after STATUS */
+    volatile DRV_SPI_TRANSFER_HANDLE cmdHandle;
+    uint32_t cmdSize;
+
+    /* Driver mode: reads queued since the start, i.e. the next sample index */
+    volatile uint32_t queued;
+
+    /* Block time stamps: written in interrupt context, read by the consumer */
+    ADC_ACQ_STAMP stamps[ADC_ACQ_STAMP_DEPTH];
+    volatile uint32_t stampHead;
+    volatile uint32_t stampTail;
+
+    /* Driver mode latency probe: ring slot and its edge time stamp */
+    volatile uint32_t probePos;
+    volatile uint32_t probeStart;
+
+    /* Event mode latency: the last two block start edges, and the cycle
+     * count at the interrupt of the last one */
+    ADC_ACQ_STAMP edges[2];
+    uint32_t edgeStart;
+
+    /* Event mode: half the DMAC writes, and what is restored at stop */
+    volatile uint32_t dmaHalf;
+    uint32_t savedTxCtrlA;
+    uint32_t savedRxCtrlA;
+    DMAC_CHANNEL_CONFIG savedTxBtCtrl;
+    DMAC_CHANNEL_CONFIG savedRxBtCtrl;
+    uint8_t savedBaud;
+
+    volatile ADC_ACQ_STATS stats;
+
+    /* Told about blocks and transfer ends, from interrupt context */
+    ADC_ACQ_CALLBACK callback;
+    uintptr_t context;
+
+} ADC_ACQ_OBJ;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data
+// *****************************************************************************
+// *****************************************************************************
+
+static ADC_ACQ_OBJ acqObj = { .spiHandle = DRV_HANDLE_INVALID, .snapHandle = DRV_SPI_TRANSFER_HANDLE_INVALID,
+                              .cmdHandle = DRV_SPI_TRANSFER_HANDLE_INVALID };
+
+/* The ring is written by the DMAC and read by the CPU */
+static CACHE_ALIGN uint32_t acqRing[2][ADC_ACQ_BLOCK_SAMPLES];
+
+/* Channel ID and CRC reads land here and are packed into acqRing per block */
+static CACHE_ALIGN uint32_t acqStage[2][ADC_ACQ_BLOCK_SAMPLES][ADC_ACQ_STAGE_SIZE / sizeof(uint32_t)];
+
+/* FIFO between the completion interrupts and the consumer */
+static SAMPLE_RING acqFifo;
+static uint32_t acqFifoBuffer[ADC_ACQ_FIFO_SAMPLES];
+
+/* Command bytes must stay valid until the DMA has clocked them out */
+static CACHE_ALIGN uint8_t acqReadCmd[1] = { ADC_ACQ_CMD_ADCDATA_READ };
+static CACHE_ALIGN uint8_t acqCtrlCmd[1U + MCP3564_SNAPSHOT_SIZE];
+static CACHE_ALIGN uint8_t acqCtrlRsp[1U + MCP3564_SNAPSHOT_SIZE];
+static CACHE_ALIGN uint8_t acqSnapCmd[1] = { MCP3564_CMD(MCP3564_REG_CONFIG0, MCP3564_CMD_TYPE_INC_READ) };
+static CACHE_ALIGN uint8_t acqSnapRsp[1U + MCP3564_SNAPSHOT_SIZE];
+static CACHE_ALIGN uint8_t acqAsyncCmd[1];
+static CACHE_ALIGN uint8_t acqAsyncRsp[1U + MCP3564_SNAPSHOT_SIZE];
+
+/* Event mode: transmit word and DMAC descriptors (128 bit aligned) */
+static uint32_t acqTxWord = ADC_ACQ_CMD_ADCDATA_READ;
+static dmac_descriptor_registers_t acqTxDesc __ALIGNED(16);
+static dmac_descriptor_registers_t acqRxDesc[2] __ALIGNED(16);
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+static bool lADC_ACQ_TransferDone(uintptr_t context)
+{
+    return (DRV_SPI_TransferStatusGet((DRV_SPI_TRANSFER_HANDLE) context) != DRV_SPI_TRANSFER_EVENT_PENDING);
+}
+
+static bool lADC_ACQ_Drained(uintptr_t context)
+{
+    return (acqObj.donePos == acqObj.queuePos);
+}
+
+/* The data-ready handler adds to the DRV_SPI queue in interrupt context,
+   which DRV_SPI only guards against its own DMAC interrupts from thread
+   context. With one priority for all neither interrupt preempts the other. */
+static bool lADC_ACQ_PrioritiesShared(void)
+{
+    uint32_t priority = NVIC_GetPriority(EIC_EXTINT_14_IRQn);
+
+    return (NVIC_GetPriority(DMAC_0_IRQn) == priority) && (NVIC_GetPriority(DMAC_1_IRQn) == priority);
+}
+
+static void lADC_ACQ_Notify(ADC_ACQ_EVENT event)
+{
+    ADC_ACQ_CALLBACK callback = acqObj.callback;
+
+    if (callback != NULL)
+    {
+        callback(event, acqObj.context);
+    }
+}
+
+/* Sleeps until the DMAC interrupt ends the transfer */
+static bool lADC_ACQ_TransferWait(DRV_SPI_TRANSFER_HANDLE handle)
+{
+    DRV_SPI_TRANSFER_EVENT event;
+    bool done;
+
+    if (handle == DRV_SPI_TRANSFER_HANDLE_INVALID)
+    {
+        return false;
+    }
+
+    APP_PERF_BEGIN(start);
+
+    done = APP_WAIT_Until(APP_WAIT_SPI, lADC_ACQ_TransferDone, (uintptr_t) handle, ADC_ACQ_TRANSFER_TIMEOUT_MS);
+
+    APP_PERF_END(APP_PERF_REGION_SPI, start);
+
+    if (!done)
+    {
+        return false;
+    }
+
+    event = DRV_SPI_TransferStatusGet(handle);
+
+    return (event != DRV_SPI_TRANSFER_EVENT_ERROR) && (event != DRV_SPI_TRANSFER_EVENT_HANDLE_INVALID);
+}
+
+static bool lADC_ACQ_CommandSend(const uint8_t* cmd, size_t size)
+{
+    DRV_SPI_TRANSFER_HANDLE handle;
+
+    memcpy(acqCtrlCmd, cmd, size);
+    DRV_SPI_WriteTransferAdd(acqObj.spiHandle, acqCtrlCmd, size, &handle);
+
+    return lADC_ACQ_TransferWait(handle);
+}
+
+/* One command byte out, STATUS + size register bytes back */
+static bool lADC_ACQ_CommandRead(uint8_t cmd, uint8_t* data, size_t size)
+{
+    DRV_SPI_TRANSFER_HANDLE handle;
+
+    acqCtrlCmd[0] = cmd;
+    DRV_SPI_WriteReadTransferAdd(acqObj.spiHandle, acqCtrlCmd, 1, acqCtrlRsp, size + 1U, &handle);
+
+    if (!lADC_ACQ_TransferWait(handle))
+    {
+        return false;
+    }
+
+    memcpy(data, &acqCtrlRsp[1], size);
+
+    return true;
+}
+
+static void lADC_ACQ_LatencyAdd(uint32_t cycles)
+{
+    if ((acqObj.stats.latencyCount == 0U) || (cycles < acqObj.stats.latencyMin))
+    {
+        acqObj.stats.latencyMin = cycles;
+    }
+    if (cycles > acqObj.stats.latencyMax)
+    {
+        acqObj.stats.latencyMax = cycles;
+    }
+    acqObj.stats.latencySum += cycles;
+    acqObj.stats.latencyCount++;
+}
+
+/* Interrupt context: queue the capture of the latest data-ready edge; false
+   when the capture was not usable */
+static bool lADC_ACQ_StampPush(uint32_t index, uint32_t* ticks)
+{
+    uint32_t head = acqObj.stampHead;
+
+    if (!ADC_STAMP_Captured(ticks))
+    {
+        acqObj.stats.stampMisses++;
+        return false;
+    }
+
+    if ((head - acqObj.stampTail) >= ADC_ACQ_STAMP_DEPTH)
+    {
+        acqObj.stats.stampMisses++;
+        return true;
+    }
+
+    acqObj.stamps[head % ADC_ACQ_STAMP_DEPTH].index = index;
+    acqObj.stamps[head % ADC_ACQ_STAMP_DEPTH].ticks = *ticks;
+    acqObj.stampHead = head + 1U;
+    acqObj.stats.stamps++;
+
+    return true;
+}
+
+/* Check the CRC of each staged read, then keep the 4 byte sample word. The
+   5 byte reads drop STATUS so CH_ID/SGN becomes byte 0. */
+static void lADC_ACQ_StagePack(uint32_t half)
+{
+    uint32_t skip = (acqObj.format == ADC_ACQ_FORMAT_32_CHID) ? 1U : 0U;
+    uint32_t data = acqObj.dataSize;
+    const uint8_t* read;
+    uint16_t crc;
+    uint32_t i;
+
+    for (i = 0; i < ADC_ACQ_BLOCK_SAMPLES; i++)
+    {
+        read = (const uint8_t*)acqStage[half][i];
+
+        if (acqObj.crc)
+        {
+            crc = MCP3564_REG_Crc16(read, data);
+            if ((read[data] != (uint8_t)(crc >> 8)) || (read[data + 1U] != (uint8_t)crc))
+            {
+                acqObj.stats.crcErrors++;
+            }
+        }
+
+        memcpy(&acqRing[half][i], read + skip, sizeof(uint32_t));
+    }
+}
+
+/* Data-ready: EIC interrupt context */
+static void lADC_ACQ_DataReadyHandler(uintptr_t context)
+{
+    DRV_SPI_TRANSFER_HANDLE handle;
+    uint32_t start = DWT->CYCCNT;
+    uint32_t ticks;
+    uint32_t pos = acqObj.queuePos;
+    uint32_t half = pos / ADC_ACQ_BLOCK_SAMPLES;
+
+    APP_TRACE(APP_TRACE_DATA_READY, 0U);
+    acqObj.stats.interrupts++;
+
+    if (acqObj.readSize != ADC_ACQ_SAMPLE_SIZE)
+    {
+        DRV_SPI_WriteReadTransferAdd(acqObj.spiHandle,
+                                     acqReadCmd, 1,
+                                     acqStage[half][pos % ADC_ACQ_BLOCK_SAMPLES], acqObj.readSize,
+                                     &handle);
+    }
+    else
+    {
+        DRV_SPI_WriteReadTransferAdd(acqObj.spiHandle,
+                                     acqReadCmd, 1,
+                                     &acqRing[half][pos % ADC_ACQ_BLOCK_SAMPLES], ADC_ACQ_SAMPLE_SIZE,
+                                     &handle);
+    }
+
+    if (handle == DRV_SPI_TRANSFER_HANDLE_INVALID)
+    {
+        /* Previous read still queued: the conversion is lost, and so is its
+         * capture, else the next edge finds the capture full */
+        (void) ADC_STAMP_Captured(&ticks);
+        acqObj.stats.overruns++;
+        APP_TRACE(APP_TRACE_OVERRUN, 0U);
+        return;
+    }
+
+    if ((pos % ADC_ACQ_BLOCK_SAMPLES) == 0U)
+    {
+        acqObj.probePos = pos;
+        acqObj.probeStart = start - ADC_ACQ_IRQ_ENTRY_CYCLES;
+        (void) lADC_ACQ_StampPush(acqObj.queued, &ticks);
+    }
+    else if ((pos % ADC_ACQ_BLOCK_SAMPLES) == (ADC_ACQ_BLOCK_SAMPLES - 1U))
+    {
+        /* Consume this edge so the next block start is the only capture */
+        (void) ADC_STAMP_Captured(&ticks);
+    }
+
+    acqObj.queued++;
+    acqObj.queuePos = (pos + 1U) % ADC_ACQ_RING_SAMPLES;
+}
+
+/* End of transfer: DMAC interrupt context */
+static void lADC_ACQ_TransferEventHandler(DRV_SPI_TRANSFER_EVENT event, DRV_SPI_TRANSFER_HANDLE transferHandle, uintptr_t context)
+{
+    uint32_t pos;
+
+    if (acqObj.streaming == false)
+    {
+        /* Control transfers are waited for by their issuer, only a queued
+         * command is reported */
+        if (transferHandle == acqObj.cmdHandle)
+        {
+            lADC_ACQ_Notify(ADC_ACQ_EVENT_TRANSFER);
+        }
+        return;
+    }
+
+    if (transferHandle == acqObj.snapHandle)
+    {
+        return;
+    }
+
+    acqObj.stats.interrupts++;
+
+    if (event != DRV_SPI_TRANSFER_EVENT_COMPLETE)
+    {
+        acqObj.stats.errors++;
+    }
+
+    if (acqObj.donePos == acqObj.probePos)
+    {
+        lADC_ACQ_LatencyAdd(DWT->CYCCNT - acqObj.probeStart);
+    }
+
+    pos = (acqObj.donePos + 1U) % ADC_ACQ_RING_SAMPLES;
+    acqObj.donePos = pos;
+    acqObj.stats.samples++;
+
+    if ((pos % ADC_ACQ_BLOCK_SAMPLES) == 0U)
+    {
+        /* The half just finished is the one before pos */
+        uint32_t half = (pos == 0U) ? 1U : 0U;
+
+        if (acqObj.readSize != ADC_ACQ_SAMPLE_SIZE)
+        {
+            lADC_ACQ_StagePack(half);
+        }
+
+        (void) SAMPLE_RING_Push(&acqFifo, acqRing[half], ADC_ACQ_BLOCK_SAMPLES);
+        acqObj.stats.blocks++;
+        lADC_ACQ_Notify(ADC_ACQ_EVENT_BLOCK);
+    }
+}
+
+/* Event mode block start: EIC interrupt, armed for one edge per block */
+static void lADC_ACQ_BlockStart(uintptr_t context)
+{
+    uint32_t start = DWT->CYCCNT;
+    uint32_t index = acqObj.stats.samples;
+    uint32_t ticks;
+
+    EIC_InterruptDisable(EIC_PIN_14);
+    APP_TRACE(APP_TRACE_DATA_READY, 0U);
+    acqObj.stats.interrupts++;
+
+    /* First conversion after the block: its index is the block boundary */
+    if (lADC_ACQ_StampPush(index, &ticks))
+    {
+        acqObj.edges[0] = acqObj.edges[1];
+        acqObj.edges[1].index = index;
+        acqObj.edges[1].ticks = ticks;
+        acqObj.edgeStart = start - ADC_ACQ_IRQ_ENTRY_CYCLES;
+    }
+}
+
+/* Event mode latency, from the block complete interrupt: the last
+   conversion of the block follows one sample period before the next block
+   start, which the TC0 stamps of the last two block starts give exactly.
+   Its edge in CPU cycles is then measured to the interrupt, the same span
+   the driver mode probe measures. */
+static void lADC_ACQ_BlockLatency(uint32_t end, uint32_t index)
+{
+    uint32_t period;
+    uint32_t cycles;
+    uint64_t last;
+
+    if ((acqObj.edges[1].index != index) || (acqObj.edges[0].index != (index - ADC_ACQ_BLOCK_SAMPLES)))
+    {
+        return;
+    }
+
+    period = acqObj.edges[1].ticks - acqObj.edges[0].ticks;
+    last = ((uint64_t)period * (ADC_ACQ_BLOCK_SAMPLES - 1U) * ADC_ACQ_STAMP_CYCLES) / ADC_ACQ_BLOCK_SAMPLES;
+    cycles = end - (acqObj.edgeStart + (uint32_t)last);
+
+    /* A handler later than the next edge measures nothing useful */
+    if (cycles < ((period * ADC_ACQ_STAMP_CYCLES) / ADC_ACQ_BLOCK_SAMPLES))
+    {
+        lADC_ACQ_LatencyAdd(cycles);
+    }
+}
+
+/* Event mode block complete: DMAC channel interrupt context */
+static void lADC_ACQ_BlockHandler(DMAC_TRANSFER_EVENT event, uintptr_t context)
+{
+    uint32_t end = DWT->CYCCNT;
+    uint32_t half = acqObj.dmaHalf;
+    uint32_t ticks;
+
+    APP_TRACE(APP_TRACE_DMA_DONE, ADC_ACQ_DMAC_RX);
+    acqObj.stats.interrupts++;
+
+    if (event != DMAC_TRANSFER_EVENT_COMPLETE)
+    {
+        acqObj.stats.errors++;
+        return;
+    }
+
+    acqObj.dmaHalf = half ^ 1U;
+    lADC_ACQ_BlockLatency(end, acqObj.stats.samples);
+    acqObj.stats.samples += ADC_ACQ_BLOCK_SAMPLES;
+
+    /* The DMAC is on the other half now; one block period to copy this one */
+    (void) SAMPLE_RING_Push(&acqFifo, acqRing[half], ADC_ACQ_BLOCK_SAMPLES);
+    acqObj.stats.blocks++;
+    lADC_ACQ_Notify(ADC_ACQ_EVENT_BLOCK);
+
+    /* Stamp the next conversion, the start of the next block */
+    (void) ADC_STAMP_Captured(&ticks);
+    EIC_REGS->EIC_INTFLAG = (1UL << (uint32_t)EIC_PIN_14);
+    EIC_InterruptEnable(EIC_PIN_14);
+}
+
+static void lADC_ACQ_SercomWordMode(bool enable)
+{
+    SERCOM1_REGS->SPIM.SERCOM_CTRLA &= ~SERCOM_SPIM_CTRLA_ENABLE_Msk;
+    while (SERCOM1_REGS->SPIM.SERCOM_SYNCBUSY != 0U)
+    {
+        /* Wait for synchronization */
+    }
+
+    if (enable == true)
+    {
+        acqObj.savedBaud = SERCOM1_REGS->SPIM.SERCOM_BAUD;
+
+        SERCOM1_REGS->SPIM.SERCOM_INTENCLR = (uint8_t)SERCOM_SPIM_INTENCLR_Msk;
+        SERCOM1_REGS->SPIM.SERCOM_BAUD = (uint8_t)SERCOM_SPIM_BAUD_BAUD(ADC_ACQ_SERCOM_BAUD);
+        SERCOM1_REGS->SPIM.SERCOM_CTRLC = SERCOM_SPIM_CTRLC_DATA32B_Msk;
+        SERCOM1_REGS->SPIM.SERCOM_LENGTH = SERCOM_SPIM_LENGTH_LEN(ADC_ACQ_SAMPLE_SIZE) | SERCOM_SPIM_LENGTH_LENEN_Msk;
+    }
+    else
+    {
+        SERCOM1_REGS->SPIM.SERCOM_LENGTH = 0U;
+        SERCOM1_REGS->SPIM.SERCOM_CTRLC = 0U;
+        SERCOM1_REGS->SPIM.SERCOM_BAUD = acqObj.savedBaud;
+    }
+
+    SERCOM1_REGS->SPIM.SERCOM_CTRLA |= SERCOM_SPIM_CTRLA_ENABLE_Msk;
+    while (SERCOM1_REGS->SPIM.SERCOM_SYNCBUSY != 0U)
+    {
+        /* Wait for synchronization */
+    }
+}
+
+static void lADC_ACQ_ChainArm(void)
+{
+    uint32_t data = (uint32_t)&SERCOM1_REGS->SPIM.SERCOM_DATA;
+    uint32_t i;
+
+    EIC_InterruptDisable(EIC_PIN_14);
+    EIC_CallbackRegister(EIC_PIN_14, lADC_ACQ_BlockStart, 0);
+
+    lADC_ACQ_SercomWordMode(true);
+
+    /* TX: one beat per data-ready event, the descriptor loops on itself */
+    acqTxDesc.DMAC_BTCTRL   = DMAC_BTCTRL_VALID_Msk | DMAC_BTCTRL_BEATSIZE_WORD | DMAC_BTCTRL_BLOCKACT_NOACT;
+    acqTxDesc.DMAC_BTCNT    = ADC_ACQ_BLOCK_SAMPLES;
+    acqTxDesc.DMAC_SRCADDR  = (uint32_t)&acqTxWord;
+    acqTxDesc.DMAC_DSTADDR  = data;
+    acqTxDesc.DMAC_DESCADDR = (uint32_t)&acqTxDesc;
+
+    /* RX: one descriptor per half, linked in a ring, interrupt per block */
+    for (i = 0; i < 2U; i++)
+    {
+        acqRxDesc[i].DMAC_BTCTRL   = DMAC_BTCTRL_VALID_Msk | DMAC_BTCTRL_BEATSIZE_WORD | DMAC_BTCTRL_DSTINC_Msk |
+                                     DMAC_BTCTRL_BLOCKACT_INT | DMAC_BTCTRL_EVOSEL_BURST;
+        acqRxDesc[i].DMAC_BTCNT    = ADC_ACQ_BLOCK_SAMPLES;
+        acqRxDesc[i].DMAC_SRCADDR  = data;
+        acqRxDesc[i].DMAC_DSTADDR  = (uint32_t)&acqRing[i][ADC_ACQ_BLOCK_SAMPLES];
+        acqRxDesc[i].DMAC_DESCADDR = (uint32_t)&acqRxDesc[i ^ 1U];
+    }
+
+    acqObj.savedTxBtCtrl = DMAC_ChannelSettingsGet(ADC_ACQ_DMAC_TX);
+    acqObj.savedRxBtCtrl = DMAC_ChannelSettingsGet(ADC_ACQ_DMAC_RX);
+    acqObj.savedTxCtrlA  = DMAC_REGS->CHANNEL[ADC_ACQ_DMAC_TX].DMAC_CHCTRLA;
+    acqObj.savedRxCtrlA  = DMAC_REGS->CHANNEL[ADC_ACQ_DMAC_RX].DMAC_CHCTRLA;
+
+    DMAC_ChannelDisable(ADC_ACQ_DMAC_TX);
+    DMAC_ChannelDisable(ADC_ACQ_DMAC_RX);
+
+    DMAC_REGS->CHANNEL[ADC_ACQ_DMAC_TX].DMAC_CHCTRLA = DMAC_CHCTRLA_TRIGACT_BURST | DMAC_CHCTRLA_TRIGSRC(0U);
+    DMAC_REGS->CHANNEL[ADC_ACQ_DMAC_TX].DMAC_CHEVCTRL = DMAC_CHEVCTRL_EVIE_Msk | DMAC_CHEVCTRL_EVACT_TRIG;
+    DMAC_REGS->CHANNEL[ADC_ACQ_DMAC_TX].DMAC_CHINTENCLR = DMAC_CHINTENCLR_TCMPL_Msk;
+
+    DMAC_REGS->CHANNEL[ADC_ACQ_DMAC_RX].DMAC_CHCTRLA = DMAC_CHCTRLA_TRIGACT_BURST | DMAC_CHCTRLA_TRIGSRC(ADC_ACQ_DMAC_TRIGSRC_SERCOM1_RX);
+    DMAC_REGS->CHANNEL[ADC_ACQ_DMAC_RX].DMAC_CHEVCTRL = DMAC_CHEVCTRL_EVOE_Msk | DMAC_CHEVCTRL_EVOMODE_DEFAULT;
+
+    acqObj.dmaHalf = 0;
+    DMAC_ChannelCallbackRegister(ADC_ACQ_DMAC_RX, lADC_ACQ_BlockHandler, 0);
+    DMAC_ChannelCallbackRegister(ADC_ACQ_DMAC_TX, NULL, 0);
+    (void) DMAC_ChannelLinkedListTransfer(ADC_ACQ_DMAC_RX, &acqRxDesc[0]);
+    (void) DMAC_ChannelLinkedListTransfer(ADC_ACQ_DMAC_TX, &acqTxDesc);
+
+    /* CS idles high; hand it to the event system last */
+    SPI_CS_Set();
+    PORT_REGS->GROUP[ADC_ACQ_CS_GROUP].PORT_EVCTRL =
+        PORT_EVCTRL_PID0(ADC_ACQ_CS_PIN) | PORT_EVCTRL_EVACT0_CLR | PORT_EVCTRL_PORTEI0_Msk |
+        PORT_EVCTRL_PID1(ADC_ACQ_CS_PIN) | PORT_EVCTRL_EVACT1(PORT_EVCTRL_EVACT0_SET_Val) | PORT_EVCTRL_PORTEI1_Msk;
+
+    /* Stamp of the first block start */
+    acqObj.edges[0].index = ADC_ACQ_EDGE_NONE;
+    acqObj.edges[1].index = ADC_ACQ_EDGE_NONE;
+    EIC_REGS->EIC_INTFLAG = (1UL << (uint32_t)EIC_PIN_14);
+    EIC_InterruptEnable(EIC_PIN_14);
+}
+
+static void lADC_ACQ_ChainDisarm(void)
+{
+    EIC_InterruptDisable(EIC_PIN_14);
+    DMAC_REGS->CHANNEL[ADC_ACQ_DMAC_TX].DMAC_CHEVCTRL = 0U;
+
+    /* No waiting for a read still on the bus: raising CS cuts it short,
+     * which the MCP3564 takes as the end of the command, and its sample
+     * belongs to a partial block which is discarded anyway */
+    DMAC_ChannelDisable(ADC_ACQ_DMAC_TX);
+    DMAC_ChannelDisable(ADC_ACQ_DMAC_RX);
+
+    PORT_REGS->GROUP[ADC_ACQ_CS_GROUP].PORT_EVCTRL = 0U;
+    SPI_CS_Set();
+
+    DMAC_REGS->CHANNEL[ADC_ACQ_DMAC_RX].DMAC_CHEVCTRL = 0U;
+    DMAC_REGS->CHANNEL[ADC_ACQ_DMAC_TX].DMAC_CHCTRLA = acqObj.savedTxCtrlA & ~DMAC_CHCTRLA_ENABLE_Msk;
+    DMAC_REGS->CHANNEL[ADC_ACQ_DMAC_RX].DMAC_CHCTRLA = acqObj.savedRxCtrlA & ~DMAC_CHCTRLA_ENABLE_Msk;
+    DMAC_REGS->CHANNEL[ADC_ACQ_DMAC_TX].DMAC_CHINTENSET = DMAC_CHINTENSET_TCMPL_Msk;
+    (void) DMAC_ChannelSettingsSet(ADC_ACQ_DMAC_TX, acqObj.savedTxBtCtrl);
+    (void) DMAC_ChannelSettingsSet(ADC_ACQ_DMAC_RX, acqObj.savedRxBtCtrl);
+
+    lADC_ACQ_SercomWordMode(false);
+
+    /* Back to the plib default: pin 14 interrupt enabled, no callback */
+    EIC_CallbackRegister(EIC_PIN_14, NULL, 0);
+    EIC_REGS->EIC_INTFLAG = (1UL << (uint32_t)EIC_PIN_14);
+    EIC_InterruptEnable(EIC_PIN_14);
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+bool ADC_ACQ_Initialize(void)
+{
+    DRV_SPI_TRANSFER_SETUP setup;
+
+    acqObj.spiHandle = DRV_SPI_Open(DRV_SPI_INDEX_0, DRV_IO_INTENT_READWRITE);
+    if (acqObj.spiHandle == DRV_HANDLE_INVALID)
+    {
+        return false;
+    }
+
+    /* MCP3564: SPI mode 0,0, CS on PB05 */
+    setup.baudRateInHz  = ADC_ACQ_SPI_CLOCK_HZ;
+    setup.clockPhase    = DRV_SPI_CLOCK_PHASE_VALID_LEADING_EDGE;
+    setup.clockPolarity = DRV_SPI_CLOCK_POLARITY_IDLE_LOW;
+    setup.dataBits      = DRV_SPI_DATA_BITS_8;
+    setup.chipSelect    = SYS_PORT_PIN_PB05;
+    setup.csPolarity    = DRV_SPI_CS_POLARITY_ACTIVE_LOW;
+
+    if (DRV_SPI_TransferSetup(acqObj.spiHandle, &setup) == false)
+    {
+        return false;
+    }
+
+    DRV_SPI_TransferEventHandlerSet(acqObj.spiHandle, lADC_ACQ_TransferEventHandler, 0);
+
+    (void) SAMPLE_RING_Initialize(&acqFifo, acqFifoBuffer, ADC_ACQ_FIFO_SAMPLES);
+
+    ADC_STAMP_Initialize();
+
+    /* Cycle counter for the latency measurement */
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    return true;
+}
+
+bool ADC_ACQ_Start(ADC_ACQ_MODE mode, ADC_ACQ_FORMAT format)
+{
+    static const uint8_t conversion[] = { ADC_ACQ_CMD_CONVERSION };
+    uint8_t config3[2];
+    uint32_t ticks;
+
+    if ((acqObj.spiHandle == DRV_HANDLE_INVALID) || (acqObj.streaming == true))
+    {
+        return false;
+    }
+
+    /* Its completion would be taken for a sample */
+    if (acqObj.cmdHandle != DRV_SPI_TRANSFER_HANDLE_INVALID)
+    {
+        (void) lADC_ACQ_TransferWait(acqObj.cmdHandle);
+        acqObj.cmdHandle = DRV_SPI_TRANSFER_HANDLE_INVALID;
+    }
+
+    /* The event chain moves exactly one 32 bit word per conversion */
+    if ((mode == ADC_ACQ_MODE_EVENT) && ((format != ADC_ACQ_FORMAT_24) || acqObj.crc))
+    {
+        return false;
+    }
+
+    if ((mode == ADC_ACQ_MODE_DRIVER) && !lADC_ACQ_PrioritiesShared())
+    {
+        return false;
+    }
+
+    config3[0] = ADC_ACQ_CMD_CONFIG3_WRITE;
+    config3[1] = ADC_ACQ_CONFIG3_CONTINUOUS | ADC_ACQ_CONFIG3_FORMAT(format);
+
+    acqObj.dataSize = (format == ADC_ACQ_FORMAT_32_CHID) ? ADC_ACQ_SAMPLE_SIZE_CHID : ADC_ACQ_SAMPLE_SIZE;
+    acqObj.readSize = acqObj.dataSize;
+    if (acqObj.crc)
+    {
+        config3[1] |= MCP3564_CONFIG3_EN_CRCCOM;
+        acqObj.readSize += MCP3564_CRC_SIZE;
+    }
+
+    acqObj.queuePos  = 0;
+    acqObj.donePos   = 0;
+    acqObj.probePos  = ADC_ACQ_RING_SAMPLES;
+    acqObj.queued    = 0;
+    acqObj.stampHead = 0;
+    acqObj.stampTail = 0;
+    acqObj.mode      = mode;
+    acqObj.format    = format;
+    memset((void*)&acqObj.stats, 0, sizeof(acqObj.stats));
+    acqObj.stats.mode = mode;
+    SAMPLE_RING_Reset(&acqFifo);
+
+    if (lADC_ACQ_CommandSend(config3, sizeof(config3)) == false)
+    {
+        return false;
+    }
+
+    MCP3564_CACHE_Set(MCP3564_REG_CONFIG3, config3[1]);
+
+    if (lADC_ACQ_CommandSend(conversion, sizeof(conversion)) == false)
+    {
+        return false;
+    }
+
+    acqObj.streaming = true;
+
+    /* The conversions before the handler is in place were captured by TC0;
+     * drop that capture so the first block start is stamped */
+    (void) ADC_STAMP_Captured(&ticks);
+
+    if (mode == ADC_ACQ_MODE_EVENT)
+    {
+        lADC_ACQ_ChainArm();
+    }
+    else
+    {
+        EIC_CallbackRegister(EIC_PIN_14, lADC_ACQ_DataReadyHandler, 0);
+    }
+
+    return true;
+}
+
+void ADC_ACQ_Stop(void)
+{
+    static const uint8_t standby[] = { ADC_ACQ_CMD_STANDBY };
+
+    if (acqObj.streaming == false)
+    {
+        return;
+    }
+
+    if (acqObj.mode == ADC_ACQ_MODE_EVENT)
+    {
+        lADC_ACQ_ChainDisarm();
+    }
+    else
+    {
+        EIC_CallbackRegister(EIC_PIN_14, NULL, 0);
+
+        /* Let the reads already queued land in the ring */
+        (void) APP_WAIT_Until(APP_WAIT_DRAIN, lADC_ACQ_Drained, 0U, ADC_ACQ_TRANSFER_TIMEOUT_MS);
+    }
+
+    acqObj.streaming = false;
+
+    (void) lADC_ACQ_CommandSend(standby, sizeof(standby));
+}
+
+bool ADC_ACQ_SnapshotRead(MCP3564_SNAPSHOT* snapshot)
+{
+    DRV_SPI_TRANSFER_HANDLE handle;
+    bool streaming;
+    bool ok;
+
+    if ((acqObj.spiHandle == DRV_HANDLE_INVALID) ||
+        ((acqObj.streaming == true) && (acqObj.mode == ADC_ACQ_MODE_EVENT)))
+    {
+        return false;
+    }
+
+    /* The EIC handler adds to the same queue; hold it off for the add only */
+    streaming = acqObj.streaming;
+    if (streaming)
+    {
+        EIC_InterruptDisable(EIC_PIN_14);
+    }
+    DRV_SPI_WriteReadTransferAdd(acqObj.spiHandle, acqSnapCmd, 1, acqSnapRsp, sizeof(acqSnapRsp),
+                                 (DRV_SPI_TRANSFER_HANDLE*)&acqObj.snapHandle);
+    handle = acqObj.snapHandle;
+    if (streaming)
+    {
+        EIC_InterruptEnable(EIC_PIN_14);
+    }
+
+    ok = lADC_ACQ_TransferWait(handle);
+    acqObj.snapHandle = DRV_SPI_TRANSFER_HANDLE_INVALID;
+
+    if (ok)
+    {
+        MCP3564_REG_SnapshotDecode(&acqSnapRsp[1], snapshot);
+    }
+
+    return ok;
+}
+
+bool ADC_ACQ_ConfigWrite(const MCP3564_CONFIG* config, bool scan, bool verify)
+{
+    const MCP3564_REG* reg = MCP3564_REG_Get(MCP3564_REG_CONFIG0);
+    uint8_t cmd[1U + MCP3564_CONFIG_SIZE_SCAN];
+    uint8_t readback[MCP3564_CONFIG_SIZE_SCAN];
+    uint32_t size;
+    uint32_t i;
+
+    if ((acqObj.spiHandle == DRV_HANDLE_INVALID) || (acqObj.streaming == true))
+    {
+        return false;
+    }
+
+    cmd[0] = reg->writeCmd;
+    size = MCP3564_REG_ConfigEncode(config, scan, &cmd[1]);
+
+    if (!lADC_ACQ_CommandSend(cmd, size + 1U))
+    {
+        return false;
+    }
+
+    if (!verify)
+    {
+        return true;
+    }
+
+    if (!lADC_ACQ_CommandRead(reg->readCmd, readback, size))
+    {
+        return false;
+    }
+
+    /* Mask the IRQ status flags, everything else must read back as sent */
+    cmd[1U + (MCP3564_REG_IRQ - MCP3564_REG_CONFIG0)] &= MCP3564_IRQ_WRITE_MASK;
+    readback[MCP3564_REG_IRQ - MCP3564_REG_CONFIG0] &= MCP3564_IRQ_WRITE_MASK;
+
+    for (i = 0; i < size; i++)
+    {
+        if (readback[i] != cmd[1U + i])
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool ADC_ACQ_BurstWrite(uint32_t address, const uint8_t* data, uint32_t size)
+{
+    const MCP3564_REG* reg = MCP3564_REG_Get(address);
+    uint8_t cmd[1U + MCP3564_SNAPSHOT_SIZE];
+    uint32_t span = 0;
+    uint32_t next;
+
+    if ((reg == NULL) || (size == 0U) || (size > MCP3564_SNAPSHOT_SIZE) ||
+        (acqObj.spiHandle == DRV_HANDLE_INVALID) || (acqObj.streaming == true))
+    {
+        return false;
+    }
+
+    /* Every register the write walks over must be writable */
+    for (next = address; span < size; next++)
+    {
+        const MCP3564_REG* r = MCP3564_REG_Get(next);
+
+        if ((r == NULL) || ((r->access & MCP3564_ACCESS_W) == 0U))
+        {
+            return false;
+        }
+        span += r->size;
+    }
+
+    if (span != size)
+    {
+        return false;
+    }
+
+    cmd[0] = reg->writeCmd;
+    memcpy(&cmd[1], data, size);
+
+    return lADC_ACQ_CommandSend(cmd, size + 1U);
+}
+
+bool ADC_ACQ_RegisterRead(uint32_t address, uint32_t* value)
+{
+    const MCP3564_REG* reg = MCP3564_REG_Get(address);
+    uint8_t data[MCP3564_REG_SIZE_MAX];
+    uint32_t i;
+
+    if ((reg == NULL) || ((reg->access & MCP3564_ACCESS_R) == 0U) ||
+        (acqObj.spiHandle == DRV_HANDLE_INVALID) || (acqObj.streaming == true))
+    {
+        return false;
+    }
+
+    if (!lADC_ACQ_CommandRead(reg->readCmd, data, reg->size))
+    {
+        return false;
+    }
+
+    /* MSB first */
+    *value = 0;
+    for (i = 0; i < reg->size; i++)
+    {
+        *value = (*value << 8) | data[i];
+    }
+
+    return true;
+}
+
+bool ADC_ACQ_RegisterWrite(uint32_t address, uint32_t value)
+{
+    const MCP3564_REG* reg = MCP3564_REG_Get(address);
+    uint8_t cmd[1U + MCP3564_REG_SIZE_MAX];
+    uint32_t i;
+
+    if ((reg == NULL) || ((reg->access & MCP3564_ACCESS_W) == 0U) ||
+        (acqObj.spiHandle == DRV_HANDLE_INVALID) || (acqObj.streaming == true))
+    {
+        return false;
+    }
+
+    /* Reject values that do not fit instead of silently truncating them */
+    if ((reg->size < 4U) && ((value >> (8U * reg->size)) != 0U))
+    {
+        return false;
+    }
+
+    cmd[0] = reg->writeCmd;
+    for (i = 0; i < reg->size; i++)
+    {
+        cmd[1U + i] = (uint8_t)(value >> (8U * (reg->size - 1U - i)));
+    }
+
+    return lADC_ACQ_CommandSend(cmd, reg->size + 1U);
+}
+
+bool ADC_ACQ_CommandStart(uint8_t command, uint32_t size)
+{
+    /* A finished command no one polled any more is dropped */
+    if ((acqObj.cmdHandle != DRV_SPI_TRANSFER_HANDLE_INVALID) &&
+        (ADC_ACQ_CommandStatusGet(NULL) == ADC_ACQ_COMMAND_PENDING))
+    {
+        return false;
+    }
+
+    if ((size > MCP3564_SNAPSHOT_SIZE) || (acqObj.spiHandle == DRV_HANDLE_INVALID) || (acqObj.streaming == true))
+    {
+        return false;
+    }
+
+    /* The handle is in place before the transfer can end and notify */
+    acqAsyncCmd[0] = command;
+    acqObj.cmdSize = size;
+    DRV_SPI_WriteReadTransferAdd(acqObj.spiHandle, acqAsyncCmd, 1, acqAsyncRsp, size + 1U,
+                                 (DRV_SPI_TRANSFER_HANDLE*)&acqObj.cmdHandle);
+    if (acqObj.cmdHandle == DRV_SPI_TRANSFER_HANDLE_INVALID)
+    {
+        return false;
+    }
+
+    return true;
+}
+
+ADC_ACQ_COMMAND_STATUS ADC_ACQ_CommandStatusGet(uint8_t* response)
+{
+    DRV_SPI_TRANSFER_EVENT event;
+
+    if (acqObj.cmdHandle == DRV_SPI_TRANSFER_HANDLE_INVALID)
+    {
+        return ADC_ACQ_COMMAND_ERROR;
+    }
+
+    event = DRV_SPI_TransferStatusGet(acqObj.cmdHandle);
+    if (event == DRV_SPI_TRANSFER_EVENT_PENDING)
+    {
+        return ADC_ACQ_COMMAND_PENDING;
+    }
+
+    acqObj.cmdHandle = DRV_SPI_TRANSFER_HANDLE_INVALID;
+
+    if ((event == DRV_SPI_TRANSFER_EVENT_ERROR) || (event == DRV_SPI_TRANSFER_EVENT_HANDLE_INVALID))
+    {
+        return ADC_ACQ_COMMAND_ERROR;
+    }
+
+    if (response != NULL)
+    {
+        memcpy(response, acqAsyncRsp, acqObj.cmdSize + 1U);
+    }
+
+    return ADC_ACQ_COMMAND_DONE;
+}
+
+bool ADC_ACQ_IsRunning(void)
+{
+    return acqObj.streaming;
+}
+
+void ADC_ACQ_CallbackRegister(ADC_ACQ_CALLBACK callback, uintptr_t context)
+{
+    acqObj.callback = NULL;
+    acqObj.context = context;
+    acqObj.callback = callback;
+}
+
+bool ADC_ACQ_CrcEnable(bool enable)
+{
+    if (acqObj.streaming)
+    {
+        return false;
+    }
+
+    acqObj.crc = enable;
+    return true;
+}
+
+bool ADC_ACQ_CrcIsEnabled(void)
+{
+    return acqObj.crc;
+}
+
+uint32_t ADC_ACQ_Read(uint32_t* samples, uint32_t count)
+{
+    return SAMPLE_RING_Pop(&acqFifo, samples, count);
+}
+
+bool ADC_ACQ_StampRead(ADC_ACQ_STAMP* stamp)
+{
+    uint32_t tail = acqObj.stampTail;
+
+    if (tail == acqObj.stampHead)
+    {
+        return false;
+    }
+
+    *stamp = acqObj.stamps[tail % ADC_ACQ_STAMP_DEPTH];
+    acqObj.stampTail = tail + 1U;
+
+    return true;
+}
+
+void ADC_ACQ_StatsGet(ADC_ACQ_STATS* stats)
+{
+    __disable_irq();
+    *stats = acqObj.stats;
+    __enable_irq();
+
+    stats->dropped   = SAMPLE_RING_OverrunsGet(&acqFifo);
+    stats->highWater = SAMPLE_RING_HighWaterGet(&acqFifo);
+}
+
+int32_t ADC_ACQ_SampleDecode(uint32_t raw)
+{
+    int32_t value;
+
+    if (acqObj.format == ADC_ACQ_FORMAT_32_CHID)
+    {
+        ADC_DECODE_Block32Sgn(&raw, &value, 1U);
+    }
+    else
+    {
+        ADC_DECODE_Block32(&raw, &value, 1U);
+    }
+
+    return value;
+}
+
+/*******************************************************************************
+ End of File
+ */
@@ -0,0 +1,484 @@
+/*******************************************************************************
+  MCP3564 Continuous Acquisition Header File
+
+  File Name:
+    adc_acq.h
+
+  Summary:
+    DMA driven continuous ADCDATA acquisition for the MCP3564.
+
+  Description:
+    This module puts the MCP3564 in continuous conversion mode and reads every
+    conversion through the DMA mode of the SPI driver (DRV_SPI). Every
+    data-ready edge on EIC pin 14 queues one ADCDATA read with
+    DRV_SPI_WriteReadTransferAdd; the DMAC channels 0/1 move the bytes while
+    the CPU is free. Samples are collected into two ping-pong blocks; each
+    completed block is pushed into a sample FIFO which the application
+    drains with ADC_ACQ_Read.
+
+    The reads are queued from the EIC interrupt, while the DRV_SPI DMAC
+    interrupts take them off the same queue. That is only safe because
+    neither interrupt can preempt the other: ADC_ACQ_Start refuses the
+    driver mode unless EIC_EXTINT_14 and DMAC channels 0/1 share one NVIC
+    priority (7 for all in this configuration).
+
+    The fastest rate is 125 ksps with MCLK from the DFLL (48 MHz / 3) and
+    156.25 ksps from DPLL0 (120 MHz / 6), see mcp3564_rate.h.
+
+    In event mode the data-ready edge is routed through EVSYS instead: it
+    drives CS low (PORT event) and triggers the SPI read DMA directly, the
+    end of the received word drives CS high again. The CPU only sees one
+    interrupt per block.
+*******************************************************************************/
+
+#ifndef _ADC_ACQ_H
+#define _ADC_ACQ_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "configuration.h"
+#include "mcp3564_reg.h"
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+extern "C" {
+
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Constants
+// *****************************************************************************
+// *****************************************************************************
+
+/* Number of samples in one ping-pong block */
+#define ADC_ACQ_BLOCK_SAMPLES               128U
+
+/* Bytes clocked per ADCDATA read: STATUS byte followed by 24 data bits */
+#define ADC_ACQ_SAMPLE_SIZE                 4U
+
+/* Sample FIFO depth, power of two: 26 ms at 156.25 ksps */
+#define ADC_ACQ_FIFO_SAMPLES                4096U
+
+/* SCK used while streaming. 60 MHz / (2 * (1 + 1)) = 15 MHz on SERCOM1. */
+#define ADC_ACQ_SPI_CLOCK_HZ                15000000U
+
+/* Block time stamps kept until read, one per FIFO block */
+#define ADC_ACQ_STAMP_DEPTH                 (ADC_ACQ_FIFO_SAMPLES / ADC_ACQ_BLOCK_SAMPLES)
+
+/* Cycles from the edge to the first ISR instruction (EIC sync + stacking) */
+#define ADC_ACQ_IRQ_ENTRY_CYCLES            16U
+
+/* A blocking control transfer which takes longer has failed */
+#define ADC_ACQ_TRANSFER_TIMEOUT_MS         100U
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Type Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Acquisition mode
+
+  Summary:
+    Selects how a data-ready edge turns into an ADCDATA read.
+
+  Remarks:
+    ADC_ACQ_MODE_DRIVER: EIC interrupt per sample, read queued on DRV_SPI.
+    ADC_ACQ_MODE_EVENT: EIC -> EVSYS -> DMAC/PORT chain, no interrupt per
+    sample. DMAC channels 0/1 and SERCOM1 are taken from DRV_SPI while the
+    acquisition runs.
+*/
+
+typedef enum
+{
+    ADC_ACQ_MODE_DRIVER = 0,
+    ADC_ACQ_MODE_EVENT
+
+} ADC_ACQ_MODE;
+
+// *****************************************************************************
+/* ADCDATA format
+
+  Summary:
+    CONFIG3.DATA_FORMAT used while streaming.
+
+  Remarks:
+    ADC_ACQ_FORMAT_32_CHID puts the channel ID in the top nibble of the
+    extra byte; the raw word then holds CH_ID/SGN in byte 0 instead of
+    STATUS. It is only available in ADC_ACQ_MODE_DRIVER.
+*/
+
+typedef enum
+{
+    ADC_ACQ_FORMAT_24 = 0,
+    ADC_ACQ_FORMAT_32_CHID = 3
+
+} ADC_ACQ_FORMAT;
+
+// *****************************************************************************
+/* Acquisition statistics
+
+  Summary:
+    Counters maintained by the acquisition engine.
+
+  Remarks:
+    overruns counts data-ready edges which arrived while the SPI driver queue
+    was full (the sample is lost). dropped counts samples which did not fit
+    in the FIFO, highWater is the deepest FIFO fill seen.
+
+    interrupts counts the CPU interrupts taken by the acquisition. Latency is
+    measured in CPU cycles from the data-ready edge to the DMAC interrupt
+    which reports the sample in RAM: in driver mode for the first sample of
+    every block, in event mode for the last one, whose edge is placed from
+    the TC0 stamps of the block starts.
+
+    crcErrors counts ADCDATA reads whose CRC-16 did not match, with
+    ADC_ACQ_CrcEnable on; the sample is still delivered.
+*/
+
+typedef struct
+{
+    ADC_ACQ_MODE mode;
+    uint32_t samples;
+    uint32_t blocks;
+    uint32_t overruns;
+    uint32_t dropped;
+    uint32_t highWater;
+    uint32_t errors;
+    uint32_t interrupts;
+    uint32_t latencyMin;
+    uint32_t latencyMax;
+    uint32_t latencyCount;
+    uint64_t latencySum;
+    uint32_t stamps;
+    uint32_t stampMisses;
+    uint32_t crcErrors;
+
+} ADC_ACQ_STATS;
+
+// *****************************************************************************
+/* Queued command status
+
+  Summary:
+    Progress of a command started by ADC_ACQ_CommandStart.
+*/
+
+typedef enum
+{
+    ADC_ACQ_COMMAND_PENDING = 0,
+    ADC_ACQ_COMMAND_DONE,
+    ADC_ACQ_COMMAND_ERROR
+
+} ADC_ACQ_COMMAND_STATUS;
+
+// *****************************************************************************
+/* Acquisition event
+
+  Summary:
+    What the callback registered by ADC_ACQ_CallbackRegister reports.
+
+  Remarks:
+    Both come from interrupt context, for a consumer which sleeps until
+    there is something to do instead of polling.
+*/
+
+typedef enum
+{
+    /* A block of samples was added to the FIFO (ADC_ACQ_Read) */
+    ADC_ACQ_EVENT_BLOCK = 0,
+
+    /* The transfer of an ADC_ACQ_CommandStart ended */
+    ADC_ACQ_EVENT_TRANSFER
+
+} ADC_ACQ_EVENT;
+
+typedef void (*ADC_ACQ_CALLBACK)(ADC_ACQ_EVENT event, uintptr_t context);
+
+// *****************************************************************************
+/* Block time stamp
+
+  Summary:
+    Hardware capture of the data-ready edge of one sample.
+
+  Remarks:
+    index is the position of the stamped sample in the stream returned by
+    ADC_ACQ_Read, counted from 0 at ADC_ACQ_Start; it stays exact as long
+    as the FIFO does not drop samples. ticks is on the ADC_STAMP time base
+    (ADC_STAMP_FREQUENCY_HZ).
+
+    Driver mode stamps the first sample of every block. Event mode stamps
+    the first conversion after each block completes, from an EIC interrupt
+    armed for that one edge. A stamp whose edge cannot be told apart
+    from a neighbour is dropped and counted in stampMisses.
+*/
+
+typedef struct
+{
+    uint32_t index;
+    uint32_t ticks;
+
+} ADC_ACQ_STAMP;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+/*******************************************************************************
+  Function:
+    bool ADC_ACQ_Initialize ( void )
+
+  Summary:
+    Opens the SPI driver client used by the acquisition engine.
+
+  Remarks:
+    Must be called after DRV_SPI_Initialize (from APP_Initialize).
+*/
+
+bool ADC_ACQ_Initialize ( void );
+
+/*******************************************************************************
+  Function:
+    bool ADC_ACQ_Start ( ADC_ACQ_MODE mode, ADC_ACQ_FORMAT format )
+
+  Summary:
+    Switches the MCP3564 to continuous conversion and starts streaming.
+
+  Description:
+    Writes CONFIG3 (CONV_MODE = continuous, DATA_FORMAT = format), issues the
+    conversion start fast command and arms the data-ready path selected by
+    mode. From then on every conversion is read by DMA into the ping-pong
+    blocks. Returns false in ADC_ACQ_MODE_EVENT for any format other than
+    ADC_ACQ_FORMAT_24 or with CRC checking on, and in ADC_ACQ_MODE_DRIVER
+    when the EIC and DRV_SPI DMAC interrupt priorities differ.
+
+  Remarks:
+    SERCOM1 must not be used through its PLIB while the acquisition runs.
+*/
+
+bool ADC_ACQ_Start ( ADC_ACQ_MODE mode, ADC_ACQ_FORMAT format );
+
+/*******************************************************************************
+  Function:
+    void ADC_ACQ_Stop ( void )
+
+  Summary:
+    Stops streaming and puts the MCP3564 in standby.
+*/
+
+void ADC_ACQ_Stop ( void );
+
+bool ADC_ACQ_IsRunning ( void );
+
+/* Sets the function told about ADC_ACQ_EVENTs, NULL for none */
+void ADC_ACQ_CallbackRegister ( ADC_ACQ_CALLBACK callback, uintptr_t context );
+
+/*******************************************************************************
+  Function:
+    bool ADC_ACQ_CrcEnable ( bool enable )
+
+  Summary:
+    Selects CRC checking of the ADCDATA reads for the next ADC_ACQ_Start.
+
+  Description:
+    With CRC on, CONFIG3.EN_CRCCOM is set and the MCP3564 appends a CRC-16
+    to every ADCDATA read. Each read is checked with MCP3564_REG_Crc16 when
+    its block completes, mismatches go to crcErrors. Fails while streaming.
+
+  Remarks:
+    Driver mode only: the two extra bytes do not fit the one word per
+    conversion of the event chain.
+*/
+
+bool ADC_ACQ_CrcEnable ( bool enable );
+
+bool ADC_ACQ_CrcIsEnabled ( void );
+
+/*******************************************************************************
+  Function:
+    bool ADC_ACQ_SnapshotRead ( MCP3564_SNAPSHOT* snapshot )
+
+  Summary:
+    Reads CONFIG0 through CRCCFG with one incremental read.
+
+  Description:
+    One command byte, one chip select frame and one DMA transfer of
+    MCP3564_SNAPSHOT_SIZE bytes. Allowed while streaming in
+    ADC_ACQ_MODE_DRIVER: the read is queued between two ADCDATA reads and
+    at the fastest data rates the conversion it displaces shows up in the
+    overrun counter. Fails in ADC_ACQ_MODE_EVENT, which owns SERCOM1.
+*/
+
+bool ADC_ACQ_SnapshotRead ( MCP3564_SNAPSHOT* snapshot );
+
+/*******************************************************************************
+  Function:
+    bool ADC_ACQ_ConfigWrite ( const MCP3564_CONFIG* config, bool scan, bool verify )
+
+  Summary:
+    Applies CONFIG0..MUX (and SCAN/TIMER when scan is true) with one
+    incremental write.
+
+  Description:
+    One command byte followed by 6 or 12 data bytes in a single chip select
+    frame. With verify the same range is read back in a second burst and
+    compared; IRQ status flags are ignored. Returns false on a transfer
+    error or a mismatch.
+
+  Remarks:
+    Only while the acquisition is stopped.
+*/
+
+bool ADC_ACQ_ConfigWrite ( const MCP3564_CONFIG* config, bool scan, bool verify );
+
+/*******************************************************************************
+  Function:
+    bool ADC_ACQ_BurstWrite ( uint32_t address, const uint8_t* data, uint32_t size )
+
+  Summary:
+    Incremental write of size bytes starting at address.
+
+  Description:
+    data holds the registers back to back, MSB first, as laid out by
+    MCP3564_REG_Pack. size must end on a register boundary and every
+    register covered must be writable.
+*/
+
+bool ADC_ACQ_BurstWrite ( uint32_t address, const uint8_t* data, uint32_t size );
+
+/*******************************************************************************
+  Function:
+    bool ADC_ACQ_RegisterRead ( uint32_t address, uint32_t* value )
+
+  Summary:
+    Reads an MCP3564 register through the SPI driver client.
+
+  Description:
+    Width and command byte come from the register map (mcp3564_reg.h). The
+    value is returned right aligned. Fails for addresses without read
+    access and while the acquisition runs.
+*/
+
+bool ADC_ACQ_RegisterRead ( uint32_t address, uint32_t* value );
+
+/*******************************************************************************
+  Function:
+    bool ADC_ACQ_RegisterWrite ( uint32_t address, uint32_t value )
+
+  Summary:
+    Writes an MCP3564 register through the SPI driver client.
+
+  Description:
+    Fails for read-only registers, for values wider than the register and
+    while the acquisition runs.
+*/
+
+bool ADC_ACQ_RegisterWrite ( uint32_t address, uint32_t value );
+
+/*******************************************************************************
+  Function:
+    bool ADC_ACQ_CommandStart ( uint8_t command, uint32_t size )
+
+  Summary:
+    Queues one command byte on the SPI driver client without waiting.
+
+  Description:
+    STATUS and size more bytes are clocked back (size 0 for a fast
+    command); ADC_ACQ_CommandStatusGet polls the transfer. One command is
+    outstanding at a time: fails while the previous one is still pending
+    (a finished one need not have been polled), while the acquisition runs
+    and for size above MCP3564_SNAPSHOT_SIZE. ADC_ACQ_Start waits for an
+    outstanding command to finish.
+*/
+
+bool ADC_ACQ_CommandStart ( uint8_t command, uint32_t size );
+
+/*******************************************************************************
+  Function:
+    ADC_ACQ_COMMAND_STATUS ADC_ACQ_CommandStatusGet ( uint8_t* response )
+
+  Summary:
+    Polls the command queued by ADC_ACQ_CommandStart.
+
+  Description:
+    Once it is no longer pending the next command may be started. On
+    ADC_ACQ_COMMAND_DONE, response (1 + size bytes, or NULL) gets STATUS
+    and the bytes read. ADC_ACQ_COMMAND_ERROR also when none was started.
+*/
+
+ADC_ACQ_COMMAND_STATUS ADC_ACQ_CommandStatusGet ( uint8_t* response );
+
+/*******************************************************************************
+  Function:
+    uint32_t ADC_ACQ_Read ( uint32_t* samples, uint32_t count )
+
+  Summary:
+    Takes up to count raw samples from the FIFO, returns how many were copied.
+
+  Description:
+    A raw sample is the 32 bit word as received: STATUS (or CH_ID/SGN) in the
+    low byte, then the 24 bit result MSB first. Use ADC_DECODE_Block32, for
+    ADC_ACQ_FORMAT_32_CHID ADC_DECODE_Block32Sgn (or ADC_ACQ_SampleDecode
+    for a single word) to get the values.
+    Only one context may call this function.
+*/
+
+uint32_t ADC_ACQ_Read ( uint32_t* samples, uint32_t count );
+
+/*******************************************************************************
+  Function:
+    bool ADC_ACQ_StampRead ( ADC_ACQ_STAMP* stamp )
+
+  Summary:
+    Takes the oldest block time stamp, false when there is none.
+
+  Remarks:
+    Same single consumer rule as ADC_ACQ_Read. Stamps which find the queue
+    full are dropped.
+*/
+
+bool ADC_ACQ_StampRead ( ADC_ACQ_STAMP* stamp );
+
+/*******************************************************************************
+  Function:
+    void ADC_ACQ_StatsGet ( ADC_ACQ_STATS* stats )
+
+  Summary:
+    Copies the counters of the running or last acquisition.
+*/
+
+void ADC_ACQ_StatsGet ( ADC_ACQ_STATS* stats );
+
+/*******************************************************************************
+  Function:
+    int32_t ADC_ACQ_SampleDecode ( uint32_t raw )
+
+  Summary:
+    Converts one raw FIFO word of the running format to a sign-extended value.
+*/
+
+int32_t ADC_ACQ_SampleDecode ( uint32_t raw );
+
+//DOM-IGNORE-BEGIN
+#ifdef __cplusplus
+}
+#endif
+//DOM-IGNORE-END
+
+#endif /* _ADC_ACQ_H */
+
+/*******************************************************************************
+ End of File
+ */
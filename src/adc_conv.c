@@ -0,0 +1,163 @@
+/*******************************************************************************
+  ADC Fixed-Point Conversion Source File
+
+  File Name:
+    adc_conv.c
+
+  Summary:
+    Integer conversion of MCP3564 codes to microvolts, and its formatter.
+
+  Description:
+    code - offset fits in 25 bits and scale in 31, so the 64 bit product
+    never overflows. Rounding adds half an LSB of the result before the
+    arithmetic shift, i.e. round half up for both signs.
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include "adc_conv.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+#define ADC_CONV_ROUND                      (1LL << (ADC_CONV_SCALE_SHIFT - 1U))
+#define ADC_CONV_DECIMALS                   6U
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data
+// *****************************************************************************
+// *****************************************************************************
+
+static ADC_CONV_CAL convCal[ADC_CONV_CHANNELS];
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+static inline int32_t lADC_CONV_Apply(const ADC_CONV_CAL* cal, int32_t code)
+{
+    int64_t product = (int64_t) (code - cal->offset) * cal->scale;
+
+    return (int32_t) ((product + ADC_CONV_ROUND) >> ADC_CONV_SCALE_SHIFT);
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+void ADC_CONV_Initialize(void)
+{
+    uint32_t channel;
+
+    for (channel = 0; channel < ADC_CONV_CHANNELS; channel++)
+    {
+        convCal[channel].scale = ADC_CONV_SCALE_DEFAULT;
+        convCal[channel].offset = 0;
+    }
+}
+
+bool ADC_CONV_CalSet(uint32_t channel, const ADC_CONV_CAL* cal)
+{
+    if ((channel >= ADC_CONV_CHANNELS) || (cal == NULL))
+    {
+        return false;
+    }
+
+    convCal[channel] = *cal;
+
+    return true;
+}
+
+bool ADC_CONV_CalGet(uint32_t channel, ADC_CONV_CAL* cal)
+{
+    if ((channel >= ADC_CONV_CHANNELS) || (cal == NULL))
+    {
+        return false;
+    }
+
+    *cal = convCal[channel];
+
+    return true;
+}
+
+int32_t ADC_CONV_ToMicrovolts(uint32_t channel, int32_t code)
+{
+    if (channel >= ADC_CONV_CHANNELS)
+    {
+        channel = ADC_CONV_CHANNEL_MUX;
+    }
+
+    return lADC_CONV_Apply(&convCal[channel], code);
+}
+
+void ADC_CONV_Block(uint32_t channel, const int32_t* codes, int32_t* uv, uint32_t count)
+{
+    ADC_CONV_CAL cal;
+    uint32_t i;
+
+    if (channel >= ADC_CONV_CHANNELS)
+    {
+        channel = ADC_CONV_CHANNEL_MUX;
+    }
+
+    /* Local copy: keeps scale/offset in registers across the loop */
+    cal = convCal[channel];
+
+    for (i = 0; i < count; i++)
+    {
+        uv[i] = lADC_CONV_Apply(&cal, codes[i]);
+    }
+}
+
+size_t ADC_CONV_Format(int32_t uv, char* text, size_t size)
+{
+    char digits[ADC_CONV_TEXT_SIZE];
+    uint32_t magnitude = (uv < 0) ? (0U - (uint32_t) uv) : (uint32_t) uv;
+    size_t count = 0;
+    size_t length = 0;
+
+    if (size == 0U)
+    {
+        return 0;
+    }
+
+    /* Least significant digit first, at least "0.000000" */
+    do
+    {
+        digits[count++] = (char) ('0' + (magnitude % 10U));
+        magnitude /= 10U;
+        if (count == ADC_CONV_DECIMALS)
+        {
+            digits[count++] = '.';
+        }
+    } while ((magnitude != 0U) || (count <= (ADC_CONV_DECIMALS + 1U)));
+
+    if (uv < 0)
+    {
+        digits[count++] = '-';
+    }
+
+    while ((count != 0U) && (length < (size - 1U)))
+    {
+        text[length++] = digits[--count];
+    }
+    text[length] = '\0';
+
+    return length;
+}
+
+/*******************************************************************************
+ End of File
+ */
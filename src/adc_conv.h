@@ -0,0 +1,146 @@
+/*******************************************************************************
+  ADC Fixed-Point Conversion Header File
+
+  File Name:
+    adc_conv.h
+
+  Summary:
+    Integer conversion of MCP3564 codes to microvolts, and its formatter.
+
+  Description:
+    uV = ((code - offset) * scale + 2^23) >> 24, one 32x32->64 multiply
+    (SMULL) per sample, no floating point anywhere. scale is the size of
+    one LSB in microvolts, Q8.24; offset is in codes. Both are kept per
+    channel ID so SCAN results can be corrected input by input; readings
+    taken in MUX mode (SINGLE, CONTINUOUS, READ) use ADC_CONV_CHANNEL_MUX.
+
+    For a 24 bit result over +/-VREF/GAIN one LSB is VREF / (GAIN * 2^23),
+    so the Q8.24 scale is simply 2 * VREF(uV) / GAIN.
+*******************************************************************************/
+
+#ifndef _ADC_CONV_H
+#define _ADC_CONV_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+extern "C" {
+
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Constants
+// *****************************************************************************
+// *****************************************************************************
+
+/* Channel IDs 0..15 as CH_ID / SCAN, plus one for MUX mode readings */
+#define ADC_CONV_CHANNEL_MUX                16U
+#define ADC_CONV_CHANNELS                   17U
+
+/* Board reference: VREF = AVDD = 3.3 V */
+#define ADC_CONV_VREF_UV                    3300000
+
+#define ADC_CONV_SCALE_SHIFT                24U
+#define ADC_CONV_SCALE(vrefUv, gain)        ((int32_t) ((2 * (int64_t) (vrefUv)) / (gain)))
+#define ADC_CONV_SCALE_DEFAULT              ADC_CONV_SCALE(ADC_CONV_VREF_UV, 1)
+
+/* Widest text, "-2147.483648", plus terminator */
+#define ADC_CONV_TEXT_SIZE                  13U
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Type Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+typedef struct
+{
+    int32_t scale;
+    int32_t offset;
+
+} ADC_CONV_CAL;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+/*******************************************************************************
+  Function:
+    void ADC_CONV_Initialize ( void )
+
+  Summary:
+    Sets every channel to ADC_CONV_SCALE_DEFAULT and zero offset.
+*/
+
+void ADC_CONV_Initialize ( void );
+
+bool ADC_CONV_CalSet ( uint32_t channel, const ADC_CONV_CAL* cal );
+
+bool ADC_CONV_CalGet ( uint32_t channel, ADC_CONV_CAL* cal );
+
+/*******************************************************************************
+  Function:
+    int32_t ADC_CONV_ToMicrovolts ( uint32_t channel, int32_t code )
+
+  Summary:
+    Converts one sign-extended code of channel to microvolts.
+
+  Remarks:
+    An unknown channel uses the ADC_CONV_CHANNEL_MUX calibration.
+*/
+
+int32_t ADC_CONV_ToMicrovolts ( uint32_t channel, int32_t code );
+
+/*******************************************************************************
+  Function:
+    void ADC_CONV_Block ( uint32_t channel, const int32_t* codes, int32_t* uv, uint32_t count )
+
+  Summary:
+    ADC_CONV_ToMicrovolts over count samples of one channel.
+
+  Remarks:
+    codes and uv may be the same buffer.
+*/
+
+void ADC_CONV_Block ( uint32_t channel, const int32_t* codes, int32_t* uv, uint32_t count );
+
+/*******************************************************************************
+  Function:
+    size_t ADC_CONV_Format ( int32_t uv, char* text, size_t size )
+
+  Summary:
+    Writes uv as volts with six decimals ("-0.000123"), returns the length.
+
+  Description:
+    Integer only: the sign is handled once on the magnitude, so values
+    between -1 V and 0 V keep their minus sign. text is always terminated
+    when size is not 0; ADC_CONV_TEXT_SIZE is always enough.
+*/
+
+size_t ADC_CONV_Format ( int32_t uv, char* text, size_t size );
+
+//DOM-IGNORE-BEGIN
+#ifdef __cplusplus
+}
+#endif
+//DOM-IGNORE-END
+
+#endif /* _ADC_CONV_H */
+
+/*******************************************************************************
+ End of File
+ */
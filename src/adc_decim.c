@@ -0,0 +1,217 @@
+/*******************************************************************************
+  ADC Decimation Filter Source File
+
+  File Name:
+    adc_decim.c
+
+  Summary:
+    Integer decimation of the sample stream, boxcar or CIC, per channel.
+
+  Description:
+    The CIC integrators are allowed to wrap: they run modulo 2^64 and the
+    combs undo the wrap, as long as the final result fits, which the
+    ratio limit guarantees. They are therefore kept unsigned.
+
+    Normalization rounds half away from zero. It is an int64 division once
+    per output, a shift when the gain is a power of two.
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <string.h>
+#include "adc_decim.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+typedef struct
+{
+    uint64_t integrator[ADC_DECIM_CIC_ORDER];
+    uint64_t delay[ADC_DECIM_CIC_ORDER];
+    uint32_t phase;
+
+} ADC_DECIM_STATE;
+
+typedef struct
+{
+    ADC_DECIM_TYPE type;
+    uint32_t ratio;
+    int64_t gain;
+    uint32_t shift;
+    bool pow2;
+    ADC_DECIM_STATE state[ADC_DECIM_CHANNELS];
+
+} ADC_DECIM_OBJ;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data
+// *****************************************************************************
+// *****************************************************************************
+
+static ADC_DECIM_OBJ decimObj =
+{
+    .type = ADC_DECIM_TYPE_BOXCAR,
+    .ratio = 1U,
+    .gain = 1,
+    .shift = 0U,
+    .pow2 = true,
+};
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+static int32_t lADC_DECIM_Normalize(int64_t sum)
+{
+    int64_t half = decimObj.gain / 2;
+
+    if (decimObj.pow2)
+    {
+        /* Arithmetic shift floors: bias negative sums to round away from zero */
+        return (int32_t) (((sum < 0) ? (sum + half - 1) : (sum + half)) >> decimObj.shift);
+    }
+
+    return (int32_t) (((sum < 0) ? (sum - half) : (sum + half)) / decimObj.gain);
+}
+
+static bool lADC_DECIM_Boxcar(ADC_DECIM_STATE* state, int32_t in, int32_t* out)
+{
+    state->integrator[0] += (uint64_t) (int64_t) in;
+
+    if (++state->phase < decimObj.ratio)
+    {
+        return false;
+    }
+
+    *out = lADC_DECIM_Normalize((int64_t) state->integrator[0]);
+    state->integrator[0] = 0U;
+    state->phase = 0U;
+
+    return true;
+}
+
+static bool lADC_DECIM_Cic(ADC_DECIM_STATE* state, int32_t in, int32_t* out)
+{
+    uint64_t value = (uint64_t) (int64_t) in;
+    uint64_t previous;
+    uint32_t stage;
+
+    for (stage = 0; stage < ADC_DECIM_CIC_ORDER; stage++)
+    {
+        state->integrator[stage] += value;
+        value = state->integrator[stage];
+    }
+
+    if (++state->phase < decimObj.ratio)
+    {
+        return false;
+    }
+
+    state->phase = 0U;
+
+    for (stage = 0; stage < ADC_DECIM_CIC_ORDER; stage++)
+    {
+        previous = state->delay[stage];
+        state->delay[stage] = value;
+        value -= previous;
+    }
+
+    *out = lADC_DECIM_Normalize((int64_t) value);
+
+    return true;
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+bool ADC_DECIM_Configure(ADC_DECIM_TYPE type, uint32_t ratio)
+{
+    uint32_t order = (type == ADC_DECIM_TYPE_CIC) ? ADC_DECIM_CIC_ORDER : 1U;
+    uint32_t i;
+
+    if ((ratio == 0U) || (ratio > ADC_DECIM_RATIO_MAX) ||
+        ((type != ADC_DECIM_TYPE_BOXCAR) && (type != ADC_DECIM_TYPE_CIC)))
+    {
+        return false;
+    }
+
+    decimObj.type = type;
+    decimObj.ratio = ratio;
+    decimObj.gain = 1;
+    for (i = 0; i < order; i++)
+    {
+        decimObj.gain *= (int64_t) ratio;
+    }
+
+    decimObj.pow2 = ((ratio & (ratio - 1U)) == 0U);
+    decimObj.shift = (uint32_t) __builtin_ctz(ratio) * order;
+
+    ADC_DECIM_Reset();
+
+    return true;
+}
+
+void ADC_DECIM_ConfigGet(ADC_DECIM_TYPE* type, uint32_t* ratio)
+{
+    *type = decimObj.type;
+    *ratio = decimObj.ratio;
+}
+
+void ADC_DECIM_Reset(void)
+{
+    memset(decimObj.state, 0, sizeof(decimObj.state));
+}
+
+uint32_t ADC_DECIM_Process(uint32_t channel, const int32_t* in, int32_t* out, uint32_t count)
+{
+    ADC_DECIM_STATE* state;
+    uint32_t n = 0;
+    uint32_t i;
+
+    if (channel >= ADC_DECIM_CHANNELS)
+    {
+        channel = ADC_DECIM_CHANNEL_MUX;
+    }
+
+    state = &decimObj.state[channel];
+
+    if (decimObj.ratio == 1U)
+    {
+        if (out != in)
+        {
+            memcpy(out, in, count * sizeof(int32_t));
+        }
+        return count;
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        if (decimObj.type == ADC_DECIM_TYPE_CIC)
+        {
+            n += lADC_DECIM_Cic(state, in[i], &out[n]) ? 1U : 0U;
+        }
+        else
+        {
+            n += lADC_DECIM_Boxcar(state, in[i], &out[n]) ? 1U : 0U;
+        }
+    }
+
+    return n;
+}
+
+/*******************************************************************************
+ End of File
+ */
@@ -0,0 +1,130 @@
+/*******************************************************************************
+  ADC Decimation Filter Header File
+
+  File Name:
+    adc_decim.h
+
+  Summary:
+    Integer decimation of the sample stream, boxcar or CIC, per channel.
+
+  Description:
+    Sits between the block decoder and anything that prints or sends
+    samples. One output is produced for every ratio inputs of a channel,
+    so the MCP3564 can run at a high data rate for the noise benefit while
+    the result still fits through the 115200 baud console.
+
+    BOXCAR: mean of ratio consecutive samples (integrate and dump).
+    CIC:    ADC_DECIM_CIC_ORDER integrators at the input rate, as many combs
+            at the output rate, differential delay 1. Gain ratio^ORDER is
+            divided out, so both types keep the input scale in codes.
+
+    State is kept per channel ID (0..15 as CH_ID) plus ADC_DECIM_CHANNEL_MUX
+    for MUX mode streams. A ratio of 1 passes samples through unchanged.
+*******************************************************************************/
+
+#ifndef _ADC_DECIM_H
+#define _ADC_DECIM_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+extern "C" {
+
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Constants
+// *****************************************************************************
+// *****************************************************************************
+
+#define ADC_DECIM_CHANNEL_MUX               16U
+#define ADC_DECIM_CHANNELS                  17U
+
+/* 25 bit input (SGN of DATA_FORMAT 11) + ORDER * log2(RATIO_MAX) bits of growth fits in 64 */
+#define ADC_DECIM_CIC_ORDER                 3U
+#define ADC_DECIM_RATIO_MAX                 1024U
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Type Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+typedef enum
+{
+    ADC_DECIM_TYPE_BOXCAR = 0,
+    ADC_DECIM_TYPE_CIC
+
+} ADC_DECIM_TYPE;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+/*******************************************************************************
+  Function:
+    bool ADC_DECIM_Configure ( ADC_DECIM_TYPE type, uint32_t ratio )
+
+  Summary:
+    Selects the filter and ratio (1..ADC_DECIM_RATIO_MAX) and resets every
+    channel.
+*/
+
+bool ADC_DECIM_Configure ( ADC_DECIM_TYPE type, uint32_t ratio );
+
+void ADC_DECIM_ConfigGet ( ADC_DECIM_TYPE* type, uint32_t* ratio );
+
+/*******************************************************************************
+  Function:
+    void ADC_DECIM_Reset ( void )
+
+  Summary:
+    Clears the filter state of every channel, e.g. when a stream starts.
+
+  Remarks:
+    The first ADC_DECIM_CIC_ORDER - 1 CIC outputs after a reset are the
+    filter settling from zero.
+*/
+
+void ADC_DECIM_Reset ( void );
+
+/*******************************************************************************
+  Function:
+    uint32_t ADC_DECIM_Process ( uint32_t channel, const int32_t* in,
+                                 int32_t* out, uint32_t count )
+
+  Summary:
+    Feeds count samples of one channel, returns the outputs written.
+
+  Description:
+    At most count / ratio + 1 outputs are written. in and out may be the
+    same buffer: output i is written only after input i has been read.
+    An unknown channel uses ADC_DECIM_CHANNEL_MUX.
+*/
+
+uint32_t ADC_DECIM_Process ( uint32_t channel, const int32_t* in, int32_t* out, uint32_t count );
+
+//DOM-IGNORE-BEGIN
+#ifdef __cplusplus
+}
+#endif
+//DOM-IGNORE-END
+
+#endif /* _ADC_DECIM_H */
+
+/*******************************************************************************
+ End of File
+ */
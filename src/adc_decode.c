@@ -0,0 +1,176 @@
+/*******************************************************************************
+  ADC Block Decode Source File
+
+  File Name:
+    adc_decode.c
+
+  Summary:
+    Turns blocks of raw MCP3564 ADCDATA reads into sign-extended int32.
+
+  Description:
+    A big-endian word loaded little-endian and byte-reversed puts the 24 bit
+    result in bits 31:8 (packed layout) or 23:0 (FIFO layout). Moving the
+    result to the top of the word and shifting right by 8 sign-extends it,
+    so no per-sample test of bit 23 is needed. A CH_ID/SGN word has SGN in
+    bits 27:24; moving bit 24 to the top and shifting right by 7 gives the
+    25 bit result. Right shifts of negative
+    values are arithmetic with every compiler this code is built with.
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <string.h>
+#include "adc_decode.h"
+
+#if defined(__ARM_ARCH_7EM__)
+#include "device.h"
+#endif
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+static inline uint32_t lADC_DECODE_Rev(uint32_t value)
+{
+#if defined(__ARM_ARCH_7EM__)
+    return __REV(value);
+#else
+    return (value >> 24) | ((value >> 8) & 0x0000FF00U) |
+           ((value << 8) & 0x00FF0000U) | (value << 24);
+#endif
+}
+
+/* Big-endian word at any alignment; LDR handles unaligned addresses on the M4 */
+static inline uint32_t lADC_DECODE_Load(const uint8_t* data)
+{
+    uint32_t word;
+
+    memcpy(&word, data, sizeof(word));
+
+    return lADC_DECODE_Rev(word);
+}
+
+static inline int32_t lADC_DECODE_Extend(uint32_t value)
+{
+    /* value holds the result in bits 31:8 */
+    return ((int32_t) value) >> 8;
+}
+
+static inline int32_t lADC_DECODE_ExtendSgn(uint32_t value)
+{
+    /* value holds the result in bits 31:7, SGN in bit 31 */
+    return ((int32_t) value) >> 7;
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+void ADC_DECODE_Block24(const uint8_t* data, int32_t* samples, uint32_t count)
+{
+    uint32_t a;
+    uint32_t b;
+    uint32_t c;
+
+    /* a = s0 s0 s0 s1, b = s1 s1 s2 s2, c = s2 s3 s3 s3 */
+    for (; count >= 4U; count -= 4U)
+    {
+        a = lADC_DECODE_Load(data);
+        b = lADC_DECODE_Load(data + 4);
+        c = lADC_DECODE_Load(data + 8);
+
+        samples[0] = lADC_DECODE_Extend(a);
+        samples[1] = lADC_DECODE_Extend((a << 24) | (b >> 8));
+        samples[2] = lADC_DECODE_Extend((b << 16) | (c >> 16));
+        samples[3] = lADC_DECODE_Extend(c << 8);
+
+        data += 4U * ADC_DECODE_SAMPLE_SIZE_24;
+        samples += 4;
+    }
+
+    /* The tail would read past the end of data with whole words */
+    ADC_DECODE_Block24Ref(data, samples, count);
+}
+
+void ADC_DECODE_Block32(const uint32_t* raw, int32_t* samples, uint32_t count)
+{
+    uint32_t i;
+
+    for (i = 0; i < count; i++)
+    {
+        samples[i] = lADC_DECODE_Extend(lADC_DECODE_Rev(raw[i]) << 8);
+    }
+}
+
+void ADC_DECODE_Block32Sgn(const uint32_t* raw, int32_t* samples, uint32_t count)
+{
+    uint32_t i;
+
+    for (i = 0; i < count; i++)
+    {
+        samples[i] = lADC_DECODE_ExtendSgn(lADC_DECODE_Rev(raw[i]) << 7);
+    }
+}
+
+void ADC_DECODE_Block24Ref(const uint8_t* data, int32_t* samples, uint32_t count)
+{
+    uint32_t value;
+    uint32_t i;
+
+    for (i = 0; i < count; i++)
+    {
+        value = ((uint32_t) data[0] << 16) | ((uint32_t) data[1] << 8) | data[2];
+        if ((value & 0x800000U) != 0U)
+        {
+            value |= 0xFF000000U;
+        }
+
+        samples[i] = (int32_t) value;
+        data += ADC_DECODE_SAMPLE_SIZE_24;
+    }
+}
+
+void ADC_DECODE_Block32Ref(const uint32_t* raw, int32_t* samples, uint32_t count)
+{
+    const uint8_t* bytes;
+    uint32_t i;
+
+    for (i = 0; i < count; i++)
+    {
+        /* Byte order as received, independent of the CPU */
+        bytes = (const uint8_t*) &raw[i];
+        ADC_DECODE_Block24Ref(&bytes[1], &samples[i], 1U);
+    }
+}
+
+void ADC_DECODE_Block32SgnRef(const uint32_t* raw, int32_t* samples, uint32_t count)
+{
+    const uint8_t* bytes;
+    uint32_t value;
+    uint32_t i;
+
+    for (i = 0; i < count; i++)
+    {
+        /* Header byte: CH_ID in bits 7:4, SGN repeated in bits 3:0 */
+        bytes = (const uint8_t*) &raw[i];
+        value = ((uint32_t) bytes[1] << 16) | ((uint32_t) bytes[2] << 8) | bytes[3];
+        if ((bytes[0] & 0x01U) != 0U)
+        {
+            value |= 0xFF000000U;
+        }
+
+        samples[i] = (int32_t) value;
+    }
+}
+
+/*******************************************************************************
+ End of File
+ */
@@ -0,0 +1,121 @@
+/*******************************************************************************
+  ADC Block Decode Header File
+
+  File Name:
+    adc_decode.h
+
+  Summary:
+    Turns blocks of raw MCP3564 ADCDATA reads into sign-extended int32.
+
+  Description:
+    Two raw layouts are handled:
+      - packed 24 bit samples, 3 bytes each, MSB first, as read with
+        ADC_ACQ_RegisterRead or straight out of an SPI receive buffer;
+      - 32 bit words as kept in the acquisition FIFO: one header byte
+        (STATUS or CH_ID/SGN) followed by the 24 bit result MSB first.
+
+    DATA_FORMAT 00 clamps an over-range result to 24 bits, so the STATUS
+    words of ADC_ACQ_FORMAT_24 decode with ADC_DECODE_Block32. The CH_ID/SGN
+    words of ADC_ACQ_FORMAT_32_CHID carry a 25 bit result, the 24 bits plus
+    SGN, from -2^24 to 2^24 - 1; decode those with ADC_DECODE_Block32Sgn.
+
+    On the Cortex-M4 the kernels use REV to byte-reverse whole words and an
+    arithmetic shift to sign-extend; elsewhere the same kernels run with a
+    portable byte reverse. The ...Ref functions are the one-byte-at-a-time
+    reference the kernels must match bit for bit (sim/tests/test_adc_decode).
+*******************************************************************************/
+
+#ifndef _ADC_DECODE_H
+#define _ADC_DECODE_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+extern "C" {
+
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Constants
+// *****************************************************************************
+// *****************************************************************************
+
+/* Bytes per packed 24 bit sample */
+#define ADC_DECODE_SAMPLE_SIZE_24           3U
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+/*******************************************************************************
+  Function:
+    void ADC_DECODE_Block24 ( const uint8_t* data, int32_t* samples, uint32_t count )
+
+  Summary:
+    Decodes count packed big-endian 24 bit samples.
+
+  Description:
+    Four samples (12 bytes, three words) are decoded per iteration, so data
+    needs no alignment. samples must not overlap data.
+*/
+
+void ADC_DECODE_Block24 ( const uint8_t* data, int32_t* samples, uint32_t count );
+
+/*******************************************************************************
+  Function:
+    void ADC_DECODE_Block32 ( const uint32_t* raw, int32_t* samples, uint32_t count )
+
+  Summary:
+    Decodes count FIFO words with a STATUS header byte (24 bit results).
+
+  Remarks:
+    raw and samples may be the same buffer. The header byte is not looked
+    at; the result is sign-extended from bit 23.
+*/
+
+void ADC_DECODE_Block32 ( const uint32_t* raw, int32_t* samples, uint32_t count );
+
+/*******************************************************************************
+  Function:
+    void ADC_DECODE_Block32Sgn ( const uint32_t* raw, int32_t* samples, uint32_t count )
+
+  Summary:
+    Decodes count FIFO words with a CH_ID/SGN header byte (25 bit results).
+
+  Remarks:
+    raw and samples may be the same buffer. The sign is the SGN bit, so
+    over-range results beyond 24 bits keep their value; take the channel ID
+    from the raw word first (ADC_SCAN_CHANNEL_ID).
+*/
+
+void ADC_DECODE_Block32Sgn ( const uint32_t* raw, int32_t* samples, uint32_t count );
+
+void ADC_DECODE_Block24Ref ( const uint8_t* data, int32_t* samples, uint32_t count );
+
+void ADC_DECODE_Block32Ref ( const uint32_t* raw, int32_t* samples, uint32_t count );
+
+void ADC_DECODE_Block32SgnRef ( const uint32_t* raw, int32_t* samples, uint32_t count );
+
+//DOM-IGNORE-BEGIN
+#ifdef __cplusplus
+}
+#endif
+//DOM-IGNORE-END
+
+#endif /* _ADC_DECODE_H */
+
+/*******************************************************************************
+ End of File
+ */
@@ -0,0 +1,378 @@
+/*******************************************************************************
+  ADC Filter Pipeline Source File
+
+  File Name:
+    adc_filter.c
+
+  Summary:
+    Chain of fixed-point FIR, biquad IIR and DC-blocking stages.
+
+  Description:
+    The recursive stages keep the fraction dropped by the output shift and
+    add it back on the next sample (first order error feedback). Without it
+    a narrow notch or a DC blocker with its pole near 1 settles on a
+    truncation bias of several codes.
+
+    The FIR keeps its history in front of the chunk in one linear buffer,
+    so the tap loop needs no circular indexing.
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <string.h>
+#include <math.h>
+#include "adc_filter.h"
+
+#if defined(__ARM_ARCH_7EM__)
+#include "device.h"
+#endif
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+#if defined(__ARM_ARCH_7EM__)
+#define ADC_FILTER_CYCLES()                 (DWT->CYCCNT)
+#else
+#define ADC_FILTER_CYCLES()                 0U
+#endif
+
+#define ADC_FILTER_ROUND                    (1LL << (ADC_FILTER_SHIFT - 1U))
+
+#ifndef M_PI
+#define M_PI                                3.14159265358979323846
+#endif
+
+typedef struct
+{
+    ADC_FILTER_TYPE type;
+    uint32_t count;
+    int32_t coef[ADC_FILTER_FIR_TAPS_MAX];
+
+    /* FIR: history then chunk; IIR: x1 x2 y1 y2 */
+    int32_t buffer[ADC_FILTER_FIR_TAPS_MAX - 1U + ADC_FILTER_CHUNK];
+    int64_t error;
+
+    uint64_t cycles;
+    uint64_t samples;
+
+} ADC_FILTER_STAGE;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data
+// *****************************************************************************
+// *****************************************************************************
+
+static ADC_FILTER_STAGE filterStages[ADC_FILTER_STAGES];
+static uint32_t filterCount;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+static inline int32_t lADC_FILTER_Saturate(int64_t value)
+{
+    if (value > INT32_MAX)
+    {
+        return INT32_MAX;
+    }
+    if (value < INT32_MIN)
+    {
+        return INT32_MIN;
+    }
+
+    return (int32_t) value;
+}
+
+static void lADC_FILTER_StateClear(ADC_FILTER_STAGE* stage)
+{
+    memset(stage->buffer, 0, sizeof(stage->buffer));
+    stage->error = 0;
+    stage->cycles = 0U;
+    stage->samples = 0U;
+}
+
+static void lADC_FILTER_Fir(ADC_FILTER_STAGE* stage, int32_t* samples, uint32_t count)
+{
+    uint32_t history = stage->count - 1U;
+    int32_t* x = &stage->buffer[history];
+    int64_t acc;
+    uint32_t i;
+    uint32_t k;
+
+    memcpy(x, samples, count * sizeof(int32_t));
+
+    for (i = 0; i < count; i++)
+    {
+        acc = ADC_FILTER_ROUND;
+        for (k = 0; k < stage->count; k++)
+        {
+            acc += (int64_t) stage->coef[k] * x[(int32_t) i - (int32_t) k];
+        }
+        samples[i] = lADC_FILTER_Saturate(acc >> ADC_FILTER_SHIFT);
+    }
+
+    /* Newest count - 1 inputs become the history of the next chunk */
+    memmove(stage->buffer, &stage->buffer[count], history * sizeof(int32_t));
+}
+
+static void lADC_FILTER_Biquad(ADC_FILTER_STAGE* stage, int32_t* samples, uint32_t count)
+{
+    const int32_t* c = stage->coef;
+    int32_t x1 = stage->buffer[0];
+    int32_t x2 = stage->buffer[1];
+    int32_t y1 = stage->buffer[2];
+    int32_t y2 = stage->buffer[3];
+    int64_t error = stage->error;
+    int64_t acc;
+    int32_t x0;
+    uint32_t i;
+
+    for (i = 0; i < count; i++)
+    {
+        x0 = samples[i];
+        acc = error + (int64_t) c[0] * x0 + (int64_t) c[1] * x1 + (int64_t) c[2] * x2 -
+              (int64_t) c[3] * y1 - (int64_t) c[4] * y2;
+
+        x2 = x1;
+        x1 = x0;
+        y2 = y1;
+        y1 = lADC_FILTER_Saturate(acc >> ADC_FILTER_SHIFT);
+        error = acc - ((int64_t) y1 << ADC_FILTER_SHIFT);
+        samples[i] = y1;
+    }
+
+    stage->buffer[0] = x1;
+    stage->buffer[1] = x2;
+    stage->buffer[2] = y1;
+    stage->buffer[3] = y2;
+    stage->error = error;
+}
+
+static void lADC_FILTER_DcBlock(ADC_FILTER_STAGE* stage, int32_t* samples, uint32_t count)
+{
+    int64_t pole = stage->coef[0];
+    int32_t x1 = stage->buffer[0];
+    int32_t y1 = stage->buffer[2];
+    int64_t error = stage->error;
+    int64_t acc;
+    uint32_t i;
+
+    for (i = 0; i < count; i++)
+    {
+        acc = error + ((int64_t) samples[i] - x1) * ADC_FILTER_ONE + pole * y1;
+        x1 = samples[i];
+        y1 = lADC_FILTER_Saturate(acc >> ADC_FILTER_SHIFT);
+        error = acc - ((int64_t) y1 << ADC_FILTER_SHIFT);
+        samples[i] = y1;
+    }
+
+    stage->buffer[0] = x1;
+    stage->buffer[2] = y1;
+    stage->error = error;
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+bool ADC_FILTER_StageAdd(ADC_FILTER_TYPE type, const int32_t* coef, uint32_t count)
+{
+    ADC_FILTER_STAGE* stage;
+    uint32_t i;
+
+    if (filterCount >= ADC_FILTER_STAGES)
+    {
+        return false;
+    }
+
+    switch (type)
+    {
+        case ADC_FILTER_TYPE_FIR:
+            if ((count == 0U) || (count > ADC_FILTER_FIR_TAPS_MAX))
+            {
+                return false;
+            }
+            break;
+
+        case ADC_FILTER_TYPE_BIQUAD:
+            if (count != ADC_FILTER_BIQUAD_COEFS)
+            {
+                return false;
+            }
+            break;
+
+        case ADC_FILTER_TYPE_DCBLOCK:
+            if (count != ADC_FILTER_DCBLOCK_COEFS)
+            {
+                return false;
+            }
+            break;
+
+        default:
+            return false;
+    }
+
+    stage = &filterStages[filterCount];
+    memset(stage, 0, sizeof(*stage));
+    stage->type = type;
+    stage->count = count;
+
+    if (coef != NULL)
+    {
+        memcpy(stage->coef, coef, count * sizeof(int32_t));
+    }
+    else if (type == ADC_FILTER_TYPE_FIR)
+    {
+        for (i = 0; i < count; i++)
+        {
+            stage->coef[i] = ADC_FILTER_ONE / (int32_t) count;
+        }
+    }
+    else if (type == ADC_FILTER_TYPE_BIQUAD)
+    {
+        stage->coef[0] = ADC_FILTER_ONE;
+    }
+    else
+    {
+        stage->coef[0] = ADC_FILTER_DCBLOCK_POLE_DEFAULT;
+    }
+
+    filterCount++;
+
+    return true;
+}
+
+bool ADC_FILTER_CoefSet(uint32_t stage, uint32_t index, const int32_t* coef, uint32_t count)
+{
+    if ((stage >= filterCount) || (index >= filterStages[stage].count) ||
+        (count > (filterStages[stage].count - index)))
+    {
+        return false;
+    }
+
+    memcpy(&filterStages[stage].coef[index], coef, count * sizeof(int32_t));
+    lADC_FILTER_StateClear(&filterStages[stage]);
+
+    return true;
+}
+
+void ADC_FILTER_Clear(void)
+{
+    filterCount = 0U;
+}
+
+uint32_t ADC_FILTER_StageCount(void)
+{
+    return filterCount;
+}
+
+bool ADC_FILTER_StageGet(uint32_t stage, ADC_FILTER_STAGE_INFO* info)
+{
+    if (stage >= filterCount)
+    {
+        return false;
+    }
+
+    info->type = filterStages[stage].type;
+    info->count = filterStages[stage].count;
+    info->coef = filterStages[stage].coef;
+    info->cycles = filterStages[stage].cycles;
+    info->samples = filterStages[stage].samples;
+
+    return true;
+}
+
+void ADC_FILTER_Reset(void)
+{
+    uint32_t i;
+
+    for (i = 0; i < filterCount; i++)
+    {
+        lADC_FILTER_StateClear(&filterStages[i]);
+    }
+}
+
+void ADC_FILTER_Process(int32_t* samples, uint32_t count)
+{
+    ADC_FILTER_STAGE* stage;
+    uint32_t chunk;
+    uint32_t start;
+    uint32_t i;
+
+    while (count != 0U)
+    {
+        chunk = (count < ADC_FILTER_CHUNK) ? count : ADC_FILTER_CHUNK;
+
+        for (i = 0; i < filterCount; i++)
+        {
+            stage = &filterStages[i];
+            start = ADC_FILTER_CYCLES();
+
+            if (stage->type == ADC_FILTER_TYPE_FIR)
+            {
+                lADC_FILTER_Fir(stage, samples, chunk);
+            }
+            else if (stage->type == ADC_FILTER_TYPE_BIQUAD)
+            {
+                lADC_FILTER_Biquad(stage, samples, chunk);
+            }
+            else
+            {
+                lADC_FILTER_DcBlock(stage, samples, chunk);
+            }
+
+            /* 32 bit difference: CYCCNT itself wraps every 36 s */
+            stage->cycles += (uint32_t) (ADC_FILTER_CYCLES() - start);
+            stage->samples += chunk;
+        }
+
+        samples += chunk;
+        count -= chunk;
+    }
+}
+
+bool ADC_FILTER_NotchDesign(uint32_t freqHz, uint32_t rateHz, int32_t* coef)
+{
+    double w;
+    double r;
+    double b1;
+    double a1;
+    double a2;
+    double gain;
+
+    if ((freqHz == 0U) || ((2U * freqHz) >= rateHz) || (rateHz <= (4U * ADC_FILTER_NOTCH_WIDTH_HZ)))
+    {
+        return false;
+    }
+
+    w = 2.0 * M_PI * (double) freqHz / (double) rateHz;
+    r = 1.0 - M_PI * (double) ADC_FILTER_NOTCH_WIDTH_HZ / (double) rateHz;
+    b1 = -2.0 * cos(w);
+    a1 = r * b1;
+    a2 = r * r;
+    gain = (1.0 + a1 + a2) / (2.0 + b1);
+
+    coef[0] = (int32_t) lround(gain * ADC_FILTER_ONE);
+    coef[1] = (int32_t) lround(gain * b1 * ADC_FILTER_ONE);
+    coef[2] = coef[0];
+    coef[3] = (int32_t) lround(a1 * ADC_FILTER_ONE);
+    coef[4] = (int32_t) lround(a2 * ADC_FILTER_ONE);
+
+    return true;
+}
+
+/*******************************************************************************
+ End of File
+ */
@@ -0,0 +1,196 @@
+/*******************************************************************************
+  ADC Filter Pipeline Header File
+
+  File Name:
+    adc_filter.h
+
+  Summary:
+    Chain of fixed-point FIR, biquad IIR and DC-blocking stages.
+
+  Description:
+    The pipeline runs on the decoded (and decimated) MUX stream. Samples are
+    processed in place, ADC_FILTER_CHUNK at a time: every stage runs over
+    the whole chunk before the next stage starts, so each stage keeps its
+    coefficients and state hot instead of the whole chain being walked per
+    sample.
+
+    Coefficients are signed Q2.30 (ADC_FILTER_ONE is 1.0) and all
+    arithmetic is integer with 64 bit accumulators, so a host build fed
+    the same coefficients and samples gives bit-identical output.
+
+    Stage coefficients:
+      FIR      c[0..taps-1], c[0] applies to the newest sample
+      BIQUAD   b0 b1 b2 a1 a2, y = b0 x0 + b1 x1 + b2 x2 - a1 y1 - a2 y2
+      DCBLOCK  pole p, y = x0 - x1 + p y1
+*******************************************************************************/
+
+#ifndef _ADC_FILTER_H
+#define _ADC_FILTER_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+extern "C" {
+
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Constants
+// *****************************************************************************
+// *****************************************************************************
+
+#define ADC_FILTER_STAGES                   4U
+#define ADC_FILTER_FIR_TAPS_MAX             32U
+#define ADC_FILTER_CHUNK                    32U
+
+#define ADC_FILTER_SHIFT                    30U
+#define ADC_FILTER_ONE                      ((int32_t) (1L << ADC_FILTER_SHIFT))
+
+/* Coefficients per stage type */
+#define ADC_FILTER_BIQUAD_COEFS             5U
+#define ADC_FILTER_DCBLOCK_COEFS            1U
+
+/* DC blocker pole 0.999: -3 dB at 0.00016 fs */
+#define ADC_FILTER_DCBLOCK_POLE_DEFAULT     1072668082
+
+/* Notch -3 dB width */
+#define ADC_FILTER_NOTCH_WIDTH_HZ           4U
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Type Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+typedef enum
+{
+    ADC_FILTER_TYPE_FIR = 0,
+    ADC_FILTER_TYPE_BIQUAD,
+    ADC_FILTER_TYPE_DCBLOCK
+
+} ADC_FILTER_TYPE;
+
+// *****************************************************************************
+/* Stage information
+
+  Summary:
+    Configuration and cycle count of one stage.
+
+  Remarks:
+    cycles is the DWT cycle count spent in the stage since the last
+    ADC_FILTER_Reset, over samples samples. Both are 64 bit: at 120 MHz a
+    32 bit total wraps within a minute of streaming. Always 0 on host
+    builds.
+*/
+
+typedef struct
+{
+    ADC_FILTER_TYPE type;
+    uint32_t count;
+    const int32_t* coef;
+    uint64_t cycles;
+    uint64_t samples;
+
+} ADC_FILTER_STAGE_INFO;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+/*******************************************************************************
+  Function:
+    bool ADC_FILTER_StageAdd ( ADC_FILTER_TYPE type, const int32_t* coef, uint32_t count )
+
+  Summary:
+    Appends a stage to the end of the chain.
+
+  Description:
+    count is the number of FIR taps (1..ADC_FILTER_FIR_TAPS_MAX), otherwise
+    it must match the stage type. coef may be NULL: a FIR then starts as a
+    moving average of count samples, a biquad as a pass-through and a DC
+    blocker with ADC_FILTER_DCBLOCK_POLE_DEFAULT.
+*/
+
+bool ADC_FILTER_StageAdd ( ADC_FILTER_TYPE type, const int32_t* coef, uint32_t count );
+
+/*******************************************************************************
+  Function:
+    bool ADC_FILTER_CoefSet ( uint32_t stage, uint32_t index, const int32_t* coef, uint32_t count )
+
+  Summary:
+    Replaces coefficients index..index+count-1 of a stage.
+
+  Remarks:
+    The stage state is cleared so the new response starts clean.
+*/
+
+bool ADC_FILTER_CoefSet ( uint32_t stage, uint32_t index, const int32_t* coef, uint32_t count );
+
+void ADC_FILTER_Clear ( void );
+
+uint32_t ADC_FILTER_StageCount ( void );
+
+bool ADC_FILTER_StageGet ( uint32_t stage, ADC_FILTER_STAGE_INFO* info );
+
+/*******************************************************************************
+  Function:
+    void ADC_FILTER_Reset ( void )
+
+  Summary:
+    Clears the state and cycle counters of every stage, keeps coefficients.
+*/
+
+void ADC_FILTER_Reset ( void );
+
+/*******************************************************************************
+  Function:
+    void ADC_FILTER_Process ( int32_t* samples, uint32_t count )
+
+  Summary:
+    Runs count samples through the chain, in place.
+
+  Remarks:
+    Outputs saturate to the int32 range. Nothing happens with no stages.
+*/
+
+void ADC_FILTER_Process ( int32_t* samples, uint32_t count );
+
+/*******************************************************************************
+  Function:
+    bool ADC_FILTER_NotchDesign ( uint32_t freqHz, uint32_t rateHz, int32_t* coef )
+
+  Summary:
+    Biquad coefficients of a notch at freqHz for a stream of rateHz.
+
+  Description:
+    Zeros on the unit circle, poles at radius 1 - pi * width / rate, DC gain
+    normalized to 1. Computed once in double precision; the quantized
+    coefficients are what the filter and any host replay use.
+*/
+
+bool ADC_FILTER_NotchDesign ( uint32_t freqHz, uint32_t rateHz, int32_t* coef );
+
+//DOM-IGNORE-BEGIN
+#ifdef __cplusplus
+}
+#endif
+//DOM-IGNORE-END
+
+#endif /* _ADC_FILTER_H */
+
+/*******************************************************************************
+ End of File
+ */
@@ -0,0 +1,253 @@
+/*******************************************************************************
+  MCP3564 SCAN Sequencer Source File
+
+  File Name:
+    adc_scan.c
+
+  Summary:
+    Multi-channel SCAN mode acquisition with channel ID demultiplexing.
+
+  Description:
+    The converter emits the selected channels in ascending ID order, then
+    waits TIMER DMCLK periods and starts over. The demultiplexer therefore
+    knows which ID should come next and counts any gap as a sequence error
+    instead of silently mislabeling the following samples: the ID in the
+    sample is always trusted for the placement.
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <string.h>
+#include "adc_scan.h"
+#include "adc_acq.h"
+#include "mcp3564_reg.h"
+#include "mcp3564_cache.h"
+#include "adc_decode.h"
+#include "adc_decim.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+/* SCAN.DLY position */
+#define ADC_SCAN_DELAY_SHIFT                21U
+
+/* TIMER is a 24 bit register */
+#define ADC_SCAN_TIMER_MAX                  0xFFFFFFUL
+
+/* Samples popped from the acquisition FIFO per pass */
+#define ADC_SCAN_CHUNK                      64U
+
+typedef struct
+{
+    uint32_t mask;
+    uint32_t next;
+    ADC_SCAN_STATS stats;
+    uint32_t count[ADC_SCAN_CHANNELS];
+
+} ADC_SCAN_OBJ;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data
+// *****************************************************************************
+// *****************************************************************************
+
+static ADC_SCAN_OBJ scanObj;
+
+static int32_t scanData[ADC_SCAN_CHANNELS][ADC_SCAN_CHANNEL_SAMPLES];
+
+static const char* const scanNames[ADC_SCAN_CHANNELS] =
+{
+    "CH0", "CH1", "CH2", "CH3", "CH4", "CH5", "CH6", "CH7",
+    "DIFFA", "DIFFB", "DIFFC", "DIFFD", "TEMP", "AVDD", "VCM", "OFFSET"
+};
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+/* Lowest selected ID above channel, wrapping to the first one of the cycle */
+static uint32_t lADC_SCAN_NextGet(uint32_t channel)
+{
+    uint32_t above = scanObj.mask & ~((2UL << channel) - 1UL);
+
+    if (above == 0U)
+    {
+        above = scanObj.mask;
+    }
+
+    return (uint32_t) __builtin_ctz(above);
+}
+
+static void lADC_SCAN_Store(uint32_t raw, int32_t sample)
+{
+    uint32_t channel = ADC_SCAN_CHANNEL_ID(raw);
+
+    scanObj.stats.samples++;
+
+    if ((scanObj.mask & (1UL << channel)) == 0U)
+    {
+        scanObj.stats.unexpected++;
+        return;
+    }
+
+    if (channel != scanObj.next)
+    {
+        scanObj.stats.sequence++;
+    }
+
+    /* The highest ID ends a cycle; counting the wrap to the lowest instead
+       would leave the last cycle uncounted */
+    if (channel == (31U - (uint32_t) __builtin_clz(scanObj.mask)))
+    {
+        scanObj.stats.cycles++;
+    }
+    scanObj.next = lADC_SCAN_NextGet(channel);
+
+    /* Only decimated samples are kept */
+    if (ADC_DECIM_Process(channel, &sample, &sample, 1U) == 0U)
+    {
+        return;
+    }
+
+    if (scanObj.count[channel] < ADC_SCAN_CHANNEL_SAMPLES)
+    {
+        scanData[channel][scanObj.count[channel]++] = sample;
+    }
+    else
+    {
+        scanObj.stats.overflow++;
+    }
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+bool ADC_SCAN_Start(uint32_t mask, uint32_t delay, uint32_t timer)
+{
+    mask &= ADC_SCAN_CHANNEL_MASK;
+
+    if ((mask == 0U) || (delay > ADC_SCAN_DELAY_MAX) || (timer > ADC_SCAN_TIMER_MAX) ||
+        (ADC_ACQ_IsRunning() == true))
+    {
+        return false;
+    }
+
+    memset(&scanObj, 0, sizeof(scanObj));
+    scanObj.mask = mask;
+    scanObj.stats.mask = mask;
+    scanObj.next = (uint32_t) __builtin_ctz(mask);
+    ADC_DECIM_Reset();
+
+    /* SCAN and TIMER are adjacent: one incremental write when both change */
+    if (!MCP3564_CACHE_Write(MCP3564_REG_SCAN, (delay << ADC_SCAN_DELAY_SHIFT) | mask) ||
+        !MCP3564_CACHE_Write(MCP3564_REG_TIMER, timer) ||
+        !MCP3564_CACHE_Flush())
+    {
+        return false;
+    }
+
+    if (!ADC_ACQ_Start(ADC_ACQ_MODE_DRIVER, ADC_ACQ_FORMAT_32_CHID))
+    {
+        (void) MCP3564_CACHE_Write(MCP3564_REG_SCAN, 0U);
+        (void) MCP3564_CACHE_Flush();
+        return false;
+    }
+
+    return true;
+}
+
+void ADC_SCAN_Stop(void)
+{
+    ADC_ACQ_Stop();
+
+    /* Back to MUX mode for SINGLE/CONTINUOUS */
+    (void) MCP3564_CACHE_Write(MCP3564_REG_SCAN, 0U);
+    (void) MCP3564_CACHE_Flush();
+}
+
+uint32_t ADC_SCAN_Process(void)
+{
+    uint32_t raw[ADC_SCAN_CHUNK];
+    int32_t samples[ADC_SCAN_CHUNK];
+    uint32_t total = 0;
+    uint32_t count;
+    uint32_t i;
+
+    do
+    {
+        count = ADC_ACQ_Read(raw, ADC_SCAN_CHUNK);
+        ADC_DECODE_Block32Sgn(raw, samples, count);
+
+        for (i = 0; i < count; i++)
+        {
+            lADC_SCAN_Store(raw[i], samples[i]);
+        }
+
+        total += count;
+
+    } while (count == ADC_SCAN_CHUNK);
+
+    return total;
+}
+
+const int32_t* ADC_SCAN_ChannelGet(uint32_t channel, uint32_t* count)
+{
+    if (channel >= ADC_SCAN_CHANNELS)
+    {
+        return NULL;
+    }
+
+    if (count != NULL)
+    {
+        *count = scanObj.count[channel];
+    }
+
+    return scanData[channel];
+}
+
+uint32_t ADC_SCAN_MinCountGet(void)
+{
+    uint32_t mask = scanObj.mask;
+    uint32_t min = ADC_SCAN_CHANNEL_SAMPLES;
+    uint32_t channel;
+
+    while (mask != 0U)
+    {
+        channel = (uint32_t) __builtin_ctz(mask);
+        mask &= mask - 1U;
+
+        if (scanObj.count[channel] < min)
+        {
+            min = scanObj.count[channel];
+        }
+    }
+
+    return min;
+}
+
+const char* ADC_SCAN_ChannelName(uint32_t channel)
+{
+    return (channel < ADC_SCAN_CHANNELS) ? scanNames[channel] : "?";
+}
+
+void ADC_SCAN_StatsGet(ADC_SCAN_STATS* stats)
+{
+    *stats = scanObj.stats;
+}
+
+/*******************************************************************************
+ End of File
+ */
@@ -0,0 +1,179 @@
+/*******************************************************************************
+  MCP3564 SCAN Sequencer Header File
+
+  File Name:
+    adc_scan.h
+
+  Summary:
+    Multi-channel SCAN mode acquisition with channel ID demultiplexing.
+
+  Description:
+    The MCP3564 SCAN register selects a set of inputs which the converter
+    walks through on its own, one conversion per data-ready edge. The
+    acquisition runs with DATA_FORMAT = 32 bit + CH_ID, so every sample
+    carries the ID of the input it was taken from. ADC_SCAN_Process drains
+    the acquisition FIFO and sorts the samples into one buffer per channel
+    ID; no per-sample MUX writes are needed.
+*******************************************************************************/
+
+#ifndef _ADC_SCAN_H
+#define _ADC_SCAN_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+extern "C" {
+
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Constants
+// *****************************************************************************
+// *****************************************************************************
+
+/* CH_ID values 0..15, same numbering as the SCAN register bits */
+#define ADC_SCAN_CHANNELS                   16U
+
+/* Samples kept per channel ID */
+#define ADC_SCAN_CHANNEL_SAMPLES            256U
+
+/* SCAN register bits 15:0, one per channel ID */
+#define ADC_SCAN_CH(n)                      (1UL << (n))
+#define ADC_SCAN_DIFF_A                     ADC_SCAN_CH(8)
+#define ADC_SCAN_DIFF_B                     ADC_SCAN_CH(9)
+#define ADC_SCAN_DIFF_C                     ADC_SCAN_CH(10)
+#define ADC_SCAN_DIFF_D                     ADC_SCAN_CH(11)
+#define ADC_SCAN_TEMP                       ADC_SCAN_CH(12)
+#define ADC_SCAN_AVDD                       ADC_SCAN_CH(13)
+#define ADC_SCAN_VCM                        ADC_SCAN_CH(14)
+#define ADC_SCAN_OFFSET                     ADC_SCAN_CH(15)
+#define ADC_SCAN_CHANNEL_MASK               0xFFFFUL
+
+/* SCAN.DLY: delay between conversions in multiples of 8 DMCLK, 0..7 */
+#define ADC_SCAN_DELAY_MAX                  7U
+
+/* CH_ID from a raw 32 bit + CH_ID sample */
+#define ADC_SCAN_CHANNEL_ID(raw)            (((raw) >> 4) & 0xFU)
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Type Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* SCAN statistics
+
+  Summary:
+    Counters of the running or last scan.
+
+  Remarks:
+    cycles counts completed passes over all selected channels. sequence
+    counts samples whose channel ID was not the next one in scan order, i.e.
+    a conversion was lost between them. unexpected counts IDs outside the
+    mask, overflow counts samples which did not fit in their channel buffer.
+*/
+
+typedef struct
+{
+    uint32_t mask;
+    uint32_t samples;
+    uint32_t cycles;
+    uint32_t sequence;
+    uint32_t unexpected;
+    uint32_t overflow;
+
+} ADC_SCAN_STATS;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+/*******************************************************************************
+  Function:
+    bool ADC_SCAN_Start ( uint32_t mask, uint32_t delay, uint32_t timer )
+
+  Summary:
+    Programs SCAN/TIMER and starts streaming the selected channels.
+
+  Description:
+    mask selects the channel IDs (SCAN bits 15:0), delay is SCAN.DLY and
+    timer the TIMER register (DMCLK periods between scan cycles). The
+    channel buffers are cleared.
+
+  Remarks:
+    Uses ADC_ACQ_MODE_DRIVER: the channel ID format does not fit the one
+    word per conversion event chain.
+*/
+
+bool ADC_SCAN_Start ( uint32_t mask, uint32_t delay, uint32_t timer );
+
+/*******************************************************************************
+  Function:
+    void ADC_SCAN_Stop ( void )
+
+  Summary:
+    Stops streaming and clears SCAN, which puts the MCP3564 back in MUX mode.
+*/
+
+void ADC_SCAN_Stop ( void );
+
+/*******************************************************************************
+  Function:
+    uint32_t ADC_SCAN_Process ( void )
+
+  Summary:
+    Moves the samples waiting in the acquisition FIFO into the channel
+    buffers. Returns the number of samples handled.
+
+  Remarks:
+    Call from the context that owns ADC_ACQ_Read.
+*/
+
+uint32_t ADC_SCAN_Process ( void );
+
+/*******************************************************************************
+  Function:
+    const int32_t* ADC_SCAN_ChannelGet ( uint32_t channel, uint32_t* count )
+
+  Summary:
+    Decoded samples collected for one channel ID, oldest first.
+
+  Description:
+    Returns NULL for an ID outside 0..15. count receives the number of
+    valid samples (up to ADC_SCAN_CHANNEL_SAMPLES).
+*/
+
+const int32_t* ADC_SCAN_ChannelGet ( uint32_t channel, uint32_t* count );
+
+uint32_t ADC_SCAN_MinCountGet ( void );
+
+const char* ADC_SCAN_ChannelName ( uint32_t channel );
+
+void ADC_SCAN_StatsGet ( ADC_SCAN_STATS* stats );
+
+//DOM-IGNORE-BEGIN
+#ifdef __cplusplus
+}
+#endif
+//DOM-IGNORE-END
+
+#endif /* _ADC_SCAN_H */
+
+/*******************************************************************************
+ End of File
+ */
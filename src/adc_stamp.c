@@ -0,0 +1,78 @@
+/*******************************************************************************
+  ADC Data-Ready Time Stamp Source File
+
+  File Name:
+    adc_stamp.c
+
+  Summary:
+    Free running 32 bit time base which latches the MCP3564 data-ready edge.
+
+  Description:
+    With EVACT = STAMP the TC keeps counting and copies COUNT into CC0 on
+    every event. INTFLAG.MC0 is set by a capture and cleared by reading
+    CC0; a capture while MC0 is still set raises INTFLAG.ERR.
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include "definitions.h"
+#include "adc_stamp.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+void ADC_STAMP_Initialize(void)
+{
+    TC0_REGS->COUNT32.TC_CTRLA = TC_CTRLA_SWRST_Msk;
+    while ((TC0_REGS->COUNT32.TC_SYNCBUSY & TC_SYNCBUSY_SWRST_Msk) != 0U)
+    {
+        /* Wait for synchronization */
+    }
+
+    /* TC0 is the master of the TC0/TC1 pair in 32 bit mode */
+    TC0_REGS->COUNT32.TC_CTRLA = TC_CTRLA_MODE_COUNT32 | TC_CTRLA_PRESCALER_DIV1 | TC_CTRLA_CAPTEN0_Msk;
+    TC0_REGS->COUNT32.TC_EVCTRL = TC_EVCTRL_TCEI_Msk | TC_EVCTRL_EVACT_STAMP;
+    TC0_REGS->COUNT32.TC_INTFLAG = (uint8_t) TC_INTFLAG_Msk;
+
+    TC0_REGS->COUNT32.TC_CTRLA |= TC_CTRLA_ENABLE_Msk;
+    while ((TC0_REGS->COUNT32.TC_SYNCBUSY & TC_SYNCBUSY_ENABLE_Msk) != 0U)
+    {
+        /* Wait for synchronization */
+    }
+}
+
+bool ADC_STAMP_Captured(uint32_t* ticks)
+{
+    uint8_t flags = TC0_REGS->COUNT32.TC_INTFLAG;
+
+    *ticks = TC0_REGS->COUNT32.TC_CC[0];
+    TC0_REGS->COUNT32.TC_INTFLAG = TC_INTFLAG_ERR_Msk;
+
+    return ((flags & (TC_INTFLAG_MC0_Msk | TC_INTFLAG_ERR_Msk)) == TC_INTFLAG_MC0_Msk);
+}
+
+uint32_t ADC_STAMP_Now(void)
+{
+    TC0_REGS->COUNT32.TC_CTRLBSET = TC_CTRLBSET_CMD_READSYNC;
+    while ((TC0_REGS->COUNT32.TC_SYNCBUSY & TC_SYNCBUSY_CTRLB_Msk) != 0U)
+    {
+        /* Wait for synchronization */
+    }
+    while ((TC0_REGS->COUNT32.TC_CTRLBSET & TC_CTRLBSET_CMD_Msk) != 0U)
+    {
+        /* Wait for the read synchronization */
+    }
+
+    return TC0_REGS->COUNT32.TC_COUNT;
+}
+
+/*******************************************************************************
+ End of File
+ */
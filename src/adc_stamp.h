@@ -0,0 +1,102 @@
+/*******************************************************************************
+  ADC Data-Ready Time Stamp Header File
+
+  File Name:
+    adc_stamp.h
+
+  Summary:
+    Free running 32 bit time base which latches the MCP3564 data-ready edge.
+
+  Description:
+    TC0/TC1 form one 32 bit counter clocked by GCLK1 (60 MHz). EVSYS channel
+    3 routes EXTINT14 to the TC event input with the time stamp capture
+    action, so the count at the edge lands in CC0 without any software in
+    between: the value does not depend on interrupt latency, only on the
+    fixed EIC + EVSYS resynchronization delay (a few GCLK cycles).
+
+    Ticks wrap every 2^32 / 60 MHz = 71.6 s; use unsigned differences.
+*******************************************************************************/
+
+#ifndef _ADC_STAMP_H
+#define _ADC_STAMP_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+extern "C" {
+
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Constants
+// *****************************************************************************
+// *****************************************************************************
+
+/* GCLK1 = DPLL0 / 2 */
+#define ADC_STAMP_FREQUENCY_HZ              60000000U
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+/*******************************************************************************
+  Function:
+    void ADC_STAMP_Initialize ( void )
+
+  Summary:
+    Starts the counter with the capture armed. Called from
+    ADC_ACQ_Initialize.
+*/
+
+void ADC_STAMP_Initialize ( void );
+
+/*******************************************************************************
+  Function:
+    bool ADC_STAMP_Captured ( uint32_t* ticks )
+
+  Summary:
+    Returns the count latched by the last data-ready edge.
+
+  Description:
+    Reading consumes the capture. Returns false when no edge was captured
+    since the previous read, or when more than one was (the value then
+    belongs to the latest edge, not necessarily the one the caller means).
+    *ticks is written in both cases.
+*/
+
+bool ADC_STAMP_Captured ( uint32_t* ticks );
+
+/*******************************************************************************
+  Function:
+    uint32_t ADC_STAMP_Now ( void )
+
+  Summary:
+    Current count, on the same time base as the captures.
+*/
+
+uint32_t ADC_STAMP_Now ( void );
+
+//DOM-IGNORE-BEGIN
+#ifdef __cplusplus
+}
+#endif
+//DOM-IGNORE-END
+
+#endif /* _ADC_STAMP_H */
+
+/*******************************************************************************
+ End of File
+ */
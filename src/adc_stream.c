@@ -0,0 +1,199 @@
+/*******************************************************************************
+  ADC Binary Stream Source File
+
+  File Name:
+    adc_stream.c
+
+  Summary:
+    Framed binary sample stream on the console UART (SERCOM5).
+
+  Description:
+    Frames are built in place and handed to the SERCOM5 ring buffer with a
+    single write, so console text queued from the same task can only end
+    up between frames, never inside one.
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <string.h>
+#include "definitions.h"
+#include "adc_stream.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+#define ADC_STREAM_SAMPLE_MAX               ((1L << 23) - 1)
+#define ADC_STREAM_SAMPLE_MIN               (-(1L << 23))
+
+typedef struct
+{
+    bool enabled;
+    uint16_t sequence;
+    uint32_t mask;
+    uint32_t count;
+    uint8_t frame[ADC_STREAM_FRAME_SIZE];
+    ADC_STREAM_STATS stats;
+
+} ADC_STREAM_OBJ;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data
+// *****************************************************************************
+// *****************************************************************************
+
+static ADC_STREAM_OBJ streamObj;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+static void lADC_STREAM_Send(void)
+{
+    uint8_t* frame = streamObj.frame;
+    uint32_t size = ADC_STREAM_HEADER_SIZE + (streamObj.count * ADC_STREAM_SAMPLE_SIZE);
+    uint16_t crc;
+
+    frame[0] = ADC_STREAM_SYNC0;
+    frame[1] = ADC_STREAM_SYNC1;
+    frame[2] = (uint8_t) streamObj.sequence;
+    frame[3] = (uint8_t) (streamObj.sequence >> 8);
+    frame[4] = (uint8_t) streamObj.mask;
+    frame[5] = (uint8_t) (streamObj.mask >> 8);
+    frame[6] = (uint8_t) (streamObj.mask >> 16);
+    frame[7] = (uint8_t) (streamObj.mask >> 24);
+    frame[8] = (uint8_t) streamObj.count;
+    frame[9] = (uint8_t) (streamObj.count >> 8);
+
+    crc = ADC_STREAM_Crc16(ADC_STREAM_CRC_INIT, &frame[2], size - 2U);
+    frame[size] = (uint8_t) crc;
+    frame[size + 1U] = (uint8_t) (crc >> 8);
+    size += ADC_STREAM_CRC_SIZE;
+
+    if (SERCOM5_USART_WriteFreeBufferCountGet() >= size)
+    {
+        (void) SERCOM5_USART_Write(frame, size);
+        streamObj.stats.frames++;
+        streamObj.stats.samples += streamObj.count;
+        streamObj.stats.bytes += size;
+    }
+    else
+    {
+        streamObj.stats.dropped++;
+    }
+
+    streamObj.sequence++;
+    streamObj.count = 0U;
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+void ADC_STREAM_Enable(bool enable)
+{
+    if (enable)
+    {
+        memset(&streamObj, 0, sizeof(streamObj));
+    }
+    else
+    {
+        ADC_STREAM_Flush();
+    }
+
+    streamObj.enabled = enable;
+}
+
+bool ADC_STREAM_IsEnabled(void)
+{
+    return streamObj.enabled;
+}
+
+void ADC_STREAM_Samples(uint32_t mask, const int32_t* samples, uint32_t count)
+{
+    uint8_t* p;
+    int32_t sample;
+    uint32_t i;
+
+    if (!streamObj.enabled)
+    {
+        return;
+    }
+
+    if ((streamObj.count != 0U) && (mask != streamObj.mask))
+    {
+        lADC_STREAM_Send();
+    }
+    streamObj.mask = mask;
+
+    p = &streamObj.frame[ADC_STREAM_HEADER_SIZE + (streamObj.count * ADC_STREAM_SAMPLE_SIZE)];
+
+    for (i = 0; i < count; i++)
+    {
+        sample = samples[i];
+        if (sample > ADC_STREAM_SAMPLE_MAX)
+        {
+            sample = ADC_STREAM_SAMPLE_MAX;
+            streamObj.stats.clipped++;
+        }
+        else if (sample < ADC_STREAM_SAMPLE_MIN)
+        {
+            sample = ADC_STREAM_SAMPLE_MIN;
+            streamObj.stats.clipped++;
+        }
+
+        p[0] = (uint8_t) sample;
+        p[1] = (uint8_t) (sample >> 8);
+        p[2] = (uint8_t) (sample >> 16);
+        p += ADC_STREAM_SAMPLE_SIZE;
+
+        if (++streamObj.count == ADC_STREAM_FRAME_SAMPLES)
+        {
+            lADC_STREAM_Send();
+            p = &streamObj.frame[ADC_STREAM_HEADER_SIZE];
+        }
+    }
+}
+
+void ADC_STREAM_Flush(void)
+{
+    if (streamObj.enabled && (streamObj.count != 0U))
+    {
+        lADC_STREAM_Send();
+    }
+}
+
+void ADC_STREAM_StatsGet(ADC_STREAM_STATS* stats)
+{
+    *stats = streamObj.stats;
+}
+
+uint16_t ADC_STREAM_Crc16(uint16_t crc, const uint8_t* data, uint32_t length)
+{
+    uint32_t x;
+
+    /* Byte at a time without a table: x^16 + x^12 + x^5 + 1 folded */
+    while (length-- != 0U)
+    {
+        x = ((uint32_t) crc >> 8) ^ *data++;
+        x ^= x >> 4;
+        crc = (uint16_t) ((crc << 8) ^ (x << 12) ^ (x << 5) ^ x);
+    }
+
+    return crc;
+}
+
+/*******************************************************************************
+ End of File
+ */
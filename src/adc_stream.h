@@ -0,0 +1,174 @@
+/*******************************************************************************
+  ADC Binary Stream Header File
+
+  File Name:
+    adc_stream.h
+
+  Summary:
+    Framed binary sample stream on the console UART (SERCOM5).
+
+  Description:
+    Frame layout, multi-byte fields little endian:
+
+      offset  size  field
+      0       2     sync, 0xA5 0x5A
+      2       2     sequence number, +1 per frame (also for dropped frames)
+      4       4     channel mask: bits 0-15 SCAN channels, bit 16 MUX
+      8       2     sample count n
+      10      3n    samples, signed 24 bit, ascending channel order
+      10+3n   2     CRC-16/CCITT-FALSE over bytes 2 .. 9+3n
+
+    At 3 bytes per sample plus 12 bytes per frame the stream is about 25x
+    denser than the console text for the same samples. Text printed by the
+    console between frames is not covered by a valid CRC, so a receiver
+    that hunts for the sync word and checks the CRC skips it.
+*******************************************************************************/
+
+#ifndef _ADC_STREAM_H
+#define _ADC_STREAM_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+extern "C" {
+
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Constants
+// *****************************************************************************
+// *****************************************************************************
+
+#define ADC_STREAM_SYNC0                    0xA5U
+#define ADC_STREAM_SYNC1                    0x5AU
+
+/* Channel mask bit of the samples taken in MUX mode */
+#define ADC_STREAM_MASK_MUX                 (1UL << 16)
+
+#define ADC_STREAM_HEADER_SIZE              10U
+#define ADC_STREAM_SAMPLE_SIZE              3U
+#define ADC_STREAM_CRC_SIZE                 2U
+
+/* Samples per frame: 204 byte frames, 94% payload */
+#define ADC_STREAM_FRAME_SAMPLES            64U
+
+#define ADC_STREAM_FRAME_SIZE               (ADC_STREAM_HEADER_SIZE + \
+                                             (ADC_STREAM_FRAME_SAMPLES * ADC_STREAM_SAMPLE_SIZE) + \
+                                             ADC_STREAM_CRC_SIZE)
+
+#define ADC_STREAM_CRC_INIT                 0xFFFFU
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Type Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Stream counters
+
+  Summary:
+    Counters since the stream was last enabled.
+
+  Remarks:
+    A frame is dropped, not waited for, when the UART transmit buffer cannot
+    take all of it: blocking here would stall the acquisition loop and
+    overrun the sample FIFO instead. The receiver sees the gap in the
+    sequence numbers.
+*/
+
+typedef struct
+{
+    uint32_t frames;
+    uint32_t samples;
+    uint32_t bytes;
+    uint32_t dropped;
+    uint32_t clipped;
+
+} ADC_STREAM_STATS;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+/*******************************************************************************
+  Function:
+    void ADC_STREAM_Enable ( bool enable )
+
+  Summary:
+    Switches the binary stream on or off.
+
+  Remarks:
+    Enabling restarts the sequence at 0 and clears the counters. Disabling
+    flushes a partly filled frame first.
+*/
+
+void ADC_STREAM_Enable ( bool enable );
+
+bool ADC_STREAM_IsEnabled ( void );
+
+/*******************************************************************************
+  Function:
+    void ADC_STREAM_Samples ( uint32_t mask, const int32_t* samples, uint32_t count )
+
+  Summary:
+    Adds samples of the channels in mask to the stream.
+
+  Description:
+    Samples are packed into the current frame, which is sent when full. A
+    different mask than the one of the pending samples sends the pending
+    frame first. Values outside the 24 bit range are clipped and counted.
+    Does nothing while the stream is off.
+*/
+
+void ADC_STREAM_Samples ( uint32_t mask, const int32_t* samples, uint32_t count );
+
+/*******************************************************************************
+  Function:
+    void ADC_STREAM_Flush ( void )
+
+  Summary:
+    Sends the pending samples as a short frame.
+*/
+
+void ADC_STREAM_Flush ( void );
+
+void ADC_STREAM_StatsGet ( ADC_STREAM_STATS* stats );
+
+/*******************************************************************************
+  Function:
+    uint16_t ADC_STREAM_Crc16 ( uint16_t crc, const uint8_t* data, uint32_t length )
+
+  Summary:
+    CRC-16/CCITT-FALSE (poly 0x1021, MSB first) of data, continued from crc.
+
+  Remarks:
+    Start with ADC_STREAM_CRC_INIT.
+*/
+
+uint16_t ADC_STREAM_Crc16 ( uint16_t crc, const uint8_t* data, uint32_t length );
+
+//DOM-IGNORE-BEGIN
+#ifdef __cplusplus
+}
+#endif
+//DOM-IGNORE-END
+
+#endif /* _ADC_STREAM_H */
+
+/*******************************************************************************
+ End of File
+ */
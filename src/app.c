@@ -28,6 +28,22 @@
 // *****************************************************************************
 
 #include "app.h"
+#include "adc_acq.h"
+#include "adc_scan.h"
+#include "mcp3564_reg.h"
+#include "mcp3564_cache.h"
+#include "adc_conv.h"
+#include "adc_decode.h"
+#include "adc_decim.h"
+#include "adc_filter.h"
+#include "adc_stamp.h"
+#include "mcp3564_rate.h"
+#include "adc_stream.h"
+#include "app_perf.h"
+#include "app_trace.h"
+#include "app_wait.h"
+#include "sys_tasks.h"
+#include "definitions.h"
 #include "math.h"
 
 /*
@@ -45,8 +61,6 @@
 
 //      Register name                       ADDR | no. of bits
 #define APP_ADC_READ_ADCDATA                0x41
-#define APP_ADC_OFFSETCALCODE               0x106E84
-#define MASK(j) (1<<j)
 //----------------------Commands Config.-----------------------// 
 #define APP_CMD_DEVICE                      0x1
 #define APP_CMD_WRITE                       0x2 
@@ -56,34 +70,6 @@
 #define APP_CMD_SHUTDOWN                    0x70
 #define APP_CMD_DEFAULT                     0x78
 #define APP_CMD_CONVERSION                  0x68
-//----------------------Registers address----------------------// 
-#define APP_CMD_ADCDATA                     0x0 // 4/24/32 bites
-char ADCDATA[15] = "0x0";
-#define APP_CMD_CONFIG0                     0x1 // 8 bits
-char CONFIG0[15] = "0x1";
-#define APP_CMD_CONFIG1                     0x2 // 8 bits
-char CONFIG1[15] = "0x2";
-#define APP_CMD_CONFIG2                     0x3 // 8 bits
-char CONFIG2[15] = "0x3";
-#define APP_CMD_CONFIG3                     0x4 // 8 bits
-char CONFIG3[15] = "0x4";
-#define APP_CMD_IRQ                         0x5 // 8 bits
-char IRQ[15] = "0x5";
-#define APP_CMD_MUX                         0x6 // 8 bits
-char MUX[15] = "0x6";
-#define APP_CMD_SCAN                        0x7 // 24 bits
-char SCAN[15] = "0x7";
-#define APP_CMD_TIMER                       0x8 // 24 bits
-char TIMER[15] = "0x8";
-#define APP_CMD_OFFSETCAL                   0x9 // 24 bits
-char OFFSETCAL[15] = "0x9";
-#define APP_CMD_GAINCAL                      0xA // 24 bits
-char GAINCAL[15] = "0xA";
-#define APP_CMD_RESERVED0                   0xB // 24 bits
-#define APP_CMD_RESERVED1                   0xC // 8 bits
-#define APP_CMD_LOCK                        0xD // 8 bits
-#define APP_CMD_RESERVED2                   0xE // 16 bits
-#define APP_CMD_CRCCFG                      0xF // 16 bits
 #define LINE_TERM                           "\r\n"          // line terminator
 
 //----------------------SPI config.----------------------// 
@@ -101,21 +87,21 @@ char APP_Config_Buffer[MAX_CONFIG_SIZE];
 //----------------------miscellaneous ----------------------// 
 #define LED_On()                            LED_Clear()
 #define LED_Off()                           LED_Set()
-#define ref_voltage                (3.3f)
-int32_t ADCval[2];
-uint8_t rxData[APP_RX_BUFFER_SIZE];
-uint8_t txData[APP_TX_BUFFER_SIZE];
-
+#define APP_CONTINUOUS_DEFAULT_BLOCKS       16U
+#define APP_CONTINUOUS_CHUNK                64U
+#define APP_SCAN_DEFAULT_SAMPLES            64U
+#define APP_PERF_BAR_WIDTH                  40U
+#define APP_TRACE_DEFAULT_RECORDS           64U
+#define APP_TRACE_LINE_SIZE                 80U
+#define APP_CONTINUOUS_PASS_CHUNKS          8U
+#define APP_SINGLE_POLL_MS                  1U
+#define APP_SINGLE_TIMEOUT_MS               5000U
+#define APP_STATUS_DR_MASK                  0x04U       // STATUS.DR_STATUS, 0 = new data
+#define APP_CYCLES_TO_NS(c)                 ((uint32_t) (((uint64_t) (c) * 1000U) / (CPU_CLOCK_FREQUENCY / 1000000U)))
 APP_DATA appData;
 
-APP_STATES nextState;
-volatile bool isTransferDone = false;
-bool ADCcycle = true;
-bool configwrite;
-bool isRTCTimerExpired;
 bool ADC_IRQ;
 
-float resoloution = 8388608;
 
 
 
@@ -123,17 +109,35 @@ int ret;
 
 
 //----------------------Command functions prototypes----------------------// 
+static void _APP_AcqEventHandler(ADC_ACQ_EVENT event, uintptr_t context);
 static void _APP_Commands_ADC(SYS_CMD_DEVICE_NODE* pCmdIO, int argc, char** argv);
 static void _APP_Commands_REGISTERs(SYS_CMD_DEVICE_NODE* pCmdIO, int argc, char** argv);
 static void _APP_Commands_READ_REG(SYS_CMD_DEVICE_NODE* pCmdIO, int argc, char** argv);
 static void _APP_Commands_WRITE_REG(SYS_CMD_DEVICE_NODE* pCmdIO, int argc, char** argv);
 static void _APP_Commands_SINGLE(SYS_CMD_DEVICE_NODE* pCmdIO, int argc, char** argv);
 static void _APP_Commands_CONTINUOUS(SYS_CMD_DEVICE_NODE* pCmdIO, int argc, char** argv);
+static void _APP_Commands_STATS(SYS_CMD_DEVICE_NODE* pCmdIO, int argc, char** argv);
+static void _APP_Commands_SCAN(SYS_CMD_DEVICE_NODE* pCmdIO, int argc, char** argv);
+static void _APP_Commands_STOP(SYS_CMD_DEVICE_NODE* pCmdIO, int argc, char** argv);
+static void _APP_Commands_SNAPSHOT(SYS_CMD_DEVICE_NODE* pCmdIO, int argc, char** argv);
+static void _APP_Commands_CONFIG(SYS_CMD_DEVICE_NODE* pCmdIO, int argc, char** argv);
+static void _APP_Commands_CACHE(SYS_CMD_DEVICE_NODE* pCmdIO, int argc, char** argv);
+static void _APP_Commands_CAL(SYS_CMD_DEVICE_NODE* pCmdIO, int argc, char** argv);
+static void _APP_Commands_DECIMATE(SYS_CMD_DEVICE_NODE* pCmdIO, int argc, char** argv);
+static void _APP_Commands_FILTER(SYS_CMD_DEVICE_NODE* pCmdIO, int argc, char** argv);
+static void _APP_Commands_RATE(SYS_CMD_DEVICE_NODE* pCmdIO, int argc, char** argv);
+static void _APP_Commands_STREAM(SYS_CMD_DEVICE_NODE* pCmdIO, int argc, char** argv);
+static void _APP_Commands_CRC(SYS_CMD_DEVICE_NODE* pCmdIO, int argc, char** argv);
 static void _APP_Commands_CONVERT(SYS_CMD_DEVICE_NODE* pCmdIO, int argc, char** argv);
 static void _APP_Commands_STANDBY(SYS_CMD_DEVICE_NODE* pCmdIO, int argc, char** argv);
 static void _APP_Commands_SHUTDOWN(SYS_CMD_DEVICE_NODE* pCmdIO, int argc, char** argv);
 static void _APP_Commands_DEFAULT(SYS_CMD_DEVICE_NODE* pCmdIO, int argc, char** argv);
 static void _APP_Commands_about(SYS_CMD_DEVICE_NODE* pCmdIO, int argc, char** argv);
+static void _APP_Commands_PERF(SYS_CMD_DEVICE_NODE* pCmdIO, int argc, char** argv);
+static void _APP_Commands_PERFHIST(SYS_CMD_DEVICE_NODE* pCmdIO, int argc, char** argv);
+static void _APP_Commands_TRACE(SYS_CMD_DEVICE_NODE* pCmdIO, int argc, char** argv);
+static void _APP_Commands_TASKS(SYS_CMD_DEVICE_NODE* pCmdIO, int argc, char** argv);
+static void _APP_Commands_WAITS(SYS_CMD_DEVICE_NODE* pCmdIO, int argc, char** argv);
 
 
 
@@ -143,8 +147,20 @@ static const SYS_CMD_DESCRIPTOR appCmdTbl[] ={/* CMD            FUNCTION
     {"REGISTERs", _APP_Commands_REGISTERs, " : View all accessible internal ADC registers"},
     {"WRITE", _APP_Commands_WRITE_REG, "     : Write the specified register"},
     {"READ", _APP_Commands_READ_REG, "      : Read the specified register"},
+    {"SNAPSHOT", _APP_Commands_SNAPSHOT, "  : Read CONFIG0..CRCCFG in one transfer"},
+    {"CONFIG", _APP_Commands_CONFIG, "    : Write CONFIG0..MUX [SCAN TIMER] in one transfer and verify"},
+    {"CACHE", _APP_Commands_CACHE, "     : Shadow register cache counters [LOAD|VERIFY|FLUSH]"},
     {"SINGLE", _APP_Commands_SINGLE, "    : Get a single conversion on the specified channel"},
-    {"CONTINUOUS", _APP_Commands_CONTINUOUS, ": Get continuous conversion on the specified channel"},
+    {"CONTINUOUS", _APP_Commands_CONTINUOUS, ": Stream continuous conversions by DMA [blocks] [EVENT]"},
+    {"STATS", _APP_Commands_STATS, "     : Acquisition counters, interrupt load and latency"},
+    {"SCAN", _APP_Commands_SCAN, "      : Scan channels by SCAN register <mask> [samples] [timer]"},
+    {"STOP", _APP_Commands_STOP, "      : Abort the running ADC command and drop the queued ones"},
+    {"CAL", _APP_Commands_CAL, "       : Per-channel offset (codes) and gain [channel offset [gain]]"},
+    {"DECIMATE", _APP_Commands_DECIMATE, "  : Decimate CONTINUOUS/SCAN samples [ratio] [CIC|BOXCAR]"},
+    {"FILTER", _APP_Commands_FILTER, "    : CONTINUOUS filter chain [CLEAR|FIR|BIQUAD|NOTCH|DCBLOCK|COEF]"},
+    {"RATE", _APP_Commands_RATE, "      : Closest data rate by MCLK, PRE and OSR [sps[.fff]]"},
+    {"STREAM", _APP_Commands_STREAM, "    : Binary framed CONTINUOUS/SCAN samples on this UART [ON|OFF]"},
+    {"CRC", _APP_Commands_CRC, "       : CRC-16 check of CONTINUOUS ADC data reads [ON|OFF]"},
     {"CONVERT", _APP_Commands_CONVERT, "   : ADC Conversion Start/Restart Fast Command"},
     {"STANDBY", _APP_Commands_STANDBY, "   : ADC Standby Mode Fast Command"},
     {"SHUTDOWN", _APP_Commands_SHUTDOWN, "  : ADC Shutdown Mode Fast Command"},
@@ -152,6 +168,14 @@ static const SYS_CMD_DESCRIPTOR appCmdTbl[] ={/* CMD            FUNCTION
     {"about", _APP_Commands_about, "     : About the software/hardware"},
 };
 
+static const SYS_CMD_DESCRIPTOR appPerfCmdTbl[] = {
+    {"PERF", _APP_Commands_PERF, "      : Region timings, min/mean/max [RESET]"},
+    {"PERFHIST", _APP_Commands_PERFHIST, "  : Duration histogram of a region <COMMAND|SPI|DECODE|FILTER|FORMAT|WRITE>"},
+    {"TRACE", _APP_Commands_TRACE, "     : Event trace, last n records [n|BIN [n]|ON|OFF|CLEAR]"},
+    {"TASKS", _APP_Commands_TASKS, "     : Scheduler tasks, runs and run times, idle passes [RESET]"},
+    {"WAITS", _APP_Commands_WAITS, "     : Blocking waits, sleeps, timeouts and wait times [RESET]"},
+};
+
 //----------------------Commands Initialization----------------------// 
 
 bool APP_AddCommandFunction() {
@@ -163,6 +187,11 @@ bool APP_AddCommandFunction() {
         return false;
     }
 
+    if (!SYS_CMD_ADDGRP(appPerfCmdTbl, sizeof (appPerfCmdTbl) / sizeof (*appPerfCmdTbl), "PERF", ": Hot path profiler, event trace and scheduler"))
+    {
+        return false;
+    }
+
     return true;
 }
 
@@ -170,6 +199,15 @@ void APP_Initialize(void) {
     /* Place the App state machine in its initial state. */
     appData.state = APP_STATE_INITIALIZE;
 
+    APP_PERF_Initialize();
+    APP_TRACE_Initialize();
+    ADC_CONV_Initialize();
+
+    if (!ADC_ACQ_Initialize()) {
+        SYS_CONSOLE_PRINT(ESC_RED "Error! --> SPI driver failed to open" ESC_RESETCOLOR "\r\n");
+    }
+    ADC_ACQ_CallbackRegister(_APP_AcqEventHandler, 0);
+
     if (APP_AddCommandFunction()) {
         SYS_CONSOLE_PRINT(ESC_GREEN "Device booted correctly!" ESC_RESETCOLOR "\r\n");
     } else {
@@ -185,6 +223,18 @@ void APP_Initialize(void) {
 
 
 
+//*********Interrupt context: a block of samples or a command transfer for APP_Tasks*********//
+static void _APP_AcqEventHandler(ADC_ACQ_EVENT event, uintptr_t context) {
+    APP_SCHED_Signal(sysTaskApp);
+}
+
+//*********Runs APP_Tasks again after ms, or at the next pass without a free timer*********//
+static void _APP_WakeAfter(uint32_t ms) {
+    if (!APP_SCHED_DelaySet(sysTaskApp, ms)) {
+        APP_SCHED_Signal(sysTaskApp);
+    }
+}
+
 void EIC_Pin14Callback(uintptr_t context) {
     // This means an interrupt condition has been sensed on EIC Pin 27.
    
@@ -192,12 +242,43 @@ void EIC_Pin14Callback(uintptr_t context) {
 }
 
 
-static void rtcEventHandler(RTC_TIMER32_INT_MASK intCause, uintptr_t context) {
-    if (intCause & RTC_TIMER32_INT_MASK_CMP0) {
-        isRTCTimerExpired = true;
-    } else {
-        isRTCTimerExpired = false;
+//----------------------Command queue----------------------// 
+
+//*********SPI commands run from APP_Tasks, one at a time, in order*********//
+static bool _APP_Defer(SYS_CMD_FNC function, SYS_CMD_DEVICE_NODE* pCmdIO, int argc, char** argv) {
+    APP_REQUEST* request;
+    char* p;
+    int i;
+
+    if (appData.deferred) {
+        return false;
+    }
+
+    if (appData.queueCount == APP_QUEUE_DEPTH) {
+        SYS_CONSOLE_PRINT(ESC_RED "ADC queue full, %s rejected (STOP empties the queue)\r\n" ESC_RESETCOLOR, argv[0]);
+        return true;
+    }
+
+    if ((appData.state != APP_STATE_IDLE) || (appData.queueCount != 0U)) {
+        SYS_CONSOLE_PRINT("Queued, %u ahead\r\n", (unsigned) (appData.queueCount + 1U));
     }
+
+    request = &appData.queue[(appData.queueHead + appData.queueCount) % APP_QUEUE_DEPTH];
+    request->function = function;
+    request->pCmdIO = pCmdIO;
+    request->argc = argc;
+
+    //*********The arguments came from one line, they fit back into one*********//
+    p = request->line;
+    for (i = 0; i < argc; i++) {
+        request->argv[i] = p;
+        strcpy(p, argv[i]);
+        p += strlen(argv[i]) + 1U;
+    }
+
+    appData.queueCount++;
+    APP_SCHED_Signal(sysTaskApp);
+    return true;
 }
 
 
@@ -227,46 +308,19 @@ static void _APP_Commands_ADC(SYS_CMD_DEVICE_NODE* pCmdIO, int argc, char** argv
 }
 
 void _APP_Commands_REGISTERs(SYS_CMD_DEVICE_NODE* pCmdIO, int argc, char** argv) {
-    static const SYS_CMD_DESCRIPTOR appCmdTb2[] = {
-        /* CMD            FUNCTION                            DESCRIPTION                  */
-        {"0x0 ---- ADCDATA", _APP_Commands_REGISTERs, "   ---- 4/24/32 "},
-        {"0x1 ---- CONFIG0", _APP_Commands_REGISTERs, "   ---- 8 "},
-        {"0x2 ---- CONFIG1", _APP_Commands_REGISTERs, "   ---- 8 "},
-        {"0x3 ---- CONFIG2", _APP_Commands_REGISTERs, "   ---- 8 "},
-        {"0x4 ---- CONFIG3", _APP_Commands_REGISTERs, "   ---- 8 "},
-        {"0x5 ---- IRQ", _APP_Commands_REGISTERs, "       ---- 8 "},
-        {"0x6 ---- MUX", _APP_Commands_REGISTERs, "       ---- 8 "},
-        {"0x7 ---- SCAN", _APP_Commands_REGISTERs, "      ---- 24 "},
-        {"0x8 ---- TIMER", _APP_Commands_REGISTERs, "     ---- 24 "},
-        {"0x9 ---- OFFSETCAL", _APP_Commands_REGISTERs, " ---- 24 "},
-        {"0xA ---- GAINCAL", _APP_Commands_REGISTERs, "   ---- 24 "},
-    };
+    const MCP3564_REG* reg;
+    uint32_t address;
 
+    SYS_CONSOLE_MESSAGE(LINE_TERM "----------- ADC internal registers ------------");
+    SYS_CONSOLE_MESSAGE(LINE_TERM " --- Addr. -- Register -- No. of Bits -- Access ---");
 
-    uint32_t ix;
-    const SYS_CMD_DESCRIPTOR* pDcpt;
-    const void* cmdIoParam = pCmdIO->cmdIoParam;
-
-
-    (*pCmdIO->pCmdApi->msg)(cmdIoParam, LINE_TERM "----------- ADC internal registers ------------");
-    (*pCmdIO->pCmdApi->msg)(cmdIoParam, LINE_TERM " --- Addr. -- Register -- No. of Bits ---");
-
-    ix = 0;
-    pDcpt = appCmdTb2;
-    while (ix < (sizeof (appCmdTb2) / sizeof (*appCmdTb2))) {
-        (*pCmdIO->pCmdApi->msg)(cmdIoParam, LINE_TERM " *** ");
-        (*pCmdIO->pCmdApi->msg)(cmdIoParam, pDcpt->cmdStr);
-        (*pCmdIO->pCmdApi->msg)(cmdIoParam, pDcpt->cmdDescr);
-        (*pCmdIO->pCmdApi->msg)(cmdIoParam, " ***");
-        ix++;
-        pDcpt++;
+    for (address = 0; address < MCP3564_REG_COUNT; address++) {
+        reg = MCP3564_REG_Get(address);
+        SYS_CONSOLE_PRINT(LINE_TERM " *** 0x%X ---- %-9s ---- %2u ---- %s ***", (unsigned) reg->address, reg->name,
+                (unsigned) (reg->size * 8U), (reg->access == MCP3564_ACCESS_RW) ? "R/W" : "R");
     }
 
-    (*pCmdIO->pCmdApi->msg)(cmdIoParam, LINE_TERM);
-
-
-
-
+    SYS_CONSOLE_MESSAGE(LINE_TERM);
 }
 /******************************************************************************/
 
@@ -276,629 +330,1039 @@ void _APP_Commands_REGISTERs(SYS_CMD_DEVICE_NODE* pCmdIO, int argc, char** argv)
 
 void _APP_Commands_READ_REG(SYS_CMD_DEVICE_NODE* pCmdIO, int argc, char** argv) {
     const void* cmdIoParam = pCmdIO->cmdIoParam;
+    const MCP3564_REG* reg;
+    uint32_t value;
+    int32_t sample;
+    char text[ADC_CONV_TEXT_SIZE];
+
+    if (_APP_Defer(_APP_Commands_READ_REG, pCmdIO, argc, argv)) {
+        return;
+    }
 
     if (argc != 2) {
-        (*pCmdIO->pCmdApi->msg)(cmdIoParam, "Usage: READ <register addr>\r\n");
+        (*pCmdIO->pCmdApi->msg)(cmdIoParam, "Usage: READ <register addr|name>\r\n");
         (*pCmdIO->pCmdApi->msg)(cmdIoParam, "Ex: READ 0x1\r\n");
         return;
     }
-    strcpy(APP_Register_Buffer, argv[1]);
 
+    reg = MCP3564_REG_Parse(argv[1]);
+    if ((reg == NULL) || ((reg->access & MCP3564_ACCESS_R) == 0U)) {
+        SYS_CONSOLE_MESSAGE("Error! Invalid Register\r\n");
+        return;
+    }
 
-    if (strncmp(APP_Register_Buffer, ADCDATA, 5) == 0) {
-        struct ADCvariable getvalue2;
-        SYS_CONSOLE_MESSAGE("ADCDATA\r\n");
-        txData[1] = APP_CMD_DEVICE;
-        txData[2] = APP_CMD_ADCDATA;
-        txData[3] = APP_CMD_READ;
-
-        txData[4] = ((uint8_t) txData[3]);
-        txData[4] = txData[4] | ((uint8_t) (txData[2]) << 2);
-        txData[4] = txData[4] | ((uint8_t) (txData[1]) << 6);
-        SYS_CONSOLE_PRINT("Sending data: 0x%x\r\n", txData[4]);
-        // SERCOM1_SPI_CallbackRegister(&SPIEventHandler, (uintptr_t) NULL);
-
-        SPI_CS_Clear();
-        if (SERCOM1_SPI_WriteRead(&txData[4], 1, rxData, 4)) {
+    SYS_CONSOLE_PRINT("Reading: %s\r\n", reg->name);
+    if (MCP3564_CACHE_IsCached(reg->address)) {
+        SYS_CONSOLE_MESSAGE("From shadow cache\r\n");
+    } else {
+        SYS_CONSOLE_PRINT("Sending data: 0x%x\r\n", reg->readCmd);
+    }
 
-        }
-        while (SERCOM1_SPI_IsBusy() == true);
+    if (!MCP3564_CACHE_Read(reg->address, &value)) {
+        SYS_CONSOLE_MESSAGE(ESC_RED "Error reading the register!\r\n" ESC_RESETCOLOR);
+        return;
+    }
 
-        ADCval[2] = ((int32_t) rxData[3]);
-        ADCval[2] = ADCval[2] | ((int32_t) (rxData[2]) << 8);
-        ADCval[2] = ADCval[2] | ((int32_t) (rxData[1]) << 16);
-        getvalue2.input_voltage = (float) ADCval[2] * ref_voltage / 8388608U;
+    SYS_CONSOLE_PRINT("%s contains: 0x%0*X\r\n", reg->name, (int) (reg->size * 2U), (unsigned) value);
 
-        SYS_CONSOLE_PRINT(ESC_GREEN "ADC voltage = %d.%06d V \r\n" ESC_RESETCOLOR, (int) getvalue2.input_voltage, (int) ((getvalue2.input_voltage - (int) getvalue2.input_voltage)*1000000.0));
+    if (reg->address == MCP3564_REG_ADCDATA) {
+        //*********Sign extend the 24 bit result*********//
+        sample = ((int32_t) (value << 8)) >> 8;
+        (void) ADC_CONV_Format(ADC_CONV_ToMicrovolts(ADC_CONV_CHANNEL_MUX, sample), text, sizeof (text));
+        SYS_CONSOLE_PRINT(ESC_GREEN "ADC value = %d (%s V) \r\n" ESC_RESETCOLOR, (int) sample, text);
+    }
+}
 
-    } else if (strncmp(APP_Register_Buffer, CONFIG0, 5) == 0) {
-        SYS_CONSOLE_MESSAGE("Reading: CONFIG0\r\n");
-        txData[1] = APP_CMD_DEVICE;
-        txData[2] = APP_CMD_CONFIG0;
-        txData[3] = APP_CMD_READ;
 
-        txData[4] = ((uint8_t) txData[3]);
-        txData[4] = txData[4] | ((uint8_t) (txData[2]) << 2);
-        txData[4] = txData[4] | ((uint8_t) (txData[1]) << 6);
-        SYS_CONSOLE_PRINT("Sending data: 0x%x\r\n", txData[4]);
-        //SERCOM1_SPI_CallbackRegister(&SPIEventHandler, (uintptr_t) NULL);
 
-        SPI_CS_Clear();
-        if (SERCOM1_SPI_WriteRead(&txData[4], 1, rxData, 2)) {
+//************Register file snapshot************// 
 
-        }
-        while (SERCOM1_SPI_IsBusy() == true);
+void _APP_Commands_SNAPSHOT(SYS_CMD_DEVICE_NODE* pCmdIO, int argc, char** argv) {
+    MCP3564_SNAPSHOT snap;
+    uint32_t start;
 
-        SYS_CONSOLE_PRINT("CONFIG0 contains: 0x%X\r\n", rxData[1]);
+    if (_APP_Defer(_APP_Commands_SNAPSHOT, pCmdIO, argc, argv)) {
+        return;
+    }
 
-    } else if (strncmp(APP_Register_Buffer, CONFIG1, 5) == 0) {
-        SYS_CONSOLE_MESSAGE("Reading: CONFIG1\r\n");
-        txData[1] = APP_CMD_DEVICE;
-        txData[2] = APP_CMD_CONFIG1;
-        txData[3] = APP_CMD_READ;
+    start = DWT->CYCCNT;
+    if (!ADC_ACQ_SnapshotRead(&snap)) {
+        SYS_CONSOLE_MESSAGE(ESC_RED "Error reading the register snapshot!\r\n" ESC_RESETCOLOR);
+        return;
+    }
 
-        txData[4] = ((uint8_t) txData[3]);
-        txData[4] = txData[4] | ((uint8_t) (txData[2]) << 2);
-        txData[4] = txData[4] | ((uint8_t) (txData[1]) << 6);
-        SYS_CONSOLE_PRINT("Sending data: 0x%x\r\n", txData[4]);
-        //SERCOM1_SPI_CallbackRegister(&SPIEventHandler, (uintptr_t) NULL);
+    SYS_CONSOLE_PRINT("1 transfer, %u bytes, %u ns\r\n", MCP3564_SNAPSHOT_SIZE + 1U,
+            (unsigned) APP_CYCLES_TO_NS(DWT->CYCCNT - start));
+    SYS_CONSOLE_PRINT("CONFIG0: 0x%02X  CONFIG1: 0x%02X  CONFIG2: 0x%02X  CONFIG3: 0x%02X\r\n",
+            snap.config0, snap.config1, snap.config2, snap.config3);
+    SYS_CONSOLE_PRINT("IRQ:     0x%02X  MUX:     0x%02X  LOCK:    0x%02X\r\n", snap.irq, snap.mux, snap.lock);
+    SYS_CONSOLE_PRINT("SCAN:    0x%06X  TIMER:   0x%06X\r\n", (unsigned) snap.scan, (unsigned) snap.timer);
+    SYS_CONSOLE_PRINT("OFFSETCAL: 0x%06X  GAINCAL: 0x%06X\r\n", (unsigned) snap.offsetcal, (unsigned) snap.gaincal);
+    SYS_CONSOLE_PRINT("Chip ID: 0x%04X  CRCCFG: 0x%04X\r\n", snap.reserved2, snap.crccfg);
+}
 
-        SPI_CS_Clear();
-        if (SERCOM1_SPI_WriteRead(&txData[4], 1, rxData, 2)) {
 
-        }
-        while (SERCOM1_SPI_IsBusy() == true);
 
-        SYS_CONSOLE_PRINT("CONFIG1 contains: 0x%X\r\n", rxData[1]);
-    } else if (strncmp(APP_Register_Buffer, CONFIG2, 5) == 0) {
-        SYS_CONSOLE_MESSAGE("Reading: CONFIG2\r\n");
-        txData[1] = APP_CMD_DEVICE;
-        txData[2] = APP_CMD_CONFIG2;
-        txData[3] = APP_CMD_READ;
+//************Batched configuration write************// 
 
-        txData[4] = ((uint8_t) txData[3]);
-        txData[4] = txData[4] | ((uint8_t) (txData[2]) << 2);
-        txData[4] = txData[4] | ((uint8_t) (txData[1]) << 6);
-        SYS_CONSOLE_PRINT("Sending data: 0x%x\r\n", txData[4]);
-        //SERCOM1_SPI_CallbackRegister(&SPIEventHandler, (uintptr_t) NULL);
+void _APP_Commands_CONFIG(SYS_CMD_DEVICE_NODE* pCmdIO, int argc, char** argv) {
+    MCP3564_CONFIG config;
+    uint32_t start;
+    bool scan;
 
-        SPI_CS_Clear();
-        if (SERCOM1_SPI_WriteRead(&txData[4], 1, rxData, 2)) {
+    if (_APP_Defer(_APP_Commands_CONFIG, pCmdIO, argc, argv)) {
+        return;
+    }
 
-        }
-        while (SERCOM1_SPI_IsBusy() == true);
+    if ((argc != 7) && (argc != 9)) {
+        SYS_CONSOLE_MESSAGE("Usage: CONFIG <config0> <config1> <config2> <config3> <irq> <mux> [scan timer]\r\n");
+        SYS_CONSOLE_MESSAGE("Ex: CONFIG 0xE3 0x0C 0x8B 0xC0 0x06 0x01\r\n");
+        return;
+    }
 
-        SYS_CONSOLE_PRINT("CONFIG2: contains: 0x%X\r\n", rxData[1]);
-    } else if (strncmp(APP_Register_Buffer, CONFIG3, 5) == 0) {
-        SYS_CONSOLE_MESSAGE("Reading: CONFIG3\r\n");
-        txData[1] = APP_CMD_DEVICE;
-        txData[2] = APP_CMD_CONFIG3;
-        txData[3] = APP_CMD_READ;
+    config.config0 = (uint8_t) strtoul(argv[1], NULL, 0);
+    config.config1 = (uint8_t) strtoul(argv[2], NULL, 0);
+    config.config2 = (uint8_t) strtoul(argv[3], NULL, 0);
+    config.config3 = (uint8_t) strtoul(argv[4], NULL, 0);
+    config.irq = (uint8_t) strtoul(argv[5], NULL, 0);
+    config.mux = (uint8_t) strtoul(argv[6], NULL, 0);
+    scan = (argc == 9);
+    config.scan = scan ? ((uint32_t) strtoul(argv[7], NULL, 0) & 0xFFFFFFU) : 0U;
+    config.timer = scan ? ((uint32_t) strtoul(argv[8], NULL, 0) & 0xFFFFFFU) : 0U;
+
+    start = DWT->CYCCNT;
+    if (!MCP3564_CACHE_ConfigApply(&config, scan, true)) {
+        SYS_CONSOLE_MESSAGE(ESC_RED "Error! Configuration write or verify failed\r\n" ESC_RESETCOLOR);
+        return;
+    }
 
-        txData[4] = ((uint8_t) txData[3]);
-        txData[4] = txData[4] | ((uint8_t) (txData[2]) << 2);
-        txData[4] = txData[4] | ((uint8_t) (txData[1]) << 6);
-        SYS_CONSOLE_PRINT("Sending data: 0x%x\r\n", txData[4]);
-        // SERCOM1_SPI_CallbackRegister(&SPIEventHandler, (uintptr_t) NULL);
+    SYS_CONSOLE_PRINT(ESC_GREEN "Configuration written and verified" ESC_RESETCOLOR " (%u bytes, %u ns)\r\n",
+            scan ? MCP3564_CONFIG_SIZE_SCAN : MCP3564_CONFIG_SIZE, (unsigned) APP_CYCLES_TO_NS(DWT->CYCCNT - start));
+}
 
-        SPI_CS_Clear();
-        if (SERCOM1_SPI_WriteRead(&txData[4], 1, rxData, 2)) {
 
-        }
-        while (SERCOM1_SPI_IsBusy() == true);
 
-        SYS_CONSOLE_PRINT("CONFIG3 contains: 0x%X\r\n", rxData[1]);
-    } else if (strncmp(APP_Register_Buffer, IRQ, 5) == 0) {
-        SYS_CONSOLE_MESSAGE("Reading: IRQ\r\n");
-        txData[1] = APP_CMD_DEVICE;
-        txData[2] = APP_CMD_IRQ;
-        txData[3] = APP_CMD_READ;
+//************Shadow register cache************// 
 
-        txData[4] = ((uint8_t) txData[3]);
-        txData[4] = txData[4] | ((uint8_t) (txData[2]) << 2);
-        txData[4] = txData[4] | ((uint8_t) (txData[1]) << 6);
-        SYS_CONSOLE_PRINT("Sending data: 0x%x\r\n", txData[4]);
-        // SERCOM1_SPI_CallbackRegister(&SPIEventHandler, (uintptr_t) NULL);
+void _APP_Commands_CACHE(SYS_CMD_DEVICE_NODE* pCmdIO, int argc, char** argv) {
+    MCP3564_CACHE_STATS stats;
+    bool ok = true;
 
-        SPI_CS_Clear();
-        if (SERCOM1_SPI_WriteRead(&txData[4], 1, rxData, 2)) {
+    if ((argc > 1) && _APP_Defer(_APP_Commands_CACHE, pCmdIO, argc, argv)) {
+        return;
+    }
 
+    if (argc > 1) {
+        if (strcmp(argv[1], "LOAD") == 0) {
+            ok = MCP3564_CACHE_Load();
+        } else if (strcmp(argv[1], "VERIFY") == 0) {
+            ok = MCP3564_CACHE_Verify();
+        } else if (strcmp(argv[1], "FLUSH") == 0) {
+            ok = MCP3564_CACHE_Flush();
+        } else {
+            SYS_CONSOLE_MESSAGE("Usage: CACHE [LOAD|VERIFY|FLUSH]\r\n");
+            return;
         }
-        while (SERCOM1_SPI_IsBusy() == true);
-
-        SYS_CONSOLE_PRINT("IRQ contains: 0x%X\r\n", rxData[1]);
-    } else if (strncmp(APP_Register_Buffer, MUX, 5) == 0) {
-        SYS_CONSOLE_MESSAGE("Reading: MUX\r\n");
-        txData[1] = APP_CMD_DEVICE;
-        txData[2] = APP_CMD_MUX;
-        txData[3] = APP_CMD_READ;
-
-        txData[4] = ((uint8_t) txData[3]);
-        txData[4] = txData[4] | ((uint8_t) (txData[2]) << 2);
-        txData[4] = txData[4] | ((uint8_t) (txData[1]) << 6);
-        SYS_CONSOLE_PRINT("Sending data: 0x%x\r\n", txData[4]);
-        // SERCOM1_SPI_CallbackRegister(&SPIEventHandler, (uintptr_t) NULL);
+        SYS_CONSOLE_PRINT("%s: %s\r\n", argv[1], ok ? ESC_GREEN "OK" ESC_RESETCOLOR : ESC_RED "FAILED" ESC_RESETCOLOR);
+    }
 
-        SPI_CS_Clear();
-        if (SERCOM1_SPI_WriteRead(&txData[4], 1, rxData, 2)) {
+    MCP3564_CACHE_StatsGet(&stats);
+    SYS_CONSOLE_PRINT("Valid: 0x%04X  Dirty: 0x%04X\r\n", stats.valid, stats.dirty);
+    SYS_CONSOLE_PRINT("Hits: %u  Misses: %u  Flushes: %u  Bytes written: %u\r\n", (unsigned) stats.hits,
+            (unsigned) stats.misses, (unsigned) stats.flushes, (unsigned) stats.bytesWritten);
+    SYS_CONSOLE_PRINT("Verifies: %u  Mismatches: %u  Last mismatch mask: 0x%04X\r\n", (unsigned) stats.verifies,
+            (unsigned) stats.mismatches, stats.mismatchMask);
+}
 
-        }
-        while (SERCOM1_SPI_IsBusy() == true);
 
-        SYS_CONSOLE_PRINT("MUX contains: 0x%X\r\n", rxData[1]);
-    } else if (strncmp(APP_Register_Buffer, SCAN, 5) == 0) {
-        SYS_CONSOLE_MESSAGE("Reading: SCAN\r\n");
-        txData[1] = APP_CMD_DEVICE;
-        txData[2] = APP_CMD_SCAN;
-        txData[3] = APP_CMD_READ;
 
-        txData[4] = ((uint8_t) txData[3]);
-        txData[4] = txData[4] | ((uint8_t) (txData[2]) << 2);
-        txData[4] = txData[4] | ((uint8_t) (txData[1]) << 6);
-        SYS_CONSOLE_PRINT("Sending data: 0x%x\r\n", txData[4]);
-        //SERCOM1_SPI_CallbackRegister(&SPIEventHandler, (uintptr_t) NULL);
+//************Write register function************// 
 
-        SPI_CS_Clear();
-        if (SERCOM1_SPI_WriteRead(&txData[4], 1, rxData, 4)) {
+void _APP_Commands_WRITE_REG(SYS_CMD_DEVICE_NODE* pCmdIO, int argc, char** argv) {
+    const void* cmdIoParam = pCmdIO->cmdIoParam;
+    const MCP3564_REG* reg;
+    uint32_t value;
+    char* end;
 
-        }
-        while (SERCOM1_SPI_IsBusy() == true);
+    if (_APP_Defer(_APP_Commands_WRITE_REG, pCmdIO, argc, argv)) {
+        return;
+    }
 
-        SYS_CONSOLE_PRINT("SCAN contains: 0x%X\r\n", rxData[3]);
-    } else if (strncmp(APP_Register_Buffer, TIMER, 5) == 0) {
-        SYS_CONSOLE_MESSAGE("Reading: TIMER\r\n");
-        txData[1] = APP_CMD_DEVICE;
-        txData[2] = APP_CMD_TIMER;
-        txData[3] = APP_CMD_READ;
+    if (argc != 3) {
+        (*pCmdIO->pCmdApi->msg)(cmdIoParam, "Usage: WRITE <register addr|name> <config>\r\n");
+        (*pCmdIO->pCmdApi->msg)(cmdIoParam, "Ex: WRITE 0x4 0xC0\r\n");
+        return;
+    }
 
-        txData[4] = ((uint8_t) txData[3]);
-        txData[4] = txData[4] | ((uint8_t) (txData[2]) << 2);
-        txData[4] = txData[4] | ((uint8_t) (txData[1]) << 6);
-        SYS_CONSOLE_PRINT("Sending data: 0x%x\r\n", txData[4]);
-        //SERCOM1_SPI_CallbackRegister(&SPIEventHandler, (uintptr_t) NULL);
+    reg = MCP3564_REG_Parse(argv[1]);
+    if ((reg == NULL) || ((reg->access & MCP3564_ACCESS_W) == 0U)) {
+        SYS_CONSOLE_MESSAGE("Error! Invalid or read-only Register\r\n");
+        return;
+    }
 
-        SPI_CS_Clear();
-        if (SERCOM1_SPI_WriteRead(&txData[4], 1, rxData, 4)) {
+    value = (uint32_t) strtoul(argv[2], &end, 0);
+    if ((*end != '\0') || ((value >> (8U * reg->size)) != 0U)) {
+        SYS_CONSOLE_PRINT(ESC_RED "Error! %s is %u bits wide\r\n" ESC_RESETCOLOR, reg->name, (unsigned) (reg->size * 8U));
+        return;
+    }
 
-        }
-        while (SERCOM1_SPI_IsBusy() == true);
+    SYS_CONSOLE_PRINT("Write: %s\r\n", reg->name);
+    SYS_CONSOLE_PRINT("Sending data: 0x%x\r\n", reg->writeCmd);
+    SYS_CONSOLE_PRINT("Config. data: 0x%0*X\r\n", (int) (reg->size * 2U), (unsigned) value);
 
-        SYS_CONSOLE_PRINT("TIMER contains: 0x%X\r\n", rxData[3]);
-    } else if (strncmp(APP_Register_Buffer, OFFSETCAL, 5) == 0) {
-        SYS_CONSOLE_MESSAGE("Reading: OFFSETCAL\r\n");
-        txData[1] = APP_CMD_DEVICE;
-        txData[2] = APP_CMD_OFFSETCAL;
-        txData[3] = APP_CMD_READ;
+    if (!MCP3564_CACHE_Write(reg->address, value) || !MCP3564_CACHE_Flush()) {
+        SYS_CONSOLE_MESSAGE(ESC_RED "Error writing the register!\r\n" ESC_RESETCOLOR);
+    }
+}
+/******************************************************************************/
 
-        txData[4] = ((uint8_t) txData[3]);
-        txData[4] = txData[4] | ((uint8_t) (txData[2]) << 2);
-        txData[4] = txData[4] | ((uint8_t) (txData[1]) << 6);
-        SYS_CONSOLE_PRINT("Sending data: 0x%x\r\n", txData[4]);
-        // SERCOM1_SPI_CallbackRegister(&SPIEventHandler, (uintptr_t) NULL); This will automatically pull CS line up after transfer.
 
-        SPI_CS_Clear();
-        if (SERCOM1_SPI_WriteRead(&txData[4], 1, rxData, 4)) {
 
-        }
-        while (SERCOM1_SPI_IsBusy() == true);
 
-        ADCval[2] = ((int32_t) rxData[3]);
-        ADCval[2] = ADCval[2] | ((int32_t) (rxData[2]) << 8);
-        ADCval[2] = ADCval[2] | ((int32_t) (rxData[1]) << 16);
 
-        SYS_CONSOLE_PRINT("OFFSETCAL contains: 0x%X\r\n", ADCval[2]);
-    } else if (strncmp(APP_Register_Buffer, GAINCAL, 5) == 0) {
-        SYS_CONSOLE_MESSAGE("Reading: GAINCAL\r\n");
-        txData[1] = APP_CMD_DEVICE;
-        txData[2] = APP_CMD_GAINCAL;
-        txData[3] = APP_CMD_READ;
 
-        txData[4] = ((uint8_t) txData[3]);
-        txData[4] = txData[4] | ((uint8_t) (txData[2]) << 2);
-        txData[4] = txData[4] | ((uint8_t) (txData[1]) << 6);
-        SYS_CONSOLE_PRINT("Sending data: 0x%x\r\n", txData[4]);
-        SERCOM1_SPI_CallbackRegister(&SPIEventHandler, (uintptr_t) NULL);
 
-        SPI_CS_Clear();
-        if (SERCOM1_SPI_WriteRead(&txData[4], 1, rxData, 4)) {
+//************Fast command function's************// 
 
-        }
-        while (SERCOM1_SPI_IsBusy() == true);
+void _APP_Commands_SINGLE(SYS_CMD_DEVICE_NODE* pCmdIO, int argc, char** argv) {
+    if (_APP_Defer(_APP_Commands_SINGLE, pCmdIO, argc, argv)) {
+        return;
+    }
 
-        SYS_CONSOLE_PRINT("GAINCAL contains: 0x%x\r\n", rxData[3]);
-    } else {
-        SYS_CONSOLE_MESSAGE("Error! Invalid Register\r\n");
+    //*********Conversion start; APP_Tasks polls DR_STATUS and reads ADCDATA*********//
+    SYS_CONSOLE_PRINT("Sending: 0x%x\r\n", APP_CMD_CONVERSION);
+    if (!ADC_ACQ_CommandStart(APP_CMD_CONVERSION, 0)) {
+        SYS_CONSOLE_MESSAGE(ESC_RED "Error initializing ADC single-shot!\r\n" ESC_RESETCOLOR);
+        return;
     }
-    
-    
-    SPI_CS_Set();
 
+    SYS_CONSOLE_MESSAGE("Initializing ADC single-shot...\r\n");
+    appData.timeStart = SYS_TIME_CounterGet();
+    appData.state = APP_STATE_SINGLE_CONVERT;
 }
 
+static void _APP_SingleReport(const uint8_t* data) {
+    int32_t sample;
+    char text[ADC_CONV_TEXT_SIZE];
 
+    //*********The result MSB first, after STATUS*********//
+    ADC_DECODE_Block24(data, &sample, 1);
 
-//************Write register function************// 
+    SYS_CONSOLE_PRINT("Receiving: 0x%06x\r\n", (unsigned) sample & 0xFFFFFFU);
+    SYS_CONSOLE_PRINT("Receiving: %d\r\n", (int) sample);
 
-void _APP_Commands_WRITE_REG(SYS_CMD_DEVICE_NODE* pCmdIO, int argc, char** argv) {
-    SPI_CS_Set();
+    (void) ADC_CONV_Format(ADC_CONV_ToMicrovolts(ADC_CONV_CHANNEL_MUX, sample), text, sizeof (text));
+    SYS_CONSOLE_PRINT(ESC_GREEN "ADC voltage = %s V \r\n" ESC_RESETCOLOR, text);
 
+    SYS_CONSOLE_MESSAGE("ADC going into SleepMode state! \r\n");
+}
 
-    const void* cmdIoParam = pCmdIO->cmdIoParam;
 
-    if (argc != 3) {
-        (*pCmdIO->pCmdApi->msg)(cmdIoParam, "Usage: WRITE <register addr> <config>\r\n");
-        (*pCmdIO->pCmdApi->msg)(cmdIoParam, "Ex: WRITE 0x46 0xE3\r\n");
+static void _APP_Commands_CONTINUOUS(SYS_CMD_DEVICE_NODE* pCmdIO, int argc, char** argv){
+    APP_CONTINUOUS* run = &appData.continuous;
+    ADC_ACQ_MODE mode = ADC_ACQ_MODE_DRIVER;
+    uint32_t blocks = APP_CONTINUOUS_DEFAULT_BLOCKS;
+
+    if (_APP_Defer(_APP_Commands_CONTINUOUS, pCmdIO, argc, argv)) {
         return;
     }
 
-    strcpy(APP_Register_Buffer, argv[1]);
-    strcpy(APP_Config_Buffer, argv[2]);
-    SYS_CONSOLE_PRINT("Configuration to register: %x\r\n", *APP_Config_Buffer);
-
-
-
-    if (strncmp(APP_Register_Buffer, CONFIG0, 5) == 0) {
-        SYS_CONSOLE_MESSAGE("Write: CONFIG0\r\n");
+    if (argc > 1) {
+        blocks = (uint32_t) strtoul(argv[1], NULL, 0);
+        if (blocks == 0) {
+            SYS_CONSOLE_MESSAGE(ESC_RED "Usage: CONTINUOUS [blocks] [EVENT]\r\n" ESC_RESETCOLOR);
+            return;
+        }
+    }
+    if ((argc > 2) && (strncmp(argv[2], "EVENT", 5) == 0)) {
+        mode = ADC_ACQ_MODE_EVENT;
+    }
 
-        txData[5] = *APP_Config_Buffer;
+    //*********Putting the ADC in Continuous mode*********//
+    SYS_CONSOLE_PRINT("Setting the ADC in continuous mode (%u blocks of %u samples)...\r\n", (unsigned) blocks, ADC_ACQ_BLOCK_SAMPLES);
 
-        txData[1] = APP_CMD_DEVICE;
-        txData[2] = APP_CMD_CONFIG0;
-        txData[3] = APP_CMD_WRITE;
+    ADC_DECIM_Reset();
+    ADC_FILTER_Reset();
 
-        txData[4] = ((uint8_t) txData[3]);
-        txData[4] = txData[4] | ((uint8_t) (txData[2]) << 2);
-        txData[4] = txData[4] | ((uint8_t) (txData[1]) << 6);
-        SYS_CONSOLE_PRINT("Sending data: 0x%x\r\n", txData[4]);
-        //SERCOM1_SPI_CallbackRegister(&SPIEventHandler, (uintptr_t) NULL);
+    if (!ADC_ACQ_Start(mode, ADC_ACQ_FORMAT_24)) {
+        SYS_CONSOLE_MESSAGE(ESC_RED "Error initializing ADC continuous conversion!\r\n" ESC_RESETCOLOR);
+        if ((mode == ADC_ACQ_MODE_EVENT) && ADC_ACQ_CrcIsEnabled()) {
+            SYS_CONSOLE_MESSAGE(ESC_RED "EVENT mode needs CRC OFF\r\n" ESC_RESETCOLOR);
+        }
+        return;
+    }
 
-        SPI_CS_Clear();
-        if (SERCOM1_SPI_Write(&txData[4], 1)) {
+    //*********APP_Tasks reads the data as it arrives*********//
+    (void) memset(run, 0, sizeof (*run));
+    run->target = blocks * ADC_ACQ_BLOCK_SAMPLES;
+    run->min = INT32_MAX;
+    run->max = INT32_MIN;
+    appData.state = APP_STATE_CONTINUOUS;
+}
 
-        } else {
-            SPI_CS_Clear();
+//*********One pass of a running CONTINUOUS, the report once all blocks are in*********//
+static void _APP_ContinuousTasks(void) {
+    APP_CONTINUOUS* run = &appData.continuous;
+    uint32_t raw[APP_CONTINUOUS_CHUNK];
+    int32_t samples[APP_CONTINUOUS_CHUNK];
+    uint32_t count;
+    uint32_t chunks = 0;
+    ADC_ACQ_STAMP stamp;
+    uint32_t i;
+    int32_t sample;
+    char text[ADC_CONV_TEXT_SIZE];
+
+    //*********Read the ADC Continuous data, a bounded amount per pass*********//
+    do {
+        count = ADC_ACQ_Read(raw, APP_CONTINUOUS_CHUNK);
+        if (count == 0U) {
+            break;
         }
-        RTC_Timer32Start();
-        /*
-        
-        
-        while (!isRTCTimerExpired == true){
-            RTC_Timer32CallbackRegister(rtcEventHandler, 0);
-        }
-        
-         */
-        while (SERCOM1_SPI_IsTransmitterBusy() == true);
-
-        SPI_CS_Clear();
-        if (SERCOM1_SPI_Write(&txData[5], 1)) {
 
+        APP_PERF_BEGIN(decodeStart);
+        ADC_DECODE_Block32(raw, samples, count);
+        APP_PERF_END(APP_PERF_REGION_DECODE, decodeStart);
+        run->samples += count;
+        count = ADC_DECIM_Process(ADC_DECIM_CHANNEL_MUX, samples, samples, count);
+
+        APP_PERF_BEGIN(filterStart);
+        ADC_FILTER_Process(samples, count);
+        APP_PERF_END(APP_PERF_REGION_FILTER, filterStart);
+        ADC_STREAM_Samples(ADC_STREAM_MASK_MUX, samples, count);
+
+        for (i = 0; i < count; i++) {
+            sample = samples[i];
+            run->sum += sample;
+            if (sample < run->min) {
+                run->min = sample;
+            }
+            if (sample > run->max) {
+                run->max = sample;
+            }
         }
-        while (SERCOM1_SPI_IsTransmitterBusy() == true);
-        //SERCOM1_SPI_CallbackRegister(&SPIEventHandler, (uintptr_t) NULL);
 
-    } else if (strncmp(APP_Register_Buffer, CONFIG3, 5) == 0) {
-        SYS_CONSOLE_MESSAGE("Write: CONFIG3\r\n");
+        run->outputs += count;
+        chunks++;
+    } while ((run->samples < run->target) && (chunks < APP_CONTINUOUS_PASS_CHUNKS));
 
-        txData[5] = 0xC0;
+    //*********Stopped at the chunk limit: the rest at the next pass, other blocks wake it*********//
+    if (chunks == APP_CONTINUOUS_PASS_CHUNKS) {
+        APP_SCHED_Signal(sysTaskApp);
+    }
 
-        txData[1] = APP_CMD_DEVICE;
-        txData[2] = APP_CMD_CONFIG3;
-        txData[3] = APP_CMD_WRITE;
+    //*********Keep the first and the latest block time stamp*********//
+    while (ADC_ACQ_StampRead(&stamp)) {
+        if (!run->stamped) {
+            run->first = stamp;
+            run->stamped = true;
+        }
+        run->last = stamp;
+    }
 
-        txData[4] = ((uint8_t) txData[3]);
-        txData[4] = txData[4] | ((uint8_t) (txData[2]) << 2);
-        txData[4] = txData[4] | ((uint8_t) (txData[1]) << 6);
-        SYS_CONSOLE_PRINT("Sending data: 0x%x\r\n", txData[4]);
-        //SERCOM1_SPI_CallbackRegister(&SPIEventHandler, (uintptr_t) NULL);
+    if (run->samples < run->target) {
+        return;
+    }
 
-        SPI_CS_Clear();
-        if (SERCOM1_SPI_Write(&txData[4], 1)) {
+    ADC_ACQ_Stop();
+    ADC_STREAM_Flush();
+    appData.state = APP_STATE_IDLE;
 
-        } else {
-            SPI_CS_Clear();
-        }
-        while (SERCOM1_SPI_IsTransmitterBusy() == true);
-        SPI_CS_Clear();
-        if (SERCOM1_SPI_Write(&txData[5], 1)) {
+    if (run->outputs == 0U) {
+        SYS_CONSOLE_MESSAGE(ESC_RED "No decimated output, use more blocks!\r\n" ESC_RESETCOLOR);
+        return;
+    }
 
-        }
-        while (SERCOM1_SPI_IsTransmitterBusy() == true);
+    sample = (int32_t) (run->sum / (int64_t) run->outputs);
+    (void) ADC_CONV_Format(ADC_CONV_ToMicrovolts(ADC_CONV_CHANNEL_MUX, sample), text, sizeof (text));
+    SYS_CONSOLE_PRINT(ESC_GREEN "Mean: %d (%s V)  Min: %d  Max: %d \r\n" ESC_RESETCOLOR, (int) sample,
+            text, (int) run->min, (int) run->max);
+
+    //*********Data rate from the hardware time stamps*********//
+    if (run->stamped && (run->last.index != run->first.index)) {
+        SYS_CONSOLE_PRINT("Stamps: #%u @ %u .. #%u @ %u ticks  ->  %u.%03u sps\r\n",
+                (unsigned) run->first.index, (unsigned) run->first.ticks, (unsigned) run->last.index, (unsigned) run->last.ticks,
+                (unsigned) (((uint64_t) (run->last.index - run->first.index) * ADC_STAMP_FREQUENCY_HZ) / (run->last.ticks - run->first.ticks)),
+                (unsigned) ((((uint64_t) (run->last.index - run->first.index) * ADC_STAMP_FREQUENCY_HZ * 1000U) /
+                (run->last.ticks - run->first.ticks)) % 1000U));
+    }
+    _APP_Commands_STATS(NULL, 0, NULL);
+}
 
-    } else if (strncmp(APP_Register_Buffer, CONFIG3, 5) == 0) {
-        SYS_CONSOLE_MESSAGE("Write: CONFIG3\r\n");
+static void _APP_Commands_STATS(SYS_CMD_DEVICE_NODE* pCmdIO, int argc, char** argv) {
+    ADC_ACQ_STATS stats;
+    uint32_t avg = 0;
 
-        txData[5] = 0xC0;
+    ADC_ACQ_StatsGet(&stats);
 
-        txData[1] = APP_CMD_DEVICE;
-        txData[2] = APP_CMD_CONFIG3;
-        txData[3] = APP_CMD_WRITE;
+    SYS_CONSOLE_PRINT("Mode: %s  Samples: %u  Blocks: %u  Overruns: %u  Dropped: %u  Errors: %u\r\n",
+            (stats.mode == ADC_ACQ_MODE_EVENT) ? "EVENT" : "DRIVER",
+            (unsigned) stats.samples, (unsigned) stats.blocks, (unsigned) stats.overruns,
+            (unsigned) stats.dropped, (unsigned) stats.errors);
+    SYS_CONSOLE_PRINT("FIFO high-watermark: %u of %u\r\n", (unsigned) stats.highWater, ADC_ACQ_FIFO_SAMPLES);
 
-        txData[4] = ((uint8_t) txData[3]);
-        txData[4] = txData[4] | ((uint8_t) (txData[2]) << 2);
-        txData[4] = txData[4] | ((uint8_t) (txData[1]) << 6);
-        SYS_CONSOLE_PRINT("Sending data: 0x%x\r\n", txData[4]);
-        //SERCOM1_SPI_CallbackRegister(&SPIEventHandler, (uintptr_t) NULL);
+    //*********Interrupt load: interrupts per 1000 samples*********//
+    SYS_CONSOLE_PRINT("Interrupts: %u  (%u per 1000 samples)\r\n", (unsigned) stats.interrupts,
+            (stats.samples != 0U) ? (unsigned) (((uint64_t) stats.interrupts * 1000U) / stats.samples) : 0U);
 
-        SPI_CS_Clear();
-        if (SERCOM1_SPI_Write(&txData[4], 1)) {
+    //*********Edge to sample in RAM, sampled once per block*********//
+    if (stats.latencyCount != 0U) {
+        avg = (uint32_t) (stats.latencySum / stats.latencyCount);
+    }
+    SYS_CONSOLE_PRINT("Latency (ns): min %u  avg %u  max %u  (%u probes)\r\n",
+            (unsigned) APP_CYCLES_TO_NS(stats.latencyMin), (unsigned) APP_CYCLES_TO_NS(avg),
+            (unsigned) APP_CYCLES_TO_NS(stats.latencyMax), (unsigned) stats.latencyCount);
+    SYS_CONSOLE_PRINT("Time stamps: %u  missed: %u  (%u MHz time base)\r\n", (unsigned) stats.stamps,
+            (unsigned) stats.stampMisses, ADC_STAMP_FREQUENCY_HZ / 1000000U);
+    SYS_CONSOLE_PRINT("CRC: %s  errors: %u\r\n", ADC_ACQ_CrcIsEnabled() ? "ON" : "OFF", (unsigned) stats.crcErrors);
+}
 
-        } else {
-            SPI_CS_Clear();
-        }
-        while (SERCOM1_SPI_IsTransmitterBusy() == true);
-        SPI_CS_Clear();
-        if (SERCOM1_SPI_Write(&txData[5], 1)) {
 
-        }
-        while (SERCOM1_SPI_IsTransmitterBusy() == true);
 
-    } else if (strncmp(APP_Register_Buffer, OFFSETCAL, 5) == 0) {
-        SYS_CONSOLE_MESSAGE("Write: OFFSETCAL\r\n");
+//************Hot path profiler************// 
 
-        uint32_t test = APP_ADC_OFFSETCALCODE;
+static void _APP_Commands_PERF(SYS_CMD_DEVICE_NODE* pCmdIO, int argc, char** argv) {
+    APP_PERF_STATS stats;
+    uint32_t region;
 
-        txData[1] = APP_CMD_DEVICE;
-        txData[2] = APP_CMD_OFFSETCAL;
-        txData[3] = APP_CMD_WRITE;
+    if ((argc == 2) && (strcmp(argv[1], "RESET") == 0)) {
+        APP_PERF_Reset();
+        SYS_CONSOLE_MESSAGE("Profiler counters cleared\r\n");
+        return;
+    }
 
-        txData[4] = ((uint8_t) txData[3]);
-        txData[4] = txData[4] | ((uint8_t) (txData[2]) << 2);
-        txData[4] = txData[4] | ((uint8_t) (txData[1]) << 6);
-        SYS_CONSOLE_PRINT("Sending data: 0x%x\r\n", txData[4]);
-        SYS_CONSOLE_PRINT("Config. data: 0x%x\r\n", test);
-        //SERCOM1_SPI_CallbackRegister(&SPIEventHandler, (uintptr_t) NULL);
+    if (!APP_PERF_ENABLE) {
+        SYS_CONSOLE_MESSAGE(ESC_RED "Profiler compiled out (APP_PERF_ENABLE 0)\r\n" ESC_RESETCOLOR);
+        return;
+    }
 
-        SPI_CS_Clear();
-        if (SERCOM1_SPI_WriteRead(&txData[4], 1, NULL, 0)) {
-            //while (SERCOM1_SPI_IsTransmitterBusy() == true);
-        } else {
-            SPI_CS_Clear();
+    SYS_CONSOLE_MESSAGE("Region       Count      Min ns     Mean ns      Max ns\r\n");
+    for (region = 0; region < APP_PERF_REGIONS; region++) {
+        APP_PERF_StatsGet((APP_PERF_REGION) region, &stats);
+        if (stats.count == 0U) {
+            SYS_CONSOLE_PRINT("%-8s %9u           -           -           -\r\n", APP_PERF_NameGet((APP_PERF_REGION) region), 0U);
+            continue;
         }
+        SYS_CONSOLE_PRINT("%-8s %9u %11u %11u %11u\r\n", APP_PERF_NameGet((APP_PERF_REGION) region),
+                (unsigned) stats.count, (unsigned) APP_PERF_TicksToNs(stats.min),
+                (unsigned) APP_PERF_TicksToNs(stats.sum / stats.count), (unsigned) APP_PERF_TicksToNs(stats.max));
+    }
+}
 
-        SPI_CS_Clear();
-        if (SERCOM1_SPI_WriteRead(&test, 4, NULL, 0)) {
-        }
-    } else {
+static void _APP_Commands_PERFHIST(SYS_CMD_DEVICE_NODE* pCmdIO, int argc, char** argv) {
+    APP_DUMP* dump = &appData.dump;
+    APP_PERF_REGION region;
+    uint32_t bin;
 
+    region = (argc == 2) ? APP_PERF_Parse(argv[1]) : APP_PERF_REGIONS;
+    if (region == APP_PERF_REGIONS) {
+        SYS_CONSOLE_MESSAGE(ESC_RED "Usage: PERFHIST <COMMAND|SPI|DECODE|FILTER|FORMAT|WRITE>\r\n" ESC_RESETCOLOR);
+        return;
     }
 
-    SPI_CS_Set();
-
+    //*********The histogram as it is now, APP_DumpTasks prints it*********//
+    dump->region = region;
+    APP_PERF_StatsGet(region, &dump->stats);
+    dump->peak = 0;
+    for (bin = 0; bin < APP_PERF_BINS; bin++) {
+        if (dump->stats.bins[bin] > dump->peak) {
+            dump->peak = dump->stats.bins[bin];
+        }
+    }
+    dump->index = 0;
+    dump->end = APP_PERF_BINS;
+    dump->any = false;
+    dump->kind = APP_DUMP_PERFHIST;
+    APP_SCHED_Signal(sysTaskCommand);
 }
-/******************************************************************************/
 
+static bool _APP_ConsoleRoom(void) {
+    return (SYS_CONSOLE_WriteFreeBufferCountGet(SYS_CONSOLE_DEFAULT_INSTANCE) >= (ssize_t) APP_TRACE_LINE_SIZE);
+}
 
+//*********One line per power of two, from its lower bound; false when the UART ring is full*********//
+static bool _APP_PerfHistTasks(APP_DUMP* dump) {
+    uint32_t width;
+    uint32_t count;
+    char bar[APP_PERF_BAR_WIDTH + 1U];
 
+    if (!dump->any) {
+        if (!_APP_ConsoleRoom()) {
+            return false;
+        }
+        SYS_CONSOLE_PRINT("%s: %u samples\r\n", APP_PERF_NameGet(dump->region), (unsigned) dump->stats.count);
+        dump->any = true;
+    }
 
+    for (; dump->index < dump->end; dump->index++) {
+        count = dump->stats.bins[dump->index];
+        if (count == 0U) {
+            continue;
+        }
+        if (!_APP_ConsoleRoom()) {
+            return false;
+        }
+        width = (uint32_t) (((uint64_t) count * APP_PERF_BAR_WIDTH + dump->peak - 1U) / dump->peak);
+        (void) memset(bar, '#', width);
+        bar[width] = '\0';
+        SYS_CONSOLE_PRINT(">= %10u ns %9u %s\r\n",
+                (unsigned) ((dump->index == 0U) ? 0U : APP_PERF_TicksToNs(1ULL << dump->index)), (unsigned) count, bar);
+    }
 
+    return true;
+}
 
+static void _APP_Commands_TRACE(SYS_CMD_DEVICE_NODE* pCmdIO, int argc, char** argv) {
+    APP_DUMP* dump = &appData.dump;
+    uint32_t count = APP_TRACE_DEFAULT_RECORDS;
+    uint32_t head;
+
+    if (argc > 1) {
+        if (strcmp(argv[1], "ON") == 0) {
+            (void) APP_TRACE_Enable(true);
+            SYS_CONSOLE_MESSAGE("Trace on\r\n");
+            return;
+        } else if (strcmp(argv[1], "OFF") == 0) {
+            (void) APP_TRACE_Enable(false);
+            SYS_CONSOLE_MESSAGE("Trace off\r\n");
+            return;
+        } else if (strcmp(argv[1], "CLEAR") == 0) {
+            APP_TRACE_Clear();
+            SYS_CONSOLE_MESSAGE("Trace cleared\r\n");
+            return;
+        } else if (strcmp(argv[1], "BIN") == 0) {
+            //*********APP_Tasks output, or stream frames, would end up inside the block*********//
+            if (APP_IsBusy()) {
+                SYS_CONSOLE_MESSAGE(ESC_RED "ADC command running, STOP it before TRACE BIN\r\n" ESC_RESETCOLOR);
+                return;
+            }
+            //*********TRC1 count(4) clock(4) n x (stamp(4) word(4)) crc16, little endian*********//
+            (void) APP_TRACE_DumpBinaryStart(&dump->bin, (argc > 2) ? (uint32_t) strtoul(argv[2], NULL, 0) : APP_TRACE_DEPTH);
+            dump->kind = APP_DUMP_TRACE_BIN;
+            APP_SCHED_Signal(sysTaskCommand);
+            return;
+        } else if ((argv[1][0] >= '0') && (argv[1][0] <= '9')) {
+            count = (uint32_t) strtoul(argv[1], NULL, 0);
+        } else {
+            SYS_CONSOLE_MESSAGE(ESC_RED "Usage: TRACE [n|BIN [n]|ON|OFF|CLEAR]\r\n" ESC_RESETCOLOR);
+            return;
+        }
+    }
 
-//************Fast command function's************// 
+    if (!APP_TRACE_ENABLE) {
+        SYS_CONSOLE_MESSAGE(ESC_RED "Trace compiled out (APP_TRACE_ENABLE 0)\r\n" ESC_RESETCOLOR);
+        return;
+    }
 
-void _APP_Commands_SINGLE(SYS_CMD_DEVICE_NODE* pCmdIO, int argc, char** argv) {
-    rxData[0] = 0;
-    rxData[1] = 0;
-    rxData[2] = 0;
-    rxData[3] = 0;
-    rxData[4] = 0;
+    //*********Paused until APP_DumpTasks has printed it, or the dump would trace its own UART traffic*********//
+    dump->enabled = APP_TRACE_Enable(false);
+    head = APP_TRACE_HeadGet();
+    if (count > APP_TRACE_DEPTH) {
+        count = APP_TRACE_DEPTH;
+    }
+    if (count > head) {
+        count = head;
+    }
 
+    dump->count = count;
+    dump->index = head - count;
+    dump->end = head;
+    dump->first = 0;
+    dump->last = 0;
+    dump->any = false;
+    dump->kind = APP_DUMP_TRACE;
+    SYS_CONSOLE_MESSAGE("   Index        Time us     Delta us  Event         Arg\r\n");
+    APP_SCHED_Signal(sysTaskCommand);
+}
 
+//*********A line per record while the UART ring has room for one; false when it is full*********//
+static bool _APP_TraceTasks(APP_DUMP* dump) {
+    APP_TRACE_RECORD record;
+    uint64_t ns;
+    uint64_t delta;
+    uint32_t head = dump->end;
 
-    txData[1] = APP_CMD_CONVERSION;
-    SYS_CONSOLE_PRINT("Sending: 0x%x\r\n", txData[1]);
-    struct ADCvariable getvalue1;
+    for (; dump->index != head; dump->index++) {
+        if (!APP_TRACE_Get(dump->index, &record)) {
+            continue;
+        }
+        if (!_APP_ConsoleRoom()) {
+            return false;
+        }
+        if (!dump->any) {
+            dump->first = record.cycles;
+            dump->last = record.cycles;
+            dump->any = true;
+        }
+        ns = ((uint64_t) (record.cycles - dump->first) * 1000U) / (CPU_CLOCK_FREQUENCY / 1000000U);
+        delta = ((uint64_t) (record.cycles - dump->last) * 1000U) / (CPU_CLOCK_FREQUENCY / 1000000U);
+        dump->last = record.cycles;
+        if ((record.event == APP_TRACE_CMD_START) || (record.event == APP_TRACE_CMD_END)) {
+            SYS_CONSOLE_PRINT("%8u %10u.%03u %8u.%03u  %-13s '%c'\r\n", (unsigned) record.index,
+                    (unsigned) (ns / 1000U), (unsigned) (ns % 1000U), (unsigned) (delta / 1000U), (unsigned) (delta % 1000U),
+                    APP_TRACE_NameGet(record.event), record.arg);
+        } else {
+            SYS_CONSOLE_PRINT("%8u %10u.%03u %8u.%03u  %-13s %u\r\n", (unsigned) record.index,
+                    (unsigned) (ns / 1000U), (unsigned) (ns % 1000U), (unsigned) (delta / 1000U), (unsigned) (delta % 1000U),
+                    APP_TRACE_NameGet(record.event), (unsigned) record.arg);
+        }
+    }
 
+    if (!_APP_ConsoleRoom()) {
+        return false;
+    }
+    SYS_CONSOLE_PRINT("%u records, %u lost to wrap; trace %s\r\n", (unsigned) dump->count,
+            (unsigned) ((head > APP_TRACE_DEPTH) ? (head - APP_TRACE_DEPTH) : 0U), dump->enabled ? "on" : "off");
 
-    SERCOM1_SPI_CallbackRegister(&SPIEventHandler, (uintptr_t) NULL);
-    SPI_CS_Clear();
+    (void) APP_TRACE_Enable(dump->enabled);
+    return true;
+}
 
-    if (SERCOM1_SPI_Write(&txData[1], 1)) {
-        SYS_CONSOLE_MESSAGE("Initializing ADC single-shot...\r\n");
-    } else {
-        SYS_CONSOLE_MESSAGE("Error initializing ADC single-shot!\r\n");
-        exit(0);
+bool APP_DumpTasks(void) {
+    APP_DUMP* dump = &appData.dump;
+    bool done;
+
+    switch (dump->kind) {
+        case APP_DUMP_TRACE:
+            done = _APP_TraceTasks(dump);
+            break;
+        case APP_DUMP_TRACE_BIN:
+            done = APP_TRACE_DumpBinaryTasks(&dump->bin);
+            break;
+        case APP_DUMP_PERFHIST:
+            done = _APP_PerfHistTasks(dump);
+            break;
+        default:
+            done = true;
+            break;
     }
 
-    while (SERCOM1_SPI_IsTransmitterBusy() == true);
-
-    while (!isRTCTimerExpired == true) {
-        RTC_Timer32CallbackRegister(rtcEventHandler, 0);
+    if (done) {
+        dump->kind = APP_DUMP_NONE;
     }
+    return !done;
+}
 
-    SERCOM1_SPI_CallbackRegister(&SPIEventHandler, (uintptr_t) NULL);
 
+//************Scheduler************// 
 
-    rxData[0] = 0;
-    rxData[1] = 0;
-    rxData[2] = 0;
-    rxData[3] = 0;
-    rxData[4] = 0;
+static void _APP_Commands_TASKS(SYS_CMD_DEVICE_NODE* pCmdIO, int argc, char** argv) {
+    static const char* const priorities[APP_SCHED_PRIORITIES] = {"HIGH", "NORMAL", "LOW"};
+    APP_SCHED_TASK_STATS task;
+    APP_SCHED_STATS sched;
+    APP_SCHED_HANDLE handle;
 
-    txData[1] = APP_ADC_READ_ADCDATA;
-    SYS_CONSOLE_PRINT("Sending: 0x%x\r\n", txData[1]);
-    SPI_CS_Clear();
-    if (SERCOM1_SPI_WriteRead(&txData[1], 1, rxData, 4)) {
-        SYS_CONSOLE_MESSAGE("Reading single-shot conversion...\r\n");
+    if ((argc == 2) && (strcmp(argv[1], "RESET") == 0)) {
+        APP_SCHED_StatsReset();
+        SYS_CONSOLE_MESSAGE("Scheduler counters cleared\r\n");
+        return;
     }
-    while (SERCOM1_SPI_IsBusy() == true);
-
-    ADCval[2] = ((int32_t) rxData[3]);
-    ADCval[2] = ADCval[2] | ((int32_t) (rxData[2]) << 8);
-    ADCval[2] = ADCval[2] | ((int32_t) (rxData[1]) << 16);
 
+    SYS_CONSOLE_MESSAGE("Task     Priority      Runs     Mean ns      Max ns\r\n");
+    for (handle = 0; APP_SCHED_TaskStatsGet(handle, &task); handle++) {
+        SYS_CONSOLE_PRINT("%-8s %-8s %9u %11u %11u\r\n", task.name, priorities[task.priority], (unsigned) task.runs,
+                (unsigned) ((task.runs == 0U) ? 0U : APP_PERF_TicksToNs(task.sum / task.runs)),
+                (unsigned) APP_PERF_TicksToNs(task.max));
+    }
 
-    SYS_CONSOLE_PRINT("Receiving: 0x%x\r\n", ADCval[2]);
-    SYS_CONSOLE_PRINT("Receiving: %d\r\n", (int) ADCval[2]);
-    if (getbit(ADCval[2], 23)) {
-        ADCval[2] = ADCval[2] | (255U << 24);
-        SYS_CONSOLE_MESSAGE("Reading a negative number -#\r\n");
-        SYS_CONSOLE_PRINT("Receiving: %x\r\n", ADCval[2]);
-        getvalue1.input_voltage = (float) ADCval[2] * ref_voltage / 8388608U;
+    //*********Idle passes found no task ready and slept in WFI*********//
+    APP_SCHED_StatsGet(&sched);
+    SYS_CONSOLE_PRINT("Passes: %u  idle: %u (%u%%)\r\n", (unsigned) sched.passes, (unsigned) sched.idle,
+            (unsigned) ((sched.passes == 0U) ? 0U : (uint32_t) (((uint64_t) sched.idle * 100U) / sched.passes)));
+}
 
-        SYS_CONSOLE_PRINT(ESC_GREEN "ADC voltage = %d.%05d V \r\n" ESC_RESETCOLOR, (int) getvalue1.input_voltage, ~(int) ((getvalue1.input_voltage - (int) getvalue1.input_voltage)*100000.0));
-    } else {
-        getvalue1.input_voltage = (float) ADCval[2] * ref_voltage / 8388608U;
+static void _APP_Commands_WAITS(SYS_CMD_DEVICE_NODE* pCmdIO, int argc, char** argv) {
+    APP_WAIT_STATS stats;
+    uint32_t site;
 
-        SYS_CONSOLE_PRINT(ESC_GREEN "ADC voltage = %d.%05d V \r\n" ESC_RESETCOLOR, (int) getvalue1.input_voltage, (int) ((getvalue1.input_voltage - (int) getvalue1.input_voltage)*100000.0));
+    if ((argc == 2) && (strcmp(argv[1], "RESET") == 0)) {
+        APP_WAIT_Reset();
+        SYS_CONSOLE_MESSAGE("Wait counters cleared\r\n");
+        return;
     }
-    //getvalue1.adc_count = *APP_Register_Buffer;
-
 
-    SYS_CONSOLE_MESSAGE("ADC going into SleepMode state! \r\n");
+    //*********Mean over every wait, the ones which did not have to sleep count as 0*********//
+    SYS_CONSOLE_MESSAGE("Wait         Count  Timeouts     Sleeps     Mean ns      Max ns\r\n");
+    for (site = 0; site < APP_WAIT_SITES; site++) {
+        APP_WAIT_StatsGet((APP_WAIT_SITE) site, &stats);
+        SYS_CONSOLE_PRINT("%-8s %9u %9u %10u %11u %11u\r\n", APP_WAIT_NameGet((APP_WAIT_SITE) site),
+                (unsigned) stats.count, (unsigned) stats.timeouts, (unsigned) stats.sleeps,
+                (unsigned) ((stats.count == 0U) ? 0U : APP_PERF_TicksToNs(stats.sum / stats.count)),
+                (unsigned) APP_PERF_TicksToNs(stats.max));
+    }
 }
 
+static void _APP_Commands_SCAN(SYS_CMD_DEVICE_NODE* pCmdIO, int argc, char** argv) {
+    uint32_t mask;
+    uint32_t samples = APP_SCAN_DEFAULT_SAMPLES;
+    uint32_t timer = 0;
 
-static void _APP_Commands_CONTINUOUS(SYS_CMD_DEVICE_NODE* pCmdIO, int argc, char** argv){
-    
-    EIC_CallbackRegister(EIC_PIN_14, EIC_Pin14Callback, 0);
-    SPI_CS_Set();
-    struct ADCvariable getvalue3;
-    
-    int i = 1; 
-    
-    //*********Putting the ADC in Continuous mode*********//
-    SYS_CONSOLE_MESSAGE("Setting the ADC in continuous mode...\r\n"); 
-
-    txData[5] = 0xC0; // CONTINUOS MODE
+    if (argc < 2) {
+        SYS_CONSOLE_MESSAGE(ESC_RED "Usage: SCAN <mask> [samples] [timer]\r\n" ESC_RESETCOLOR);
+        SYS_CONSOLE_MESSAGE("mask bits: 0-7 CH0-CH7, 8-11 DIFFA-DIFFD, 12 TEMP, 13 AVDD, 14 VCM, 15 OFFSET\r\n");
+        return;
+    }
 
-    txData[1] = APP_CMD_DEVICE;
-    txData[2] = APP_CMD_CONFIG3;
-    txData[3] = APP_CMD_WRITE;
+    if (_APP_Defer(_APP_Commands_SCAN, pCmdIO, argc, argv)) {
+        return;
+    }
 
-    txData[4] = ((uint8_t) txData[3]);
-    txData[4] = txData[4] | ((uint8_t) (txData[2]) << 2);
-    txData[4] = txData[4] | ((uint8_t) (txData[1]) << 6);
+    mask = (uint32_t) strtoul(argv[1], NULL, 0);
+    if (argc > 2) {
+        samples = (uint32_t) strtoul(argv[2], NULL, 0);
+    }
+    if (argc > 3) {
+        timer = (uint32_t) strtoul(argv[3], NULL, 0);
+    }
+    if ((samples == 0) || (samples > ADC_SCAN_CHANNEL_SAMPLES)) {
+        samples = ADC_SCAN_CHANNEL_SAMPLES;
+    }
 
-    SPI_CS_Clear();
-    if (SERCOM1_SPI_Write(&txData[4], 1)) {
+    SYS_CONSOLE_PRINT("Scanning mask 0x%04x, %u samples per channel...\r\n", (unsigned) mask, (unsigned) samples);
 
-    } else {
-        SYS_CONSOLE_MESSAGE(ESC_RED "Error initializing ADC continuous conversion!\r\n" ESC_RESETCOLOR);
+    if (!ADC_SCAN_Start(mask, 0, timer)) {
+        SYS_CONSOLE_MESSAGE(ESC_RED "Error starting the ADC scan!\r\n" ESC_RESETCOLOR);
+        return;
     }
-    while (SERCOM1_SPI_IsTransmitterBusy() == true);
-    SPI_CS_Clear();
-    
-    if (SERCOM1_SPI_Write(&txData[5], 1)) {
 
+    appData.scanMask = mask;
+    appData.scanSamples = samples;
+    appData.state = APP_STATE_SCAN;
+}
+
+//*********Demultiplex until every selected channel is filled*********//
+static void _APP_ScanTasks(void) {
+    ADC_SCAN_STATS stats;
+    const int32_t* data;
+    uint32_t channel;
+    uint32_t count;
+    uint32_t i;
+    int64_t sum;
+    int32_t mean;
+    char text[ADC_CONV_TEXT_SIZE];
+
+    (void) ADC_SCAN_Process();
+    if (ADC_SCAN_MinCountGet() < appData.scanSamples) {
+        return;
     }
-    while (SERCOM1_SPI_IsTransmitterBusy() == true);
-    SPI_CS_Clear();
-    //*********Read the ADC Continuous data*********//
-    while (ADC_IRQ) {
-        ADC_IRQ = false;
-        SPI_CS_Clear();
 
-        if (SERCOM1_SPI_Read(rxData, 3)) {
+    ADC_SCAN_Stop();
+    appData.state = APP_STATE_IDLE;
 
+    for (channel = 0; channel < ADC_SCAN_CHANNELS; channel++) {
+        if ((appData.scanMask & ADC_SCAN_CH(channel)) == 0U) {
+            continue;
         }
-        
-        ADCval[i] = ((int32_t) rxData[3]);
-        ADCval[i] = ADCval[i] | ((int32_t) (rxData[2]) << 8);
-        ADCval[i] = ADCval[i] | ((int32_t) (rxData[1]) << 16);
-
 
+        data = ADC_SCAN_ChannelGet(channel, &count);
+        sum = 0;
+        for (i = 0; i < count; i++) {
+            sum += data[i];
+        }
+        mean = (count != 0U) ? (int32_t) (sum / (int64_t) count) : 0;
+        ADC_STREAM_Samples(ADC_SCAN_CH(channel), data, count);
 
-        i++;
+        (void) ADC_CONV_Format(ADC_CONV_ToMicrovolts(channel, mean), text, sizeof (text));
+        SYS_CONSOLE_PRINT(ESC_GREEN "%-6s" ESC_RESETCOLOR " n: %u  mean: %d (%s V)\r\n", ADC_SCAN_ChannelName(channel),
+                (unsigned) count, (int) mean, text);
     }
 
-    for (i != 0; i > 1; i--) {
-        
-        SYS_CONSOLE_PRINT("Receiving: 0x%x\r\n", ADCval[i]);
-        SYS_CONSOLE_PRINT("Receiving: %d\r\n", (int) ADCval[i]);
-        if (getbit(ADCval[i], 23)) {
-            ADCval[i] = ADCval[i] | (255U << 24);
-            SYS_CONSOLE_MESSAGE("Reading a negative number -#\r\n");
-            SYS_CONSOLE_PRINT("Receiving: %x\r\n", ADCval[i]);
-            getvalue3.input_voltage = (float) ADCval[i] * ref_voltage / 8388608U;
+    ADC_STREAM_Flush();
 
-            SYS_CONSOLE_PRINT(ESC_GREEN "ADC voltage = %d.%05d V \r\n" ESC_RESETCOLOR, (int) getvalue3.input_voltage, ~(int) ((getvalue3.input_voltage - (int) getvalue3.input_voltage)*100000.0));
-        } else {
-            getvalue3.input_voltage = (float) ADCval[i] * ref_voltage / 8388608U;
+    ADC_SCAN_StatsGet(&stats);
+    SYS_CONSOLE_PRINT("Cycles: %u  Sequence errors: %u  Unexpected IDs: %u\r\n",
+            (unsigned) stats.cycles, (unsigned) stats.sequence, (unsigned) stats.unexpected);
+}
 
-            SYS_CONSOLE_PRINT(ESC_GREEN "ADC voltage = %d.%05d V \r\n" ESC_RESETCOLOR, (int) getvalue3.input_voltage, (int) ((getvalue3.input_voltage - (int) getvalue3.input_voltage)*100000.0));
-        }
+static void _APP_Commands_STOP(SYS_CMD_DEVICE_NODE* pCmdIO, int argc, char** argv) {
+    uint32_t dropped = appData.queueCount;
+
+    appData.queueCount = 0;
+
+    //*********A command byte on the SPI finishes by itself, nobody waits for it*********//
+    switch (appData.state) {
+        case APP_STATE_CONTINUOUS:
+            ADC_ACQ_Stop();
+            ADC_STREAM_Flush();
+            break;
+        case APP_STATE_SCAN:
+            ADC_SCAN_Stop();
+            ADC_STREAM_Flush();
+            break;
+        case APP_STATE_IDLE:
+            if (dropped == 0U) {
+                SYS_CONSOLE_MESSAGE("Nothing running\r\n");
+                return;
+            }
+            break;
+        default:
+            break;
+    }
 
-    }    
+    appData.state = APP_STATE_IDLE;
+    SYS_CONSOLE_PRINT(ESC_YELLOW "Stopped" ESC_RESETCOLOR ", %u queued dropped\r\n", (unsigned) dropped);
+}
 
+static void _APP_Commands_CAL(SYS_CMD_DEVICE_NODE* pCmdIO, int argc, char** argv) {
+    ADC_CONV_CAL cal;
+    uint32_t channel;
+    uint32_t gain = 1;
 
-    
-    SPI_CS_Set();
-}
+    if (argc >= 3) {
+        channel = (uint32_t) strtoul(argv[1], NULL, 0);
+        if (argc > 3) {
+            gain = (uint32_t) strtoul(argv[3], NULL, 0);
+        }
+        if ((channel >= ADC_CONV_CHANNELS) || (gain == 0)) {
+            SYS_CONSOLE_PRINT(ESC_RED "Usage: CAL [channel(0-%u) offset [gain]]\r\n" ESC_RESETCOLOR, ADC_CONV_CHANNELS - 1U);
+            return;
+        }
+        cal.offset = (int32_t) strtol(argv[2], NULL, 0);
+        cal.scale = ADC_CONV_SCALE(ADC_CONV_VREF_UV, gain);
+        (void) ADC_CONV_CalSet(channel, &cal);
+    } else if (argc != 1) {
+        SYS_CONSOLE_PRINT(ESC_RED "Usage: CAL [channel(0-%u) offset [gain]]\r\n" ESC_RESETCOLOR, ADC_CONV_CHANNELS - 1U);
+        return;
+    }
 
+    //*********Scale is uV per LSB in Q8.24*********//
+    for (channel = 0; channel < ADC_CONV_CHANNELS; channel++) {
+        (void) ADC_CONV_CalGet(channel, &cal);
+        SYS_CONSOLE_PRINT("%-6s offset: %d  scale: %d\r\n",
+                (channel == ADC_CONV_CHANNEL_MUX) ? "MUX" : ADC_SCAN_ChannelName(channel), (int) cal.offset, (int) cal.scale);
+    }
+}
 
+static void _APP_Commands_DECIMATE(SYS_CMD_DEVICE_NODE* pCmdIO, int argc, char** argv) {
+    ADC_DECIM_TYPE type;
+    uint32_t ratio;
+
+    ADC_DECIM_ConfigGet(&type, &ratio);
+
+    if (argc > 1) {
+        ratio = (uint32_t) strtoul(argv[1], NULL, 0);
+        if (argc > 2) {
+            if (strncmp(argv[2], "CIC", 3) == 0) {
+                type = ADC_DECIM_TYPE_CIC;
+            } else if (strncmp(argv[2], "BOXCAR", 6) == 0) {
+                type = ADC_DECIM_TYPE_BOXCAR;
+            } else {
+                ratio = 0;
+            }
+        }
+        if (!ADC_DECIM_Configure(type, ratio)) {
+            SYS_CONSOLE_PRINT(ESC_RED "Usage: DECIMATE [ratio(1-%u)] [CIC|BOXCAR]\r\n" ESC_RESETCOLOR, ADC_DECIM_RATIO_MAX);
+            return;
+        }
+    }
 
-static void _APP_Commands_CONVERT(SYS_CMD_DEVICE_NODE* pCmdIO, int argc, char** argv) {
-    txData[1] = APP_CMD_CONVERSION;
-    SYS_CONSOLE_PRINT("Sending: 0x%x\r\n", txData[1]);
+    SYS_CONSOLE_PRINT("Decimation: %s, ratio %u%s\r\n", (type == ADC_DECIM_TYPE_CIC) ? "CIC" : "BOXCAR",
+            (unsigned) ratio, (ratio == 1U) ? " (off)" : "");
+}
 
+static void _APP_Commands_FILTER(SYS_CMD_DEVICE_NODE* pCmdIO, int argc, char** argv) {
+    static const char* const typeNames[] = {"FIR", "BIQUAD", "DCBLOCK"};
+    ADC_FILTER_STAGE_INFO info;
+    int32_t coef[MAX_CMD_ARGS];
+    uint32_t stage;
+    uint32_t i;
+    bool ok = true;
 
-    SERCOM1_SPI_CallbackRegister(&SPIEventHandler, (uintptr_t) NULL);
-    SPI_CS_Clear();
+    for (i = 2; (i < (uint32_t) argc) && (i < (2U + MAX_CMD_ARGS)); i++) {
+        coef[i - 2U] = (int32_t) strtol(argv[i], NULL, 0);
+    }
 
-    if (SERCOM1_SPI_Write(&txData[1], 1)) {
-        SYS_CONSOLE_PRINT(ESC_GREEN"Analog value converted!\r\n" ESC_RESETCOLOR);
+    //*********Coefficients are Q2.30: 1.0 = 0x40000000*********//
+    if (argc == 1) {
+        /* List only */
+    } else if (strncmp(argv[1], "CLEAR", 5) == 0) {
+        ADC_FILTER_Clear();
+    } else if ((strncmp(argv[1], "FIR", 3) == 0) && (argc == 3)) {
+        ok = ADC_FILTER_StageAdd(ADC_FILTER_TYPE_FIR, NULL, (uint32_t) coef[0]);
+    } else if ((strncmp(argv[1], "BIQUAD", 6) == 0) && (argc == (int) (2U + ADC_FILTER_BIQUAD_COEFS))) {
+        ok = ADC_FILTER_StageAdd(ADC_FILTER_TYPE_BIQUAD, coef, ADC_FILTER_BIQUAD_COEFS);
+    } else if ((strncmp(argv[1], "NOTCH", 5) == 0) && (argc == 4)) {
+        ok = ADC_FILTER_NotchDesign((uint32_t) coef[0], (uint32_t) coef[1], coef) &&
+                ADC_FILTER_StageAdd(ADC_FILTER_TYPE_BIQUAD, coef, ADC_FILTER_BIQUAD_COEFS);
+    } else if ((strncmp(argv[1], "DCBLOCK", 7) == 0) && (argc <= 3)) {
+        ok = ADC_FILTER_StageAdd(ADC_FILTER_TYPE_DCBLOCK, (argc == 3) ? coef : NULL, ADC_FILTER_DCBLOCK_COEFS);
+    } else if ((strncmp(argv[1], "COEF", 4) == 0) && (argc >= 5)) {
+        ok = ADC_FILTER_CoefSet((uint32_t) coef[0], (uint32_t) coef[1], &coef[2], (uint32_t) argc - 4U);
     } else {
-        SYS_CONSOLE_PRINT(ESC_RED "Error initializing ADC conversion!\r\n" ESC_RESETCOLOR);
-        exit(0);
+        ok = false;
     }
 
-    while (SERCOM1_SPI_IsTransmitterBusy() == true);
+    if (!ok) {
+        SYS_CONSOLE_MESSAGE(ESC_RED "Usage: FILTER [CLEAR | FIR <taps> | BIQUAD <b0 b1 b2 a1 a2> | NOTCH <hz> <rate> |\r\n"
+                "               DCBLOCK [pole] | COEF <stage> <index> <c...>]\r\n" ESC_RESETCOLOR);
+        return;
+    }
 
+    for (stage = 0; ADC_FILTER_StageGet(stage, &info); stage++) {
+        SYS_CONSOLE_PRINT(ESC_GREEN "%u: %-7s" ESC_RESETCOLOR " cycles/sample: %u\r\n", (unsigned) stage,
+                typeNames[info.type], (info.samples != 0U) ? (unsigned) (info.cycles / info.samples) : 0U);
+        for (i = 0; i < info.count; i++) {
+            SYS_CONSOLE_PRINT(" %d", (int) info.coef[i]);
+        }
+        SYS_CONSOLE_MESSAGE("\r\n");
+    }
 }
 
-static void _APP_Commands_STANDBY(SYS_CMD_DEVICE_NODE* pCmdIO, int argc, char** argv) {
-    txData[1] = APP_CMD_STANDBY;
-    SYS_CONSOLE_PRINT("Sending: 0x%x\r\n", txData[1]);
+static void _APP_Commands_RATE(SYS_CMD_DEVICE_NODE* pCmdIO, int argc, char** argv) {
+    MCP3564_RATE setting;
+    uint32_t rate = 0;
+    uint32_t scale = 1000;
+    unsigned long value;
+    char* p;
 
+    if (_APP_Defer(_APP_Commands_RATE, pCmdIO, argc, argv)) {
+        return;
+    }
 
-    SERCOM1_SPI_CallbackRegister(&SPIEventHandler, (uintptr_t) NULL);
-    SPI_CS_Clear();
+    if (argc > 1) {
+        //*********sps with up to 3 decimals, in milli-sps*********//
+        value = strtoul(argv[1], &p, 10);
+        if ((p != argv[1]) && (argv[1][0] != '-') && (value <= (UINT32_MAX / 1000U))) {
+            rate = (uint32_t) value * 1000U;
+            if (*p == '.') {
+                for (p++; (*p >= '0') && (*p <= '9') && (scale > 1U); p++) {
+                    scale /= 10U;
+                    rate += (uint32_t) (*p - '0') * scale;
+                }
+            }
+        }
 
-    if (SERCOM1_SPI_Write(&txData[1], 1)) {
-        SYS_CONSOLE_PRINT(ESC_YELLOW "ADC going in standby...\r\n" ESC_RESETCOLOR);
-    } else {
-        SYS_CONSOLE_PRINT(ESC_RED "Error initializing ADC conversion!\r\n" ESC_RESETCOLOR);
-        exit(0);
+        //*********Whole argument, no wrap: anything else would set a rate nobody asked for*********//
+        if ((rate == 0U) || (*p != '\0') || !MCP3564_RATE_Find(rate, &setting)) {
+            SYS_CONSOLE_MESSAGE(ESC_RED "Usage: RATE [sps[.fff]]\r\n" ESC_RESETCOLOR);
+            return;
+        }
+        if (!MCP3564_RATE_Apply(&setting)) {
+            SYS_CONSOLE_MESSAGE(ESC_RED "RATE: not applied (acquisition running or SPI error)\r\n" ESC_RESETCOLOR);
+            return;
+        }
+    } else if (!MCP3564_RATE_Get(&setting)) {
+        SYS_CONSOLE_MESSAGE(ESC_RED "RATE: CONFIG1 read failed\r\n" ESC_RESETCOLOR);
+        return;
     }
 
-    while (SERCOM1_SPI_IsTransmitterBusy() == true);
+    SYS_CONSOLE_PRINT("Rate: " ESC_GREEN "%u.%03u sps" ESC_RESETCOLOR, (unsigned) (setting.rate / 1000U),
+            (unsigned) (setting.rate % 1000U));
+    if (argc > 1) {
+        SYS_CONSOLE_PRINT(" (requested %u.%03u)", (unsigned) (rate / 1000U), (unsigned) (rate % 1000U));
+    }
+    SYS_CONSOLE_PRINT("\r\nMCLK: %u Hz (%s %u MHz / %u)  PRE: %u  OSR: %u\r\n", (unsigned) setting.mclkHz,
+            (setting.source == MCP3564_RATE_SOURCE_DPLL) ? "DPLL0" : "DFLL", (unsigned) (setting.sourceHz / 1000000U),
+            (unsigned) setting.mclkDiv, (unsigned) setting.pre, (unsigned) setting.osr);
+    SYS_CONSOLE_PRINT("ENOB: %u.%u bits (data sheet, gain 1)\r\n", (unsigned) (setting.enob / 10U),
+            (unsigned) (setting.enob % 10U));
+}
 
+static void _APP_Commands_STREAM(SYS_CMD_DEVICE_NODE* pCmdIO, int argc, char** argv) {
+    ADC_STREAM_STATS stats;
+
+    if (argc > 1) {
+        if (strncmp(argv[1], "ON", 2) == 0) {
+            ADC_STREAM_Enable(true);
+        } else if (strncmp(argv[1], "OFF", 3) == 0) {
+            ADC_STREAM_Enable(false);
+        } else {
+            SYS_CONSOLE_MESSAGE(ESC_RED "Usage: STREAM [ON|OFF]\r\n" ESC_RESETCOLOR);
+            return;
+        }
+    }
+
+    //*********Frame: A5 5A seq(2) mask(4) n(2) n x int24 crc16, little endian*********//
+    ADC_STREAM_StatsGet(&stats);
+    SYS_CONSOLE_PRINT("Stream: %s  Frames: %u  Samples: %u  Bytes: %u  Dropped: %u  Clipped: %u\r\n",
+            ADC_STREAM_IsEnabled() ? "ON" : "OFF", (unsigned) stats.frames, (unsigned) stats.samples,
+            (unsigned) stats.bytes, (unsigned) stats.dropped, (unsigned) stats.clipped);
 }
 
-static void _APP_Commands_SHUTDOWN(SYS_CMD_DEVICE_NODE* pCmdIO, int argc, char** argv) {
-    txData[1] = APP_CMD_SHUTDOWN;
-    SYS_CONSOLE_PRINT("Sending: 0x%x\r\n", txData[1]);
+static void _APP_Commands_CRC(SYS_CMD_DEVICE_NODE* pCmdIO, int argc, char** argv) {
+    ADC_ACQ_STATS stats;
+    bool enable;
 
+    if (argc > 1) {
+        if (strncmp(argv[1], "ON", 2) == 0) {
+            enable = true;
+        } else if (strncmp(argv[1], "OFF", 3) == 0) {
+            enable = false;
+        } else {
+            SYS_CONSOLE_MESSAGE(ESC_RED "Usage: CRC [ON|OFF]\r\n" ESC_RESETCOLOR);
+            return;
+        }
+        if (!ADC_ACQ_CrcEnable(enable)) {
+            SYS_CONSOLE_MESSAGE(ESC_RED "Acquisition running!\r\n" ESC_RESETCOLOR);
+            return;
+        }
+    }
 
-    SERCOM1_SPI_CallbackRegister(&SPIEventHandler, (uintptr_t) NULL);
-    SPI_CS_Clear();
+    //*********Counted from the last CONTINUOUS start*********//
+    ADC_ACQ_StatsGet(&stats);
+    SYS_CONSOLE_PRINT("CRC: %s  errors: %u of %u reads\r\n", ADC_ACQ_CrcIsEnabled() ? "ON" : "OFF",
+            (unsigned) stats.crcErrors, (unsigned) stats.samples);
+}
 
-    if (SERCOM1_SPI_Write(&txData[1], 1)) {
-        SYS_CONSOLE_PRINT(ESC_YELLOW"ADC shutting down...\r\n" ESC_RESETCOLOR);
-    } else {
-        SYS_CONSOLE_PRINT(ESC_RED "Error initializing ADC conversion!\r\n" ESC_RESETCOLOR);
-        exit(0);
+//*********Fast commands: the byte is queued here, APP_Tasks reports it sent*********//
+static void _APP_FastCommand(uint8_t command) {
+    SYS_CONSOLE_PRINT("Sending: 0x%x\r\n", command);
+
+    if (!ADC_ACQ_CommandStart(command, 0)) {
+        SYS_CONSOLE_PRINT(ESC_RED "Error sending the fast command!\r\n" ESC_RESETCOLOR);
+        return;
     }
 
-    while (SERCOM1_SPI_IsTransmitterBusy() == true);
+    appData.fastCommand = command;
+    appData.state = APP_STATE_FAST_COMMAND_WAIT;
 }
 
-static void _APP_Commands_DEFAULT(SYS_CMD_DEVICE_NODE* pCmdIO, int argc, char** argv) {
-    txData[1] = APP_CMD_DEFAULT;
-    SYS_CONSOLE_PRINT("Sending: 0x%x\r\n", txData[1]);
+static void _APP_FastCommandDone(void) {
+    switch (appData.fastCommand) {
+        case APP_CMD_CONVERSION:
+            SYS_CONSOLE_PRINT(ESC_GREEN"Analog value converted!\r\n" ESC_RESETCOLOR);
+            break;
+        case APP_CMD_STANDBY:
+            SYS_CONSOLE_PRINT(ESC_YELLOW "ADC going in standby...\r\n" ESC_RESETCOLOR);
+            break;
+        case APP_CMD_SHUTDOWN:
+            SYS_CONSOLE_PRINT(ESC_YELLOW"ADC shutting down...\r\n" ESC_RESETCOLOR);
+            break;
+        case APP_CMD_DEFAULT:
+            SYS_CONSOLE_MESSAGE("Device full reset...\r\n");
+            //*********All registers are back at their defaults*********//
+            MCP3564_CACHE_Invalidate();
+            break;
+        default:
+            break;
+    }
+}
 
+static void _APP_Commands_CONVERT(SYS_CMD_DEVICE_NODE* pCmdIO, int argc, char** argv) {
+    if (_APP_Defer(_APP_Commands_CONVERT, pCmdIO, argc, argv)) {
+        return;
+    }
+    _APP_FastCommand(APP_CMD_CONVERSION);
+}
 
-    SERCOM1_SPI_CallbackRegister(&SPIEventHandler, (uintptr_t) NULL);
-    SPI_CS_Clear();
+static void _APP_Commands_STANDBY(SYS_CMD_DEVICE_NODE* pCmdIO, int argc, char** argv) {
+    if (_APP_Defer(_APP_Commands_STANDBY, pCmdIO, argc, argv)) {
+        return;
+    }
+    _APP_FastCommand(APP_CMD_STANDBY);
+}
 
-    if (SERCOM1_SPI_Write(&txData[1], 1)) {
-        SYS_CONSOLE_MESSAGE("Device full reset...\r\n");
-    } else {
-        SYS_CONSOLE_MESSAGE(ESC_YELLOW"Error initializing ADC single-shot!\r\n"ESC_RESETCOLOR);
-        exit(0);
+static void _APP_Commands_SHUTDOWN(SYS_CMD_DEVICE_NODE* pCmdIO, int argc, char** argv) {
+    if (_APP_Defer(_APP_Commands_SHUTDOWN, pCmdIO, argc, argv)) {
+        return;
     }
+    _APP_FastCommand(APP_CMD_SHUTDOWN);
+}
 
-    while (SERCOM1_SPI_IsTransmitterBusy() == true);
+static void _APP_Commands_DEFAULT(SYS_CMD_DEVICE_NODE* pCmdIO, int argc, char** argv) {
+    if (_APP_Defer(_APP_Commands_DEFAULT, pCmdIO, argc, argv)) {
+        return;
+    }
+    _APP_FastCommand(APP_CMD_DEFAULT);
 }
 
 void _APP_Commands_about(SYS_CMD_DEVICE_NODE* pCmdIO, int argc, char** argv) {
@@ -916,141 +1380,139 @@ void _APP_Commands_about(SYS_CMD_DEVICE_NODE* pCmdIO, int argc, char** argv) {
 
 
 
-//----------------------Math / conversion----------------------// 
-
-int getbit(int w, unsigned j) {
-    return ((w & MASK(j)) == 0) ? 0 : 1;
-}
-
-
-
-/******************************************************************************/
-
-
-
-
-//----------------------SPI state-machine----------------------// 
-
-void SPIEventHandler(uintptr_t context) {
-    isTransferDone = true;
+//----------------------ADC command state-machine----------------------// 
 
-    /* De-assert the CS line */
+//*********Run the oldest queued command, it may start a longer operation*********//
+static void _APP_QueueRun(void) {
+    APP_REQUEST* request = &appData.queue[appData.queueHead];
 
-    SPI_CS_Set();
+    appData.queueHead = (appData.queueHead + 1U) % APP_QUEUE_DEPTH;
+    appData.queueCount--;
 
+    appData.deferred = true;
+    request->function(request->pCmdIO, request->argc, request->argv);
+    appData.deferred = false;
 }
 
 void APP_Tasks(void) {
-    struct ADCvariable getvalue1;
-
-    while (ADCcycle == true) {
-
-        /* Check the application's current state. */
-        switch (appData.state) {
-                /* Application's initial state. */
-            case APP_STATE_INITIALIZE:
-
-                SERCOM1_SPI_CallbackRegister(&SPIEventHandler, (uintptr_t) NULL);
-                appData.state = APP_STATE_WRITE_DATA;
-
+    ADC_ACQ_COMMAND_STATUS status;
+    uint8_t response[4];
+
+    /* Check the application's current state. */
+    switch (appData.state) {
+            /* Application's initial state. */
+        case APP_STATE_INITIALIZE:
+            appData.state = APP_STATE_IDLE;
+            break;
+
+        case APP_STATE_IDLE:
+            if (appData.queueCount == 0U) {
                 break;
+            }
 
+            _APP_QueueRun();
+            break;
 
-                /* TODO: implement your application state machine.*/
-
-            case APP_STATE_TRANSFER_COMPLETE_WAIT:
-
-                if (isTransferDone == true) {
-                    isTransferDone = false;
-                    /* Wait for the SPI slave to become ready before sending next commands */
-                    while (SERCOM1_SPI_IsBusy() == true);
-                    appData.state = nextState;
-                }
+        case APP_STATE_FAST_COMMAND_WAIT:
+            status = ADC_ACQ_CommandStatusGet(NULL);
+            if (status == ADC_ACQ_COMMAND_PENDING) {
                 break;
+            }
+            if (status == ADC_ACQ_COMMAND_DONE) {
+                _APP_FastCommandDone();
+            } else {
+                SYS_CONSOLE_MESSAGE(ESC_RED "Error sending the fast command!\r\n" ESC_RESETCOLOR);
+            }
+            appData.state = APP_STATE_IDLE;
+            break;
 
-
-            case APP_STATE_WRITE_DATA:
-                configwrite = false;
-                //while (SERCOM1_SPI_IsTransmitterBusy() == true);
-                txData[0] = ("%x", *APP_Register_Buffer);
-                txData[1] = ("%x", *APP_Config_Buffer);
-                txData[2] = APP_CMD_READ;
-
-
-
-                SPI_CS_Clear();
-                if (SERCOM1_SPI_Write(&txData[0], sizeof (txData[0]))) {
-
-                } else {
-                    SPI_CS_Clear();
-
-                }
-                if (SERCOM1_SPI_Write(&txData[2], sizeof (txData[2]))) {
-                    appData.state = APP_STATE_TRANSFER_COMPLETE_WAIT;
-                    nextState = APP_STATE_SEND_READ_DATA_CMD;
-                } else {
-
-                }
-                configwrite = true;
+        case APP_STATE_SINGLE_CONVERT:
+            status = ADC_ACQ_CommandStatusGet(NULL);
+            if (status == ADC_ACQ_COMMAND_PENDING) {
                 break;
-
-            case APP_STATE_SEND_READ_DATA_CMD:
-                txData[1] = APP_CMD_DEVICE;
-                txData[2] = APP_CMD_CONFIG0;
-                txData[3] = APP_CMD_READ;
-
-                txData[3] = ((uint8_t) txData[2]);
-                txData[3] = txData[3] | ((uint8_t) (txData[1]) << 2);
-                txData[3] = txData[3] | ((uint8_t) (txData[0]) << 6);
-                SYS_CONSOLE_PRINT("Sending: 0x%x\r\n", (uint8_t) txData[3]);
-                SPI_CS_Clear();
-                SERCOM1_SPI_WriteRead(txData[3], 1, rxData, 4);
-                appData.state = APP_STATE_TRANSFER_COMPLETE_WAIT;
-                nextState = APP_STATE_VERIFY;
+            }
+            if (status == ADC_ACQ_COMMAND_ERROR) {
+                SYS_CONSOLE_MESSAGE(ESC_RED "Error initializing ADC single-shot!\r\n" ESC_RESETCOLOR);
+                appData.state = APP_STATE_IDLE;
                 break;
-
-            case APP_STATE_READ_DATA:
-                SPI_CS_Clear();
-                SERCOM1_SPI_WriteRead(NULL, 0, rxData, 4);
-                appData.state = APP_STATE_TRANSFER_COMPLETE_WAIT;
-                nextState = APP_STATE_VERIFY;
+            }
+            SYS_CONSOLE_PRINT("Sending: 0x%x\r\n", APP_ADC_READ_ADCDATA);
+            SYS_CONSOLE_MESSAGE("Reading single-shot conversion...\r\n");
+            appData.timePoll = SYS_TIME_CounterGet();
+            _APP_WakeAfter(APP_SINGLE_POLL_MS);
+            appData.state = APP_STATE_SINGLE_WAIT;
+            break;
+
+        case APP_STATE_SINGLE_WAIT:
+            if ((SYS_TIME_CounterGet() - appData.timePoll) < SYS_TIME_MSToCount(APP_SINGLE_POLL_MS)) {
                 break;
+            }
+            if (!ADC_ACQ_CommandStart(APP_ADC_READ_ADCDATA, 3)) {
+                SYS_CONSOLE_MESSAGE(ESC_RED "Error reading the single-shot conversion!\r\n" ESC_RESETCOLOR);
+                appData.state = APP_STATE_IDLE;
+                break;
+            }
+            appData.state = APP_STATE_SINGLE_READ;
+            break;
 
-            case APP_STATE_VERIFY:
-
-                if (true) {
-                    ADCval[2] = ((uint32_t) rxData[3]);
-                    ADCval[2] = ADCval[2] | ((uint32_t) (rxData[2]) << 8);
-                    ADCval[2] = ADCval[2] | ((uint32_t) (rxData[1]) << 16);
-
-                    SYS_CONSOLE_PRINT("Return value: 0x%x\r\n", ADCval[2]);
-                    //getvalue1.adc_count = *APP_Register_Buffer;
-                    getvalue1.input_voltage = (float) ADCval[2] * ref_voltage / 8388608U;
-
-                    SYS_CONSOLE_PRINT("ADC conversion:(" __DATE__ " " __TIME__ ") = %d.%02d V \r\n", (int) getvalue1.input_voltage, (int) ((getvalue1.input_voltage - (int) getvalue1.input_voltage)*100.0));
+        case APP_STATE_SINGLE_READ:
+            status = ADC_ACQ_CommandStatusGet(response);
+            if (status == ADC_ACQ_COMMAND_PENDING) {
+                break;
+            }
+            if (status == ADC_ACQ_COMMAND_ERROR) {
+                SYS_CONSOLE_MESSAGE(ESC_RED "Error reading the single-shot conversion!\r\n" ESC_RESETCOLOR);
+                appData.state = APP_STATE_IDLE;
+                break;
+            }
 
-                    SYS_CONSOLE_MESSAGE("ADC going into SleepMode state! \r\n");
-                    appData.state = APP_STATE_ERROR;
+            //*********Conversion not done yet: poll again, up to the timeout*********//
+            if ((response[0] & APP_STATUS_DR_MASK) != 0U) {
+                appData.timePoll = SYS_TIME_CounterGet();
+                if ((appData.timePoll - appData.timeStart) >= SYS_TIME_MSToCount(APP_SINGLE_TIMEOUT_MS)) {
+                    SYS_CONSOLE_MESSAGE(ESC_RED "No single-shot result, data ready timed out!\r\n" ESC_RESETCOLOR);
+                    appData.state = APP_STATE_IDLE;
                 } else {
-                    appData.state = APP_STATE_ERROR;
-                    ADCcycle = false;
+                    _APP_WakeAfter(APP_SINGLE_POLL_MS);
+                    appData.state = APP_STATE_SINGLE_WAIT;
                 }
                 break;
+            }
 
-            case APP_STATE_ERROR:
-                ADCcycle = false;
-                break;
+            _APP_SingleReport(&response[1]);
+            appData.state = APP_STATE_IDLE;
+            break;
 
-                /* The default state should never be executed. */
-            default:
-            {
-                /* TODO: Handle error in application's state machine. */
-                break;
+        case APP_STATE_CONTINUOUS:
+            _APP_ContinuousTasks();
+
+            //*********SNAPSHOT does not wait for the stream, its read goes between two ADCDATA reads*********//
+            if ((appData.state == APP_STATE_CONTINUOUS) && (appData.queueCount != 0U) &&
+                    (appData.queue[appData.queueHead].function == _APP_Commands_SNAPSHOT)) {
+                _APP_QueueRun();
             }
-        }
+            break;
+
+        case APP_STATE_SCAN:
+            _APP_ScanTasks();
+            break;
+
+            /* The default state should never be executed. */
+        default:
+            appData.state = APP_STATE_IDLE;
+            break;
+    }
+
+    //*********Interrupts and timers wake the states that wait; the next queued command needs a pass*********//
+    if ((appData.state == APP_STATE_IDLE) && (appData.queueCount != 0U)) {
+        APP_SCHED_Signal(sysTaskApp);
     }
 }
 
+bool APP_IsBusy(void) {
+    return (appData.state != APP_STATE_IDLE) || (appData.queueCount != 0U);
+}
+
 //static const SYS_CMD_DESCRIPTOR test;
 
 
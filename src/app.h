@@ -39,6 +39,9 @@
 #include "peripheral/port/plib_port.h"
 #include "peripheral/rtc/plib_rtc.h"
 #include "peripheral/eic/plib_eic.h"
+#include "adc_acq.h"
+#include "app_perf.h"
+#include "app_trace.h"
 
 
 
@@ -86,20 +89,95 @@ extern "C" {
 extern char APP_Register_Buffer[MAX_REG_SIZE];
 extern char APP_Config_Buffer[MAX_CONFIG_SIZE];
 
+/* ADC commands waiting behind the one running */
+#define APP_QUEUE_DEPTH                     4U
+
+/* A TRACE or PERFHIST dump waiting for the console UART goes on once this
+   much of its transmit ring is free */
+#define APP_DUMP_ROOM                       256U
+
 typedef enum
 {
     /* Application's state machine's initial state. */
     APP_STATE_INITIALIZE,
-    APP_STATE_TRANSFER_COMPLETE_WAIT,    
-    APP_STATE_WRITE_DATA,        
-    APP_STATE_SEND_READ_DATA_CMD,
-    APP_STATE_READ_DATA,
-    APP_STATE_VERIFY,
-    APP_STATE_ERROR,
-    /* TODO: Define states used by the application state machine. */
+
+    /* No ADC operation running, the next queued command starts here */
+    APP_STATE_IDLE,
+
+    /* Fast command byte queued on the SPI driver */
+    APP_STATE_FAST_COMMAND_WAIT,
+
+    /* SINGLE: conversion start sent / waiting to poll / ADCDATA read queued */
+    APP_STATE_SINGLE_CONVERT,
+    APP_STATE_SINGLE_WAIT,
+    APP_STATE_SINGLE_READ,
+
+    /* Acquisition running, one FIFO chunk per pass */
+    APP_STATE_CONTINUOUS,
+    APP_STATE_SCAN,
 
 } APP_STATES;
 
+/* A console command deferred to APP_Tasks, with its own copy of the line */
+typedef struct
+{
+    SYS_CMD_FNC function;
+    SYS_CMD_DEVICE_NODE* pCmdIO;
+    int argc;
+    char* argv[MAX_CMD_ARGS];
+    char line[SYS_CMD_MAX_LENGTH + 1];
+
+} APP_REQUEST;
+
+/* CONTINUOUS in progress */
+typedef struct
+{
+    uint32_t target;
+    uint32_t samples;
+    uint32_t outputs;
+    int64_t sum;
+    int32_t min;
+    int32_t max;
+    bool stamped;
+    ADC_ACQ_STAMP first;
+    ADC_ACQ_STAMP last;
+
+} APP_CONTINUOUS;
+
+/* Console dump written by APP_DumpTasks */
+typedef enum
+{
+    APP_DUMP_NONE = 0,
+    APP_DUMP_TRACE,
+    APP_DUMP_TRACE_BIN,
+    APP_DUMP_PERFHIST,
+
+} APP_DUMP_KIND;
+
+typedef struct
+{
+    APP_DUMP_KIND kind;
+
+    /* Next trace record or histogram bin, and the end */
+    uint32_t index;
+    uint32_t end;
+
+    /* TRACE: records asked for, stamps of the first and the previous line,
+       recording before the dump */
+    uint32_t count;
+    uint32_t first;
+    uint32_t last;
+    bool any;
+    bool enabled;
+    APP_TRACE_DUMP bin;
+
+    /* PERFHIST: the region's statistics when the command ran */
+    APP_PERF_REGION region;
+    APP_PERF_STATS stats;
+    uint32_t peak;
+
+} APP_DUMP;
+
 struct ADCvariable {
     uint16_t adc_count;
     float input_voltage;
@@ -126,7 +204,24 @@ typedef struct
     /* The application's current state */
     APP_STATES state;
 
-    /* TODO: Define any additional data used by the application. */
+    /* Commands queued by the console, oldest at queueHead */
+    APP_REQUEST queue[APP_QUEUE_DEPTH];
+    uint32_t queueHead;
+    uint32_t queueCount;
+
+    /* Set while APP_Tasks runs a queued command */
+    bool deferred;
+
+    /* The running operation */
+    uint8_t fastCommand;
+    uint32_t timeStart;
+    uint32_t timePoll;
+    uint32_t scanMask;
+    uint32_t scanSamples;
+    APP_CONTINUOUS continuous;
+
+    /* TRACE or PERFHIST output still to write */
+    APP_DUMP dump;
 
 } APP_DATA;
 
@@ -180,13 +275,10 @@ typedef struct
 
 void APP_SPICallBack(uintptr_t contextHandle);
 
-void SPIEventHandler(uintptr_t context);
-
 void APP_Initialize ( void );
 
 void ADC_cmd_READ();
 bool APP_AddCommandFunction();
-static void rtcEventHandler (RTC_TIMER32_INT_MASK intCause, uintptr_t context);
 
 
 /*******************************************************************************
@@ -221,6 +313,35 @@ static void rtcEventHandler (RTC_TIMER32_INT_MASK intCause, uintptr_t context);
 
 void APP_Tasks( void );
 
+/*******************************************************************************
+  Function:
+    bool APP_IsBusy ( void )
+
+  Summary:
+    Returns true while an ADC command runs or waits in the queue.
+*/
+
+bool APP_IsBusy( void );
+
+/*******************************************************************************
+  Function:
+    bool APP_DumpTasks ( void )
+
+  Summary:
+    Writes the next chunk of a TRACE or PERFHIST dump.
+
+  Description:
+    As many lines as the console transmit ring has room for, without
+    waiting for it to drain. Returns true while the dump has more to
+    write; the caller runs it again once APP_DUMP_ROOM bytes are free.
+
+  Remarks:
+    Called from the COMMAND task ahead of the command processor, so the
+    next command line is read after the dump.
+*/
+
+bool APP_DumpTasks( void );
+
 //DOM-IGNORE-BEGIN
 #ifdef __cplusplus
 }
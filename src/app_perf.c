@@ -0,0 +1,119 @@
+/*******************************************************************************
+  Hot Path Profiler Source File
+
+  File Name:
+    app_perf.c
+
+  Summary:
+    Per region timing statistics on the DWT cycle counter.
+
+  Description:
+    Recording is inline in app_perf.h; this file holds the statistics and
+    what the PERF commands need to read them back.
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <string.h>
+#include "definitions.h"
+#include "app_perf.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+#if defined(__ARM_ARCH_7EM__)
+#define APP_PERF_FREQUENCY_HZ               CPU_CLOCK_FREQUENCY
+#else
+#define APP_PERF_FREQUENCY_HZ               1000000000U
+#endif
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data
+// *****************************************************************************
+// *****************************************************************************
+
+APP_PERF_STATS appPerfStats[APP_PERF_REGIONS];
+
+static const char* const appPerfNames[APP_PERF_REGIONS] =
+{
+    [APP_PERF_REGION_COMMAND] = "COMMAND",
+    [APP_PERF_REGION_SPI]     = "SPI",
+    [APP_PERF_REGION_DECODE]  = "DECODE",
+    [APP_PERF_REGION_FILTER]  = "FILTER",
+    [APP_PERF_REGION_FORMAT]  = "FORMAT",
+    [APP_PERF_REGION_WRITE]   = "WRITE",
+};
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+void APP_PERF_Initialize(void)
+{
+#if defined(__ARM_ARCH_7EM__)
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+
+    APP_PERF_Reset();
+}
+
+void APP_PERF_Reset(void)
+{
+    uint32_t region;
+
+    (void) memset(appPerfStats, 0, sizeof(appPerfStats));
+
+    for (region = 0U; region < (uint32_t) APP_PERF_REGIONS; region++)
+    {
+        appPerfStats[region].min = UINT32_MAX;
+    }
+}
+
+const char* APP_PERF_NameGet(APP_PERF_REGION region)
+{
+    return ((uint32_t) region < (uint32_t) APP_PERF_REGIONS) ? appPerfNames[region] : NULL;
+}
+
+APP_PERF_REGION APP_PERF_Parse(const char* name)
+{
+    uint32_t region;
+
+    for (region = 0U; region < (uint32_t) APP_PERF_REGIONS; region++)
+    {
+        if (strcmp(name, appPerfNames[region]) == 0)
+        {
+            break;
+        }
+    }
+
+    return (APP_PERF_REGION) region;
+}
+
+void APP_PERF_StatsGet(APP_PERF_REGION region, APP_PERF_STATS* stats)
+{
+    __disable_irq();
+    *stats = appPerfStats[region];
+    __enable_irq();
+}
+
+uint32_t APP_PERF_TicksToNs(uint64_t ticks)
+{
+    uint64_t ns = (ticks * 1000U) / (APP_PERF_FREQUENCY_HZ / 1000000U);
+
+    return (ns > UINT32_MAX) ? UINT32_MAX : (uint32_t) ns;
+}
+
+/*******************************************************************************
+ End of File
+ */
@@ -0,0 +1,202 @@
+/*******************************************************************************
+  Hot Path Profiler Header File
+
+  File Name:
+    app_perf.h
+
+  Summary:
+    Per region timing statistics on the DWT cycle counter.
+
+  Description:
+    A region is timed by bracketing it in the same function:
+
+        APP_PERF_BEGIN(start);
+        ...
+        APP_PERF_END(APP_PERF_REGION_SPI, start);
+
+    Each region keeps its count, min, max and sum, and a histogram with one
+    bin per power of two of the duration. On the target the time base is
+    DWT->CYCCNT (CPU clock); on a host build, CLOCK_MONOTONIC in ns, so the
+    simulation image measures its own host time, not simulated time.
+
+    Recording is inline: two counter reads, a CLZ and a handful of adds
+    and compares. Regions are recorded from thread level only; an
+    interrupt taken inside a region counts towards it. With
+    APP_PERF_ENABLE 0 the macros expand to nothing.
+*******************************************************************************/
+
+#ifndef _APP_PERF_H
+#define _APP_PERF_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#if defined(__ARM_ARCH_7EM__)
+#include "device.h"
+#else
+#include <time.h>
+#endif
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+extern "C" {
+
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Constants
+// *****************************************************************************
+// *****************************************************************************
+
+#ifndef APP_PERF_ENABLE
+#define APP_PERF_ENABLE                     1
+#endif
+
+/* Bin b holds durations of 2^b to 2^(b+1) - 1 ticks (bin 0 also 0) */
+#define APP_PERF_BINS                       32U
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Data Types
+// *****************************************************************************
+// *****************************************************************************
+
+typedef enum
+{
+    /* A console command, from dispatch to return */
+    APP_PERF_REGION_COMMAND = 0,
+
+    /* Blocking wait for an SPI transfer to the MCP3564 */
+    APP_PERF_REGION_SPI,
+
+    /* ADC_DECODE_Block32 of a CONTINUOUS chunk */
+    APP_PERF_REGION_DECODE,
+
+    /* ADC_FILTER_Process of a CONTINUOUS chunk */
+    APP_PERF_REGION_FILTER,
+
+    /* vsnprintf of SYS_CONSOLE_Print */
+    APP_PERF_REGION_FORMAT,
+
+    /* Console write, including waiting for room in the UART ring */
+    APP_PERF_REGION_WRITE,
+
+    APP_PERF_REGIONS
+
+} APP_PERF_REGION;
+
+typedef struct
+{
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint64_t sum;
+    uint32_t bins[APP_PERF_BINS];
+
+} APP_PERF_STATS;
+
+// DOM-IGNORE-BEGIN
+extern APP_PERF_STATS appPerfStats[APP_PERF_REGIONS];
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+/* Current tick of the profiler time base */
+static inline uint32_t APP_PERF_Now(void)
+{
+#if defined(__ARM_ARCH_7EM__)
+    return DWT->CYCCNT;
+#else
+    struct timespec now;
+
+    (void) clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (uint32_t) (((uint64_t) now.tv_sec * 1000000000U) + (uint64_t) now.tv_nsec);
+#endif
+}
+
+static inline void APP_PERF_Record(APP_PERF_REGION region, uint32_t ticks)
+{
+    APP_PERF_STATS* stats = &appPerfStats[region];
+
+    stats->count++;
+    stats->sum += ticks;
+    if (ticks < stats->min)
+    {
+        stats->min = ticks;
+    }
+    if (ticks > stats->max)
+    {
+        stats->max = ticks;
+    }
+    stats->bins[31U - (uint32_t) __builtin_clz(ticks | 1U)]++;
+}
+
+#if APP_PERF_ENABLE
+#define APP_PERF_BEGIN(start)               uint32_t start = APP_PERF_Now()
+#define APP_PERF_END(region, start)         APP_PERF_Record((region), APP_PERF_Now() - (start))
+#else
+#define APP_PERF_BEGIN(start)
+#define APP_PERF_END(region, start)
+#endif
+
+/*******************************************************************************
+  Function:
+    void APP_PERF_Initialize ( void )
+
+  Summary:
+    Starts the cycle counter and clears the statistics.
+*/
+
+void APP_PERF_Initialize ( void );
+
+/* Clears the statistics of every region */
+void APP_PERF_Reset ( void );
+
+/* Region name for the console, NULL past the last region */
+const char* APP_PERF_NameGet ( APP_PERF_REGION region );
+
+/* Region by name (as APP_PERF_NameGet), APP_PERF_REGIONS if unknown */
+APP_PERF_REGION APP_PERF_Parse ( const char* name );
+
+/*******************************************************************************
+  Function:
+    void APP_PERF_StatsGet ( APP_PERF_REGION region, APP_PERF_STATS* stats )
+
+  Summary:
+    Copies the statistics of a region.
+
+  Description:
+    Taken with interrupts off so a region is seen as a whole; min is
+    UINT32_MAX while count is 0.
+*/
+
+void APP_PERF_StatsGet ( APP_PERF_REGION region, APP_PERF_STATS* stats );
+
+/* Converts profiler ticks to ns */
+uint32_t APP_PERF_TicksToNs ( uint64_t ticks );
+
+//DOM-IGNORE-BEGIN
+#ifdef __cplusplus
+}
+#endif
+//DOM-IGNORE-END
+
+#endif /* _APP_PERF_H */
+
+/*******************************************************************************
+ End of File
+ */
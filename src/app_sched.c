@@ -0,0 +1,228 @@
+/*******************************************************************************
+  Cooperative Scheduler Source File
+
+  File Name:
+    app_sched.c
+
+  Summary:
+    Run-to-completion task scheduler behind SYS_Tasks.
+
+  Description:
+    See app_sched.h. The task table is only written at initialization,
+    the ready bits are the one piece of state shared with handlers.
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <string.h>
+#include "definitions.h"
+#include "app_perf.h"
+#include "app_sched.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+typedef struct
+{
+    APP_SCHED_FUNCTION function;
+    APP_SCHED_TASK_STATS stats;
+
+} APP_SCHED_TASK;
+
+typedef struct
+{
+    APP_SCHED_TASK task[APP_SCHED_TASKS_MAX];
+    uint32_t count;
+    APP_SCHED_STATS stats;
+
+} APP_SCHED_OBJ;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data
+// *****************************************************************************
+// *****************************************************************************
+
+volatile uint32_t appSchedReady;
+
+static APP_SCHED_OBJ appSchedObj;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+/* Highest priority task in ready, the first registered of equals */
+static uint32_t lAPP_SCHED_Best(uint32_t ready)
+{
+    uint32_t best = APP_SCHED_TASKS_MAX;
+    uint32_t task;
+
+    for (task = 0U; task < appSchedObj.count; task++)
+    {
+        if (((ready & (1UL << task)) != 0U) &&
+            ((best == APP_SCHED_TASKS_MAX) || (appSchedObj.task[task].stats.priority < appSchedObj.task[best].stats.priority)))
+        {
+            best = task;
+        }
+    }
+
+    return best;
+}
+
+static void lAPP_SCHED_Timer(uintptr_t context)
+{
+    APP_SCHED_Signal((APP_SCHED_HANDLE) context);
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+void APP_SCHED_Initialize(void)
+{
+    (void) memset(&appSchedObj, 0, sizeof(appSchedObj));
+    appSchedReady = 0U;
+}
+
+APP_SCHED_HANDLE APP_SCHED_TaskRegister(const char* name, APP_SCHED_FUNCTION function, APP_SCHED_PRIORITY priority)
+{
+    APP_SCHED_TASK* task;
+    APP_SCHED_HANDLE handle;
+
+    if ((appSchedObj.count == APP_SCHED_TASKS_MAX) || (function == NULL) || (priority >= APP_SCHED_PRIORITIES))
+    {
+        return APP_SCHED_HANDLE_INVALID;
+    }
+
+    handle = appSchedObj.count;
+    task = &appSchedObj.task[handle];
+    task->function = function;
+    task->stats.name = name;
+    task->stats.priority = priority;
+    appSchedObj.count++;
+
+    APP_SCHED_Signal(handle);
+
+    return handle;
+}
+
+bool APP_SCHED_PeriodSet(APP_SCHED_HANDLE task, uint32_t ms)
+{
+    if (task >= appSchedObj.count)
+    {
+        return false;
+    }
+
+    return (SYS_TIME_CallbackRegisterMS(lAPP_SCHED_Timer, (uintptr_t) task, ms, SYS_TIME_PERIODIC) != SYS_TIME_HANDLE_INVALID);
+}
+
+bool APP_SCHED_DelaySet(APP_SCHED_HANDLE task, uint32_t ms)
+{
+    if (task >= appSchedObj.count)
+    {
+        return false;
+    }
+
+    /* A single shot timer with a callback frees itself when it fires */
+    return (SYS_TIME_CallbackRegisterMS(lAPP_SCHED_Timer, (uintptr_t) task, ms, SYS_TIME_SINGLE) != SYS_TIME_HANDLE_INVALID);
+}
+
+void APP_SCHED_Tasks(void)
+{
+    APP_SCHED_TASK_STATS* stats;
+    uint32_t ran = 0U;
+    uint32_t ready;
+    uint32_t task;
+    uint32_t start;
+    uint32_t ticks;
+
+    appSchedObj.stats.passes++;
+
+    /* Re-read after every task: a handler may have signalled a higher one */
+    while ((ready = (appSchedReady & ~ran)) != 0U)
+    {
+        task = lAPP_SCHED_Best(ready);
+        if (task == APP_SCHED_TASKS_MAX)
+        {
+            /* Bits of unregistered tasks */
+            (void) __atomic_fetch_and(&appSchedReady, ~ready, __ATOMIC_RELAXED);
+            break;
+        }
+
+        ran |= 1UL << task;
+        (void) __atomic_fetch_and(&appSchedReady, ~(1UL << task), __ATOMIC_RELAXED);
+
+        start = APP_PERF_Now();
+        appSchedObj.task[task].function();
+        ticks = APP_PERF_Now() - start;
+
+        stats = &appSchedObj.task[task].stats;
+        stats->runs++;
+        stats->sum += ticks;
+        if (ticks > stats->max)
+        {
+            stats->max = ticks;
+        }
+    }
+
+    if (ran != 0U)
+    {
+        return;
+    }
+
+    /* A pending interrupt wakes the core with PRIMASK set and is taken at
+     * __enable_irq, after the test which it would otherwise race */
+    __disable_irq();
+    if (appSchedReady == 0U)
+    {
+        appSchedObj.stats.idle++;
+        __WFI();
+    }
+    __enable_irq();
+}
+
+bool APP_SCHED_TaskStatsGet(APP_SCHED_HANDLE task, APP_SCHED_TASK_STATS* stats)
+{
+    if (task >= appSchedObj.count)
+    {
+        return false;
+    }
+
+    *stats = appSchedObj.task[task].stats;
+
+    return true;
+}
+
+void APP_SCHED_StatsGet(APP_SCHED_STATS* stats)
+{
+    *stats = appSchedObj.stats;
+}
+
+void APP_SCHED_StatsReset(void)
+{
+    uint32_t task;
+
+    for (task = 0U; task < appSchedObj.count; task++)
+    {
+        appSchedObj.task[task].stats.runs = 0U;
+        appSchedObj.task[task].stats.max = 0U;
+        appSchedObj.task[task].stats.sum = 0U;
+    }
+
+    (void) memset(&appSchedObj.stats, 0, sizeof(appSchedObj.stats));
+}
+
+/*******************************************************************************
+ End of File
+ */
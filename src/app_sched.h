@@ -0,0 +1,183 @@
+/*******************************************************************************
+  Cooperative Scheduler Header File
+
+  File Name:
+    app_sched.h
+
+  Summary:
+    Run-to-completion task scheduler behind SYS_Tasks.
+
+  Description:
+    A task is a polled state machine function registered with a priority.
+    It only runs when its ready bit is set: by an interrupt handler or
+    callback that has work for it (APP_SCHED_Signal), by a SYS_TIME timer
+    (APP_SCHED_PeriodSet, APP_SCHED_DelaySet), or by the task itself when
+    it has to be polled again. The bit is cleared just before the task
+    runs, so a signal which comes while it runs is not lost.
+
+    APP_SCHED_Tasks is one pass: the ready tasks run highest priority
+    first, each at most once. A task signalled during the pass runs in it
+    if it has not run yet and takes its place by priority, so a lower
+    priority task never starts while a higher one is ready, and a task
+    which keeps itself ready cannot starve the ones below it. Nothing is
+    preempted: a higher priority task waits at most for the task running
+    when it was signalled.
+
+    With no task ready the pass ends in WFI, with interrupts masked
+    between the test and the sleep so a signal cannot be missed.
+*******************************************************************************/
+
+#ifndef _APP_SCHED_H
+#define _APP_SCHED_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+extern "C" {
+
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Constants
+// *****************************************************************************
+// *****************************************************************************
+
+/* Tasks which can be registered, at most 32 (one ready bit each) */
+#define APP_SCHED_TASKS_MAX                 8U
+
+#define APP_SCHED_HANDLE_INVALID            ((APP_SCHED_HANDLE) UINT32_MAX)
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Data Types
+// *****************************************************************************
+// *****************************************************************************
+
+typedef uint32_t APP_SCHED_HANDLE;
+
+typedef void (*APP_SCHED_FUNCTION)(void);
+
+typedef enum
+{
+    /* Sample processing: CONTINUOUS, SCAN, queued ADC commands */
+    APP_SCHED_PRIORITY_HIGH = 0,
+
+    /* Console command processor */
+    APP_SCHED_PRIORITY_NORMAL,
+
+    /* Background housekeeping */
+    APP_SCHED_PRIORITY_LOW,
+
+    APP_SCHED_PRIORITIES
+
+} APP_SCHED_PRIORITY;
+
+typedef struct
+{
+    const char* name;
+    APP_SCHED_PRIORITY priority;
+    uint32_t runs;
+
+    /* Run time in APP_PERF ticks */
+    uint32_t max;
+    uint64_t sum;
+
+} APP_SCHED_TASK_STATS;
+
+typedef struct
+{
+    uint32_t passes;
+
+    /* Passes with no task ready, which slept in WFI */
+    uint32_t idle;
+
+} APP_SCHED_STATS;
+
+// DOM-IGNORE-BEGIN
+extern volatile uint32_t appSchedReady;
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+/* Marks a task ready, from thread level or any handler */
+static inline void APP_SCHED_Signal(APP_SCHED_HANDLE task)
+{
+    if (task < APP_SCHED_TASKS_MAX)
+    {
+        (void) __atomic_fetch_or(&appSchedReady, 1UL << task, __ATOMIC_RELAXED);
+    }
+}
+
+/* Drops every task and clears the statistics */
+void APP_SCHED_Initialize ( void );
+
+/*******************************************************************************
+  Function:
+    APP_SCHED_HANDLE APP_SCHED_TaskRegister ( const char* name,
+        APP_SCHED_FUNCTION function, APP_SCHED_PRIORITY priority )
+
+  Summary:
+    Adds a task, ready so it runs once at the first pass.
+
+  Description:
+    Tasks of the same priority run in registration order. Returns
+    APP_SCHED_HANDLE_INVALID when APP_SCHED_TASKS_MAX are registered.
+    Call it at initialization, before SYS_Tasks runs.
+*/
+
+APP_SCHED_HANDLE APP_SCHED_TaskRegister ( const char* name, APP_SCHED_FUNCTION function, APP_SCHED_PRIORITY priority );
+
+/* Signals the task every ms milliseconds from a periodic SYS_TIME callback */
+bool APP_SCHED_PeriodSet ( APP_SCHED_HANDLE task, uint32_t ms );
+
+/* Signals the task once, ms milliseconds from now */
+bool APP_SCHED_DelaySet ( APP_SCHED_HANDLE task, uint32_t ms );
+
+/*******************************************************************************
+  Function:
+    void APP_SCHED_Tasks ( void )
+
+  Summary:
+    Runs one pass, or sleeps in WFI until the next interrupt if no task is
+    ready.
+
+  Remarks:
+    Called from SYS_Tasks.
+*/
+
+void APP_SCHED_Tasks ( void );
+
+/* Copies the statistics of a task, false past the last registered one */
+bool APP_SCHED_TaskStatsGet ( APP_SCHED_HANDLE task, APP_SCHED_TASK_STATS* stats );
+
+void APP_SCHED_StatsGet ( APP_SCHED_STATS* stats );
+
+/* Clears the run counts and times, the tasks stay registered */
+void APP_SCHED_StatsReset ( void );
+
+//DOM-IGNORE-BEGIN
+#ifdef __cplusplus
+}
+#endif
+//DOM-IGNORE-END
+
+#endif /* _APP_SCHED_H */
+
+/*******************************************************************************
+ End of File
+ */
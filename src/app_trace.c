@@ -0,0 +1,236 @@
+/*******************************************************************************
+  Event Trace Source File
+
+  File Name:
+    app_trace.c
+
+  Summary:
+    In-RAM circular trace of time stamped events, safe to write from ISRs.
+
+  Description:
+    Recording is inline in app_trace.h; this file holds the ring and what
+    the TRACE command needs to read it back. Readers pause recording while
+    they walk the ring, so a dump shows one consistent window.
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <string.h>
+#include "definitions.h"
+#include "adc_stream.h"
+#include "app_trace.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+#define APP_TRACE_INDEX_MASK                0xFFFFU
+
+/* Magic, count and clock */
+#define APP_TRACE_HEADER_SIZE               12U
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data
+// *****************************************************************************
+// *****************************************************************************
+
+volatile uint64_t appTraceRing[APP_TRACE_DEPTH];
+volatile uint32_t appTraceHead;
+volatile bool appTraceEnabled;
+
+static const char* const appTraceNames[APP_TRACE_EVENTS] =
+{
+    [APP_TRACE_NONE]          = "NONE",
+    [APP_TRACE_CS_ASSERT]     = "CS_ASSERT",
+    [APP_TRACE_CS_DEASSERT]   = "CS_DEASSERT",
+    [APP_TRACE_DMA_DONE]      = "DMA_DONE",
+    [APP_TRACE_DATA_READY]    = "DATA_READY",
+    [APP_TRACE_OVERRUN]       = "OVERRUN",
+    [APP_TRACE_UART_DRAINED]  = "UART_DRAINED",
+    [APP_TRACE_CMD_START]     = "CMD_START",
+    [APP_TRACE_CMD_END]       = "CMD_END",
+};
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+/* All or nothing, so a full UART ring cannot cut a piece of the block */
+static bool lAPP_TRACE_Write(uint8_t* data, uint32_t length)
+{
+    if (SERCOM5_USART_WriteFreeBufferCountGet() < length)
+    {
+        return false;
+    }
+
+    (void) SERCOM5_USART_Write(data, length);
+
+    return true;
+}
+
+static void lAPP_TRACE_Put32(uint8_t* buffer, uint32_t value)
+{
+    buffer[0] = (uint8_t) value;
+    buffer[1] = (uint8_t) (value >> 8);
+    buffer[2] = (uint8_t) (value >> 16);
+    buffer[3] = (uint8_t) (value >> 24);
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+void APP_TRACE_Initialize(void)
+{
+#if defined(__ARM_ARCH_7EM__)
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+
+    appTraceEnabled = false;
+    APP_TRACE_Clear();
+    appTraceEnabled = true;
+}
+
+bool APP_TRACE_Enable(bool enable)
+{
+    bool previous = appTraceEnabled;
+
+    appTraceEnabled = enable;
+
+    return previous;
+}
+
+void APP_TRACE_Clear(void)
+{
+    bool enabled = APP_TRACE_Enable(false);
+
+    (void) memset((void*) appTraceRing, 0, sizeof(appTraceRing));
+    appTraceHead = 0U;
+
+    (void) APP_TRACE_Enable(enabled);
+}
+
+uint32_t APP_TRACE_HeadGet(void)
+{
+    return appTraceHead;
+}
+
+bool APP_TRACE_Get(uint32_t index, APP_TRACE_RECORD* record)
+{
+    uint64_t raw = appTraceRing[index & (APP_TRACE_DEPTH - 1U)];
+    uint32_t upper = (uint32_t) (raw >> 32);
+
+    if (((upper >> 16) != (index & APP_TRACE_INDEX_MASK)) || (((upper >> 8) & 0xFFU) == (uint32_t) APP_TRACE_NONE))
+    {
+        return false;
+    }
+
+    record->index = index;
+    record->cycles = (uint32_t) raw;
+    record->event = (APP_TRACE_EVENT) ((upper >> 8) & 0xFFU);
+    record->arg = (uint8_t) upper;
+
+    return true;
+}
+
+const char* APP_TRACE_NameGet(APP_TRACE_EVENT event)
+{
+    return ((uint32_t) event < (uint32_t) APP_TRACE_EVENTS) ? appTraceNames[event] : "?";
+}
+
+uint32_t APP_TRACE_DumpBinaryStart(APP_TRACE_DUMP* dump, uint32_t count)
+{
+    APP_TRACE_RECORD record;
+    uint32_t head;
+    uint32_t first;
+
+    dump->enabled = APP_TRACE_Enable(false);
+    head = appTraceHead;
+
+    if (count > APP_TRACE_DEPTH)
+    {
+        count = APP_TRACE_DEPTH;
+    }
+    if (count > head)
+    {
+        count = head;
+    }
+
+    /* Only the oldest records can have been overwritten */
+    for (first = head - count; (first != head) && !APP_TRACE_Get(first, &record); first++)
+    {
+    }
+
+    dump->stage = APP_TRACE_DUMP_HEADER;
+    dump->first = first;
+    dump->next = first;
+    dump->head = head;
+    dump->crc = ADC_STREAM_CRC_INIT;
+
+    return head - first;
+}
+
+bool APP_TRACE_DumpBinaryTasks(APP_TRACE_DUMP* dump)
+{
+    uint8_t buffer[APP_TRACE_HEADER_SIZE];
+    uint64_t raw;
+
+    if (dump->stage == APP_TRACE_DUMP_HEADER)
+    {
+        (void) memcpy(buffer, APP_TRACE_MAGIC, 4U);
+        lAPP_TRACE_Put32(&buffer[4], dump->head - dump->first);
+        lAPP_TRACE_Put32(&buffer[8], CPU_CLOCK_FREQUENCY);
+        if (!lAPP_TRACE_Write(buffer, APP_TRACE_HEADER_SIZE))
+        {
+            return false;
+        }
+        dump->crc = ADC_STREAM_Crc16(dump->crc, &buffer[4], APP_TRACE_HEADER_SIZE - 4U);
+        dump->stage = APP_TRACE_DUMP_RECORDS;
+    }
+
+    if (dump->stage == APP_TRACE_DUMP_RECORDS)
+    {
+        for (; dump->next != dump->head; dump->next++)
+        {
+            raw = appTraceRing[dump->next & (APP_TRACE_DEPTH - 1U)];
+            lAPP_TRACE_Put32(&buffer[0], (uint32_t) raw);
+            lAPP_TRACE_Put32(&buffer[4], (uint32_t) (raw >> 32));
+            if (!lAPP_TRACE_Write(buffer, 8U))
+            {
+                return false;
+            }
+            dump->crc = ADC_STREAM_Crc16(dump->crc, buffer, 8U);
+        }
+        dump->stage = APP_TRACE_DUMP_CRC;
+    }
+
+    if (dump->stage == APP_TRACE_DUMP_CRC)
+    {
+        buffer[0] = (uint8_t) dump->crc;
+        buffer[1] = (uint8_t) (dump->crc >> 8);
+        if (!lAPP_TRACE_Write(buffer, 2U))
+        {
+            return false;
+        }
+        (void) APP_TRACE_Enable(dump->enabled);
+        dump->stage = APP_TRACE_DUMP_DONE;
+    }
+
+    return true;
+}
+
+/*******************************************************************************
+ End of File
+ */
@@ -0,0 +1,246 @@
+/*******************************************************************************
+  Event Trace Header File
+
+  File Name:
+    app_trace.h
+
+  Summary:
+    In-RAM circular trace of time stamped events, safe to write from ISRs.
+
+  Description:
+    A record is 8 bytes, written with one 64 bit store:
+
+      bits  0-31   DWT->CYCCNT at the event (CPU clock)
+      bits 32-39   argument (DMA channel, SPI client, command character ...)
+      bits 40-47   APP_TRACE_EVENT
+      bits 48-63   low 16 bits of the record index
+
+    The writer takes its slot with an atomic increment of the head index
+    (LDREX/STREX), so thread code and handlers of any priority record
+    without locks and without masking interrupts. A handler preempting a
+    writer between its increment and its store can make two neighbouring
+    records appear out of time order; the index, not the stamp, is the
+    order of recording.
+
+    The ring keeps the last APP_TRACE_DEPTH records. A reader checks the
+    index bits of a slot: if they do not match, the record was overwritten
+    while being read. Recording costs one flag test, the increment, a
+    cycle counter read and the store; with APP_TRACE_ENABLE 0 APP_TRACE
+    expands to nothing.
+*******************************************************************************/
+
+#ifndef _APP_TRACE_H
+#define _APP_TRACE_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "device.h"
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+extern "C" {
+
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Constants
+// *****************************************************************************
+// *****************************************************************************
+
+#ifndef APP_TRACE_ENABLE
+#define APP_TRACE_ENABLE                    1
+#endif
+
+/* Records kept, a power of two */
+#define APP_TRACE_DEPTH                     1024U
+
+/* Binary dump: magic, then count, clock and records, then CRC-16 */
+#define APP_TRACE_MAGIC                     "TRC1"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Data Types
+// *****************************************************************************
+// *****************************************************************************
+
+typedef enum
+{
+    APP_TRACE_NONE = 0,
+
+    /* Chip select driven active / released by DRV_SPI, arg: client index */
+    APP_TRACE_CS_ASSERT,
+    APP_TRACE_CS_DEASSERT,
+
+    /* DRV_SPI or event mode DMAC transfer complete, arg: channel */
+    APP_TRACE_DMA_DONE,
+
+    /* MCP3564 data-ready edge taken by the EIC handler */
+    APP_TRACE_DATA_READY,
+
+    /* Data-ready with the previous read still queued, sample lost */
+    APP_TRACE_OVERRUN,
+
+    /* Console UART transmit ring ran empty */
+    APP_TRACE_UART_DRAINED,
+
+    /* Console command dispatched / returned, arg: its first character */
+    APP_TRACE_CMD_START,
+    APP_TRACE_CMD_END,
+
+    APP_TRACE_EVENTS
+
+} APP_TRACE_EVENT;
+
+typedef struct
+{
+    uint32_t index;
+    uint32_t cycles;
+    APP_TRACE_EVENT event;
+    uint8_t arg;
+
+} APP_TRACE_RECORD;
+
+/* Where a binary dump is */
+typedef enum
+{
+    APP_TRACE_DUMP_HEADER = 0,
+    APP_TRACE_DUMP_RECORDS,
+    APP_TRACE_DUMP_CRC,
+    APP_TRACE_DUMP_DONE
+
+} APP_TRACE_DUMP_STAGE;
+
+/* A binary dump in progress, records first .. head - 1 */
+typedef struct
+{
+    APP_TRACE_DUMP_STAGE stage;
+    uint32_t first;
+    uint32_t next;
+    uint32_t head;
+    uint16_t crc;
+
+    /* Recording before the dump, restored at its end */
+    bool enabled;
+
+} APP_TRACE_DUMP;
+
+// DOM-IGNORE-BEGIN
+extern volatile uint64_t appTraceRing[APP_TRACE_DEPTH];
+extern volatile uint32_t appTraceHead;
+extern volatile bool appTraceEnabled;
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+static inline void APP_TRACE_Record(APP_TRACE_EVENT event, uint8_t arg)
+{
+    uint32_t index;
+
+    if (!appTraceEnabled)
+    {
+        return;
+    }
+
+    index = __atomic_fetch_add(&appTraceHead, 1U, __ATOMIC_RELAXED);
+
+    appTraceRing[index & (APP_TRACE_DEPTH - 1U)] =
+        ((uint64_t) ((index << 16) | ((uint32_t) event << 8) | arg) << 32) | DWT->CYCCNT;
+}
+
+#if APP_TRACE_ENABLE
+#define APP_TRACE(event, arg)               APP_TRACE_Record((event), (uint8_t) (arg))
+#else
+#define APP_TRACE(event, arg)
+#endif
+
+/* The drivers' and PLIBs' events (sys_trace_hook.h, SYS_TRACE_HOOK_HEADER
+   in user.h) go into the same ring: CS_ASSERT is APP_TRACE_CS_ASSERT */
+#define SYS_TRACE_HOOK(event, arg)          APP_TRACE(APP_TRACE_##event, (arg))
+
+/* Starts the cycle counter and recording, with the ring empty */
+void APP_TRACE_Initialize ( void );
+
+/* Pauses or resumes recording, returns the previous state */
+bool APP_TRACE_Enable ( bool enable );
+
+/* Drops every record */
+void APP_TRACE_Clear ( void );
+
+/* Index the next record gets; records are index - APP_TRACE_DEPTH .. index - 1 */
+uint32_t APP_TRACE_HeadGet ( void );
+
+/*******************************************************************************
+  Function:
+    bool APP_TRACE_Get ( uint32_t index, APP_TRACE_RECORD* record )
+
+  Summary:
+    Reads the record with the given index.
+
+  Description:
+    Returns false when it is not in the ring (never written, or already
+    overwritten by a newer record).
+*/
+
+bool APP_TRACE_Get ( uint32_t index, APP_TRACE_RECORD* record );
+
+/* Event name for the text dump, "?" if unknown */
+const char* APP_TRACE_NameGet ( APP_TRACE_EVENT event );
+
+/*******************************************************************************
+  Function:
+    uint32_t APP_TRACE_DumpBinaryStart ( APP_TRACE_DUMP* dump, uint32_t count )
+
+  Summary:
+    Starts a dump of the last count records to the console UART in one
+    binary block.
+
+  Description:
+    Layout, little endian: "TRC1", uint32 record count n, uint32 cycle
+    counter frequency in Hz, n records of uint32 stamp and uint32 upper word
+    (as in the ring), CRC-16/CCITT-FALSE over everything after the magic.
+    Overwritten records are left out. Recording is paused until the dump is
+    done, so the block is one window. Writes nothing itself, see
+    APP_TRACE_DumpBinaryTasks. Returns n.
+*/
+
+uint32_t APP_TRACE_DumpBinaryStart ( APP_TRACE_DUMP* dump, uint32_t count );
+
+/*******************************************************************************
+  Function:
+    bool APP_TRACE_DumpBinaryTasks ( APP_TRACE_DUMP* dump )
+
+  Summary:
+    Writes as much of a started dump as the UART ring has room for.
+
+  Description:
+    Never waits: the header, each record and the CRC go into the ring whole
+    or are left for the next call. Returns true once the CRC is written and
+    recording is back as it was before APP_TRACE_DumpBinaryStart.
+*/
+
+bool APP_TRACE_DumpBinaryTasks ( APP_TRACE_DUMP* dump );
+
+//DOM-IGNORE-BEGIN
+#ifdef __cplusplus
+}
+#endif
+//DOM-IGNORE-END
+
+#endif /* _APP_TRACE_H */
+
+/*******************************************************************************
+ End of File
+ */
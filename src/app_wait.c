@@ -0,0 +1,133 @@
+/*******************************************************************************
+  Event Wait Source File
+
+  File Name:
+    app_wait.c
+
+  Summary:
+    Blocking waits which sleep in WFI until an interrupt, with a timeout.
+
+  Description:
+    See app_wait.h. The timeout is measured on the SYS_TIME counter; the
+    SYS_TIME delay timer only makes sure an interrupt comes at the end of
+    the wait. Without a free timer object the wait still ends at the first
+    interrupt after the timeout.
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <string.h>
+#include "definitions.h"
+#include "app_perf.h"
+#include "app_wait.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data
+// *****************************************************************************
+// *****************************************************************************
+
+static APP_WAIT_STATS appWaitStats[APP_WAIT_SITES];
+
+static const char* const appWaitNames[APP_WAIT_SITES] =
+{
+    [APP_WAIT_SPI]   = "SPI",
+    [APP_WAIT_DRAIN] = "DRAIN",
+};
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+bool APP_WAIT_Until(APP_WAIT_SITE site, APP_WAIT_CONDITION condition, uintptr_t context, uint32_t timeoutMs)
+{
+    APP_WAIT_STATS* stats = &appWaitStats[site];
+    SYS_TIME_HANDLE timer = SYS_TIME_HANDLE_INVALID;
+    uint32_t start;
+    uint32_t timeStart = 0U;
+    uint32_t ticks;
+    bool done;
+    bool armed = false;
+
+    stats->count++;
+
+    done = condition(context);
+    if (done)
+    {
+        return true;
+    }
+
+    start = APP_PERF_Now();
+
+    while (!done)
+    {
+        if (!armed)
+        {
+            timeStart = SYS_TIME_CounterGet();
+            if (SYS_TIME_DelayMS(timeoutMs, &timer) != SYS_TIME_SUCCESS)
+            {
+                timer = SYS_TIME_HANDLE_INVALID;
+            }
+            armed = true;
+        }
+        else if ((SYS_TIME_CounterGet() - timeStart) >= SYS_TIME_MSToCount(timeoutMs))
+        {
+            stats->timeouts++;
+            break;
+        }
+        else
+        {
+            /* Woken by an interrupt which was not the one waited for */
+        }
+
+        __disable_irq();
+        done = condition(context);
+        if (!done)
+        {
+            stats->sleeps++;
+            __WFI();
+        }
+        __enable_irq();
+
+        done = done || condition(context);
+    }
+
+    if ((timer != SYS_TIME_HANDLE_INVALID) && !SYS_TIME_DelayIsComplete(timer))
+    {
+        (void) SYS_TIME_TimerDestroy(timer);
+    }
+
+    ticks = APP_PERF_Now() - start;
+    stats->sum += ticks;
+    if (ticks > stats->max)
+    {
+        stats->max = ticks;
+    }
+
+    return done;
+}
+
+const char* APP_WAIT_NameGet(APP_WAIT_SITE site)
+{
+    return ((uint32_t) site < (uint32_t) APP_WAIT_SITES) ? appWaitNames[site] : NULL;
+}
+
+void APP_WAIT_StatsGet(APP_WAIT_SITE site, APP_WAIT_STATS* stats)
+{
+    *stats = appWaitStats[site];
+}
+
+void APP_WAIT_Reset(void)
+{
+    (void) memset(appWaitStats, 0, sizeof(appWaitStats));
+}
+
+/*******************************************************************************
+ End of File
+ */
@@ -0,0 +1,124 @@
+/*******************************************************************************
+  Event Wait Header File
+
+  File Name:
+    app_wait.h
+
+  Summary:
+    Blocking waits which sleep in WFI until an interrupt, with a timeout.
+
+  Description:
+    A wait is a condition function and the site that waits on it:
+
+        ok = APP_WAIT_Until(APP_WAIT_SPI, lDone, (uintptr_t) handle, 100U);
+
+    The condition is tested, and while it is false the core sleeps in WFI
+    until the next interrupt: the SPI or DMAC handler that completes a
+    transfer, the EIC data-ready edge, or the SYS_TIME timer that ends the
+    wait at the timeout. Interrupts are
+    masked between the test and the sleep, so an interrupt which makes the
+    condition true cannot be slept through.
+
+    Waits are taken at thread level only, from code that has to block
+    (driver calls made by commands). State machines do not block: their
+    scheduler task is signalled by the interrupt instead (app_sched.h).
+
+    Each site keeps its count, timeouts, sleeps and wait times.
+*******************************************************************************/
+
+#ifndef _APP_WAIT_H
+#define _APP_WAIT_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+extern "C" {
+
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Data Types
+// *****************************************************************************
+// *****************************************************************************
+
+typedef enum
+{
+    /* Blocking DRV_SPI transfer to the MCP3564 */
+    APP_WAIT_SPI = 0,
+
+    /* ADC_ACQ_Stop: reads already queued landing in the ring */
+    APP_WAIT_DRAIN,
+
+    APP_WAIT_SITES
+
+} APP_WAIT_SITE;
+
+/* True once the wait is over */
+typedef bool (*APP_WAIT_CONDITION)(uintptr_t context);
+
+typedef struct
+{
+    uint32_t count;
+    uint32_t timeouts;
+
+    /* WFIs taken, each ended by an interrupt */
+    uint32_t sleeps;
+
+    /* Wait time in APP_PERF ticks */
+    uint32_t max;
+    uint64_t sum;
+
+} APP_WAIT_STATS;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+/*******************************************************************************
+  Function:
+    bool APP_WAIT_Until ( APP_WAIT_SITE site, APP_WAIT_CONDITION condition,
+        uintptr_t context, uint32_t timeoutMs )
+
+  Summary:
+    Sleeps until condition(context) is true or timeoutMs have passed.
+
+  Description:
+    Returns the last result of the condition, false on a timeout. A
+    condition already true returns at once, without a timer. Thread level
+    only.
+*/
+
+bool APP_WAIT_Until ( APP_WAIT_SITE site, APP_WAIT_CONDITION condition, uintptr_t context, uint32_t timeoutMs );
+
+/* Site name for the console, NULL past the last site */
+const char* APP_WAIT_NameGet ( APP_WAIT_SITE site );
+
+void APP_WAIT_StatsGet ( APP_WAIT_SITE site, APP_WAIT_STATS* stats );
+
+/* Clears the statistics of every site */
+void APP_WAIT_Reset ( void );
+
+//DOM-IGNORE-BEGIN
+#ifdef __cplusplus
+}
+#endif
+//DOM-IGNORE-END
+
+#endif /* _APP_WAIT_H */
+
+/*******************************************************************************
+ End of File
+ */
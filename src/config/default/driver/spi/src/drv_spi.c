@@ -49,6 +49,7 @@
 #include "configuration.h"
 #include "driver/spi/drv_spi.h"
 #include "system/debug/sys_debug.h"
+#include "sys_trace_hook.h" /* Hand edit: SYS_TRACE_HOOK */
 
 // *****************************************************************************
 // *****************************************************************************
@@ -529,6 +530,7 @@ static void lDRV_SPI_UpdateTransferSetupAndAssertCS(
         {
             SYS_PORT_PinSet(clientObj->setup.chipSelect);
         }
+        SYS_TRACE_HOOK(CS_ASSERT, transferObj->clientHandle); /* Hand edit: SYS_TRACE_HOOK */
     }
 }
 
@@ -565,6 +567,7 @@ static void lDRV_SPI_PlibCallbackHandler(uintptr_t contextHandle)
         {
             SYS_PORT_PinClear(clientObj->setup.chipSelect);
         }
+        SYS_TRACE_HOOK(CS_DEASSERT, transferObj->clientHandle); /* Hand edit: SYS_TRACE_HOOK */
     }
 
     /* Check if the client that submitted the request is active? */
@@ -700,6 +703,8 @@ static void lDRV_SPI_TX_DMA_CallbackHandler(
 
     dObj = &gDrvSPIObj[clientObj->drvIndex];
 
+    SYS_TRACE_HOOK(DMA_DONE, dObj->txDMAChannel); /* Hand edit: SYS_TRACE_HOOK */
+
     if (dObj->txDummyDataSize > 0U)
     {
         /* Configure DMA channel to transmit (dummy data) from the same location
@@ -730,6 +735,8 @@ static void lDRV_SPI_RX_DMA_CallbackHandler(
 
     dObj = &gDrvSPIObj[clientObj->drvIndex];
 
+    SYS_TRACE_HOOK(DMA_DONE, dObj->rxDMAChannel); /* Hand edit: SYS_TRACE_HOOK */
+
     if (dObj->rxDummyDataSize > 0U)
     {
         /* Configure DMA to receive dummy data */
@@ -760,6 +767,7 @@ static void lDRV_SPI_RX_DMA_CallbackHandler(
             {
                 SYS_PORT_PinClear(clientObj->setup.chipSelect);
             }
+            SYS_TRACE_HOOK(CS_DEASSERT, transferObj->clientHandle); /* Hand edit: SYS_TRACE_HOOK */
         }
 
         /* Check if the client that submitted the request is active? */
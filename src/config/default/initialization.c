@@ -46,6 +46,7 @@
 #include "configuration.h"
 #include "definitions.h"
 #include "device.h"
+#include "sys_tasks.h"
 
 
 // ****************************************************************************
@@ -334,6 +335,8 @@ void SYS_Initialize ( void* data )
     /* MISRAC 2012 deviation block end */
     APP_Initialize();
 
+    SYS_TASKS_Initialize();
+
 
     NVIC_Initialize();
 
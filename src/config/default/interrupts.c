@@ -113,7 +113,6 @@ extern void EIC_EXTINT_15_Handler      ( void ) __attribute__((weak, alias("Dumm
 extern void FREQM_Handler              ( void ) __attribute__((weak, alias("Dummy_Handler")));
 extern void NVMCTRL_0_Handler          ( void ) __attribute__((weak, alias("Dummy_Handler")));
 extern void NVMCTRL_1_Handler          ( void ) __attribute__((weak, alias("Dummy_Handler")));
-extern void DMAC_2_Handler             ( void ) __attribute__((weak, alias("Dummy_Handler")));
 extern void DMAC_3_Handler             ( void ) __attribute__((weak, alias("Dummy_Handler")));
 extern void DMAC_OTHER_Handler         ( void ) __attribute__((weak, alias("Dummy_Handler")));
 extern void EVSYS_0_Handler            ( void ) __attribute__((weak, alias("Dummy_Handler")));
@@ -251,7 +250,7 @@ const H3DeviceVectors exception_table=
     .pfnNVMCTRL_1_Handler          = NVMCTRL_1_Handler,
     .pfnDMAC_0_Handler             = DMAC_0_InterruptHandler,
     .pfnDMAC_1_Handler             = DMAC_1_InterruptHandler,
-    .pfnDMAC_2_Handler             = DMAC_2_Handler,
+    .pfnDMAC_2_Handler             = DMAC_2_InterruptHandler,
     .pfnDMAC_3_Handler             = DMAC_3_Handler,
     .pfnDMAC_OTHER_Handler         = DMAC_OTHER_Handler,
     .pfnEVSYS_0_Handler            = EVSYS_0_Handler,
@@ -68,6 +68,7 @@ void RTC_InterruptHandler (void);
 void EIC_EXTINT_14_InterruptHandler (void);
 void DMAC_0_InterruptHandler (void);
 void DMAC_1_InterruptHandler (void);
+void DMAC_2_InterruptHandler (void);
 void SERCOM1_SPI_InterruptHandler (void);
 void SERCOM5_USART_InterruptHandler (void);
 
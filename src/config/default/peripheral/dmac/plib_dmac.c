@@ -54,7 +54,7 @@
 // *****************************************************************************
 // *****************************************************************************
 
-#define DMAC_CHANNELS_NUMBER        (2U)
+#define DMAC_CHANNELS_NUMBER        (3U)
 
 #define DMAC_CRC_CHANNEL_OFFSET     (0x20U)
 
@@ -132,6 +132,17 @@ void DMAC_Initialize( void )
 
    DMAC_REGS->CHANNEL[1].DMAC_CHINTENSET = (DMAC_CHINTENSET_TERR_Msk | DMAC_CHINTENSET_TCMPL_Msk);
 
+   /***************** Configure DMA channel 2 ********************/
+   DMAC_REGS->CHANNEL[2].DMAC_CHCTRLA = DMAC_CHCTRLA_TRIGACT(2U) | DMAC_CHCTRLA_TRIGSRC(15U) | DMAC_CHCTRLA_THRESHOLD(0U) | DMAC_CHCTRLA_BURSTLEN(0U) ;
+
+   descriptor_section[2].DMAC_BTCTRL = DMAC_BTCTRL_BLOCKACT_INT | DMAC_BTCTRL_BEATSIZE_BYTE | DMAC_BTCTRL_VALID_Msk | DMAC_BTCTRL_SRCINC_Msk ;
+
+   DMAC_REGS->CHANNEL[2].DMAC_CHPRILVL = DMAC_CHPRILVL_PRILVL(0U);
+
+   dmacChannelObj[2].inUse = true;
+
+   DMAC_REGS->CHANNEL[2].DMAC_CHINTENSET = (DMAC_CHINTENSET_TERR_Msk | DMAC_CHINTENSET_TCMPL_Msk);
+
     /* Enable the DMAC module & Priority Level x Enable */
     DMAC_REGS->DMAC_CTRL = DMAC_CTRL_DMAENABLE_Msk | DMAC_CTRL_LVLEN0_Msk | DMAC_CTRL_LVLEN1_Msk | DMAC_CTRL_LVLEN2_Msk | DMAC_CTRL_LVLEN3_Msk;
 }
@@ -192,6 +203,44 @@ bool DMAC_ChannelTransfer( DMAC_CHANNEL channel, const void *srcAddr, const void
         /* Set Block Transfer Count */
         dmacDescReg->DMAC_BTCNT = ((uint16_t)blockSize / ((uint16_t)1U << beat_size));
 
+        /* Single block transfer, drop any link left by a linked list transfer */
+        dmacDescReg->DMAC_DESCADDR = 0U;
+
+        /* Enable the channel */
+        DMAC_REGS->CHANNEL[channel].DMAC_CHCTRLA |= DMAC_CHCTRLA_ENABLE_Msk;
+
+        /* Verify if Trigger source is Software Trigger */
+        if ((((DMAC_REGS->CHANNEL[channel].DMAC_CHCTRLA & DMAC_CHCTRLA_TRIGSRC_Msk) >> DMAC_CHCTRLA_TRIGSRC_Pos) == 0x00U)
+                                                && (((DMAC_REGS->CHANNEL[channel].DMAC_CHEVCTRL & DMAC_CHEVCTRL_EVIE_Msk)) != DMAC_CHEVCTRL_EVIE_Msk))
+        {
+            /* Trigger the DMA transfer */
+            DMAC_REGS->DMAC_SWTRIGCTRL |= ((uint32_t)1U << channel);
+        }
+        returnStatus = true;
+    }
+
+    return returnStatus;
+}
+
+/*******************************************************************************
+    This function submits a list of DMAC transfers.
+********************************************************************************/
+
+bool DMAC_ChannelLinkedListTransfer (DMAC_CHANNEL channel, dmac_descriptor_registers_t* channelDesc)
+{
+    bool returnStatus = false;
+    bool isBusy = dmacChannelObj[channel].isBusy;
+
+    if (((DMAC_REGS->CHANNEL[channel].DMAC_CHINTFLAG & (DMAC_CHINTENCLR_TCMPL_Msk | DMAC_CHINTENCLR_TERR_Msk)) != 0U) || (!isBusy))
+    {
+        /* Clear the transfer complete flag */
+        DMAC_REGS->CHANNEL[channel].DMAC_CHINTFLAG = DMAC_CHINTENCLR_TCMPL_Msk | DMAC_CHINTENCLR_TERR_Msk;
+
+        dmacChannelObj[channel].isBusy = true;
+
+        /* The first descriptor lives in the base descriptor section */
+        (void) memcpy(&descriptor_section[channel], channelDesc, sizeof(dmac_descriptor_registers_t));
+
         /* Enable the channel */
         DMAC_REGS->CHANNEL[channel].DMAC_CHCTRLA |= DMAC_CHCTRLA_ENABLE_Msk;
 
@@ -202,6 +251,7 @@ bool DMAC_ChannelTransfer( DMAC_CHANNEL channel, const void *srcAddr, const void
             /* Trigger the DMA transfer */
             DMAC_REGS->DMAC_SWTRIGCTRL |= ((uint32_t)1U << channel);
         }
+
         returnStatus = true;
     }
 
@@ -500,3 +550,8 @@ void __attribute__((used)) DMAC_1_InterruptHandler( void )
    DMAC_channel_interruptHandler(1U);
 }
 
+void __attribute__((used)) DMAC_2_InterruptHandler( void )
+{
+   DMAC_channel_interruptHandler(2U);
+}
+
@@ -46,8 +46,24 @@
 
 void EVSYS_Initialize( void )
 {
-    /*Event Channel User Configuration*/
+    /*Event Channel Configuration*/
+    /* Channel 0: EIC_EXTINT_14 (MCP3564 data ready) -> PORT EV0 */
+    EVSYS_REGS->CHANNEL[0].EVSYS_CHANNEL = EVSYS_CHANNEL_EVGEN(0x20U) | EVSYS_CHANNEL_PATH(0x2U) | EVSYS_CHANNEL_EDGSEL(0x0U);
+
+    /* Channel 1: EIC_EXTINT_14 (MCP3564 data ready) -> DMAC CH0 */
+    EVSYS_REGS->CHANNEL[1].EVSYS_CHANNEL = EVSYS_CHANNEL_EVGEN(0x20U) | EVSYS_CHANNEL_PATH(0x1U) | EVSYS_CHANNEL_EDGSEL(0x1U);
+
+    /* Channel 2: DMAC CH1 (beat complete) -> PORT EV1 */
+    EVSYS_REGS->CHANNEL[2].EVSYS_CHANNEL = EVSYS_CHANNEL_EVGEN(0x23U) | EVSYS_CHANNEL_PATH(0x2U) | EVSYS_CHANNEL_EDGSEL(0x0U);
 
+    /* Channel 3: EIC_EXTINT_14 (MCP3564 data ready) -> TC0 time stamp capture */
+    EVSYS_REGS->CHANNEL[3].EVSYS_CHANNEL = EVSYS_CHANNEL_EVGEN(0x20U) | EVSYS_CHANNEL_PATH(0x1U) | EVSYS_CHANNEL_EDGSEL(0x1U);
+
+    /*Event Channel User Configuration*/
+    EVSYS_REGS->EVSYS_USER[1] = EVSYS_USER_CHANNEL(0x1U);   /* PORT_EV0  <- channel 0 */
+    EVSYS_REGS->EVSYS_USER[2] = EVSYS_USER_CHANNEL(0x3U);   /* PORT_EV1  <- channel 2 */
+    EVSYS_REGS->EVSYS_USER[5] = EVSYS_USER_CHANNEL(0x2U);   /* DMAC_CH0  <- channel 1 */
+    EVSYS_REGS->EVSYS_USER[44] = EVSYS_USER_CHANNEL(0x4U);  /* TC0_EVU   <- channel 3 */
 }
 
 
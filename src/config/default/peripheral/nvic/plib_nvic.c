@@ -67,6 +67,8 @@ void NVIC_Initialize( void )
     NVIC_EnableIRQ(DMAC_0_IRQn);
     NVIC_SetPriority(DMAC_1_IRQn, 7);
     NVIC_EnableIRQ(DMAC_1_IRQn);
+    NVIC_SetPriority(DMAC_2_IRQn, 7);
+    NVIC_EnableIRQ(DMAC_2_IRQn);
     NVIC_SetPriority(SERCOM1_0_IRQn, 7);
     NVIC_EnableIRQ(SERCOM1_0_IRQn);
     NVIC_SetPriority(SERCOM1_1_IRQn, 7);
@@ -50,6 +50,8 @@
 
 #include "interrupts.h"
 #include "plib_sercom5_usart.h"
+#include "peripheral/dmac/plib_dmac.h"
+#include "sys_trace_hook.h" /* Hand edit: SYS_TRACE_HOOK */
 
 // *****************************************************************************
 // *****************************************************************************
@@ -83,6 +85,18 @@ volatile static uint8_t SERCOM5_USART_ReadBuffer[SERCOM5_USART_READ_BUFFER_SIZE]
 
 volatile static uint8_t SERCOM5_USART_WriteBuffer[SERCOM5_USART_WRITE_BUFFER_SIZE];
 
+/* Transmit: DMAC channel 2, triggered by DRE, moves contiguous segments of
+ * the write ring. One interrupt per segment instead of one per byte. The
+ * DRE interrupt path is kept for 9 bit characters. */
+#define SERCOM5_USART_TX_DMA_CHANNEL        DMAC_CHANNEL_2
+#define SERCOM5_USART_TX_DMA_IRQn           DMAC_2_IRQn
+
+/* Bytes handed to the DMAC and not yet released from the ring */
+volatile static uint32_t sercom5USARTTxDmaSize;
+
+static void SERCOM5_USART_TxDmaStart(void);
+static void SERCOM5_USART_TxDmaCallback(DMAC_TRANSFER_EVENT event, uintptr_t context);
+
 void SERCOM5_USART_Initialize( void )
 {
     /*
@@ -147,6 +161,9 @@ void SERCOM5_USART_Initialize( void )
         sercom5USARTObj.rdBufferSize = SERCOM5_USART_READ_BUFFER_9BIT_SIZE;
         sercom5USARTObj.wrBufferSize = SERCOM5_USART_WRITE_BUFFER_9BIT_SIZE;
     }
+    sercom5USARTTxDmaSize = 0U;
+    DMAC_ChannelCallbackRegister(SERCOM5_USART_TX_DMA_CHANNEL, SERCOM5_USART_TxDmaCallback, 0U);
+
     /* Enable error interrupt */
     SERCOM5_REGS->USART_INT.SERCOM_INTENSET = (uint8_t)SERCOM_USART_INT_INTENSET_ERROR_Msk;
 
@@ -702,13 +719,68 @@ size_t SERCOM5_USART_Write(uint8_t* pWrBuffer, const size_t size )
     /* Check if any data is pending for transmission */
     if (SERCOM5_USART_WritePendingBytesGet() > 0U)
     {
-        /* Enable TX interrupt as data is pending for transmission */
-        SERCOM5_USART_TX_INT_ENABLE();
+        if (((SERCOM5_REGS->USART_INT.SERCOM_CTRLB & SERCOM_USART_INT_CTRLB_CHSIZE_Msk) >> SERCOM_USART_INT_CTRLB_CHSIZE_Pos) != 0x01U)
+        {
+            /* The DMAC completion handler also starts segments */
+            NVIC_DisableIRQ(SERCOM5_USART_TX_DMA_IRQn);
+            SERCOM5_USART_TxDmaStart();
+            NVIC_EnableIRQ(SERCOM5_USART_TX_DMA_IRQn);
+        }
+        else
+        {
+            /* Enable TX interrupt as data is pending for transmission */
+            SERCOM5_USART_TX_INT_ENABLE();
+        }
     }
 
     return nBytesWritten;
 }
 
+/* Called with the DMAC channel interrupt masked or from it */
+static void SERCOM5_USART_TxDmaStart(void)
+{
+    uint32_t wrInIndex = sercom5USARTObj.wrInIndex;
+    uint32_t wrOutIndex = sercom5USARTObj.wrOutIndex;
+    uint32_t size;
+
+    if ((sercom5USARTTxDmaSize != 0U) || (wrInIndex == wrOutIndex))
+    {
+        return;
+    }
+
+    /* Up to the write index or to the end of the ring, whichever is first */
+    size = (wrInIndex > wrOutIndex) ? (wrInIndex - wrOutIndex) : (sercom5USARTObj.wrBufferSize - wrOutIndex);
+
+    if (DMAC_ChannelTransfer(SERCOM5_USART_TX_DMA_CHANNEL, (const void*)&SERCOM5_USART_WriteBuffer[wrOutIndex],
+                             (const void*)&SERCOM5_REGS->USART_INT.SERCOM_DATA, size) == true)
+    {
+        sercom5USARTTxDmaSize = size;
+    }
+}
+
+static void SERCOM5_USART_TxDmaCallback(DMAC_TRANSFER_EVENT event, uintptr_t context)
+{
+    uint32_t wrOutIndex = sercom5USARTObj.wrOutIndex + sercom5USARTTxDmaSize;
+
+    /* A transfer error releases the segment as well: resending it would
+     * repeat the bytes which did go out */
+    if (wrOutIndex >= sercom5USARTObj.wrBufferSize)
+    {
+        wrOutIndex = 0U;
+    }
+
+    sercom5USARTObj.wrOutIndex = wrOutIndex;
+    sercom5USARTTxDmaSize = 0U;
+
+    if (wrOutIndex == sercom5USARTObj.wrInIndex)
+    {
+        SYS_TRACE_HOOK(UART_DRAINED, 0U); /* Hand edit: SYS_TRACE_HOOK */
+    }
+
+    SERCOM5_USART_SendWriteNotification();
+    SERCOM5_USART_TxDmaStart();
+}
+
 size_t SERCOM5_USART_WriteFreeBufferCountGet(void)
 {
     return (sercom5USARTObj.wrBufferSize - 1U) - SERCOM5_USART_WriteCountGet();
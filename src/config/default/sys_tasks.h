@@ -51,6 +51,21 @@
 
 #include "configuration.h"
 #include "definitions.h"
+#include "app_sched.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Task Handles
+// *****************************************************************************
+// *****************************************************************************
+
+/* Scheduler tasks SYS_Tasks runs, signal one to have it run */
+extern APP_SCHED_HANDLE sysTaskApp;
+extern APP_SCHED_HANDLE sysTaskCommand;
+extern APP_SCHED_HANDLE sysTaskCache;
+
+/* Registers the tasks, from SYS_Initialize after APP_Initialize */
+void SYS_TASKS_Initialize ( void );
 
 
 #endif //SYS_TASKS_H
\ No newline at end of file
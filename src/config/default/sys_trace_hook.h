@@ -0,0 +1,65 @@
+/*******************************************************************************
+  System Trace Hook Header File
+
+  File Name:
+    sys_trace_hook.h
+
+  Summary:
+    Event trace hook of the drivers and PLIBs, empty unless the application
+    provides one.
+
+  Description:
+    DRV_SPI, the console USART PLIB and SYS_COMMAND mark a few events with
+
+        SYS_TRACE_HOOK(CS_ASSERT, clientHandle);
+
+    The event is a bare name, the application decides what it becomes:
+
+        CS_ASSERT, CS_DEASSERT  chip select driven / released by DRV_SPI,
+                                arg: client handle
+        DMA_DONE                DRV_SPI DMAC transfer complete, arg: channel
+        UART_DRAINED            console transmit ring ran empty
+        CMD_START, CMD_END      console command dispatched / returned,
+                                arg: its first character
+
+    An application which traces sets SYS_TRACE_HOOK_HEADER in user.h to a
+    header defining SYS_TRACE_HOOK(event, arg); it is included here after
+    configuration.h. Without it the hook expands to nothing and the
+    generated code needs nothing from the application.
+
+  Remarks:
+    Not generated by MCC. The hook sites in the generated files are hand
+    edits, marked "Hand edit: SYS_TRACE_HOOK", to be kept when the
+    configuration is regenerated.
+*******************************************************************************/
+
+#ifndef _SYS_TRACE_HOOK_H
+#define _SYS_TRACE_HOOK_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include "configuration.h"
+
+#ifdef SYS_TRACE_HOOK_HEADER
+#include SYS_TRACE_HOOK_HEADER
+#endif
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Hook
+// *****************************************************************************
+// *****************************************************************************
+
+#ifndef SYS_TRACE_HOOK
+#define SYS_TRACE_HOOK(event, arg)
+#endif
+
+#endif /* _SYS_TRACE_HOOK_H */
+
+/*******************************************************************************
+ End of File
+ */
@@ -58,6 +58,8 @@
 #include "system/debug/sys_debug.h"
 #include "system/reset/sys_reset.h"
 #include "osal/osal.h"
+#include "app_perf.h"
+#include "sys_trace_hook.h" /* Hand edit: SYS_TRACE_HOOK */
 
 // *****************************************************************************
 // *****************************************************************************
@@ -1076,7 +1078,11 @@ static void ParseCmdBuffer(SYS_CMD_IO_DCPT* pCmdIO)
                         if(strcmp(argv[0], pDcpt->cmdStr) == 0)
                         {
                             // command found
+                            SYS_TRACE_HOOK(CMD_START, argv[0][0]); /* Hand edit: SYS_TRACE_HOOK */
+                            APP_PERF_BEGIN(cmdStart);
                             pDcpt->cmdFnc(&pCmdIO->devNode, argc, argv);
+                            APP_PERF_END(APP_PERF_REGION_COMMAND, cmdStart);
+                            SYS_TRACE_HOOK(CMD_END, argv[0][0]); /* Hand edit: SYS_TRACE_HOOK */
                             return;
                         }
                         ix++;
@@ -56,6 +56,7 @@
 #include "system/console/sys_console.h"
 #include "configuration.h"
 #include "osal/osal.h"
+#include "app_perf.h"
 #include <stdio.h>
 #include <string.h>
 #include <stdarg.h>
@@ -344,6 +345,8 @@ void SYS_CONSOLE_Print(const SYS_CONSOLE_HANDLE handle, const char *format, ...)
         return;
     }
 
+    APP_PERF_BEGIN(formatStart);
+
     /* Get the variable arguments in va_list */
     va_start( args, format );
 
@@ -351,11 +354,15 @@ void SYS_CONSOLE_Print(const SYS_CONSOLE_HANDLE handle, const char *format, ...)
 
     va_end( args );
 
+    APP_PERF_END(APP_PERF_REGION_FORMAT, formatStart);
+
     if ((len > 0U) && (len < SYS_CONSOLE_PRINT_BUFFER_SIZE))
     {
         consolePrintBuffer[len] = '\0';
 
+        APP_PERF_BEGIN(writeStart);
         (void) pConsoleObj->devDesc->write_t(pConsoleObj->devIndex, consolePrintBuffer, len);
+        APP_PERF_END(APP_PERF_REGION_WRITE, writeStart);
     }
 
     /* Release mutex */
@@ -378,7 +385,9 @@ void SYS_CONSOLE_Message(const SYS_CONSOLE_HANDLE handle, const char *message)
         return;
     }
 
+    APP_PERF_BEGIN(writeStart);
     (void) pConsoleObj->devDesc->write_t(pConsoleObj->devIndex, message, strlen(message));
+    APP_PERF_END(APP_PERF_REGION_WRITE, writeStart);
 }
 
 bool SYS_CONSOLE_Flush(const SYS_CONSOLE_HANDLE handle)
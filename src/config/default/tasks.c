@@ -53,46 +53,107 @@
 #include "configuration.h"
 #include "definitions.h"
 #include "sys_tasks.h"
+#include "mcp3564_cache.h"
 
 
+// *****************************************************************************
+// *****************************************************************************
+// Section: Task Handles
+// *****************************************************************************
+// *****************************************************************************
+
+/* The shadow verify runs once a period, this wakes it often enough that a
+ * verify is at most a quarter of a period late */
+#define SYS_TASKS_CACHE_POLL_MS     (MCP3564_CACHE_VERIFY_PERIOD_MS / 4U)
+
+APP_SCHED_HANDLE sysTaskApp = APP_SCHED_HANDLE_INVALID;
+APP_SCHED_HANDLE sysTaskCommand = APP_SCHED_HANDLE_INVALID;
+APP_SCHED_HANDLE sysTaskCache = APP_SCHED_HANDLE_INVALID;
 
 
 // *****************************************************************************
 // *****************************************************************************
-// Section: System "Tasks" Routine
+// Section: Task Functions
 // *****************************************************************************
 // *****************************************************************************
 
-/*******************************************************************************
-  Function:
-    void SYS_Tasks ( void )
-
-  Remarks:
-    See prototype in system/common/sys_module.h.
-*/
-void SYS_Tasks ( void )
+/* The command processor takes one character per call, once a TRACE or
+ * PERFHIST dump is out. A dump writes what the transmit ring takes and
+ * goes on when the ring has drained to APP_DUMP_ROOM free bytes */
+static void lSYS_TASKS_Command(void)
 {
-    /* Maintain system services */
-//APP_AddCommandFunction();    
-SYS_CMD_Tasks();
+    if (APP_DumpTasks())
+    {
+        (void) SERCOM5_USART_WriteNotificationEnable(true, true);
+
+        /* Drained before the notification was on */
+        if (SERCOM5_USART_WriteFreeBufferCountGet() >= APP_DUMP_ROOM)
+        {
+            APP_SCHED_Signal(sysTaskCommand);
+        }
+        return;
+    }
+    (void) SERCOM5_USART_WriteNotificationEnable(false, false);
+
+    (void) SYS_CMD_Tasks();
+
+    if (SYS_CONSOLE_ReadCountGet(SYS_CONSOLE_DEFAULT_INSTANCE) > 0)
+    {
+        APP_SCHED_Signal(sysTaskCommand);
+    }
+}
 
+/* SERCOM5 receive interrupt, a character for the command processor */
+static void lSYS_TASKS_ConsoleReceive(SERCOM_USART_EVENT event, uintptr_t context)
+{
+    APP_SCHED_Signal(sysTaskCommand);
+}
 
+/* SERCOM5 transmit ring drained to the threshold, room for a dump */
+static void lSYS_TASKS_ConsoleTransmit(SERCOM_USART_EVENT event, uintptr_t context)
+{
+    APP_SCHED_Signal(sysTaskCommand);
+}
 
+void SYS_TASKS_Initialize ( void )
+{
+    APP_SCHED_Initialize();
 
+    /* APP signals itself: queued commands, acquisition events, its timers */
+    sysTaskApp = APP_SCHED_TaskRegister("APP", APP_Tasks, APP_SCHED_PRIORITY_HIGH);
+    sysTaskCommand = APP_SCHED_TaskRegister("COMMAND", lSYS_TASKS_Command, APP_SCHED_PRIORITY_NORMAL);
+    sysTaskCache = APP_SCHED_TaskRegister("CACHE", MCP3564_CACHE_Tasks, APP_SCHED_PRIORITY_LOW);
 
-    /* Maintain Device Drivers */
-    
+    SERCOM5_USART_ReadCallbackRegister(lSYS_TASKS_ConsoleReceive, 0U);
+    SERCOM5_USART_ReadThresholdSet(1U);
+    (void) SERCOM5_USART_ReadNotificationEnable(true, true);
+    SERCOM5_USART_WriteCallbackRegister(lSYS_TASKS_ConsoleTransmit, 0U);
+    SERCOM5_USART_WriteThresholdSet(APP_DUMP_ROOM);
 
-    /* Maintain Middleware & Other Libraries */
-    
+    (void) APP_SCHED_PeriodSet(sysTaskCache, SYS_TASKS_CACHE_POLL_MS);
+}
 
-    /* Maintain the application's state machine. */
-        /* Call Application task APP. */
-    //APP_Tasks();
 
+// *****************************************************************************
+// *****************************************************************************
+// Section: System "Tasks" Routine
+// *****************************************************************************
+// *****************************************************************************
 
+/*******************************************************************************
+  Function:
+    void SYS_Tasks ( void )
 
+  Remarks:
+    See prototype in system/common/sys_module.h.
 
+    One scheduler pass: the ready tasks by priority, sample processing
+    first, then the command processor, then the shadow register verify.
+    With nothing ready the core sleeps in WFI until an interrupt.
+*/
+void SYS_Tasks ( void )
+{
+    APP_SCHED_Tasks();
 }
 
 /*******************************************************************************
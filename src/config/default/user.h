@@ -33,6 +33,8 @@ extern "C" {
 // *****************************************************************************
 // *****************************************************************************
 
+/* Defines SYS_TRACE_HOOK of the drivers and PLIBs (sys_trace_hook.h) */
+#define SYS_TRACE_HOOK_HEADER               "app_trace.h"
 
 //DOM-IGNORE-BEGIN
 #ifdef __cplusplus
@@ -0,0 +1,355 @@
+/*******************************************************************************
+  MCP3564 Shadow Register Cache Source File
+
+  File Name:
+    mcp3564_cache.c
+
+  Summary:
+    RAM shadow of the MCP3564 register file with valid/dirty tracking.
+
+  Description:
+    One bit per address in the valid and dirty masks. IRQ is kept in the
+    shadow with its status flags masked off so a flush span crossing it can
+    be written back, but reads of IRQ always go to the device.
+
+    Loads and verifies use ADC_ACQ_SnapshotRead, which is allowed while
+    streaming in driver mode; flushes need the acquisition stopped. The
+    background verify still waits for the stream to stop: its snapshot
+    would take one of the two DRV_SPI queue slots the data-ready reads
+    need.
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <string.h>
+#include "definitions.h"
+#include "mcp3564_cache.h"
+#include "adc_acq.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+#define MCP3564_CACHE_BIT(address)          ((uint16_t) (1U << (address)))
+
+/* Registers which change without being written */
+#define MCP3564_CACHE_VOLATILE              (MCP3564_CACHE_BIT(MCP3564_REG_ADCDATA) | \
+                                             MCP3564_CACHE_BIT(MCP3564_REG_IRQ) |     \
+                                             MCP3564_CACHE_BIT(MCP3564_REG_CRCCFG))
+
+/* CONFIG0..GAINCAL: writable back to back, one incremental write */
+#define MCP3564_CACHE_BLOCK_FIRST           MCP3564_REG_CONFIG0
+#define MCP3564_CACHE_BLOCK_LAST            MCP3564_REG_GAINCAL
+#define MCP3564_CACHE_BLOCK                 ((uint16_t) (((2U << MCP3564_CACHE_BLOCK_LAST) - 1U) & \
+                                                         ~((1U << MCP3564_CACHE_BLOCK_FIRST) - 1U)))
+#define MCP3564_CACHE_BLOCK_SIZE            18U
+
+/* Everything a snapshot returns */
+#define MCP3564_CACHE_SNAPSHOT              ((uint16_t) (0xFFFFU & ~MCP3564_CACHE_BIT(MCP3564_REG_ADCDATA)))
+
+typedef struct
+{
+    uint32_t value[MCP3564_REG_COUNT];
+    uint16_t valid;
+    uint16_t dirty;
+    uint32_t verifyStart;
+    MCP3564_CACHE_STATS stats;
+
+} MCP3564_CACHE_OBJ;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data
+// *****************************************************************************
+// *****************************************************************************
+
+static MCP3564_CACHE_OBJ cacheObj;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+static void lMCP3564_CACHE_FromSnapshot(const MCP3564_SNAPSHOT* snap, uint32_t* value)
+{
+    value[MCP3564_REG_CONFIG0]   = snap->config0;
+    value[MCP3564_REG_CONFIG1]   = snap->config1;
+    value[MCP3564_REG_CONFIG2]   = snap->config2;
+    value[MCP3564_REG_CONFIG3]   = snap->config3;
+    value[MCP3564_REG_IRQ]       = snap->irq & MCP3564_IRQ_WRITE_MASK;
+    value[MCP3564_REG_MUX]       = snap->mux;
+    value[MCP3564_REG_SCAN]      = snap->scan;
+    value[MCP3564_REG_TIMER]     = snap->timer;
+    value[MCP3564_REG_OFFSETCAL] = snap->offsetcal;
+    value[MCP3564_REG_GAINCAL]   = snap->gaincal;
+    value[MCP3564_REG_RESERVED0] = snap->reserved0;
+    value[MCP3564_REG_RESERVED1] = snap->reserved1;
+    value[MCP3564_REG_LOCK]      = snap->lock;
+    value[MCP3564_REG_RESERVED2] = snap->reserved2;
+    value[MCP3564_REG_CRCCFG]    = snap->crccfg;
+}
+
+static uint32_t lMCP3564_CACHE_HighestBit(uint16_t mask)
+{
+    return 31U - (uint32_t) __builtin_clz((uint32_t) mask);
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+void MCP3564_CACHE_Invalidate(void)
+{
+    cacheObj.valid = 0;
+    cacheObj.dirty = 0;
+}
+
+bool MCP3564_CACHE_Load(void)
+{
+    MCP3564_SNAPSHOT snap;
+    uint32_t value[MCP3564_REG_COUNT];
+    uint32_t address;
+
+    if (!ADC_ACQ_SnapshotRead(&snap))
+    {
+        return false;
+    }
+
+    lMCP3564_CACHE_FromSnapshot(&snap, value);
+
+    for (address = 0; address < MCP3564_REG_COUNT; address++)
+    {
+        if ((MCP3564_CACHE_BIT(address) & MCP3564_CACHE_SNAPSHOT & ~cacheObj.dirty) != 0U)
+        {
+            cacheObj.value[address] = value[address];
+        }
+    }
+
+    cacheObj.valid |= MCP3564_CACHE_SNAPSHOT;
+
+    return true;
+}
+
+bool MCP3564_CACHE_IsCached(uint32_t address)
+{
+    return (address < MCP3564_REG_COUNT) &&
+           ((cacheObj.valid & ~MCP3564_CACHE_VOLATILE & MCP3564_CACHE_BIT(address)) != 0U);
+}
+
+bool MCP3564_CACHE_Read(uint32_t address, uint32_t* value)
+{
+    if (MCP3564_CACHE_IsCached(address))
+    {
+        cacheObj.stats.hits++;
+        *value = cacheObj.value[address];
+        return true;
+    }
+
+    cacheObj.stats.misses++;
+
+    if (!ADC_ACQ_RegisterRead(address, value))
+    {
+        return false;
+    }
+
+    if ((MCP3564_CACHE_BIT(address) & MCP3564_CACHE_VOLATILE) == 0U)
+    {
+        cacheObj.value[address] = *value;
+        cacheObj.valid |= MCP3564_CACHE_BIT(address);
+    }
+
+    return true;
+}
+
+bool MCP3564_CACHE_Write(uint32_t address, uint32_t value)
+{
+    const MCP3564_REG* reg = MCP3564_REG_Get(address);
+    uint16_t bit;
+
+    if ((reg == NULL) || ((reg->access & MCP3564_ACCESS_W) == 0U) ||
+        ((value >> (8U * reg->size)) != 0U))
+    {
+        return false;
+    }
+
+    bit = MCP3564_CACHE_BIT(address);
+
+    if (((cacheObj.valid & bit) != 0U) && (cacheObj.value[address] == value))
+    {
+        cacheObj.stats.hits++;
+        return true;
+    }
+
+    cacheObj.value[address] = value;
+    cacheObj.valid |= bit;
+    cacheObj.dirty |= bit;
+
+    return true;
+}
+
+bool MCP3564_CACHE_Flush(void)
+{
+    uint8_t data[MCP3564_CACHE_BLOCK_SIZE];
+    uint16_t block = cacheObj.dirty & MCP3564_CACHE_BLOCK;
+    uint32_t first;
+    uint32_t last;
+    uint32_t size;
+    uint16_t span;
+
+    if (block != 0U)
+    {
+        first = (uint32_t) __builtin_ctz((uint32_t) block);
+        last = lMCP3564_CACHE_HighestBit(block);
+        span = (uint16_t) (((2U << last) - 1U) & ~((1U << first) - 1U));
+
+        /* Clean registers between two dirty ones are rewritten as they are */
+        if (((cacheObj.valid & span) != span) && !MCP3564_CACHE_Load())
+        {
+            return false;
+        }
+
+        size = MCP3564_REG_Pack(cacheObj.value, first, last, data);
+        if (!ADC_ACQ_BurstWrite(first, data, size))
+        {
+            return false;
+        }
+
+        cacheObj.dirty &= (uint16_t) ~span;
+        cacheObj.stats.flushes++;
+        cacheObj.stats.bytesWritten += size;
+    }
+
+    if ((cacheObj.dirty & MCP3564_CACHE_BIT(MCP3564_REG_LOCK)) != 0U)
+    {
+        if (!ADC_ACQ_RegisterWrite(MCP3564_REG_LOCK, cacheObj.value[MCP3564_REG_LOCK]))
+        {
+            return false;
+        }
+
+        cacheObj.dirty &= (uint16_t) ~MCP3564_CACHE_BIT(MCP3564_REG_LOCK);
+        cacheObj.stats.flushes++;
+        cacheObj.stats.bytesWritten += 1U;
+    }
+
+    return true;
+}
+
+void MCP3564_CACHE_Set(uint32_t address, uint32_t value)
+{
+    if (address < MCP3564_REG_COUNT)
+    {
+        cacheObj.value[address] = value;
+        cacheObj.valid |= MCP3564_CACHE_BIT(address);
+        cacheObj.dirty &= (uint16_t) ~MCP3564_CACHE_BIT(address);
+    }
+}
+
+bool MCP3564_CACHE_ConfigApply(const MCP3564_CONFIG* config, bool scan, bool verify)
+{
+    uint16_t range = (uint16_t) (((2U << MCP3564_REG_MUX) - 1U) & ~1U);
+
+    if (scan)
+    {
+        range |= MCP3564_CACHE_BIT(MCP3564_REG_SCAN) | MCP3564_CACHE_BIT(MCP3564_REG_TIMER);
+    }
+
+    if (!ADC_ACQ_ConfigWrite(config, scan, verify))
+    {
+        /* Part of the burst may have landed */
+        cacheObj.valid &= (uint16_t) ~range;
+        cacheObj.dirty &= (uint16_t) ~range;
+        return false;
+    }
+
+    MCP3564_CACHE_Set(MCP3564_REG_CONFIG0, config->config0);
+    MCP3564_CACHE_Set(MCP3564_REG_CONFIG1, config->config1);
+    MCP3564_CACHE_Set(MCP3564_REG_CONFIG2, config->config2);
+    MCP3564_CACHE_Set(MCP3564_REG_CONFIG3, config->config3);
+    MCP3564_CACHE_Set(MCP3564_REG_IRQ, config->irq & MCP3564_IRQ_WRITE_MASK);
+    MCP3564_CACHE_Set(MCP3564_REG_MUX, config->mux);
+
+    if (scan)
+    {
+        MCP3564_CACHE_Set(MCP3564_REG_SCAN, config->scan);
+        MCP3564_CACHE_Set(MCP3564_REG_TIMER, config->timer);
+    }
+
+    return true;
+}
+
+bool MCP3564_CACHE_Verify(void)
+{
+    MCP3564_SNAPSHOT snap;
+    uint32_t value[MCP3564_REG_COUNT];
+    uint16_t check = cacheObj.valid & (uint16_t) ~cacheObj.dirty & (uint16_t) ~MCP3564_CACHE_VOLATILE;
+    uint16_t mismatch = 0;
+    uint32_t address;
+
+    if (!ADC_ACQ_SnapshotRead(&snap))
+    {
+        return false;
+    }
+
+    lMCP3564_CACHE_FromSnapshot(&snap, value);
+    cacheObj.stats.verifies++;
+
+    for (address = 0; address < MCP3564_REG_COUNT; address++)
+    {
+        if (((check & MCP3564_CACHE_BIT(address)) != 0U) && (cacheObj.value[address] != value[address]))
+        {
+            mismatch |= MCP3564_CACHE_BIT(address);
+            cacheObj.value[address] = value[address];
+            cacheObj.stats.mismatches++;
+        }
+    }
+
+    if (mismatch != 0U)
+    {
+        cacheObj.stats.mismatchMask = mismatch;
+    }
+
+    return (mismatch == 0U);
+}
+
+void MCP3564_CACHE_StatsGet(MCP3564_CACHE_STATS* stats)
+{
+    *stats = cacheObj.stats;
+    stats->valid = cacheObj.valid;
+    stats->dirty = cacheObj.dirty;
+}
+
+void MCP3564_CACHE_Tasks(void)
+{
+    uint32_t now = SYS_TIME_CounterGet();
+
+    if ((cacheObj.valid & ~MCP3564_CACHE_VOLATILE) == 0U)
+    {
+        cacheObj.verifyStart = now;
+        return;
+    }
+
+    /* Overdue while streaming: runs at the first poll after the stop */
+    if (ADC_ACQ_IsRunning())
+    {
+        return;
+    }
+
+    if ((now - cacheObj.verifyStart) >= SYS_TIME_MSToCount(MCP3564_CACHE_VERIFY_PERIOD_MS))
+    {
+        cacheObj.verifyStart = now;
+        (void) MCP3564_CACHE_Verify();
+    }
+}
+
+/*******************************************************************************
+ End of File
+ */
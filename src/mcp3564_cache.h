@@ -0,0 +1,214 @@
+/*******************************************************************************
+  MCP3564 Shadow Register Cache Header File
+
+  File Name:
+    mcp3564_cache.h
+
+  Summary:
+    RAM shadow of the MCP3564 register file with valid/dirty tracking.
+
+  Description:
+    Reads of configuration registers are served from RAM once known. Writes
+    only mark the register dirty; MCP3564_CACHE_Flush sends the dirty range
+    with one incremental write. A background task periodically compares
+    the shadow with a register snapshot taken from the device.
+
+    ADCDATA, IRQ (status flags) and CRCCFG change on their own and are
+    never served from the shadow.
+*******************************************************************************/
+
+#ifndef _MCP3564_CACHE_H
+#define _MCP3564_CACHE_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "mcp3564_reg.h"
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+extern "C" {
+
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Constants
+// *****************************************************************************
+// *****************************************************************************
+
+/* Background verify period */
+#define MCP3564_CACHE_VERIFY_PERIOD_MS      1000U
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Type Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Cache statistics
+
+  Summary:
+    Counters of the shadow register cache.
+
+  Remarks:
+    bytesWritten counts register data bytes sent by flushes. mismatchMask
+    holds one bit per address found different on the last failed verify.
+*/
+
+typedef struct
+{
+    uint32_t hits;
+    uint32_t misses;
+    uint32_t flushes;
+    uint32_t bytesWritten;
+    uint32_t verifies;
+    uint32_t mismatches;
+    uint16_t mismatchMask;
+    uint16_t valid;
+    uint16_t dirty;
+
+} MCP3564_CACHE_STATS;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+/*******************************************************************************
+  Function:
+    void MCP3564_CACHE_Invalidate ( void )
+
+  Summary:
+    Forgets every shadowed value, e.g. after the full reset fast command.
+*/
+
+void MCP3564_CACHE_Invalidate ( void );
+
+/*******************************************************************************
+  Function:
+    bool MCP3564_CACHE_Load ( void )
+
+  Summary:
+    Fills the shadow from one register snapshot. Pending writes are kept.
+*/
+
+bool MCP3564_CACHE_Load ( void );
+
+/*******************************************************************************
+  Function:
+    bool MCP3564_CACHE_Read ( uint32_t address, uint32_t* value )
+
+  Summary:
+    Returns the register value, from RAM when it is shadowed.
+
+  Description:
+    A dirty register returns the value waiting to be flushed.
+*/
+
+bool MCP3564_CACHE_Read ( uint32_t address, uint32_t* value );
+
+bool MCP3564_CACHE_IsCached ( uint32_t address );
+
+/*******************************************************************************
+  Function:
+    bool MCP3564_CACHE_Write ( uint32_t address, uint32_t value )
+
+  Summary:
+    Stores value in the shadow and marks the register dirty.
+
+  Description:
+    Writing the value the shadow already holds is a no-op. Fails for
+    read-only registers and values wider than the register.
+*/
+
+bool MCP3564_CACHE_Write ( uint32_t address, uint32_t value );
+
+/*******************************************************************************
+  Function:
+    bool MCP3564_CACHE_Flush ( void )
+
+  Summary:
+    Sends the dirty registers to the device.
+
+  Description:
+    CONFIG0..GAINCAL is one contiguous writable range: the span from the
+    lowest to the highest dirty register in it goes out as one incremental
+    write. LOCK is written on its own. Registers inside the span that are
+    not shadowed yet are loaded first. On failure the registers stay dirty.
+*/
+
+bool MCP3564_CACHE_Flush ( void );
+
+/*******************************************************************************
+  Function:
+    void MCP3564_CACHE_Set ( uint32_t address, uint32_t value )
+
+  Summary:
+    Records a value written to the device outside the cache.
+*/
+
+void MCP3564_CACHE_Set ( uint32_t address, uint32_t value );
+
+/*******************************************************************************
+  Function:
+    bool MCP3564_CACHE_ConfigApply ( const MCP3564_CONFIG* config, bool scan, bool verify )
+
+  Summary:
+    ADC_ACQ_ConfigWrite keeping the shadow coherent.
+*/
+
+bool MCP3564_CACHE_ConfigApply ( const MCP3564_CONFIG* config, bool scan, bool verify );
+
+/*******************************************************************************
+  Function:
+    bool MCP3564_CACHE_Verify ( void )
+
+  Summary:
+    Compares the clean shadowed registers with a device snapshot.
+
+  Description:
+    Returns true when they match. Registers found different are counted,
+    flagged in mismatchMask and resynchronized to the device value.
+*/
+
+bool MCP3564_CACHE_Verify ( void );
+
+void MCP3564_CACHE_StatsGet ( MCP3564_CACHE_STATS* stats );
+
+/*******************************************************************************
+  Function:
+    void MCP3564_CACHE_Tasks ( void )
+
+  Summary:
+    Runs MCP3564_CACHE_Verify every MCP3564_CACHE_VERIFY_PERIOD_MS once the
+    shadow holds anything. Called from SYS_Tasks.
+
+  Remarks:
+    No verify runs while the acquisition streams; one that falls due
+    meanwhile runs right after ADC_ACQ_Stop.
+*/
+
+void MCP3564_CACHE_Tasks ( void );
+
+//DOM-IGNORE-BEGIN
+#ifdef __cplusplus
+}
+#endif
+//DOM-IGNORE-END
+
+#endif /* _MCP3564_CACHE_H */
+
+/*******************************************************************************
+ End of File
+ */
@@ -0,0 +1,306 @@
+/*******************************************************************************
+  MCP3564 Data Rate Source File
+
+  File Name:
+    mcp3564_rate.c
+
+  Summary:
+    Chooses MCLK, prescaler and OSR for a requested data rate.
+
+  Description:
+    The rate only depends on the source clock and DIV * PRE * OSR.
+    mcp3564Rates holds all 64 PRE / OSR combinations in ascending OSR with
+    the rate each gives at DIV 1 from either source, generated and divided
+    by the compiler: the rate for a DIV is that divided by DIV, and the
+    search derives the best DIV of each entry with one division. Nothing
+    at run time needs more than 32 bits.
+
+    The ENOB of a setting is the figure for its OSR at gain 1 from the
+    ENOB vs. OSR table of the MCP3561/2/4 data sheet (DS20006181). PRE
+    slows the modulator without changing it.
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include "definitions.h"
+#include "mcp3564_rate.h"
+#include "mcp3564_reg.h"
+#include "mcp3564_cache.h"
+#include "adc_acq.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+/* CONFIG1.OSR code -> OSR3 * OSR1 */
+#define MCP3564_RATE_OSR_0                  32UL
+#define MCP3564_RATE_OSR_1                  64UL
+#define MCP3564_RATE_OSR_2                  128UL
+#define MCP3564_RATE_OSR_3                  256UL
+#define MCP3564_RATE_OSR_4                  512UL
+#define MCP3564_RATE_OSR_5                  1024UL
+#define MCP3564_RATE_OSR_6                  2048UL
+#define MCP3564_RATE_OSR_7                  4096UL
+#define MCP3564_RATE_OSR_8                  8192UL
+#define MCP3564_RATE_OSR_9                  16384UL
+#define MCP3564_RATE_OSR_10                 20480UL
+#define MCP3564_RATE_OSR_11                 24576UL
+#define MCP3564_RATE_OSR_12                 40960UL
+#define MCP3564_RATE_OSR_13                 49152UL
+#define MCP3564_RATE_OSR_14                 81920UL
+#define MCP3564_RATE_OSR_15                 98304UL
+
+/* DRCLK at DIV 1 in milli-sps: (source / 4) / (PRE * OSR), at most 937.5e6 */
+#define MCP3564_RATE_BASE(hz, pre, osr)                                         \
+    ((uint32_t) (((uint64_t) (hz) * 1000U / 4U) / ((1UL << (pre)) * MCP3564_RATE_OSR_##osr)))
+
+#define MCP3564_RATE_ENTRY(pre, osr)                                            \
+    {                                                                           \
+        .preCode = (pre),                                                       \
+        .osrCode = (osr),                                                       \
+        .base =                                                                 \
+        {                                                                       \
+            [MCP3564_RATE_SOURCE_DFLL] = MCP3564_RATE_BASE(MCP3564_RATE_DFLL_HZ, pre, osr), \
+            [MCP3564_RATE_SOURCE_DPLL] = MCP3564_RATE_BASE(MCP3564_RATE_DPLL_HZ, pre, osr), \
+        },                                                                      \
+    }
+
+#define MCP3564_RATE_OSR_ENTRIES(osr)                                           \
+    MCP3564_RATE_ENTRY(0, osr), MCP3564_RATE_ENTRY(1, osr),                     \
+    MCP3564_RATE_ENTRY(2, osr), MCP3564_RATE_ENTRY(3, osr)
+
+/* Entry of a CONFIG1 PRE / OSR code pair */
+#define MCP3564_RATE_INDEX(pre, osr)        (((uint32_t) (osr) * 4U) + (pre))
+
+typedef struct
+{
+    uint8_t preCode;
+    uint8_t osrCode;
+    uint32_t base[MCP3564_RATE_SOURCES];
+
+} MCP3564_RATE_ENTRY;
+
+typedef struct
+{
+    uint32_t hz;
+    uint32_t divMin;
+    uint32_t divMax;
+    uint32_t gclkSrc;
+
+} MCP3564_RATE_CLOCK;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data
+// *****************************************************************************
+// *****************************************************************************
+
+static const uint32_t mcp3564OsrValue[16] =
+{
+    MCP3564_RATE_OSR_0,  MCP3564_RATE_OSR_1,  MCP3564_RATE_OSR_2,  MCP3564_RATE_OSR_3,
+    MCP3564_RATE_OSR_4,  MCP3564_RATE_OSR_5,  MCP3564_RATE_OSR_6,  MCP3564_RATE_OSR_7,
+    MCP3564_RATE_OSR_8,  MCP3564_RATE_OSR_9,  MCP3564_RATE_OSR_10, MCP3564_RATE_OSR_11,
+    MCP3564_RATE_OSR_12, MCP3564_RATE_OSR_13, MCP3564_RATE_OSR_14, MCP3564_RATE_OSR_15,
+};
+
+/* CONFIG1.OSR code -> ENOB at gain 1 (data sheet ENOB vs. OSR table), tenths of a bit */
+static const uint8_t mcp3564OsrEnob[16] =
+{
+    137U, 153U, 166U, 176U, 184U, 190U, 195U, 200U,
+    205U, 210U, 211U, 212U, 215U, 216U, 219U, 220U,
+};
+
+static const MCP3564_RATE_CLOCK mcp3564Clocks[MCP3564_RATE_SOURCES] =
+{
+    [MCP3564_RATE_SOURCE_DFLL] =
+    {
+        .hz = MCP3564_RATE_DFLL_HZ,
+        .divMin = (MCP3564_RATE_DFLL_HZ + MCP3564_RATE_MCLK_MAX_HZ - 1U) / MCP3564_RATE_MCLK_MAX_HZ,
+        .divMax = MCP3564_RATE_DFLL_HZ / MCP3564_RATE_MCLK_MIN_HZ,
+        .gclkSrc = GCLK_GENCTRL_SRC_DFLL_Val,
+    },
+    [MCP3564_RATE_SOURCE_DPLL] =
+    {
+        .hz = MCP3564_RATE_DPLL_HZ,
+        .divMin = (MCP3564_RATE_DPLL_HZ + MCP3564_RATE_MCLK_MAX_HZ - 1U) / MCP3564_RATE_MCLK_MAX_HZ,
+        .divMax = MCP3564_RATE_DPLL_HZ / MCP3564_RATE_MCLK_MIN_HZ,
+        .gclkSrc = GCLK_GENCTRL_SRC_DPLL0_Val,
+    },
+};
+
+static const MCP3564_RATE_ENTRY mcp3564Rates[] =
+{
+    MCP3564_RATE_OSR_ENTRIES(0),  MCP3564_RATE_OSR_ENTRIES(1),  MCP3564_RATE_OSR_ENTRIES(2),
+    MCP3564_RATE_OSR_ENTRIES(3),  MCP3564_RATE_OSR_ENTRIES(4),  MCP3564_RATE_OSR_ENTRIES(5),
+    MCP3564_RATE_OSR_ENTRIES(6),  MCP3564_RATE_OSR_ENTRIES(7),  MCP3564_RATE_OSR_ENTRIES(8),
+    MCP3564_RATE_OSR_ENTRIES(9),  MCP3564_RATE_OSR_ENTRIES(10), MCP3564_RATE_OSR_ENTRIES(11),
+    MCP3564_RATE_OSR_ENTRIES(12), MCP3564_RATE_OSR_ENTRIES(13), MCP3564_RATE_OSR_ENTRIES(14),
+    MCP3564_RATE_OSR_ENTRIES(15),
+};
+
+#define MCP3564_RATE_ENTRIES                (sizeof(mcp3564Rates) / sizeof(mcp3564Rates[0]))
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+static void lMCP3564_RATE_Fill(MCP3564_RATE* setting, MCP3564_RATE_SOURCE source, uint32_t div, uint32_t index)
+{
+    const MCP3564_RATE_ENTRY* entry = &mcp3564Rates[index];
+
+    setting->source = source;
+    setting->sourceHz = mcp3564Clocks[source].hz;
+    setting->mclkDiv = div;
+    setting->mclkHz = mcp3564Clocks[source].hz / div;
+    setting->preCode = entry->preCode;
+    setting->osrCode = entry->osrCode;
+    setting->pre = 1UL << entry->preCode;
+    setting->osr = mcp3564OsrValue[entry->osrCode];
+    setting->rate = entry->base[source] / div;
+    setting->enob = mcp3564OsrEnob[entry->osrCode];
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+bool MCP3564_RATE_Find(uint32_t rate, MCP3564_RATE* setting)
+{
+    const MCP3564_RATE_CLOCK* clock;
+    uint32_t best = UINT32_MAX;
+    uint32_t bestOsr = 0U;
+    uint32_t error;
+    uint32_t actual;
+    uint32_t first;
+    uint32_t div;
+    uint32_t source;
+    uint32_t i;
+
+    if (rate == 0U)
+    {
+        return false;
+    }
+
+    for (source = 0U; source < MCP3564_RATE_SOURCES; source++)
+    {
+        clock = &mcp3564Clocks[source];
+
+        for (i = 0U; i < MCP3564_RATE_ENTRIES; i++)
+        {
+            /* Rate is 1/DIV: the nearest rate is at floor or ceil of the ideal DIV */
+            first = mcp3564Rates[i].base[source] / rate;
+
+            for (div = first; div <= (first + 1U); div++)
+            {
+                if ((div < clock->divMin) || (div > clock->divMax))
+                {
+                    continue;
+                }
+
+                actual = mcp3564Rates[i].base[source] / div;
+                error = (actual > rate) ? (actual - rate) : (rate - actual);
+
+                if ((error < best) || ((error == best) && (mcp3564Rates[i].osrCode > bestOsr)))
+                {
+                    best = error;
+                    bestOsr = mcp3564Rates[i].osrCode;
+                    lMCP3564_RATE_Fill(setting, (MCP3564_RATE_SOURCE) source, div, i);
+                }
+            }
+        }
+    }
+
+    /* Out of range requests end at the nearest end of the range */
+    if (best == UINT32_MAX)
+    {
+        clock = &mcp3564Clocks[MCP3564_RATE_SOURCE_DPLL];
+        if (rate > (mcp3564Rates[0].base[MCP3564_RATE_SOURCE_DPLL] / clock->divMin))
+        {
+            lMCP3564_RATE_Fill(setting, MCP3564_RATE_SOURCE_DPLL, clock->divMin, 0U);
+        }
+        else
+        {
+            clock = &mcp3564Clocks[MCP3564_RATE_SOURCE_DFLL];
+            lMCP3564_RATE_Fill(setting, MCP3564_RATE_SOURCE_DFLL, clock->divMax, MCP3564_RATE_ENTRIES - 1U);
+        }
+    }
+
+    return true;
+}
+
+bool MCP3564_RATE_Apply(const MCP3564_RATE* setting)
+{
+    uint32_t config0;
+
+    const MCP3564_RATE_CLOCK* clock;
+
+    if ((ADC_ACQ_IsRunning() == true) || (setting->source >= MCP3564_RATE_SOURCES) ||
+        (setting->preCode > 3U) || (setting->osrCode > 15U))
+    {
+        return false;
+    }
+
+    clock = &mcp3564Clocks[setting->source];
+    if ((setting->mclkDiv < clock->divMin) || (setting->mclkDiv > clock->divMax))
+    {
+        return false;
+    }
+
+    GCLK_REGS->GCLK_GENCTRL[5] = (GCLK_REGS->GCLK_GENCTRL[5] & ~(GCLK_GENCTRL_DIV_Msk | GCLK_GENCTRL_SRC_Msk)) |
+                                 GCLK_GENCTRL_DIV(setting->mclkDiv) | GCLK_GENCTRL_SRC(clock->gclkSrc);
+    while ((GCLK_REGS->GCLK_SYNCBUSY & GCLK_SYNCBUSY_GENCTRL_GCLK5) == GCLK_SYNCBUSY_GENCTRL_GCLK5)
+    {
+        /* Wait for synchronization */
+    }
+
+    if (!MCP3564_CACHE_Read(MCP3564_REG_CONFIG0, &config0))
+    {
+        return false;
+    }
+
+    if ((config0 & MCP3564_CONFIG0_CLK_INTERNAL_Msk) != 0U)
+    {
+        (void) MCP3564_CACHE_Write(MCP3564_REG_CONFIG0, config0 & ~MCP3564_CONFIG0_CLK_SEL_Msk);
+    }
+
+    (void) MCP3564_CACHE_Write(MCP3564_REG_CONFIG1,
+                               ((uint32_t) setting->preCode << MCP3564_CONFIG1_PRE_Pos) |
+                               ((uint32_t) setting->osrCode << MCP3564_CONFIG1_OSR_Pos));
+
+    /* CONFIG0 and CONFIG1 are adjacent: one incremental write */
+    return MCP3564_CACHE_Flush();
+}
+
+bool MCP3564_RATE_Get(MCP3564_RATE* setting)
+{
+    uint32_t config1;
+    uint32_t genctrl = GCLK_REGS->GCLK_GENCTRL[5];
+    uint32_t div = (genctrl & GCLK_GENCTRL_DIV_Msk) >> GCLK_GENCTRL_DIV_Pos;
+    MCP3564_RATE_SOURCE source = ((genctrl & GCLK_GENCTRL_SRC_Msk) == GCLK_GENCTRL_SRC_DPLL0) ?
+                                 MCP3564_RATE_SOURCE_DPLL : MCP3564_RATE_SOURCE_DFLL;
+
+    if (!MCP3564_CACHE_Read(MCP3564_REG_CONFIG1, &config1))
+    {
+        return false;
+    }
+
+    lMCP3564_RATE_Fill(setting, source, (div == 0U) ? 1U : div,
+                       MCP3564_RATE_INDEX((config1 >> MCP3564_CONFIG1_PRE_Pos) & 0x3U,
+                                          (config1 & MCP3564_CONFIG1_OSR_Msk) >> MCP3564_CONFIG1_OSR_Pos));
+
+    return true;
+}
+
+/*******************************************************************************
+ End of File
+ */
@@ -0,0 +1,169 @@
+/*******************************************************************************
+  MCP3564 Data Rate Header File
+
+  File Name:
+    mcp3564_rate.h
+
+  Summary:
+    Chooses MCLK, prescaler and OSR for a requested data rate.
+
+  Description:
+    In continuous conversion the data rate is
+
+      DRCLK = MCLK / (4 * PRE * OSR)
+
+    MCLK is the external clock on the MCLK pin, GCLK5 output on PA11, so
+    its source and DIV are knobs next to CONFIG1.PRE and CONFIG1.OSR. The
+    MCP3564 accepts 1..20 MHz of MCLK:
+
+      - DFLL 48 MHz, DIV 3..48: at most 16 MHz, 125 ksps
+      - DPLL0 120 MHz (the CPU clock), DIV 6..120: 20 MHz, 156.25 ksps
+
+    The DFLL is the default of the clock configuration; the DPLL0 reaches
+    the top rate and steps between the DFLL ones.
+*******************************************************************************/
+
+#ifndef _MCP3564_RATE_H
+#define _MCP3564_RATE_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+extern "C" {
+
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Constants
+// *****************************************************************************
+// *****************************************************************************
+
+#define MCP3564_RATE_DFLL_HZ                48000000U
+#define MCP3564_RATE_DPLL_HZ                120000000U
+#define MCP3564_RATE_MCLK_MIN_HZ            1000000U
+#define MCP3564_RATE_MCLK_MAX_HZ            20000000U
+
+/* CONFIG0.CLK_SEL, bits 5:4: 1x selects the internal oscillator */
+#define MCP3564_CONFIG0_CLK_SEL_Msk         0x30U
+#define MCP3564_CONFIG0_CLK_INTERNAL_Msk    0x20U
+
+/* CONFIG1: PRE in bits 7:6, OSR in bits 5:2 */
+#define MCP3564_CONFIG1_PRE_Pos             6U
+#define MCP3564_CONFIG1_OSR_Pos             2U
+#define MCP3564_CONFIG1_OSR_Msk             0x3CU
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Type Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* GCLK5 source
+
+  Summary:
+    Clock the MCLK generator divides.
+*/
+
+typedef enum
+{
+    MCP3564_RATE_SOURCE_DFLL = 0,
+    MCP3564_RATE_SOURCE_DPLL,
+    MCP3564_RATE_SOURCES
+
+} MCP3564_RATE_SOURCE;
+
+// *****************************************************************************
+/* Data rate setting
+
+  Summary:
+    One MCLK / PRE / OSR combination and what it yields.
+
+  Remarks:
+    rate is in milli-samples per second, enob in tenths of a bit (data
+    sheet figure for the OSR at gain 1).
+*/
+
+typedef struct
+{
+    MCP3564_RATE_SOURCE source;
+    uint32_t sourceHz;
+    uint32_t mclkDiv;
+    uint32_t mclkHz;
+    uint8_t preCode;
+    uint8_t osrCode;
+    uint32_t pre;
+    uint32_t osr;
+    uint32_t rate;
+    uint8_t enob;
+
+} MCP3564_RATE;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+/*******************************************************************************
+  Function:
+    bool MCP3564_RATE_Find ( uint32_t rate, MCP3564_RATE* setting )
+
+  Summary:
+    Closest achievable data rate to rate (milli-sps).
+
+  Description:
+    Of the settings with the smallest rate error the one with the highest
+    OSR wins, as it has the lowest noise; among equal OSRs the DFLL and the
+    lower PRE. Fails for rate 0.
+*/
+
+bool MCP3564_RATE_Find ( uint32_t rate, MCP3564_RATE* setting );
+
+/*******************************************************************************
+  Function:
+    bool MCP3564_RATE_Apply ( const MCP3564_RATE* setting )
+
+  Summary:
+    Programs the GCLK5 source and DIV, CONFIG1 and, if needed,
+    CONFIG0.CLK_SEL.
+
+  Remarks:
+    CONFIG0 is switched to the external clock when it selects the internal
+    oscillator. Fails while the acquisition runs.
+*/
+
+bool MCP3564_RATE_Apply ( const MCP3564_RATE* setting );
+
+/*******************************************************************************
+  Function:
+    bool MCP3564_RATE_Get ( MCP3564_RATE* setting )
+
+  Summary:
+    Current setting from GCLK5 and CONFIG1 (through the register cache).
+*/
+
+bool MCP3564_RATE_Get ( MCP3564_RATE* setting );
+
+//DOM-IGNORE-BEGIN
+#ifdef __cplusplus
+}
+#endif
+//DOM-IGNORE-END
+
+#endif /* _MCP3564_RATE_H */
+
+/*******************************************************************************
+ End of File
+ */
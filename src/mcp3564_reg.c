@@ -0,0 +1,249 @@
+/*******************************************************************************
+  MCP3564 Register Map Source File
+
+  File Name:
+    mcp3564_reg.c
+
+  Summary:
+    Constant descriptor table of the MCP3564 internal registers.
+
+  Description:
+    Widths and access rights follow the MCP3561/2/4 data sheet register
+    map. RESERVED0 must keep its 0x900000 default and RESERVED2 holds the
+    read-only chip ID, so neither is writable from the console.
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdlib.h>
+#include <string.h>
+#include "mcp3564_reg.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+#define MCP3564_REG_ENTRY(reg, bytes, rights)                                   \
+    {                                                                           \
+        .name = #reg,                                                           \
+        .address = MCP3564_REG_##reg,                                           \
+        .size = (bytes),                                                        \
+        .access = (rights),                                                     \
+        .readCmd = MCP3564_CMD(MCP3564_REG_##reg, MCP3564_CMD_TYPE_INC_READ),   \
+        .writeCmd = MCP3564_CMD(MCP3564_REG_##reg, MCP3564_CMD_TYPE_INC_WRITE), \
+    }
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data
+// *****************************************************************************
+// *****************************************************************************
+
+/* Indexed by address */
+static const MCP3564_REG mcp3564Regs[MCP3564_REG_COUNT] =
+{
+    MCP3564_REG_ENTRY(ADCDATA,   3U, MCP3564_ACCESS_R),
+    MCP3564_REG_ENTRY(CONFIG0,   1U, MCP3564_ACCESS_RW),
+    MCP3564_REG_ENTRY(CONFIG1,   1U, MCP3564_ACCESS_RW),
+    MCP3564_REG_ENTRY(CONFIG2,   1U, MCP3564_ACCESS_RW),
+    MCP3564_REG_ENTRY(CONFIG3,   1U, MCP3564_ACCESS_RW),
+    MCP3564_REG_ENTRY(IRQ,       1U, MCP3564_ACCESS_RW),
+    MCP3564_REG_ENTRY(MUX,       1U, MCP3564_ACCESS_RW),
+    MCP3564_REG_ENTRY(SCAN,      3U, MCP3564_ACCESS_RW),
+    MCP3564_REG_ENTRY(TIMER,     3U, MCP3564_ACCESS_RW),
+    MCP3564_REG_ENTRY(OFFSETCAL, 3U, MCP3564_ACCESS_RW),
+    MCP3564_REG_ENTRY(GAINCAL,   3U, MCP3564_ACCESS_RW),
+    MCP3564_REG_ENTRY(RESERVED0, 3U, MCP3564_ACCESS_R),
+    MCP3564_REG_ENTRY(RESERVED1, 1U, MCP3564_ACCESS_R),
+    MCP3564_REG_ENTRY(LOCK,      1U, MCP3564_ACCESS_RW),
+    MCP3564_REG_ENTRY(RESERVED2, 2U, MCP3564_ACCESS_R),
+    MCP3564_REG_ENTRY(CRCCFG,    2U, MCP3564_ACCESS_R),
+};
+
+/* CRC-16 polynomial 0x8005, one byte per lookup */
+static const uint16_t mcp3564Crc16[256] =
+{
+    0x0000U, 0x8005U, 0x800FU, 0x000AU, 0x801BU, 0x001EU, 0x0014U, 0x8011U,
+    0x8033U, 0x0036U, 0x003CU, 0x8039U, 0x0028U, 0x802DU, 0x8027U, 0x0022U,
+    0x8063U, 0x0066U, 0x006CU, 0x8069U, 0x0078U, 0x807DU, 0x8077U, 0x0072U,
+    0x0050U, 0x8055U, 0x805FU, 0x005AU, 0x804BU, 0x004EU, 0x0044U, 0x8041U,
+    0x80C3U, 0x00C6U, 0x00CCU, 0x80C9U, 0x00D8U, 0x80DDU, 0x80D7U, 0x00D2U,
+    0x00F0U, 0x80F5U, 0x80FFU, 0x00FAU, 0x80EBU, 0x00EEU, 0x00E4U, 0x80E1U,
+    0x00A0U, 0x80A5U, 0x80AFU, 0x00AAU, 0x80BBU, 0x00BEU, 0x00B4U, 0x80B1U,
+    0x8093U, 0x0096U, 0x009CU, 0x8099U, 0x0088U, 0x808DU, 0x8087U, 0x0082U,
+    0x8183U, 0x0186U, 0x018CU, 0x8189U, 0x0198U, 0x819DU, 0x8197U, 0x0192U,
+    0x01B0U, 0x81B5U, 0x81BFU, 0x01BAU, 0x81ABU, 0x01AEU, 0x01A4U, 0x81A1U,
+    0x01E0U, 0x81E5U, 0x81EFU, 0x01EAU, 0x81FBU, 0x01FEU, 0x01F4U, 0x81F1U,
+    0x81D3U, 0x01D6U, 0x01DCU, 0x81D9U, 0x01C8U, 0x81CDU, 0x81C7U, 0x01C2U,
+    0x0140U, 0x8145U, 0x814FU, 0x014AU, 0x815BU, 0x015EU, 0x0154U, 0x8151U,
+    0x8173U, 0x0176U, 0x017CU, 0x8179U, 0x0168U, 0x816DU, 0x8167U, 0x0162U,
+    0x8123U, 0x0126U, 0x012CU, 0x8129U, 0x0138U, 0x813DU, 0x8137U, 0x0132U,
+    0x0110U, 0x8115U, 0x811FU, 0x011AU, 0x810BU, 0x010EU, 0x0104U, 0x8101U,
+    0x8303U, 0x0306U, 0x030CU, 0x8309U, 0x0318U, 0x831DU, 0x8317U, 0x0312U,
+    0x0330U, 0x8335U, 0x833FU, 0x033AU, 0x832BU, 0x032EU, 0x0324U, 0x8321U,
+    0x0360U, 0x8365U, 0x836FU, 0x036AU, 0x837BU, 0x037EU, 0x0374U, 0x8371U,
+    0x8353U, 0x0356U, 0x035CU, 0x8359U, 0x0348U, 0x834DU, 0x8347U, 0x0342U,
+    0x03C0U, 0x83C5U, 0x83CFU, 0x03CAU, 0x83DBU, 0x03DEU, 0x03D4U, 0x83D1U,
+    0x83F3U, 0x03F6U, 0x03FCU, 0x83F9U, 0x03E8U, 0x83EDU, 0x83E7U, 0x03E2U,
+    0x83A3U, 0x03A6U, 0x03ACU, 0x83A9U, 0x03B8U, 0x83BDU, 0x83B7U, 0x03B2U,
+    0x0390U, 0x8395U, 0x839FU, 0x039AU, 0x838BU, 0x038EU, 0x0384U, 0x8381U,
+    0x0280U, 0x8285U, 0x828FU, 0x028AU, 0x829BU, 0x029EU, 0x0294U, 0x8291U,
+    0x82B3U, 0x02B6U, 0x02BCU, 0x82B9U, 0x02A8U, 0x82ADU, 0x82A7U, 0x02A2U,
+    0x82E3U, 0x02E6U, 0x02ECU, 0x82E9U, 0x02F8U, 0x82FDU, 0x82F7U, 0x02F2U,
+    0x02D0U, 0x82D5U, 0x82DFU, 0x02DAU, 0x82CBU, 0x02CEU, 0x02C4U, 0x82C1U,
+    0x8243U, 0x0246U, 0x024CU, 0x8249U, 0x0258U, 0x825DU, 0x8257U, 0x0252U,
+    0x0270U, 0x8275U, 0x827FU, 0x027AU, 0x826BU, 0x026EU, 0x0264U, 0x8261U,
+    0x0220U, 0x8225U, 0x822FU, 0x022AU, 0x823BU, 0x023EU, 0x0234U, 0x8231U,
+    0x8213U, 0x0216U, 0x021CU, 0x8219U, 0x0208U, 0x820DU, 0x8207U, 0x0202U,
+};
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+/* Next register of an incremental read, MSB first; advances *data */
+static uint32_t lMCP3564_REG_Field(const uint8_t** data, uint32_t address)
+{
+    const uint8_t* p = *data;
+    uint32_t value = 0;
+    uint32_t i;
+
+    for (i = 0; i < mcp3564Regs[address].size; i++)
+    {
+        value = (value << 8) | p[i];
+    }
+
+    *data = p + mcp3564Regs[address].size;
+
+    return value;
+}
+
+/* Counterpart of lMCP3564_REG_Field for writes */
+static void lMCP3564_REG_FieldPut(uint8_t** data, uint32_t address, uint32_t value)
+{
+    uint8_t* p = *data;
+    uint32_t size = mcp3564Regs[address].size;
+    uint32_t i;
+
+    for (i = 0; i < size; i++)
+    {
+        p[i] = (uint8_t) (value >> (8U * (size - 1U - i)));
+    }
+
+    *data = p + size;
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+const MCP3564_REG* MCP3564_REG_Get(uint32_t address)
+{
+    return (address < MCP3564_REG_COUNT) ? &mcp3564Regs[address] : NULL;
+}
+
+const MCP3564_REG* MCP3564_REG_Parse(const char* text)
+{
+    char* end;
+    unsigned long address;
+    uint32_t i;
+
+    if ((text == NULL) || (*text == '\0'))
+    {
+        return NULL;
+    }
+
+    address = strtoul(text, &end, 0);
+    if (*end == '\0')
+    {
+        return MCP3564_REG_Get((uint32_t) address);
+    }
+
+    for (i = 0; i < MCP3564_REG_COUNT; i++)
+    {
+        if (strcmp(text, mcp3564Regs[i].name) == 0)
+        {
+            return &mcp3564Regs[i];
+        }
+    }
+
+    return NULL;
+}
+
+void MCP3564_REG_SnapshotDecode(const uint8_t* data, MCP3564_SNAPSHOT* snapshot)
+{
+    snapshot->config0   = (uint8_t) lMCP3564_REG_Field(&data, MCP3564_REG_CONFIG0);
+    snapshot->config1   = (uint8_t) lMCP3564_REG_Field(&data, MCP3564_REG_CONFIG1);
+    snapshot->config2   = (uint8_t) lMCP3564_REG_Field(&data, MCP3564_REG_CONFIG2);
+    snapshot->config3   = (uint8_t) lMCP3564_REG_Field(&data, MCP3564_REG_CONFIG3);
+    snapshot->irq       = (uint8_t) lMCP3564_REG_Field(&data, MCP3564_REG_IRQ);
+    snapshot->mux       = (uint8_t) lMCP3564_REG_Field(&data, MCP3564_REG_MUX);
+    snapshot->scan      = lMCP3564_REG_Field(&data, MCP3564_REG_SCAN);
+    snapshot->timer     = lMCP3564_REG_Field(&data, MCP3564_REG_TIMER);
+    snapshot->offsetcal = lMCP3564_REG_Field(&data, MCP3564_REG_OFFSETCAL);
+    snapshot->gaincal   = lMCP3564_REG_Field(&data, MCP3564_REG_GAINCAL);
+    snapshot->reserved0 = lMCP3564_REG_Field(&data, MCP3564_REG_RESERVED0);
+    snapshot->reserved1 = (uint8_t) lMCP3564_REG_Field(&data, MCP3564_REG_RESERVED1);
+    snapshot->lock      = (uint8_t) lMCP3564_REG_Field(&data, MCP3564_REG_LOCK);
+    snapshot->reserved2 = (uint16_t) lMCP3564_REG_Field(&data, MCP3564_REG_RESERVED2);
+    snapshot->crccfg    = (uint16_t) lMCP3564_REG_Field(&data, MCP3564_REG_CRCCFG);
+}
+
+uint32_t MCP3564_REG_ConfigEncode(const MCP3564_CONFIG* config, bool scan, uint8_t* data)
+{
+    uint8_t* p = data;
+
+    lMCP3564_REG_FieldPut(&p, MCP3564_REG_CONFIG0, config->config0);
+    lMCP3564_REG_FieldPut(&p, MCP3564_REG_CONFIG1, config->config1);
+    lMCP3564_REG_FieldPut(&p, MCP3564_REG_CONFIG2, config->config2);
+    lMCP3564_REG_FieldPut(&p, MCP3564_REG_CONFIG3, config->config3);
+    lMCP3564_REG_FieldPut(&p, MCP3564_REG_IRQ, config->irq);
+    lMCP3564_REG_FieldPut(&p, MCP3564_REG_MUX, config->mux);
+
+    if (scan)
+    {
+        lMCP3564_REG_FieldPut(&p, MCP3564_REG_SCAN, config->scan);
+        lMCP3564_REG_FieldPut(&p, MCP3564_REG_TIMER, config->timer);
+    }
+
+    return (uint32_t) (p - data);
+}
+
+uint32_t MCP3564_REG_Pack(const uint32_t* values, uint32_t first, uint32_t last, uint8_t* data)
+{
+    uint8_t* p = data;
+    uint32_t address;
+
+    for (address = first; (address <= last) && (address < MCP3564_REG_COUNT); address++)
+    {
+        lMCP3564_REG_FieldPut(&p, address, values[address]);
+    }
+
+    return (uint32_t) (p - data);
+}
+
+uint16_t MCP3564_REG_Crc16(const uint8_t* data, uint32_t size)
+{
+    uint32_t crc = MCP3564_CRC_SEED;
+
+    while (size-- != 0U)
+    {
+        crc = ((crc << 8) & 0xFFFFU) ^ mcp3564Crc16[((crc >> 8) ^ *data++) & 0xFFU];
+    }
+
+    return (uint16_t) crc;
+}
+
+/*******************************************************************************
+ End of File
+ */
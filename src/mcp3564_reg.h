@@ -0,0 +1,275 @@
+/*******************************************************************************
+  MCP3564 Register Map Header File
+
+  File Name:
+    mcp3564_reg.h
+
+  Summary:
+    Constant descriptor table of the MCP3564 internal registers.
+
+  Description:
+    One descriptor per register address (0x0..0xF) holding the name, the
+    width, the access rights and the read/write command bytes. The command
+    bytes are constant expressions, so the table lives in flash and nothing
+    is assembled at run time. Lookup by address is an array index.
+*******************************************************************************/
+
+#ifndef _MCP3564_REG_H
+#define _MCP3564_REG_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+extern "C" {
+
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Constants
+// *****************************************************************************
+// *****************************************************************************
+
+/* Device address, bits 7:6 of every command byte */
+#define MCP3564_DEVICE_ADDRESS              0x1U
+
+/* Command types, bits 1:0 */
+#define MCP3564_CMD_TYPE_STATIC_READ        0x1U
+#define MCP3564_CMD_TYPE_INC_WRITE          0x2U
+#define MCP3564_CMD_TYPE_INC_READ           0x3U
+
+#define MCP3564_CMD(address, type)          ((uint8_t) ((MCP3564_DEVICE_ADDRESS << 6) | ((uint32_t) (address) << 2) | (type)))
+
+/* Register addresses */
+#define MCP3564_REG_ADCDATA                 0x0U
+#define MCP3564_REG_CONFIG0                 0x1U
+#define MCP3564_REG_CONFIG1                 0x2U
+#define MCP3564_REG_CONFIG2                 0x3U
+#define MCP3564_REG_CONFIG3                 0x4U
+#define MCP3564_REG_IRQ                     0x5U
+#define MCP3564_REG_MUX                     0x6U
+#define MCP3564_REG_SCAN                    0x7U
+#define MCP3564_REG_TIMER                   0x8U
+#define MCP3564_REG_OFFSETCAL               0x9U
+#define MCP3564_REG_GAINCAL                 0xAU
+#define MCP3564_REG_RESERVED0               0xBU
+#define MCP3564_REG_RESERVED1               0xCU
+#define MCP3564_REG_LOCK                    0xDU
+#define MCP3564_REG_RESERVED2               0xEU
+#define MCP3564_REG_CRCCFG                  0xFU
+
+#define MCP3564_REG_COUNT                   16U
+
+/* Widest register in bytes (ADCDATA with DATA_FORMAT 32 bit) */
+#define MCP3564_REG_SIZE_MAX                4U
+
+/* Bytes clocked out by one incremental read from CONFIG0 to CRCCFG */
+#define MCP3564_SNAPSHOT_SIZE               27U
+
+/* Bytes of one incremental write from CONFIG0: up to MUX, or up to TIMER */
+#define MCP3564_CONFIG_SIZE                 6U
+#define MCP3564_CONFIG_SIZE_SCAN            12U
+
+/* IRQ bits 6:4 are status flags, only 3:0 read back what was written */
+#define MCP3564_IRQ_WRITE_MASK              0x0FU
+
+/* CONFIG3.EN_CRCCOM: a CRC-16 follows the data of every read.
+   CONFIG3.CRC_FORMAT left 0: 16 bit CRC, no padding. */
+#define MCP3564_CONFIG3_EN_CRCCOM           0x04U
+#define MCP3564_CRC_SIZE                    2U
+#define MCP3564_CRC_SEED                    0x0000U
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Type Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+typedef enum
+{
+    MCP3564_ACCESS_R = 0x1,
+    MCP3564_ACCESS_W = 0x2,
+    MCP3564_ACCESS_RW = 0x3
+
+} MCP3564_ACCESS;
+
+// *****************************************************************************
+/* Register descriptor
+
+  Summary:
+    Static description of one MCP3564 register.
+
+  Remarks:
+    size is in bytes. ADCDATA is listed with the 24 bit width of the default
+    DATA_FORMAT; the streaming path in adc_acq.c handles the other formats.
+*/
+
+typedef struct
+{
+    const char* name;
+    uint8_t address;
+    uint8_t size;
+    uint8_t access;
+    uint8_t readCmd;
+    uint8_t writeCmd;
+
+} MCP3564_REG;
+
+// *****************************************************************************
+/* Register file snapshot
+
+  Summary:
+    CONFIG0..CRCCFG as returned by one incremental read, decoded.
+
+  Remarks:
+    reserved2 holds the chip ID. crccfg is the CRC of the configuration as
+    computed by the device.
+*/
+
+typedef struct
+{
+    uint8_t config0;
+    uint8_t config1;
+    uint8_t config2;
+    uint8_t config3;
+    uint8_t irq;
+    uint8_t mux;
+    uint32_t scan;
+    uint32_t timer;
+    uint32_t offsetcal;
+    uint32_t gaincal;
+    uint32_t reserved0;
+    uint8_t reserved1;
+    uint8_t lock;
+    uint16_t reserved2;
+    uint16_t crccfg;
+
+} MCP3564_SNAPSHOT;
+
+// *****************************************************************************
+/* Configuration set
+
+  Summary:
+    The writable registers from CONFIG0 to TIMER, applied with one
+    incremental write.
+
+  Remarks:
+    scan and timer are only sent when the caller asks for them; without
+    them the write stops after MUX.
+*/
+
+typedef struct
+{
+    uint8_t config0;
+    uint8_t config1;
+    uint8_t config2;
+    uint8_t config3;
+    uint8_t irq;
+    uint8_t mux;
+    uint32_t scan;
+    uint32_t timer;
+
+} MCP3564_CONFIG;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+/*******************************************************************************
+  Function:
+    const MCP3564_REG* MCP3564_REG_Get ( uint32_t address )
+
+  Summary:
+    Returns the descriptor of address, NULL if address is above 0xF.
+*/
+
+const MCP3564_REG* MCP3564_REG_Get ( uint32_t address );
+
+/*******************************************************************************
+  Function:
+    const MCP3564_REG* MCP3564_REG_Parse ( const char* text )
+
+  Summary:
+    Resolves a console argument to a descriptor.
+
+  Description:
+    Numbers ("0x4", "4") are an index into the table. Anything else is
+    compared against the register names, e.g. "CONFIG3".
+*/
+
+const MCP3564_REG* MCP3564_REG_Parse ( const char* text );
+
+/*******************************************************************************
+  Function:
+    void MCP3564_REG_SnapshotDecode ( const uint8_t* data, MCP3564_SNAPSHOT* snapshot )
+
+  Summary:
+    Splits the MCP3564_SNAPSHOT_SIZE bytes following the STATUS byte of an
+    incremental read at CONFIG0 into the register fields.
+*/
+
+void MCP3564_REG_SnapshotDecode ( const uint8_t* data, MCP3564_SNAPSHOT* snapshot );
+
+/*******************************************************************************
+  Function:
+    uint32_t MCP3564_REG_ConfigEncode ( const MCP3564_CONFIG* config, bool scan, uint8_t* data )
+
+  Summary:
+    Lays out config as the data bytes of an incremental write at CONFIG0.
+
+  Description:
+    Returns the number of bytes written to data: MCP3564_CONFIG_SIZE, or
+    MCP3564_CONFIG_SIZE_SCAN when scan is true.
+*/
+
+uint32_t MCP3564_REG_ConfigEncode ( const MCP3564_CONFIG* config, bool scan, uint8_t* data );
+
+/*******************************************************************************
+  Function:
+    uint32_t MCP3564_REG_Pack ( const uint32_t* values, uint32_t first, uint32_t last, uint8_t* data )
+
+  Summary:
+    Lays out values[first..last] as the data bytes of an incremental write
+    at first. Returns the number of bytes.
+*/
+
+uint32_t MCP3564_REG_Pack ( const uint32_t* values, uint32_t first, uint32_t last, uint8_t* data );
+
+/*******************************************************************************
+  Function:
+    uint16_t MCP3564_REG_Crc16 ( const uint8_t* data, uint32_t size )
+
+  Summary:
+    CRC-16 as appended by CRCCOM: polynomial 0x8005, MSB first, seeded
+    with MCP3564_CRC_SEED, over STATUS and the data bytes of a read.
+
+  Remarks:
+    Compare against the two bytes following the data, MSB first.
+*/
+
+uint16_t MCP3564_REG_Crc16 ( const uint8_t* data, uint32_t size );
+
+//DOM-IGNORE-BEGIN
+#ifdef __cplusplus
+}
+#endif
+//DOM-IGNORE-END
+
+#endif /* _MCP3564_REG_H */
+
+/*******************************************************************************
+ End of File
+ */
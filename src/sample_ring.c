@@ -0,0 +1,153 @@
+/*******************************************************************************
+  Sample Ring Buffer Source File
+
+  File Name:
+    sample_ring.c
+
+  Summary:
+    Lock-free single-producer/single-consumer ring of raw ADC samples.
+
+  Description:
+    The copy into the ring happens before head is published (release store),
+    and the consumer reads head with an acquire load before touching the
+    data. On the Cortex-M4 this compiles to a DMB around the index update,
+    no interrupt masking is needed on either side.
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <string.h>
+#include "sample_ring.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+static inline uint32_t lSAMPLE_RING_Load(const volatile uint32_t* index)
+{
+    return __atomic_load_n(index, __ATOMIC_ACQUIRE);
+}
+
+static inline void lSAMPLE_RING_Store(volatile uint32_t* index, uint32_t value)
+{
+    __atomic_store_n(index, value, __ATOMIC_RELEASE);
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+bool SAMPLE_RING_Initialize(SAMPLE_RING* ring, uint32_t* buffer, uint32_t size)
+{
+    if ((ring == NULL) || (buffer == NULL) || (size == 0U) || ((size & (size - 1U)) != 0U))
+    {
+        return false;
+    }
+
+    ring->buffer = buffer;
+    ring->mask = size - 1U;
+    SAMPLE_RING_Reset(ring);
+
+    return true;
+}
+
+void SAMPLE_RING_Reset(SAMPLE_RING* ring)
+{
+    ring->head = 0;
+    ring->tail = 0;
+    ring->highWater = 0;
+    ring->overruns = 0;
+}
+
+uint32_t SAMPLE_RING_Count(const SAMPLE_RING* ring)
+{
+    return lSAMPLE_RING_Load(&ring->head) - lSAMPLE_RING_Load(&ring->tail);
+}
+
+uint32_t SAMPLE_RING_Space(const SAMPLE_RING* ring)
+{
+    return (ring->mask + 1U) - SAMPLE_RING_Count(ring);
+}
+
+uint32_t SAMPLE_RING_Push(SAMPLE_RING* ring, const uint32_t* samples, uint32_t count)
+{
+    uint32_t head = ring->head;
+    uint32_t used = head - lSAMPLE_RING_Load(&ring->tail);
+    uint32_t space = (ring->mask + 1U) - used;
+    uint32_t index = head & ring->mask;
+    uint32_t first;
+
+    if (count > space)
+    {
+        ring->overruns += count - space;
+        count = space;
+    }
+
+    /* Up to the end of the storage, then wrap */
+    first = (ring->mask + 1U) - index;
+    if (first > count)
+    {
+        first = count;
+    }
+
+    memcpy(&ring->buffer[index], samples, first * sizeof(uint32_t));
+    memcpy(&ring->buffer[0], &samples[first], (count - first) * sizeof(uint32_t));
+
+    lSAMPLE_RING_Store(&ring->head, head + count);
+
+    used += count;
+    if (used > ring->highWater)
+    {
+        ring->highWater = used;
+    }
+
+    return count;
+}
+
+uint32_t SAMPLE_RING_Pop(SAMPLE_RING* ring, uint32_t* samples, uint32_t count)
+{
+    uint32_t tail = ring->tail;
+    uint32_t avail = lSAMPLE_RING_Load(&ring->head) - tail;
+    uint32_t index = tail & ring->mask;
+    uint32_t first;
+
+    if (count > avail)
+    {
+        count = avail;
+    }
+
+    first = (ring->mask + 1U) - index;
+    if (first > count)
+    {
+        first = count;
+    }
+
+    memcpy(samples, &ring->buffer[index], first * sizeof(uint32_t));
+    memcpy(&samples[first], &ring->buffer[0], (count - first) * sizeof(uint32_t));
+
+    lSAMPLE_RING_Store(&ring->tail, tail + count);
+
+    return count;
+}
+
+uint32_t SAMPLE_RING_HighWaterGet(const SAMPLE_RING* ring)
+{
+    return ring->highWater;
+}
+
+uint32_t SAMPLE_RING_OverrunsGet(const SAMPLE_RING* ring)
+{
+    return ring->overruns;
+}
+
+/*******************************************************************************
+ End of File
+ */
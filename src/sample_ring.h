@@ -0,0 +1,147 @@
+/*******************************************************************************
+  Sample Ring Buffer Header File
+
+  File Name:
+    sample_ring.h
+
+  Summary:
+    Lock-free single-producer/single-consumer ring of raw ADC samples.
+
+  Description:
+    One context (an ISR or a DMA completion handler) pushes, one context (the
+    application task) pops. The producer only writes head, the consumer only
+    writes tail, so neither side disables interrupts. Indices run free and
+    are masked on access, which requires a power-of-two capacity.
+*******************************************************************************/
+
+#ifndef _SAMPLE_RING_H
+#define _SAMPLE_RING_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+extern "C" {
+
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Type Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Sample ring object
+
+  Summary:
+    State of one ring. Treat as opaque, use the SAMPLE_RING_* functions.
+
+  Remarks:
+    highWater and overruns are owned by the producer and may be read at any
+    time by the consumer.
+*/
+
+typedef struct
+{
+    uint32_t* buffer;
+    uint32_t mask;
+
+    /* Written by the producer only */
+    volatile uint32_t head;
+    volatile uint32_t highWater;
+    volatile uint32_t overruns;
+
+    /* Written by the consumer only */
+    volatile uint32_t tail;
+
+} SAMPLE_RING;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+/*******************************************************************************
+  Function:
+    bool SAMPLE_RING_Initialize ( SAMPLE_RING* ring, uint32_t* buffer, uint32_t size )
+
+  Summary:
+    Binds a ring to caller supplied storage of size samples.
+
+  Remarks:
+    Returns false if size is not a power of two.
+*/
+
+bool SAMPLE_RING_Initialize ( SAMPLE_RING* ring, uint32_t* buffer, uint32_t size );
+
+/*******************************************************************************
+  Function:
+    void SAMPLE_RING_Reset ( SAMPLE_RING* ring )
+
+  Summary:
+    Empties the ring and clears the counters.
+
+  Remarks:
+    Only while neither producer nor consumer is active.
+*/
+
+void SAMPLE_RING_Reset ( SAMPLE_RING* ring );
+
+uint32_t SAMPLE_RING_Count ( const SAMPLE_RING* ring );
+
+uint32_t SAMPLE_RING_Space ( const SAMPLE_RING* ring );
+
+/*******************************************************************************
+  Function:
+    uint32_t SAMPLE_RING_Push ( SAMPLE_RING* ring, const uint32_t* samples, uint32_t count )
+
+  Summary:
+    Producer side. Copies up to count samples into the ring.
+
+  Description:
+    Returns the number of samples stored. Samples which do not fit are not
+    stored and are added to the overrun counter.
+*/
+
+uint32_t SAMPLE_RING_Push ( SAMPLE_RING* ring, const uint32_t* samples, uint32_t count );
+
+/*******************************************************************************
+  Function:
+    uint32_t SAMPLE_RING_Pop ( SAMPLE_RING* ring, uint32_t* samples, uint32_t count )
+
+  Summary:
+    Consumer side. Moves up to count samples out of the ring.
+
+  Description:
+    Returns the number of samples copied, 0 when the ring is empty.
+*/
+
+uint32_t SAMPLE_RING_Pop ( SAMPLE_RING* ring, uint32_t* samples, uint32_t count );
+
+uint32_t SAMPLE_RING_HighWaterGet ( const SAMPLE_RING* ring );
+
+uint32_t SAMPLE_RING_OverrunsGet ( const SAMPLE_RING* ring );
+
+//DOM-IGNORE-BEGIN
+#ifdef __cplusplus
+}
+#endif
+//DOM-IGNORE-END
+
+#endif /* _SAMPLE_RING_H */
+
+/*******************************************************************************
+ End of File
+ */